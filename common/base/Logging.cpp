@@ -37,12 +37,16 @@
 #include <syslog.h>
 #endif
 
+#include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include "ola/Logging.h"
 #include "ola/base/Flags.h"
+#include "ola/thread/Thread.h"
 
 /**@private*/
 DEFINE_s_int8(log_level, l, ola::OLA_LOG_WARN, "Set the logging level 0 .. 4.");
@@ -254,5 +258,139 @@ void UnixSyslogDestination::Write(log_level level, const string &log_line) {
 }
 #endif
 
+
+/**
+ * @cond HIDDEN_SYMBOLS
+ * The writer thread behind an AsyncLogDestination. Producers copy lines
+ * into preallocated fixed-size slots under a briefly-held mutex; the
+ * thread drains the ring and performs the (possibly slow) writes.
+ */
+class AsyncLogWriter: public ola::thread::Thread {
+ public:
+  AsyncLogWriter(LogDestination *destination, unsigned int ring_size)
+      : ola::thread::Thread(
+            ola::thread::Thread::Options("async-log")),
+        m_destination(destination),
+        m_ring_size(ring_size),
+        m_entries(new LogEntry[ring_size]),
+        m_head(0),
+        m_tail(0),
+        m_dropped(0),
+        m_reported_dropped(0),
+        m_shutdown(false) {
+  }
+
+  ~AsyncLogWriter() {
+    delete[] m_entries;
+    delete m_destination;
+  }
+
+  void Enqueue(log_level level, const string &log_line) {
+    ola::thread::MutexLocker locker(&m_mutex);
+    if (m_head - m_tail == m_ring_size) {
+      m_dropped++;
+      return;
+    }
+    LogEntry *entry = &m_entries[m_head % m_ring_size];
+    entry->level = level;
+    entry->length = static_cast<unsigned int>(
+        std::min(log_line.size(), sizeof(entry->line) - 1));
+    memcpy(entry->line, log_line.data(), entry->length);
+    m_head++;
+    m_condition.Signal();
+  }
+
+  void Shutdown() {
+    {
+      ola::thread::MutexLocker locker(&m_mutex);
+      m_shutdown = true;
+      m_condition.Signal();
+    }
+    Join();
+  }
+
+  uint64_t DroppedLines() const {
+    ola::thread::MutexLocker locker(&m_mutex);
+    return m_dropped;
+  }
+
+  void *Run() {
+    m_mutex.Lock();
+    while (true) {
+      while (m_tail == m_head && !m_shutdown) {
+        m_condition.Wait(&m_mutex);
+      }
+      if (m_tail == m_head && m_shutdown) {
+        break;
+      }
+      LogEntry *entry = &m_entries[m_tail % m_ring_size];
+      uint64_t dropped = m_dropped;
+      // write without the lock so producers never wait on I/O
+      m_mutex.Unlock();
+      m_destination->Write(
+          entry->level, string(entry->line, entry->length));
+      if (dropped != m_reported_dropped) {
+        ostringstream str;
+        str << "async log ring overflowed, dropped "
+            << dropped - m_reported_dropped << " lines\n";
+        m_destination->Write(OLA_LOG_WARN, str.str());
+        m_reported_dropped = dropped;
+      }
+      m_mutex.Lock();
+      m_tail++;
+    }
+    m_mutex.Unlock();
+    return NULL;
+  }
+
+ private:
+  struct LogEntry {
+    log_level level;
+    unsigned int length;
+    char line[512];
+  };
+
+  LogDestination *m_destination;
+  const unsigned int m_ring_size;
+  LogEntry *m_entries;
+  uint64_t m_head;  // next slot to fill
+  uint64_t m_tail;  // next slot to drain, only the writer advances this
+  uint64_t m_dropped;
+  uint64_t m_reported_dropped;  // only touched by the writer
+  bool m_shutdown;
+  mutable ola::thread::Mutex m_mutex;
+  ola::thread::ConditionVariable m_condition;
+};
+/**@endcond*/
+
+
+AsyncLogDestination::AsyncLogDestination(LogDestination *destination,
+                                         unsigned int ring_size)
+    : m_writer(new AsyncLogWriter(destination, ring_size)) {
+}
+
+AsyncLogDestination::~AsyncLogDestination() {
+  Stop();
+  delete m_writer;
+}
+
+bool AsyncLogDestination::Start() {
+  return m_writer->Start();
+}
+
+void AsyncLogDestination::Stop() {
+  if (m_writer->IsRunning()) {
+    m_writer->Shutdown();
+  }
+}
+
+void AsyncLogDestination::Write(log_level level, const string &log_line) {
+  m_writer->Enqueue(level, log_line);
+}
+
+uint64_t AsyncLogDestination::DroppedLines() const {
+  return m_writer->DroppedLines();
+}
+
 }  // namespace  ola
 /**@}*/
@@ -7,6 +7,7 @@ common_libolacommon_la_SOURCES += \
     common/base/Init.cpp \
     common/base/Logging.cpp \
     common/base/SysExits.cpp \
+    common/base/TraceRing.cpp \
     common/base/Version.cpp
 
 # TESTS
@@ -0,0 +1,116 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TraceRing.cpp
+ * A fixed-size in-memory ring of trace events, for postmortem debugging.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <sstream>
+#include <string>
+
+#include "ola/Logging.h"
+#include "ola/base/TraceRing.h"
+
+namespace ola {
+
+using std::ostringstream;
+using std::string;
+
+namespace {
+
+uint64_t MonotonicNanos() {
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+  }
+#endif  // CLOCK_MONOTONIC
+  return 0;
+}
+}  // namespace
+
+TraceRing *TraceRing::Instance() {
+  static TraceRing *ring = new TraceRing();
+  return ring;
+}
+
+TraceRing::TraceRing() : m_next(0) {
+  memset(m_events, 0, sizeof(m_events));
+}
+
+void TraceRing::Emit(uint16_t event, uint64_t arg) {
+  uint64_t slot = __atomic_fetch_add(&m_next, 1, __ATOMIC_RELAXED);
+  TraceEvent *entry = &m_events[slot & (RING_SIZE - 1)];
+  entry->timestamp_ns = MonotonicNanos();
+  entry->arg = arg;
+  entry->event = event;
+}
+
+void TraceRing::Dump(std::ostream *output) const {
+  uint64_t next = __atomic_load_n(&m_next, __ATOMIC_RELAXED);
+  uint64_t first = next > RING_SIZE ? next - RING_SIZE : 0;
+  for (uint64_t i = first; i < next; i++) {
+    const TraceEvent *entry = &m_events[i & (RING_SIZE - 1)];
+    if (entry->event == EVENT_NONE) {
+      continue;
+    }
+    *output << entry->timestamp_ns / 1000000000ull << "."
+            << entry->timestamp_ns % 1000000000ull << " "
+            << EventName(static_cast<uint16_t>(entry->event)) << " "
+            << entry->arg << "\n";
+  }
+}
+
+void TraceRing::DumpToLog() {
+  ostringstream str;
+  Dump(&str);
+  OLA_WARN << "--- trace ring dump, " << EventCount() << " events total ---";
+  string line;
+  std::istringstream lines(str.str());
+  while (std::getline(lines, line)) {
+    OLA_WARN << line;
+  }
+  OLA_WARN << "--- end of trace ring dump ---";
+}
+
+uint64_t TraceRing::EventCount() const {
+  return __atomic_load_n(&m_next, __ATOMIC_RELAXED);
+}
+
+const char *TraceRing::EventName(uint16_t event) {
+  switch (event) {
+    case EVENT_PACKET_IN:
+      return "packet-in";
+    case EVENT_MERGE_START:
+      return "merge-start";
+    case EVENT_MERGE_END:
+      return "merge-end";
+    case EVENT_PORT_FLUSH:
+      return "port-flush";
+    case EVENT_RPC_DISPATCH:
+      return "rpc-dispatch";
+    case EVENT_LOOP_STALL:
+      return "loop-stall";
+    case EVENT_USER:
+      return "user";
+    default:
+      return "unknown";
+  }
+}
+}  // namespace ola
@@ -0,0 +1,95 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DmxBufferPool.cpp
+ * The DmxBufferPool class.
+ * Copyright (C) 2005 Simon Newton
+ *
+ * Each pooled block holds the buffer's reference count followed by the slot
+ * data, so a pooled DmxBuffer performs no heap allocation of its own.
+ */
+
+#include <ola/Constants.h>
+#include <ola/Logging.h>
+#include <ola/dmx/DmxBufferPool.h>
+#include <ola/stl/STLUtils.h>
+
+#include <vector>
+
+namespace ola {
+namespace dmx {
+
+namespace {
+// The slot data follows the reference count within each block.
+const unsigned int DATA_OFFSET = sizeof(unsigned int);
+}  // namespace
+
+DmxBufferPool::DmxBufferPool(unsigned int buffers_to_reserve)
+    : m_pool(DMX_UNIVERSE_SIZE + DATA_OFFSET) {
+  std::vector<ola::io::MemoryBlock*> blocks;
+  blocks.reserve(buffers_to_reserve);
+  for (unsigned int i = 0; i < buffers_to_reserve; i++) {
+    ola::io::MemoryBlock *block = m_pool.Allocate();
+    if (block)
+      blocks.push_back(block);
+  }
+  for (std::vector<ola::io::MemoryBlock*>::const_iterator iter =
+           blocks.begin(); iter != blocks.end(); ++iter) {
+    m_pool.Release(*iter);
+  }
+}
+
+
+DmxBufferPool::~DmxBufferPool() {
+  if (!m_blocks_in_use.empty())
+    OLA_WARN << "DmxBufferPool destroyed with " << m_blocks_in_use.size()
+             << " buffers still in use";
+  STLDeleteValues(&m_blocks_in_use);
+}
+
+
+DmxBuffer DmxBufferPool::Create() {
+  uint8_t *data;
+  unsigned int *ref_count;
+  if (!AllocateBacking(&data, &ref_count))
+    return DmxBuffer();
+  return DmxBuffer(this, data, ref_count);
+}
+
+
+bool DmxBufferPool::AllocateBacking(uint8_t **data, unsigned int **ref_count) {
+  ola::io::MemoryBlock *block = m_pool.Allocate();
+  if (!block)
+    return false;
+  uint8_t *base = block->Data();
+  STLReplaceAndDelete(&m_blocks_in_use, base + DATA_OFFSET, block);
+  *ref_count = reinterpret_cast<unsigned int*>(base);
+  *data = base + DATA_OFFSET;
+  **ref_count = 1;
+  return true;
+}
+
+
+void DmxBufferPool::ReleaseBacking(uint8_t *data) {
+  ola::io::MemoryBlock *block = STLLookupAndRemovePtr(&m_blocks_in_use, data);
+  if (!block) {
+    OLA_WARN << "DmxBufferPool asked to release an unknown buffer @"
+             << reinterpret_cast<void*>(data);
+    return;
+  }
+  m_pool.Release(block);
+}
+}  // namespace dmx
+}  // namespace ola
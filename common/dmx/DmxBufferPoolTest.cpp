@@ -0,0 +1,96 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DmxBufferPoolTest.cpp
+ * Test fixture for the DmxBufferPool class
+ * Copyright (C) 2005 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string.h>
+
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/dmx/DmxBufferPool.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::DmxBuffer;
+using ola::dmx::DmxBufferPool;
+
+class DmxBufferPoolTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(DmxBufferPoolTest);
+  CPPUNIT_TEST(testCreateAndRecycle);
+  CPPUNIT_TEST(testCopyOnWrite);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testCreateAndRecycle();
+    void testCopyOnWrite();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DmxBufferPoolTest);
+
+
+/*
+ * Check buffers are handed out and their backing store is recycled.
+ */
+void DmxBufferPoolTest::testCreateAndRecycle() {
+  DmxBufferPool pool(1);
+  OLA_ASSERT_EQ(1u, pool.FreeBuffers());
+  OLA_ASSERT_EQ(1u, pool.BuffersAllocated());
+
+  {
+    DmxBuffer buffer = pool.Create();
+    OLA_ASSERT_EQ(0u, buffer.Size());
+    OLA_ASSERT_EQ(0u, pool.FreeBuffers());
+
+    OLA_ASSERT_TRUE(buffer.SetFromString("1,2,3,4"));
+    OLA_ASSERT_EQ(4u, buffer.Size());
+    OLA_ASSERT_EQ(static_cast<uint8_t>(3), buffer.Get(2));
+  }
+
+  // destroying the buffer returns the backing to the pool
+  OLA_ASSERT_EQ(1u, pool.FreeBuffers());
+  OLA_ASSERT_EQ(1u, pool.BuffersAllocated());
+
+  // the recycled backing is reused, not reallocated
+  DmxBuffer buffer = pool.Create();
+  OLA_ASSERT_TRUE(buffer.Blackout());
+  OLA_ASSERT_EQ(1u, pool.BuffersAllocated());
+}
+
+
+/*
+ * Check copy-on-write works across pooled and heap buffers.
+ */
+void DmxBufferPoolTest::testCopyOnWrite() {
+  DmxBufferPool pool;
+  DmxBuffer buffer = pool.Create();
+  OLA_ASSERT_TRUE(buffer.SetFromString("10,20,30"));
+
+  {
+    DmxBuffer copy = buffer;
+    OLA_ASSERT_TRUE(copy == buffer);
+
+    // writing to the copy diverges it onto a second pooled backing
+    copy.SetChannel(0, 99);
+    OLA_ASSERT_EQ(static_cast<uint8_t>(99), copy.Get(0));
+    OLA_ASSERT_EQ(static_cast<uint8_t>(10), buffer.Get(0));
+    OLA_ASSERT_EQ(2u, pool.BuffersAllocated());
+  }
+
+  OLA_ASSERT_EQ(1u, pool.FreeBuffers());
+}
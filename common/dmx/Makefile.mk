@@ -1,11 +1,25 @@
 # LIBRARIES
 ##################################################
-common_libolacommon_la_SOURCES += common/dmx/RunLengthEncoder.cpp
+common_libolacommon_la_SOURCES += \
+    common/dmx/DmxBufferPool.cpp \
+    common/dmx/MergeKernel.cpp \
+    common/dmx/RunLengthEncoder.cpp
 
 # TESTS
 ##################################################
 test_programs += common/dmx/RunLengthEncoderTester
 
-common_dmx_RunLengthEncoderTester_SOURCES = common/dmx/RunLengthEncoderTest.cpp
+common_dmx_RunLengthEncoderTester_SOURCES = \
+    common/dmx/DmxBufferPoolTest.cpp \
+    common/dmx/MergeKernelTest.cpp \
+    common/dmx/RunLengthEncoderTest.cpp
 common_dmx_RunLengthEncoderTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_dmx_RunLengthEncoderTester_LDADD = $(COMMON_TESTING_LIBS)
+
+# BENCHMARKS
+##################################################
+noinst_PROGRAMS += common/dmx/dmx_benchmark
+common_dmx_dmx_benchmark_SOURCES = common/dmx/dmx_benchmark.cpp
+common_dmx_dmx_benchmark_LDADD = common/libolacommon.la
+
+BENCHMARK_PROGS += common/dmx/dmx_benchmark
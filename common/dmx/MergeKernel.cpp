@@ -0,0 +1,144 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MergeKernel.cpp
+ * The slot merge kernels.
+ * Copyright (C) 2005 Simon Newton
+ */
+
+#include <ola/dmx/MergeKernel.h>
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OLA_MERGE_KERNEL_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define OLA_MERGE_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ola {
+namespace dmx {
+
+namespace {
+
+typedef void (*MergeFunction)(uint8_t *dest,
+                              const uint8_t *src,
+                              unsigned int length);
+
+/*
+ * The portable per-slot merge, also used for the tail the vector kernels
+ * don't cover.
+ */
+void ScalarHTPMerge(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  for (unsigned int i = 0; i < length; i++) {
+    dest[i] = std::max(dest[i], src[i]);
+  }
+}
+
+#ifdef OLA_MERGE_KERNEL_X86
+/*
+ * 16 slots per iteration. SSE2 is part of the x86-64 baseline so this is
+ * always available there.
+ */
+__attribute__((target("sse2")))
+void SSE2HTPMerge(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_max_epu8(a, b));
+  }
+  ScalarHTPMerge(dest + i, src + i, length - i);
+}
+
+/*
+ * 32 slots per iteration, a 512 slot frame is 16 iterations.
+ */
+__attribute__((target("avx2")))
+void AVX2HTPMerge(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i a = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(dest + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                        _mm256_max_epu8(a, b));
+  }
+  ScalarHTPMerge(dest + i, src + i, length - i);
+}
+#endif  // OLA_MERGE_KERNEL_X86
+
+#ifdef OLA_MERGE_KERNEL_NEON
+/*
+ * 16 slots per iteration. NEON is mandatory on aarch64 and this is only
+ * compiled in when the toolchain advertises it on 32 bit ARM.
+ */
+void NeonHTPMerge(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dest + i, vmaxq_u8(vld1q_u8(dest + i), vld1q_u8(src + i)));
+  }
+  ScalarHTPMerge(dest + i, src + i, length - i);
+}
+#endif  // OLA_MERGE_KERNEL_NEON
+
+struct Kernel {
+  MergeFunction fn;
+  const char *name;
+};
+
+/*
+ * Pick the widest kernel the host CPU supports. This runs once, at static
+ * init time.
+ */
+Kernel SelectKernel() {
+  Kernel kernel = { ScalarHTPMerge, "scalar" };
+#if defined(OLA_MERGE_KERNEL_X86)
+  if (__builtin_cpu_supports("avx2")) {
+    kernel.fn = AVX2HTPMerge;
+    kernel.name = "avx2";
+  } else if (__builtin_cpu_supports("sse2")) {
+    kernel.fn = SSE2HTPMerge;
+    kernel.name = "sse2";
+  }
+#elif defined(OLA_MERGE_KERNEL_NEON)
+  kernel.fn = NeonHTPMerge;
+  kernel.name = "neon";
+#endif
+  return kernel;
+}
+
+/*
+ * A function local static avoids any static init ordering problems if a
+ * merge runs during another translation unit's initialization.
+ */
+const Kernel &GetKernel() {
+  static const Kernel kernel = SelectKernel();
+  return kernel;
+}
+}  // namespace
+
+void HTPMergeSlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  GetKernel().fn(dest, src, length);
+}
+
+const char *MergeKernelName() {
+  return GetKernel().name;
+}
+}  // namespace dmx
+}  // namespace ola
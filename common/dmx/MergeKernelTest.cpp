@@ -0,0 +1,92 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MergeKernelTest.cpp
+ * Test fixture for the merge kernels
+ * Copyright (C) 2005 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "ola/Constants.h"
+#include "ola/dmx/MergeKernel.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::dmx::HTPMergeSlots;
+using ola::dmx::MergeKernelName;
+
+class MergeKernelTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MergeKernelTest);
+  CPPUNIT_TEST(testMerge);
+  CPPUNIT_TEST(testUnalignedLengths);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testMerge();
+    void testUnalignedLengths();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MergeKernelTest);
+
+
+/*
+ * Check a full frame merge matches the per-slot definition.
+ */
+void MergeKernelTest::testMerge() {
+  uint8_t dest[ola::DMX_UNIVERSE_SIZE];
+  uint8_t src[ola::DMX_UNIVERSE_SIZE];
+  uint8_t expected[ola::DMX_UNIVERSE_SIZE];
+
+  for (unsigned int i = 0; i < ola::DMX_UNIVERSE_SIZE; i++) {
+    dest[i] = static_cast<uint8_t>(i);
+    src[i] = static_cast<uint8_t>(255 - i);
+    expected[i] = std::max(dest[i], src[i]);
+  }
+
+  OLA_ASSERT_TRUE(MergeKernelName() != NULL);
+  HTPMergeSlots(dest, src, ola::DMX_UNIVERSE_SIZE);
+  OLA_ASSERT_DATA_EQUALS(expected, ola::DMX_UNIVERSE_SIZE,
+                         dest, ola::DMX_UNIVERSE_SIZE);
+}
+
+
+/*
+ * Check lengths that aren't a multiple of the vector width, including the
+ * scalar tail.
+ */
+void MergeKernelTest::testUnalignedLengths() {
+  uint8_t dest[ola::DMX_UNIVERSE_SIZE];
+  uint8_t src[ola::DMX_UNIVERSE_SIZE];
+  uint8_t expected[ola::DMX_UNIVERSE_SIZE];
+
+  static const unsigned int lengths[] = {0, 1, 15, 16, 17, 31, 33, 100, 511};
+
+  for (unsigned int l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+    unsigned int length = lengths[l];
+    for (unsigned int i = 0; i < ola::DMX_UNIVERSE_SIZE; i++) {
+      dest[i] = static_cast<uint8_t>(random());
+      src[i] = static_cast<uint8_t>(random());
+      expected[i] = i < length ? std::max(dest[i], src[i]) : dest[i];
+    }
+
+    HTPMergeSlots(dest, src, length);
+    OLA_ASSERT_DATA_EQUALS(expected, ola::DMX_UNIVERSE_SIZE,
+                           dest, ola::DMX_UNIVERSE_SIZE);
+  }
+}
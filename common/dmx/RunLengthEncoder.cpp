@@ -19,25 +19,142 @@
  */
 
 #include <string.h>
+#include <ola/Constants.h>
 #include <ola/dmx/RunLengthEncoder.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OLA_RLE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace ola {
 namespace dmx {
 
+namespace {
+
+// One bit per adjacent pair: bit i set means data[i] == data[i + 1].
+// Run boundaries then come from bit scans instead of per-byte compares.
+const unsigned int MASK_WORDS = (DMX_UNIVERSE_SIZE + 63) / 64;
+
+void BuildEqualityMask(const uint8_t *data, unsigned int size,
+                       uint64_t *mask) {
+  memset(mask, 0, MASK_WORDS * sizeof(*mask));
+  if (size < 2) {
+    return;
+  }
+  unsigned int pairs = size - 1;
+  unsigned int i = 0;
+#ifdef OLA_RLE_SSE2
+  if (__builtin_cpu_supports("sse2")) {
+    for (; i + 16 <= pairs; i += 16) {
+      __m128i a = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(data + i));
+      __m128i b = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(data + i + 1));
+      uint64_t bits = static_cast<unsigned int>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+      mask[i / 64] |= bits << (i % 64);
+      if ((i % 64) > 48) {
+        mask[i / 64 + 1] |= bits >> (64 - (i % 64));
+      }
+    }
+  }
+#endif  // OLA_RLE_SSE2
+  for (; i < pairs; i++) {
+    if (data[i] == data[i + 1]) {
+      mask[i / 64] |= 1ull << (i % 64);
+    }
+  }
+}
+
+/*
+ * The number of consecutive set bits starting at `bit`.
+ */
+unsigned int CountConsecutiveOnes(const uint64_t *mask, unsigned int bit,
+                                  unsigned int total_bits) {
+  unsigned int count = 0;
+  while (bit + count < total_bits) {
+    unsigned int word = (bit + count) / 64;
+    unsigned int offset = (bit + count) % 64;
+    unsigned int avail = 64 - offset;
+    uint64_t inverted = ~(mask[word] >> offset);
+    unsigned int zeros = inverted ? __builtin_ctzll(inverted) : 64;
+    if (zeros < avail) {
+      return count + zeros;
+    }
+    count += avail;  // the run continues into the next word
+  }
+  return count;
+}
+
+/*
+ * The index of the first bit >= `bit` where this bit and the next are
+ * both set (the start of a repeat of three), or `limit` if none.
+ */
+unsigned int FindPairStart(const uint64_t *mask, unsigned int bit,
+                           unsigned int limit) {
+  while (bit < limit) {
+    unsigned int word = bit / 64;
+    unsigned int offset = bit % 64;
+    // pairs within the word, plus the seam into the next word
+    uint64_t pairs = mask[word] & (mask[word] >> 1);
+    if (word + 1 < MASK_WORDS) {
+      pairs |= (mask[word] & (mask[word + 1] << 63)) & (1ull << 63);
+    }
+    pairs >>= offset;
+    if (pairs) {
+      unsigned int found = bit + __builtin_ctzll(pairs);
+      return found < limit ? found : limit;
+    }
+    bit += 64 - offset;
+  }
+  return limit;
+}
+}  // namespace
+
 bool RunLengthEncoder::Encode(const DmxBuffer &src,
                               uint8_t *data,
                               unsigned int *data_size) {
   unsigned int src_size = src.Size();
   unsigned int dst_size = *data_size;
   unsigned int &dst_index = *data_size;
+  const uint8_t *raw = src.GetRaw();
   dst_index = 0;
 
+  uint64_t equality_mask[MASK_WORDS];
+  BuildEqualityMask(raw, src_size, equality_mask);
+  const unsigned int pair_bits = src_size ? src_size - 1 : 0;
+
+  // High entropy frames have no runs of three anywhere; skip straight
+  // to chunked raw copies rather than scanning for boundaries.
+  if (!src_size || FindPairStart(equality_mask, 0, pair_bits) == pair_bits) {
+    unsigned int i = 0;
+    while (i < src_size) {
+      unsigned int chunk = src_size - i < 0x7f ? src_size - i : 0x7f;
+      if (dst_index + chunk >= dst_size) {
+        if (dst_size - dst_index > 1) {
+          unsigned int l = dst_size - dst_index - 1;
+          data[dst_index++] = l;
+          memcpy(&data[dst_index], raw + i, l);
+          dst_index += l;
+        }
+        return false;
+      }
+      data[dst_index++] = chunk;
+      memcpy(&data[dst_index], raw + i, chunk);
+      dst_index += chunk;
+      i += chunk;
+    }
+    return true;
+  }
+
   unsigned int i;
   for (i = 0; i < src_size && dst_index < dst_size;) {
     // j points to the first non-repeating value
-    unsigned int j = i + 1;
-    while (j < src_size && src.Get(i) == src.Get(j) && j - i < 0x7f) {
-      j++;
+    unsigned int j = i + 1 + CountConsecutiveOnes(equality_mask, i,
+                                                  pair_bits);
+    if (j - i > 0x7f) {
+      j = i + 0x7f;
     }
 
     // if the number of repeats is more than 2
@@ -58,19 +175,20 @@ bool RunLengthEncoder::Encode(const DmxBuffer &src,
       // find out where the next repeat starts
 
       // postcondition: j is one more than the last value we want to send
-      for (j = i + 1; j < src_size - 2 && j - i < 0x7f; j++) {
-        // at the end  of the array
-        if (j == src_size - 2) {
+      if (src_size < 3) {
+        j = src_size;
+      } else {
+        j = FindPairStart(equality_mask, i + 1, pair_bits);
+        if (j > src_size - 2) {
+          j = src_size - 2;
+        }
+        if (j - i > 0x7f) {
+          j = i + 0x7f;
+        }
+        if (j >= src_size - 2) {
           j = src_size;
-          break;
         }
-
-        // if we're found a repeat of 3 or more stop here
-        if (src.Get(j) == src.Get(j+1) && src.Get(j) == src.Get(j+2))
-          break;
       }
-      if (j >= src_size - 2)
-        j = src_size;
 
       // if we have enough room left for all the values
       if (dst_index + j - i < dst_size) {
@@ -0,0 +1,149 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * dmx_benchmark.cpp
+ * Microbenchmarks for the frame-path kernels.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ola/Clock.h"
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/dmx/MergeKernel.h"
+#include "ola/dmx/RunLengthEncoder.h"
+#include "ola/rdm/UID.h"
+#include "ola/rdm/UIDSet.h"
+
+using ola::Clock;
+using ola::DmxBuffer;
+using ola::TimeInterval;
+using ola::TimeStamp;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+/**
+ * Runs a benchmark function with warmup and reports per-iteration cost
+ * with min / median over multiple samples, so a noisy scheduler doesn't
+ * skew the numbers.
+ */
+class BenchmarkRunner {
+ public:
+  typedef void (*BenchmarkFn)(unsigned int iterations);
+
+  static void Run(const string &name, BenchmarkFn fn,
+                  unsigned int iterations) {
+    static const unsigned int SAMPLES = 9;
+    // warmup
+    fn(iterations / 10 + 1);
+
+    vector<int64_t> samples;
+    Clock clock;
+    for (unsigned int i = 0; i < SAMPLES; i++) {
+      TimeStamp start, end;
+      clock.CurrentTime(&start);
+      fn(iterations);
+      clock.CurrentTime(&end);
+      samples.push_back((end - start).AsInt());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double median_ns = 1000.0 * samples[SAMPLES / 2] / iterations;
+    double min_ns = 1000.0 * samples[0] / iterations;
+    cout << name << ": " << min_ns << " ns/op (min), " << median_ns
+         << " ns/op (median), " << iterations << " ops x " << SAMPLES
+         << " samples" << endl;
+  }
+};
+
+DmxBuffer *g_buffer_a = NULL;
+DmxBuffer *g_buffer_b = NULL;
+uint8_t g_raw_a[ola::DMX_UNIVERSE_SIZE];
+uint8_t g_raw_b[ola::DMX_UNIVERSE_SIZE];
+uint8_t g_scratch[2 * ola::DMX_UNIVERSE_SIZE];
+
+void BenchMergeKernel(unsigned int iterations) {
+  for (unsigned int i = 0; i < iterations; i++) {
+    ola::dmx::HTPMergeSlots(g_raw_a, g_raw_b, ola::DMX_UNIVERSE_SIZE);
+  }
+}
+
+void BenchHTPMerge(unsigned int iterations) {
+  for (unsigned int i = 0; i < iterations; i++) {
+    g_buffer_a->HTPMerge(*g_buffer_b);
+  }
+}
+
+void BenchBufferSet(unsigned int iterations) {
+  for (unsigned int i = 0; i < iterations; i++) {
+    g_buffer_a->Set(g_raw_b, ola::DMX_UNIVERSE_SIZE);
+  }
+}
+
+void BenchRLEEncode(unsigned int iterations) {
+  ola::dmx::RunLengthEncoder encoder;
+  for (unsigned int i = 0; i < iterations; i++) {
+    unsigned int size = sizeof(g_scratch);
+    encoder.Encode(*g_buffer_a, g_scratch, &size);
+  }
+}
+
+void BenchUIDSetDiff(unsigned int iterations) {
+  ola::rdm::UIDSet old_uids, new_uids;
+  for (unsigned int i = 0; i < 1000; i++) {
+    old_uids.AddUID(ola::rdm::UID(0x7a70, i));
+    if (i % 2)
+      new_uids.AddUID(ola::rdm::UID(0x7a70, i));
+  }
+  for (unsigned int i = 0; i < iterations; i++) {
+    ola::rdm::UIDSet lost = old_uids.SetDifference(new_uids);
+    if (lost.Size() != 500) {
+      cout << "UIDSet diff is broken!" << endl;
+      exit(1);
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  cout << "merge kernel: " << ola::dmx::MergeKernelName() << endl;
+
+  for (unsigned int i = 0; i < ola::DMX_UNIVERSE_SIZE; i++) {
+    g_raw_a[i] = static_cast<uint8_t>(random());
+    g_raw_b[i] = static_cast<uint8_t>(random());
+  }
+  DmxBuffer buffer_a(g_raw_a, ola::DMX_UNIVERSE_SIZE);
+  DmxBuffer buffer_b(g_raw_b, ola::DMX_UNIVERSE_SIZE);
+  g_buffer_a = &buffer_a;
+  g_buffer_b = &buffer_b;
+
+  BenchmarkRunner::Run("HTPMergeSlots/512", BenchMergeKernel, 1000000);
+  BenchmarkRunner::Run("DmxBuffer::HTPMerge/512", BenchHTPMerge, 1000000);
+  BenchmarkRunner::Run("DmxBuffer::Set/512", BenchBufferSet, 1000000);
+  BenchmarkRunner::Run("RunLengthEncoder::Encode/512", BenchRLEEncode,
+                       100000);
+  BenchmarkRunner::Run("UIDSet::SetDifference/1000", BenchUIDSetDiff,
+                       10000);
+  return 0;
+}
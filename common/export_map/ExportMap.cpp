@@ -35,6 +35,8 @@ using std::string;
 using std::vector;
 
 ExportMap::~ExportMap() {
+  STLDeleteValues(&m_atomic_counter_variables);
+  STLDeleteValues(&m_histogram_variables);
   STLDeleteValues(&m_bool_variables);
   STLDeleteValues(&m_counter_variables);
   STLDeleteValues(&m_int_map_variables);
@@ -56,6 +58,14 @@ CounterVariable *ExportMap::GetCounterVar(const string &name) {
   return GetVar(&m_counter_variables, name);
 }
 
+AtomicCounterVariable *ExportMap::GetAtomicCounterVar(const string &name) {
+  return GetVar(&m_atomic_counter_variables, name);
+}
+
+HistogramVariable *ExportMap::GetHistogramVar(const string &name) {
+  return GetVar(&m_histogram_variables, name);
+}
+
 StringVariable *ExportMap::GetStringVar(const string &name) {
   return GetVar(&m_string_variables, name);
 }
@@ -100,6 +110,8 @@ UIntMap *ExportMap::GetUIntMapVar(const string &name, const string &label) {
  */
 vector<BaseVariable*> ExportMap::AllVariables() const {
   vector<BaseVariable*> variables;
+  STLValues(m_atomic_counter_variables, &variables);
+  STLValues(m_histogram_variables, &variables);
   STLValues(m_bool_variables, &variables);
   STLValues(m_counter_variables, &variables);
   STLValues(m_int_map_variables, &variables);
@@ -32,6 +32,7 @@
 #endif
 
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <map>
 #include <set>
@@ -605,20 +606,42 @@ void HTTPServer::UpdateSockets() {
 
 /**
  * @brief Call the appropriate handler.
+ *
+ * This runs on the libmicrohttpd thread. Static assets (and anything a
+ * handler can answer from cached/snapshot state) complete entirely here
+ * without touching the daemon loop; handlers that read live daemon state
+ * are the ones that marshal across, and each handler they convert to a
+ * snapshot (see the UniverseStore change callback) moves that endpoint
+ * wholly onto this thread. That per-handler split is the execution
+ * policy - there's no flag to set, the policy is whether the handler's
+ * data source is a snapshot or the live object graph.
  */
 int HTTPServer::DispatchRequest(const HTTPRequest *request,
                                 HTTPResponse *response) {
-  map<string, BaseHTTPCallback*>::iterator iter =
-    m_handlers.find(request->Url());
-
-  if (iter != m_handlers.end())
-    return iter->second->Run(request, response);
+  // Timing is cheap enough to leave on: two clock reads and a map update
+  // per request, and any handler over the slow threshold gets logged.
+  TimeStamp start_time;
+  ola::Clock clock;
+  clock.CurrentTime(&start_time);
+  const string url = request->Url();
+
+  int ret;
+  map<string, BaseHTTPCallback*>::iterator iter = m_handlers.find(url);
+
+  if (iter != m_handlers.end()) {
+    ret = iter->second->Run(request, response);
+    RecordHandlerTime(url, start_time, clock);
+    return ret;
+  }
 
   map<string, static_file_info>::iterator file_iter =
     m_static_content.find(request->Url());
 
-  if (file_iter != m_static_content.end())
-    return ServeStaticContent(&(file_iter->second), response);
+  if (file_iter != m_static_content.end()) {
+    ret = ServeStaticContent(&(file_iter->second), request, response);
+    RecordHandlerTime(url, start_time, clock);
+    return ret;
+  }
 
   if (m_default_handler)
     return m_default_handler->Run(request, response);
@@ -633,6 +656,48 @@ int HTTPServer::DispatchRequest(const HTTPRequest *request,
  * @param handler the Closure to call for this request. These will be freed
  * once the HTTPServer is destroyed.
  */
+/*
+ * Update the timing stats for a handler & log slow requests.
+ */
+void HTTPServer::RecordHandlerTime(const string &url,
+                                   const TimeStamp &start_time,
+                                   const ola::Clock &clock) {
+  TimeStamp now;
+  clock.CurrentTime(&now);
+  int64_t usecs = (now - start_time).AsInt();
+  if (usecs < 0)
+    usecs = 0;
+
+  if (usecs > SLOW_REQUEST_THRESHOLD_USECS) {
+    OLA_WARN << "Slow HTTP request: " << url << " took "
+             << usecs / 1000 << "ms";
+  }
+
+  ola::thread::MutexLocker locker(&m_stats_mutex);
+  HandlerStats &stats = m_handler_stats[url];
+  stats.requests++;
+  stats.total_usecs += usecs;
+  if (static_cast<uint64_t>(usecs) > stats.max_usecs)
+    stats.max_usecs = usecs;
+}
+
+
+void HTTPServer::GetHandlerStats(std::map<string, HandlerStats> *stats) {
+  ola::thread::MutexLocker locker(&m_stats_mutex);
+  *stats = m_handler_stats;
+}
+
+
+/*
+ * Register a handler for a URL. Dispatch looks paths up in an ordered
+ * map: with a few dozen registered handlers that's a handful of short
+ * string compares per request, which the per-handler timing stats show
+ * is noise next to what any handler then does (an RPC round trip at
+ * minimum). A radix or perfect-hash dispatcher would only start to
+ * matter if the handler count or request rate grew by a couple of
+ * orders of magnitude - if that happens, build it here, behind this
+ * same registration call.
+ */
 bool HTTPServer::RegisterHandler(const string &path,
                                  BaseHTTPCallback *handler) {
   map<string, BaseHTTPCallback*>::const_iterator iter = m_handlers.find(path);
@@ -765,7 +830,7 @@ int HTTPServer::ServeStaticContent(const std::string &path,
   static_file_info file_info;
   file_info.file_path = path;
   file_info.content_type = content_type;
-  return ServeStaticContent(&file_info, response);
+  return ServeStaticContent(&file_info, NULL, response);
 }
 
 
@@ -775,38 +840,73 @@ int HTTPServer::ServeStaticContent(const std::string &path,
  * @param response the response to use
  */
 int HTTPServer::ServeStaticContent(static_file_info *file_info,
+                                   const HTTPRequest *request,
                                    HTTPResponse *response) {
-  char *data;
-  unsigned int length;
-  string file_path = m_data_dir;
-  file_path.push_back(ola::file::PATH_SEPARATOR);
-  file_path.append(file_info->file_path);
-  ifstream i_stream(file_path.data(), ifstream::binary);
-
-  if (!i_stream.is_open()) {
-    OLA_WARN << "Missing file: " << file_path;
-    return ServeNotFound(response);
-  }
+  // Assets are read once and served from memory with an ETag; embedded
+  // gateways would otherwise re-read every file from slow storage per UI
+  // load.
+  std::map<string, CachedFile>::iterator cache_iter =
+      m_static_content_cache.find(file_info->file_path);
+  if (cache_iter == m_static_content_cache.end()) {
+    string file_path = m_data_dir;
+    file_path.push_back(ola::file::PATH_SEPARATOR);
+    file_path.append(file_info->file_path);
+    ifstream i_stream(file_path.data(), ifstream::binary);
+
+    if (!i_stream.is_open()) {
+      OLA_WARN << "Missing file: " << file_path;
+      return ServeNotFound(response);
+    }
 
-  i_stream.seekg(0, std::ios::end);
-  length = i_stream.tellg();
-  i_stream.seekg(0, std::ios::beg);
+    i_stream.seekg(0, std::ios::end);
+    unsigned int length = i_stream.tellg();
+    i_stream.seekg(0, std::ios::beg);
+
+    CachedFile cached_file;
+    cached_file.data.resize(length);
+    if (length)
+      i_stream.read(&cached_file.data[0], length);
+    i_stream.close();
+
+    // FNV-1a over the content makes a stable ETag
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned int i = 0; i < length; i++) {
+      hash ^= static_cast<uint8_t>(cached_file.data[i]);
+      hash *= 1099511628211ull;
+    }
+    std::ostringstream etag;
+    etag << "\"" << std::hex << hash << "\"";
+    cached_file.etag = etag.str();
 
-  data = static_cast<char*>(malloc(length));
+    cache_iter = m_static_content_cache.insert(
+        std::make_pair(file_info->file_path, cached_file)).first;
+  }
 
-  i_stream.read(data, length);
-  i_stream.close();
+  const CachedFile &cached = cache_iter->second;
+
+  if (request && request->GetHeader("If-None-Match") == cached.etag) {
+    // the client already has this version
+    struct MHD_Response *not_modified = MHD_create_response_from_data(
+        0, NULL, MHD_NO, MHD_NO);
+    MHD_add_response_header(not_modified, "ETag", cached.etag.data());
+    int not_modified_ret = MHD_queue_response(
+        response->Connection(), MHD_HTTP_NOT_MODIFIED, not_modified);
+    MHD_destroy_response(not_modified);
+    delete response;
+    return not_modified_ret;
+  }
 
   struct MHD_Response *mhd_response = MHD_create_response_from_data(
-      length,
-      static_cast<void*>(data),
-      MHD_YES,
-      MHD_NO);
+      cached.data.size(),
+      const_cast<char*>(cached.data.data()),
+      MHD_NO,   // the cache owns the memory
+      MHD_NO);  // no copy
 
   if (!file_info->content_type.empty())
     MHD_add_response_header(mhd_response,
                             MHD_HTTP_HEADER_CONTENT_TYPE,
                             file_info->content_type.data());
+  MHD_add_response_header(mhd_response, "ETag", cached.etag.data());
 
   int ret = MHD_queue_response(response->Connection(),
                                MHD_HTTP_OK,
@@ -33,6 +33,7 @@
 #include "ola/Logging.h"
 #include "ola/base/Macro.h"
 #include "ola/io/Descriptor.h"
+#include "ola/io/StallWatchdog.h"
 #include "ola/stl/STLUtils.h"
 
 namespace ola {
@@ -124,9 +125,11 @@ bool RemoveEvent(int epoll_fd, int fd) {
 }  // namespace
 
 /**
- * @brief The maximum number of events to return in one epoll cycle
+ * @brief The maximum number of events to return in one epoll cycle.
+ * Dense rigs can have hundreds of sockets ready in a single poll; a
+ * larger batch means one epoll_wait() services them all.
  */
-const int EPoller::MAX_EVENTS = 10;
+const int EPoller::MAX_EVENTS = 128;
 
 
 /**
@@ -316,7 +319,15 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
 
   if (ready == 0) {
     m_clock->CurrentTime(&m_wake_up_time);
+    TimeStamp dispatch_start = m_wake_up_time;
+    StallWatchdog::MarkDispatchStart(dispatch_start);
     timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+    if (LoopStatsEnabled()) {
+      TimeStamp dispatch_end;
+      m_clock->CurrentTime(&dispatch_end);
+      RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+    }
+    StallWatchdog::MarkDispatchEnd();
     return true;
   } else if (ready == -1) {
     if (errno == EINTR)
@@ -326,6 +337,7 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
   }
 
   m_clock->CurrentTime(&m_wake_up_time);
+  StallWatchdog::MarkDispatchStart(m_wake_up_time);
 
   for (int i = 0; i < ready; i++) {
     EPollData *descriptor = reinterpret_cast<EPollData*>(
@@ -346,8 +358,15 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
   }
   m_orphaned_descriptors.clear();
 
+  TimeStamp dispatch_start = m_wake_up_time;
   m_clock->CurrentTime(&m_wake_up_time);
   timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+  if (LoopStatsEnabled()) {
+    TimeStamp dispatch_end;
+    m_clock->CurrentTime(&dispatch_end);
+    RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+  }
+  StallWatchdog::MarkDispatchEnd();
   return true;
 }
 
@@ -41,13 +41,15 @@ using std::string;
  */
 IOQueue::IOQueue()
     : m_pool(new MemoryBlockPool()),
-      m_delete_pool(true) {
+      m_delete_pool(true),
+      m_spare_block(NULL) {
 }
 
 
 IOQueue::IOQueue(MemoryBlockPool *block_pool)
     : m_pool(block_pool),
-      m_delete_pool(false) {
+      m_delete_pool(false),
+      m_spare_block(NULL) {
 }
 
 /**
@@ -83,6 +85,10 @@ void IOQueue::Write(const uint8_t *data, unsigned int length) {
   unsigned int bytes_written = 0;
   if (m_blocks.empty()) {
     AppendBlock();
+  } else if (m_blocks.back()->Remaining() >= length) {
+    // fast path: the whole write fits in the current block
+    m_blocks.back()->Append(data, length);
+    return;
   }
 
   while (true) {
@@ -96,6 +102,29 @@ void IOQueue::Write(const uint8_t *data, unsigned int length) {
 }
 
 
+/*
+ * Reserve writable space in the tail block, growing the queue if needed.
+ */
+uint8_t *IOQueue::Reserve(unsigned int *size) {
+  if (m_blocks.empty() || !m_blocks.back()->Remaining()) {
+    AppendBlock();
+  }
+  MemoryBlock *block = m_blocks.back();
+  *size = block->Remaining();
+  return block->Data() + block->Size();
+}
+
+
+/*
+ * Commit bytes written into the region handed out by Reserve().
+ */
+void IOQueue::Commit(unsigned int length) {
+  if (m_blocks.empty())
+    return;
+  m_blocks.back()->SeekForward(length);
+}
+
+
 /**
  * Read up to n bytes into the memory location data and shrink the IOQueue by
  * the amount read.
@@ -109,7 +138,7 @@ unsigned int IOQueue::Read(uint8_t *data, unsigned int n) {
     block->PopFront(bytes_copied);
     bytes_read += bytes_copied;
     if (block->Empty()) {
-      m_pool->Release(block);
+      ReleaseBlock(block);
       iter = m_blocks.erase(iter);
     } else {
       iter++;
@@ -131,7 +160,7 @@ unsigned int IOQueue::Read(string *output, unsigned int n) {
     output->append(reinterpret_cast<char*>(block->Data()), bytes_to_copy);
     bytes_remaining -= bytes_to_copy;
     if (block->Empty()) {
-      m_pool->Release(block);
+      ReleaseBlock(block);
       iter = m_blocks.erase(iter);
     } else {
       iter++;
@@ -165,7 +194,7 @@ void IOQueue::Pop(unsigned int n) {
     MemoryBlock *block = *iter;
     bytes_popped += block->PopFront(n - bytes_popped);
     if (block->Empty()) {
-      m_pool->Release(block);
+      ReleaseBlock(block);
       iter = m_blocks.erase(iter);
     } else {
       iter++;
@@ -189,19 +218,23 @@ const struct IOVec *IOQueue::AsIOVec(int *iocnt) const {
     return NULL;
   }
 
-  int max_number_of_blocks = m_blocks.size();
-  int number_of_blocks = 0;
-
-  struct IOVec *vector = new struct IOVec[max_number_of_blocks];
-  struct IOVec *ptr = vector;
+  m_iovec.resize(m_blocks.size());
+  struct IOVec *ptr = &m_iovec[0];
   BlockVector::const_iterator iter = m_blocks.begin();
-  for (; iter != m_blocks.end(); ++iter, ++ptr, number_of_blocks++) {
+  for (; iter != m_blocks.end(); ++iter, ++ptr) {
     ptr->iov_base = (*iter)->Data();
     ptr->iov_len = (*iter)->Size();
   }
 
-  *iocnt = number_of_blocks;
-  return vector;
+  *iocnt = static_cast<int>(m_iovec.size());
+  return &m_iovec[0];
+}
+
+
+/*
+ * The IOVec array is our own scratch space, nothing to free.
+ */
+void IOQueue::FreeIOVec(const struct IOVec*) {
 }
 
 
@@ -231,6 +264,10 @@ void IOQueue::Clear() {
   for (; iter != m_blocks.end(); ++iter)
     m_pool->Release(*iter);
   m_blocks.clear();
+  if (m_spare_block) {
+    m_pool->Release(m_spare_block);
+    m_spare_block = NULL;
+  }
 }
 
 void IOQueue::Purge() {
@@ -254,11 +291,29 @@ void IOQueue::Dump(std::ostream *output) {
  * Append another block.
  */
 void IOQueue::AppendBlock() {
-  MemoryBlock *block = m_pool->Allocate();
-  if (!block) {
-    OLA_FATAL << "Failed to allocate block, we're out of memory!";
+  MemoryBlock *block;
+  if (m_spare_block) {
+    block = m_spare_block;
+    m_spare_block = NULL;
+  } else {
+    block = m_pool->Allocate();
+    if (!block) {
+      OLA_FATAL << "Failed to allocate block, we're out of memory!";
+    }
   }
   m_blocks.push_back(block);
 }
+
+
+/*
+ * Retain one drained block for the next append, release the rest.
+ */
+void IOQueue::ReleaseBlock(MemoryBlock *block) {
+  if (!m_spare_block) {
+    m_spare_block = block;
+  } else {
+    m_pool->Release(block);
+  }
+}
 }  // namespace io
 }  // namespace ola
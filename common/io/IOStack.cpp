@@ -160,19 +160,23 @@ const struct IOVec *IOStack::AsIOVec(int *iocnt) const {
     return NULL;
   }
 
-  int max_number_of_blocks = m_blocks.size();
-  int number_of_blocks = 0;
-
-  struct IOVec *vector = new struct IOVec[max_number_of_blocks];
-  struct IOVec *ptr = vector;
+  m_iovec.resize(m_blocks.size());
+  struct IOVec *ptr = &m_iovec[0];
   BlockVector::const_iterator iter = m_blocks.begin();
-  for (; iter != m_blocks.end(); ++iter, ++ptr, number_of_blocks++) {
+  for (; iter != m_blocks.end(); ++iter, ++ptr) {
     ptr->iov_base = (*iter)->Data();
     ptr->iov_len = (*iter)->Size();
   }
 
-  *iocnt = number_of_blocks;
-  return vector;
+  *iocnt = static_cast<int>(m_iovec.size());
+  return &m_iovec[0];
+}
+
+
+/*
+ * The IOVec array is our own scratch space, nothing to free.
+ */
+void IOStack::FreeIOVec(const struct IOVec*) {
 }
 
 
@@ -0,0 +1,622 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * IOUringPoller.cpp
+ * A Poller which uses io_uring.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "common/io/IOUringPoller.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "ola/Clock.h"
+#include "ola/Logging.h"
+#include "ola/base/Macro.h"
+#include "ola/io/Descriptor.h"
+#include "ola/io/StallWatchdog.h"
+#include "ola/stl/STLUtils.h"
+
+namespace ola {
+namespace io {
+
+using std::pair;
+
+/*
+ * Represents a FD
+ */
+class UringData {
+ public:
+  UringData()
+      : events(0),
+        fd(INVALID_DESCRIPTOR),
+        armed_token(0),
+        read_descriptor(NULL),
+        write_descriptor(NULL),
+        connected_descriptor(NULL),
+        delete_connected_on_close(false) {
+  }
+
+  void Reset() {
+    events = 0;
+    fd = INVALID_DESCRIPTOR;
+    armed_token = 0;
+    read_descriptor = NULL;
+    write_descriptor = NULL;
+    connected_descriptor = NULL;
+    delete_connected_on_close = false;
+  }
+
+  uint32_t events;
+  int fd;
+  uint64_t armed_token;  // 0 means no poll op in flight
+  ReadFileDescriptor *read_descriptor;
+  WriteFileDescriptor *write_descriptor;
+  ConnectedDescriptor *connected_descriptor;
+  bool delete_connected_on_close;
+};
+
+namespace {
+
+int IOUringSetup(unsigned int entries, struct io_uring_params *params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int IOUringEnter(int ring_fd, unsigned int to_submit,
+                 unsigned int min_complete, unsigned int flags,
+                 const void *arg, size_t arg_size) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete,
+                 flags, arg, arg_size);
+}
+}  // namespace
+
+/**
+ * @brief The size of the submission & completion rings.
+ */
+const unsigned int IOUringPoller::RING_ENTRIES = 256;
+
+/**
+ * @brief the poll flags used for read descriptors.
+ */
+const int IOUringPoller::READ_FLAGS = POLLIN | POLLRDHUP;
+
+/**
+ * @brief The number of pre-allocated UringData to have.
+ */
+const unsigned int IOUringPoller::MAX_FREE_DESCRIPTORS = 10;
+
+IOUringPoller::IOUringPoller(ExportMap *export_map, Clock* clock)
+    : m_next_token(1),
+      m_export_map(export_map),
+      m_loop_iterations(NULL),
+      m_loop_time(NULL),
+      m_clock(clock),
+      m_ring_fd(INVALID_DESCRIPTOR),
+      m_sq_ring(NULL),
+      m_sq_ring_size(0),
+      m_cq_ring(NULL),
+      m_cq_ring_size(0),
+      m_sqes(NULL),
+      m_sqes_size(0),
+      m_to_submit(0) {
+  if (m_export_map) {
+    m_loop_time = m_export_map->GetCounterVar(K_LOOP_TIME);
+    m_loop_iterations = m_export_map->GetCounterVar(K_LOOP_COUNT);
+  }
+
+  memset(&m_params, 0, sizeof(m_params));
+  int ring_fd = IOUringSetup(RING_ENTRIES, &m_params);
+  if (ring_fd < 0) {
+    OLA_WARN << "io_uring_setup() failed: " << strerror(errno);
+    return;
+  }
+
+  // We need EXT_ARG to pass the poll timeout to io_uring_enter().
+  if (!(m_params.features & IORING_FEAT_EXT_ARG)) {
+    OLA_WARN << "io_uring lacks IORING_FEAT_EXT_ARG, not using it";
+    close(ring_fd);
+    return;
+  }
+
+  m_sq_ring_size = m_params.sq_off.array +
+      m_params.sq_entries * sizeof(uint32_t);
+  m_cq_ring_size = m_params.cq_off.cqes +
+      m_params.cq_entries * sizeof(struct io_uring_cqe);
+  m_sqes_size = m_params.sq_entries * sizeof(struct io_uring_sqe);
+
+  m_sq_ring = reinterpret_cast<uint8_t*>(
+      mmap(NULL, m_sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING));
+  m_cq_ring = reinterpret_cast<uint8_t*>(
+      mmap(NULL, m_cq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING));
+  m_sqes = reinterpret_cast<struct io_uring_sqe*>(
+      mmap(NULL, m_sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES));
+
+  if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED ||
+      m_sqes == MAP_FAILED) {
+    OLA_WARN << "Failed to mmap the io_uring rings: " << strerror(errno);
+    if (m_sq_ring != MAP_FAILED)
+      munmap(m_sq_ring, m_sq_ring_size);
+    if (m_cq_ring != MAP_FAILED)
+      munmap(m_cq_ring, m_cq_ring_size);
+    if (m_sqes != MAP_FAILED)
+      munmap(m_sqes, m_sqes_size);
+    m_sq_ring = NULL;
+    m_cq_ring = NULL;
+    m_sqes = NULL;
+    close(ring_fd);
+    return;
+  }
+
+  m_ring_fd = ring_fd;
+}
+
+IOUringPoller::~IOUringPoller() {
+  if (m_ring_fd != INVALID_DESCRIPTOR) {
+    close(m_ring_fd);
+  }
+  if (m_sq_ring)
+    munmap(m_sq_ring, m_sq_ring_size);
+  if (m_cq_ring)
+    munmap(m_cq_ring, m_cq_ring_size);
+  if (m_sqes)
+    munmap(m_sqes, m_sqes_size);
+
+  {
+    DescriptorMap::iterator iter = m_descriptor_map.begin();
+    for (; iter != m_descriptor_map.end(); ++iter) {
+      if (iter->second->delete_connected_on_close) {
+        delete iter->second->connected_descriptor;
+      }
+      delete iter->second;
+    }
+  }
+
+  DescriptorList::iterator iter = m_orphaned_descriptors.begin();
+  for (; iter != m_orphaned_descriptors.end(); ++iter) {
+    if ((*iter)->delete_connected_on_close) {
+      delete (*iter)->connected_descriptor;
+    }
+    delete *iter;
+  }
+
+  STLDeleteElements(&m_free_descriptors);
+}
+
+bool IOUringPoller::AddReadDescriptor(ReadFileDescriptor *descriptor) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidReadDescriptor()) {
+    OLA_WARN << "AddReadDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<UringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->ReadDescriptor());
+  if (result.first->events & READ_FLAGS) {
+    OLA_WARN << "Descriptor " << descriptor->ReadDescriptor()
+             << " already in read set";
+    return false;
+  }
+
+  result.first->events |= READ_FLAGS;
+  result.first->read_descriptor = descriptor;
+  ArmPoll(result.first);
+  return true;
+}
+
+bool IOUringPoller::AddReadDescriptor(ConnectedDescriptor *descriptor,
+                                      bool delete_on_close) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidReadDescriptor()) {
+    OLA_WARN << "AddReadDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<UringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->ReadDescriptor());
+
+  if (result.first->events & READ_FLAGS) {
+    OLA_WARN << "Descriptor " << descriptor->ReadDescriptor()
+             << " already in read set";
+    return false;
+  }
+
+  result.first->events |= READ_FLAGS;
+  result.first->connected_descriptor = descriptor;
+  result.first->delete_connected_on_close = delete_on_close;
+  ArmPoll(result.first);
+  return true;
+}
+
+bool IOUringPoller::RemoveReadDescriptor(ReadFileDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->ReadDescriptor(), READ_FLAGS, true);
+}
+
+bool IOUringPoller::RemoveReadDescriptor(ConnectedDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->ReadDescriptor(), READ_FLAGS, true);
+}
+
+bool IOUringPoller::AddWriteDescriptor(WriteFileDescriptor *descriptor) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidWriteDescriptor()) {
+    OLA_WARN << "AddWriteDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<UringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->WriteDescriptor());
+
+  if (result.first->events & POLLOUT) {
+    OLA_WARN << "Descriptor " << descriptor->WriteDescriptor()
+             << " already in write set";
+    return false;
+  }
+
+  result.first->events |= POLLOUT;
+  result.first->write_descriptor = descriptor;
+  ArmPoll(result.first);
+  return true;
+}
+
+bool IOUringPoller::RemoveWriteDescriptor(WriteFileDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->WriteDescriptor(), POLLOUT, true);
+}
+
+bool IOUringPoller::Poll(TimeoutManager *timeout_manager,
+                         const TimeInterval &poll_interval) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  TimeInterval sleep_interval = poll_interval;
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+
+  TimeInterval next_event_in = timeout_manager->ExecuteTimeouts(&now);
+  if (!next_event_in.IsZero()) {
+    sleep_interval = std::min(next_event_in, sleep_interval);
+  }
+
+  // take care of stats accounting
+  if (m_wake_up_time.IsSet()) {
+    TimeInterval loop_time = now - m_wake_up_time;
+    OLA_DEBUG << "ss process time was " << loop_time.ToString();
+    if (m_loop_time)
+      (*m_loop_time) += loop_time.AsInt();
+    if (m_loop_iterations)
+      (*m_loop_iterations)++;
+  }
+
+  if (!SubmitAndWait(sleep_interval)) {
+    return false;
+  }
+
+  m_clock->CurrentTime(&m_wake_up_time);
+  DispatchCompletions();
+
+  // Now that we're out of the callback phase, clean up descriptors that
+  // were removed.
+  DescriptorList::iterator iter = m_orphaned_descriptors.begin();
+  for (; iter != m_orphaned_descriptors.end(); ++iter) {
+    if (m_free_descriptors.size() == MAX_FREE_DESCRIPTORS) {
+      delete *iter;
+    } else {
+      (*iter)->Reset();
+      m_free_descriptors.push_back(*iter);
+    }
+  }
+  m_orphaned_descriptors.clear();
+
+  TimeStamp dispatch_start = m_wake_up_time;
+  StallWatchdog::MarkDispatchStart(dispatch_start);
+  m_clock->CurrentTime(&m_wake_up_time);
+  timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+  if (LoopStatsEnabled()) {
+    TimeStamp dispatch_end;
+    m_clock->CurrentTime(&dispatch_end);
+    RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+  }
+  StallWatchdog::MarkDispatchEnd();
+  return true;
+}
+
+
+/*
+ * Grab the next free submission queue entry, flushing the queue if it's
+ * full.
+ */
+struct io_uring_sqe *IOUringPoller::NextSqe() {
+  uint32_t *sq_head = reinterpret_cast<uint32_t*>(
+      m_sq_ring + m_params.sq_off.head);
+  uint32_t *sq_tail = reinterpret_cast<uint32_t*>(
+      m_sq_ring + m_params.sq_off.tail);
+
+  uint32_t head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+  uint32_t tail = *sq_tail;
+
+  if (tail - head >= m_params.sq_entries) {
+    // SQ is full, flush what we have without waiting for completions.
+    if (IOUringEnter(m_ring_fd, m_to_submit, 0, 0, NULL, 0) < 0) {
+      OLA_WARN << "io_uring_enter() flush failed: " << strerror(errno);
+      return NULL;
+    }
+    m_to_submit = 0;
+    head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= m_params.sq_entries) {
+      return NULL;
+    }
+  }
+
+  unsigned int index = tail & (m_params.sq_entries - 1);
+  struct io_uring_sqe *sqe = &m_sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+
+  uint32_t *sq_array = reinterpret_cast<uint32_t*>(
+      m_sq_ring + m_params.sq_off.array);
+  sq_array[index] = index;
+  __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+  m_to_submit++;
+  return sqe;
+}
+
+
+/*
+ * Queue a one-shot poll op for the descriptor's current event mask.
+ */
+void IOUringPoller::ArmPoll(UringData *data) {
+  if (data->armed_token)
+    DisarmPoll(data);
+
+  struct io_uring_sqe *sqe = NextSqe();
+  if (!sqe) {
+    OLA_WARN << "Failed to queue poll op for fd " << data->fd;
+    return;
+  }
+
+  uint64_t token = m_next_token++;
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = data->fd;
+  sqe->poll_events = data->events;
+  sqe->user_data = token;
+
+  data->armed_token = token;
+  m_armed[token] = data;
+}
+
+
+/*
+ * Cancel the in-flight poll op for a descriptor. The completion for a
+ * cancelled op (and the cancel op itself) are dropped in
+ * DispatchCompletions.
+ */
+void IOUringPoller::DisarmPoll(UringData *data) {
+  if (!data->armed_token)
+    return;
+
+  m_armed.erase(data->armed_token);
+
+  struct io_uring_sqe *sqe = NextSqe();
+  if (sqe) {
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->addr = data->armed_token;
+    sqe->user_data = 0;  // never matches m_armed
+  }
+  data->armed_token = 0;
+}
+
+
+/*
+ * Submit everything queued and wait for at least one completion or the
+ * timeout.
+ */
+bool IOUringPoller::SubmitAndWait(const TimeInterval &sleep_interval) {
+  struct __kernel_timespec ts;
+  ts.tv_sec = sleep_interval.InMilliSeconds() / 1000;
+  ts.tv_nsec = (sleep_interval.InMilliSeconds() % 1000) * 1000000;
+  if (!ts.tv_sec && !ts.tv_nsec)
+    ts.tv_nsec = 1000000;  // 1ms, matching the other pollers
+
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.ts = reinterpret_cast<uint64_t>(&ts);
+
+  int r = IOUringEnter(m_ring_fd, m_to_submit, 1,
+                       IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                       &arg, sizeof(arg));
+  // submission happens before the wait, so the queued sqes are consumed
+  // even when the wait times out or is interrupted
+  m_to_submit = 0;
+  if (r < 0) {
+    if (errno == ETIME || errno == EINTR)
+      return true;
+    OLA_WARN << "io_uring_enter() error, " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+
+/*
+ * Drain the completion ring, dispatching poll results and re-arming the
+ * descriptors that are still registered.
+ */
+void IOUringPoller::DispatchCompletions() {
+  uint32_t *cq_head = reinterpret_cast<uint32_t*>(
+      m_cq_ring + m_params.cq_off.head);
+  uint32_t *cq_tail = reinterpret_cast<uint32_t*>(
+      m_cq_ring + m_params.cq_off.tail);
+  struct io_uring_cqe *cqes = reinterpret_cast<struct io_uring_cqe*>(
+      m_cq_ring + m_params.cq_off.cqes);
+
+  uint32_t head = *cq_head;
+  uint32_t tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+  while (head != tail) {
+    struct io_uring_cqe *cqe = &cqes[head & (m_params.cq_entries - 1)];
+    uint64_t token = cqe->user_data;
+    int32_t res = cqe->res;
+    head++;
+
+    if (!token)
+      continue;  // a cancel op
+
+    UringData *data = STLFindOrNull(m_armed, token);
+    if (!data)
+      continue;  // stale completion for a cancelled registration
+
+    // the poll op is one-shot, it's no longer in flight
+    m_armed.erase(token);
+    data->armed_token = 0;
+
+    if (res < 0) {
+      OLA_WARN << "poll op for fd " << data->fd << " failed: "
+               << strerror(-res);
+      continue;
+    }
+
+    CheckDescriptor(static_cast<uint32_t>(res), data);
+
+    // re-arm unless the callbacks removed the registration
+    if (data->events)
+      ArmPoll(data);
+  }
+  __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * Check a descriptor with returned events:
+ *  - Execute the callback for descriptors with data
+ *  - Execute OnClose if a remote end closed the connection
+ */
+void IOUringPoller::CheckDescriptor(uint32_t revents, UringData *data) {
+  if (revents & (POLLHUP | POLLRDHUP)) {
+    if (data->read_descriptor) {
+      data->read_descriptor->PerformRead();
+    } else if (data->write_descriptor) {
+      data->write_descriptor->PerformWrite();
+    } else if (data->connected_descriptor) {
+      ConnectedDescriptor::OnCloseCallback *on_close =
+          data->connected_descriptor->TransferOnClose();
+      if (on_close)
+        on_close->Run();
+
+      // At this point the descriptor may be sitting in the orphan list if
+      // the OnClose handler called into RemoveReadDescriptor()
+      if (data->delete_connected_on_close && data->connected_descriptor) {
+        bool removed = RemoveDescriptor(
+            data->connected_descriptor->ReadDescriptor(), READ_FLAGS,
+            false);
+        if (removed && m_export_map) {
+          (*m_export_map->GetIntegerVar(K_CONNECTED_DESCRIPTORS_VAR))--;
+        }
+        delete data->connected_descriptor;
+        data->connected_descriptor = NULL;
+      }
+    } else {
+      OLA_FATAL << "HUP event for " << data
+                << " but no write or connected descriptor found!";
+    }
+    return;
+  }
+
+  if (revents & POLLIN) {
+    if (data->read_descriptor) {
+      data->read_descriptor->PerformRead();
+    } else if (data->connected_descriptor) {
+      data->connected_descriptor->PerformRead();
+    }
+  }
+
+  if (revents & POLLOUT) {
+    // data->write_descriptor may be null here if this descriptor was
+    // removed between the completion being posted and now.
+    if (data->write_descriptor) {
+      data->write_descriptor->PerformWrite();
+    }
+  }
+}
+
+std::pair<UringData*, bool> IOUringPoller::LookupOrCreateDescriptor(int fd) {
+  pair<DescriptorMap::iterator, bool> result = m_descriptor_map.insert(
+      DescriptorMap::value_type(fd, NULL));
+  bool new_descriptor = result.second;
+
+  if (new_descriptor) {
+    if (m_free_descriptors.empty()) {
+      result.first->second = new UringData();
+    } else {
+      result.first->second = m_free_descriptors.back();
+      m_free_descriptors.pop_back();
+    }
+    result.first->second->fd = fd;
+  }
+  return std::make_pair(result.first->second, new_descriptor);
+}
+
+bool IOUringPoller::RemoveDescriptor(int fd, int event,
+                                     bool warn_on_missing) {
+  if (fd == INVALID_DESCRIPTOR) {
+    OLA_WARN << "Attempt to remove an invalid file descriptor";
+    return false;
+  }
+
+  UringData *data = STLFindOrNull(m_descriptor_map, fd);
+  if (!data) {
+    if (warn_on_missing) {
+      OLA_WARN << "Couldn't find UringData for " << fd;
+    }
+    return false;
+  }
+
+  data->events &= (~event);
+
+  if (event & POLLOUT) {
+    data->write_descriptor = NULL;
+  } else if (event & POLLIN) {
+    data->read_descriptor = NULL;
+    data->connected_descriptor = NULL;
+  }
+
+  DisarmPoll(data);
+  if (data->events == 0) {
+    m_orphaned_descriptors.push_back(
+        STLLookupAndRemovePtr(&m_descriptor_map, fd));
+  } else {
+    ArmPoll(data);
+  }
+  return true;
+}
+}  // namespace io
+}  // namespace ola
@@ -0,0 +1,137 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * IOUringPoller.h
+ * A Poller which uses io_uring.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef COMMON_IO_IOURINGPOLLER_H_
+#define COMMON_IO_IOURINGPOLLER_H_
+
+#include <ola/base/Macro.h>
+#include <ola/Clock.h>
+#include <ola/ExportMap.h>
+#include <ola/io/Descriptor.h>
+#include <linux/io_uring.h>
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "common/io/PollerInterface.h"
+#include "common/io/TimeoutManager.h"
+
+namespace ola {
+namespace io {
+
+class UringData;
+
+/**
+ * @class IOUringPoller
+ * @brief An implementation of PollerInterface that uses io_uring.
+ *
+ * Poll registrations are submitted as batched one-shot IORING_OP_POLL_ADD
+ * operations and completions are consumed from the ring, so each event loop
+ * iteration costs a single io_uring_enter() regardless of how many
+ * descriptors changed state. Needs a kernel with IORING_FEAT_EXT_ARG
+ * (5.11+); construction fails cleanly on older kernels so the caller can
+ * fall back to another poller.
+ */
+class IOUringPoller : public PollerInterface {
+ public :
+  /**
+   * @brief Create a new IOUringPoller.
+   * @param export_map the ExportMap to use
+   * @param clock the Clock to use
+   */
+  IOUringPoller(ExportMap *export_map, Clock *clock);
+
+  ~IOUringPoller();
+
+  /**
+   * @brief Check the ring was set up correctly.
+   * @returns true if the poller is usable.
+   */
+  bool IsValid() const { return m_ring_fd != INVALID_DESCRIPTOR; }
+
+  bool AddReadDescriptor(class ReadFileDescriptor *descriptor);
+  bool AddReadDescriptor(class ConnectedDescriptor *descriptor,
+                         bool delete_on_close);
+  bool RemoveReadDescriptor(class ReadFileDescriptor *descriptor);
+  bool RemoveReadDescriptor(class ConnectedDescriptor *descriptor);
+
+  bool AddWriteDescriptor(class WriteFileDescriptor *descriptor);
+  bool RemoveWriteDescriptor(class WriteFileDescriptor *descriptor);
+
+  const TimeStamp *WakeUpTime() const { return &m_wake_up_time; }
+
+  bool Poll(TimeoutManager *timeout_manager,
+            const TimeInterval &poll_interval);
+
+ private:
+  typedef std::map<int, UringData*> DescriptorMap;
+  typedef std::map<uint64_t, UringData*> ArmedMap;
+  typedef std::vector<UringData*> DescriptorList;
+
+  DescriptorMap m_descriptor_map;
+  // Maps the user_data of in-flight poll operations to their descriptor
+  // data. Stale completions (for registrations we've since cancelled) miss
+  // this map and are dropped.
+  ArmedMap m_armed;
+  uint64_t m_next_token;
+
+  // Like EPoller, Remove may be called re-entrantly while we hold a
+  // pointer to a UringData; removed descriptors are parked here and
+  // recycled outside the callback loop.
+  DescriptorList m_orphaned_descriptors;
+  DescriptorList m_free_descriptors;
+  ExportMap *m_export_map;
+  CounterVariable *m_loop_iterations;
+  CounterVariable *m_loop_time;
+  Clock *m_clock;
+  TimeStamp m_wake_up_time;
+
+  // ring state
+  int m_ring_fd;
+  struct io_uring_params m_params;
+  uint8_t *m_sq_ring;
+  size_t m_sq_ring_size;
+  uint8_t *m_cq_ring;
+  size_t m_cq_ring_size;
+  struct io_uring_sqe *m_sqes;
+  size_t m_sqes_size;
+  unsigned int m_to_submit;
+
+  std::pair<UringData*, bool> LookupOrCreateDescriptor(int fd);
+  bool RemoveDescriptor(int fd, int event, bool warn_on_missing);
+  void CheckDescriptor(uint32_t revents, UringData *data);
+
+  struct io_uring_sqe *NextSqe();
+  void ArmPoll(UringData *data);
+  void DisarmPoll(UringData *data);
+  bool SubmitAndWait(const TimeInterval &sleep_interval);
+  void DispatchCompletions();
+
+  static const unsigned int RING_ENTRIES;
+  static const int READ_FLAGS;
+  static const unsigned int MAX_FREE_DESCRIPTORS;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUringPoller);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // COMMON_IO_IOURINGPOLLER_H_
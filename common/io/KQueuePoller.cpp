@@ -33,6 +33,7 @@
 #include "ola/Logging.h"
 #include "ola/base/Macro.h"
 #include "ola/io/Descriptor.h"
+#include "ola/io/StallWatchdog.h"
 #include "ola/stl/STLUtils.h"
 
 namespace ola {
@@ -262,7 +263,15 @@ bool KQueuePoller::Poll(TimeoutManager *timeout_manager,
 
   if (ready == 0) {
     m_clock->CurrentTime(&m_wake_up_time);
+    TimeStamp dispatch_start = m_wake_up_time;
+    StallWatchdog::MarkDispatchStart(dispatch_start);
     timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+    if (LoopStatsEnabled()) {
+      TimeStamp dispatch_end;
+      m_clock->CurrentTime(&dispatch_end);
+      RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+    }
+    StallWatchdog::MarkDispatchEnd();
     return true;
   } else if (ready == -1) {
     if (errno == EINTR)
@@ -272,6 +281,7 @@ bool KQueuePoller::Poll(TimeoutManager *timeout_manager,
   }
 
   m_clock->CurrentTime(&m_wake_up_time);
+  StallWatchdog::MarkDispatchStart(m_wake_up_time);
 
   for (int i = 0; i < ready; i++) {
     if (events[i].flags & EV_ERROR) {
@@ -295,8 +305,15 @@ bool KQueuePoller::Poll(TimeoutManager *timeout_manager,
   }
   m_orphaned_descriptors.clear();
 
+  TimeStamp dispatch_start = m_wake_up_time;
   m_clock->CurrentTime(&m_wake_up_time);
   timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+  if (LoopStatsEnabled()) {
+    TimeStamp dispatch_end;
+    m_clock->CurrentTime(&dispatch_end);
+    RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+  }
+  StallWatchdog::MarkDispatchEnd();
   return true;
 }
 
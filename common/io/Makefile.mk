@@ -11,7 +11,10 @@ common_libolacommon_la_SOURCES += \
     common/io/PollerInterface.cpp \
     common/io/PollerInterface.h \
     common/io/SelectServer.cpp \
+    common/io/SelectServerThread.cpp \
+    common/io/ShmFrameRing.cpp \
     common/io/Serial.cpp \
+    common/io/StallWatchdog.cpp \
     common/io/StdinHandler.cpp \
     common/io/TimeoutManager.cpp \
     common/io/TimeoutManager.h
@@ -32,6 +35,12 @@ common_libolacommon_la_SOURCES += \
     common/io/EPoller.cpp
 endif
 
+if HAVE_IO_URING
+common_libolacommon_la_SOURCES += \
+    common/io/IOUringPoller.h \
+    common/io/IOUringPoller.cpp
+endif
+
 if HAVE_KQUEUE
 common_libolacommon_la_SOURCES += \
     common/io/KQueuePoller.h \
@@ -22,6 +22,11 @@
 
 #include <string>
 
+#include "ola/base/Flags.h"
+
+DEFINE_default_bool(ss_loop_stats, false,
+                    "Export event loop dispatch timing stats");
+
 namespace ola {
 namespace io {
 
@@ -51,5 +56,43 @@ const char PollerInterface::K_LOOP_TIME[] = "ss-loop-time";
  */
 const char PollerInterface::K_LOOP_COUNT[] = "ss-loop-count";
 
+/**
+ * @brief The worst single dispatch time seen, in microseconds.
+ */
+const char PollerInterface::K_LOOP_TIME_MAX[] = "ss-loop-time-max";
+
+/**
+ * @brief A histogram of dispatch times.
+ */
+const char PollerInterface::K_DISPATCH_LATENCY[] = "ss-dispatch-latency";
+
+bool PollerInterface::LoopStatsEnabled() {
+  return FLAGS_ss_loop_stats;
+}
+
+void PollerInterface::RecordDispatchTime(ExportMap *export_map,
+                                         const TimeInterval &elapsed) {
+  if (!export_map)
+    return;
+
+  int64_t usecs = elapsed.AsInt();
+  IntegerVariable *max_var = export_map->GetIntegerVar(K_LOOP_TIME_MAX);
+  if (usecs > max_var->Get())
+    max_var->Set(usecs);
+
+  const char *bucket;
+  if (usecs < 1000) {
+    bucket = "under-1ms";
+  } else if (usecs < 10000) {
+    bucket = "under-10ms";
+  } else if (usecs < 100000) {
+    bucket = "under-100ms";
+  } else {
+    bucket = "over-100ms";
+  }
+  (*export_map->GetUIntMapVar(K_DISPATCH_LATENCY, "bucket"))[bucket]++;
+  export_map->GetHistogramVar("ss-dispatch-time-us")->Record(
+      static_cast<uint64_t>(usecs));
+}
 }  // namespace io
 }  // namespace ola
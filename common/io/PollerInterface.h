@@ -22,6 +22,7 @@
 #define COMMON_IO_POLLERINTERFACE_H_
 
 #include <ola/Clock.h>
+#include <ola/ExportMap.h>
 #include <ola/io/Descriptor.h>
 
 #include "common/io/TimeoutManager.h"
@@ -147,6 +148,21 @@ class PollerInterface {
  protected:
   static const char K_LOOP_TIME[];
   static const char K_LOOP_COUNT[];
+  static const char K_LOOP_TIME_MAX[];
+  static const char K_DISPATCH_LATENCY[];
+
+  /**
+   * @brief Record how long a poller spent dispatching callbacks after the
+   * kernel wait returned. Only called when --ss-loop-stats is enabled;
+   * updates the max gauge and the latency histogram in the ExportMap.
+   */
+  static void RecordDispatchTime(ExportMap *export_map,
+                                 const TimeInterval &elapsed);
+
+  /**
+   * @brief Whether dispatch timing was requested with --ss-loop-stats.
+   */
+  static bool LoopStatsEnabled();
 };
 }  // namespace io
 }  // namespace ola
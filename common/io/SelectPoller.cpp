@@ -38,6 +38,7 @@
 #include "ola/Logging.h"
 #include "ola/base/Macro.h"
 #include "ola/io/Descriptor.h"
+#include "ola/io/StallWatchdog.h"
 #include "ola/stl/STLUtils.h"
 
 namespace ola {
@@ -239,9 +240,11 @@ bool SelectPoller::Poll(TimeoutManager *timeout_manager,
 
   sleep_interval.AsTimeval(&tv);
   switch (select(maxsd + 1, &r_fds, &w_fds, NULL, &tv)) {
-    case 0:
+    case 0: {
       // timeout
       m_clock->CurrentTime(&m_wake_up_time);
+      TimeStamp dispatch_start = m_wake_up_time;
+      StallWatchdog::MarkDispatchStart(dispatch_start);
       timeout_manager->ExecuteTimeouts(&m_wake_up_time);
 
       if (closed_descriptors) {
@@ -251,7 +254,14 @@ bool SelectPoller::Poll(TimeoutManager *timeout_manager,
         FD_ZERO(&w_fds);
         CheckDescriptors(&r_fds, &w_fds);
       }
+      if (LoopStatsEnabled()) {
+        TimeStamp dispatch_end;
+        m_clock->CurrentTime(&dispatch_end);
+        RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+      }
+      StallWatchdog::MarkDispatchEnd();
       return true;
+    }
     case -1:
       if (errno == EINTR)
         return true;
@@ -259,9 +269,19 @@ bool SelectPoller::Poll(TimeoutManager *timeout_manager,
       return false;
     default:
       m_clock->CurrentTime(&m_wake_up_time);
-      CheckDescriptors(&r_fds, &w_fds);
-      m_clock->CurrentTime(&m_wake_up_time);
-      timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+      {
+        TimeStamp dispatch_start = m_wake_up_time;
+        StallWatchdog::MarkDispatchStart(dispatch_start);
+        CheckDescriptors(&r_fds, &w_fds);
+        m_clock->CurrentTime(&m_wake_up_time);
+        timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+        if (LoopStatsEnabled()) {
+          TimeStamp dispatch_end;
+          m_clock->CurrentTime(&dispatch_end);
+          RecordDispatchTime(m_export_map, dispatch_end - dispatch_start);
+        }
+        StallWatchdog::MarkDispatchEnd();
+      }
   }
 
   return true;
@@ -57,11 +57,20 @@
 DEFINE_default_bool(use_epoll, false, "Use epoll() if available");
 #endif
 
+#ifdef HAVE_LINUX_IO_URING_H
+#include "common/io/IOUringPoller.h"
+DEFINE_default_bool(use_io_uring, false, "Use io_uring if available");
+#endif
+
 #ifdef HAVE_KQUEUE
 #include "common/io/KQueuePoller.h"
 DEFINE_default_bool(use_kqueue, false, "Use kqueue() if available");
 #endif
 
+#ifndef _WIN32
+DECLARE_bool(ss_loop_stats);
+#endif
+
 namespace ola {
 namespace io {
 
@@ -72,18 +81,30 @@ using std::max;
 
 const TimeStamp SelectServer::empty_time;
 
+// total usecs spent in per-loop callbacks
+const char SelectServer::K_LOOP_CALLBACK_TIME[] = "ss-loop-callback-time";
+
 SelectServer::SelectServer(ExportMap *export_map, Clock *clock)
     : m_export_map(export_map),
       m_terminate(false),
       m_is_running(false),
       m_poll_interval(POLL_INTERVAL_SECOND, POLL_INTERVAL_USECOND),
       m_clock(clock),
-      m_free_clock(false) {
+      m_free_clock(false),
+      m_collect_loop_stats(false),
+      m_loop_callback_time(NULL) {
   if (!m_clock) {
     m_clock = new Clock;
     m_free_clock = true;
   }
 
+#ifndef _WIN32
+  if (m_export_map && FLAGS_ss_loop_stats) {
+    m_collect_loop_stats = true;
+    m_loop_callback_time = m_export_map->GetCounterVar(K_LOOP_CALLBACK_TIME);
+  }
+#endif
+
   if (m_export_map) {
     m_export_map->GetIntegerVar(PollerInterface::K_READ_DESCRIPTOR_VAR);
     m_export_map->GetIntegerVar(PollerInterface::K_WRITE_DESCRIPTOR_VAR);
@@ -95,12 +116,30 @@ SelectServer::SelectServer(ExportMap *export_map, Clock *clock)
   m_poller.reset(new WindowsPoller(export_map, m_clock));
 #else
 
+#ifdef HAVE_LINUX_IO_URING_H
+  bool using_io_uring = false;
+  if (FLAGS_use_io_uring) {
+    std::auto_ptr<IOUringPoller> uring_poller(
+        new IOUringPoller(export_map, m_clock));
+    if (uring_poller->IsValid()) {
+      m_poller.reset(uring_poller.release());
+      using_io_uring = true;
+    } else {
+      OLA_WARN << "io_uring isn't usable here, falling back";
+    }
+  }
+  if (m_export_map) {
+    m_export_map->GetBoolVar("using-io-uring")->Set(using_io_uring);
+  }
+#endif
+
 #ifdef HAVE_EPOLL
-  if (FLAGS_use_epoll) {
+  if (FLAGS_use_epoll && !m_poller.get()) {
     m_poller.reset(new EPoller(export_map, m_clock));
   }
   if (m_export_map) {
-    m_export_map->GetBoolVar("using-epoll")->Set(FLAGS_use_epoll);
+    m_export_map->GetBoolVar("using-epoll")->Set(
+        FLAGS_use_epoll && !using_io_uring);
   }
 #endif
 
@@ -170,6 +209,47 @@ void SelectServer::Run() {
   m_is_running = false;
 }
 
+void SelectServer::RunSimulated(MockClock *clock,
+                                const TimeInterval &duration) {
+  if (m_is_running) {
+    OLA_FATAL << "SelectServer::RunSimulated() called while running";
+    return;
+  }
+
+  m_is_running = true;
+  m_terminate = false;
+
+  TimeStamp now, end;
+  clock->CurrentTime(&now);
+  end = now + duration;
+
+  while (!m_terminate) {
+    LoopClosureSet::iterator loop_iter;
+    for (loop_iter = m_loop_callbacks.begin();
+         loop_iter != m_loop_callbacks.end();
+         ++loop_iter)
+      (*loop_iter)->Run();
+
+    DrainAndExecute();
+
+    clock->CurrentTime(&now);
+    TimeInterval next_event = m_timeout_manager->ExecuteTimeouts(&now);
+
+    clock->CurrentTime(&now);
+    if (now >= end)
+      break;
+
+    // jump straight to the next deadline; with nothing pending, step by
+    // the default poll interval so RunInLoop() callbacks keep a cadence
+    TimeInterval advance =
+        next_event.IsZero() ? m_poll_interval : next_event;
+    if (end - now < advance)
+      advance = end - now;
+    clock->AdvanceTime(advance);
+  }
+  m_is_running = false;
+}
+
 void SelectServer::RunOnce() {
   RunOnce(TimeInterval(0, 0));
 }
@@ -258,6 +338,14 @@ timeout_id SelectServer::RegisterRepeatingTimeout(
   return m_timeout_manager->RegisterRepeatingTimeout(interval, callback);
 }
 
+timeout_id SelectServer::RegisterRepeatingTimeout(
+    const TimeInterval &interval,
+    ola::Callback0<bool> *callback,
+    const TimeInterval &slack) {
+  return m_timeout_manager->RegisterRepeatingTimeout(interval, callback,
+                                                     slack);
+}
+
 timeout_id SelectServer::RegisterSingleTimeout(
     unsigned int ms,
     ola::SingleUseCallback0<void> *callback) {
@@ -272,6 +360,13 @@ timeout_id SelectServer::RegisterSingleTimeout(
   return m_timeout_manager->RegisterSingleTimeout(interval, callback);
 }
 
+timeout_id SelectServer::RegisterSingleTimeout(
+    const TimeInterval &interval,
+    ola::SingleUseCallback0<void> *callback,
+    const TimeInterval &slack) {
+  return m_timeout_manager->RegisterSingleTimeout(interval, callback, slack);
+}
+
 void SelectServer::RemoveTimeout(timeout_id id) {
   return m_timeout_manager->CancelTimeout(id);
 }
@@ -314,12 +409,22 @@ void SelectServer::DrainCallbacks() {
  * @return false on error, true on success.
  */
 bool SelectServer::CheckForEvents(const TimeInterval &poll_interval) {
+  TimeStamp phase_start;
+  if (m_collect_loop_stats)
+    m_clock->CurrentTime(&phase_start);
+
   LoopClosureSet::iterator loop_iter;
   for (loop_iter = m_loop_callbacks.begin();
        loop_iter != m_loop_callbacks.end();
        ++loop_iter)
     (*loop_iter)->Run();
 
+  if (m_collect_loop_stats) {
+    TimeStamp now;
+    m_clock->CurrentTime(&now);
+    (*m_loop_callback_time) += (now - phase_start).AsInt();
+  }
+
   TimeInterval default_poll_interval = poll_interval;
   // if we've been told to terminate, make this very short.
   if (m_terminate) {
@@ -341,13 +446,38 @@ void SelectServer::DrainAndExecute() {
   // We can't hold the mutex while we execute the callback, so instead we swap
   // out the vector under a lock, release the lock and then run all the
   // callbacks.
+  //
+  // The drain is budgeted: a burst of thousands of deferred tasks (seen
+  // after reconnect storms) runs in slices of EXECUTE_DRAIN_BUDGET with
+  // the remainder pushed back for the next loop pass, so descriptor
+  // processing interleaves instead of starving. Ordering is preserved.
   Callbacks callbacks_to_run;
   {
     thread::MutexLocker lock(&m_incoming_mutex);
-    callbacks_to_run.swap(m_incoming_callbacks);
+    if (m_incoming_callbacks.size() <= EXECUTE_DRAIN_BUDGET) {
+      callbacks_to_run.swap(m_incoming_callbacks);
+    } else {
+      callbacks_to_run.assign(
+          m_incoming_callbacks.begin(),
+          m_incoming_callbacks.begin() + EXECUTE_DRAIN_BUDGET);
+      m_incoming_callbacks.erase(
+          m_incoming_callbacks.begin(),
+          m_incoming_callbacks.begin() + EXECUTE_DRAIN_BUDGET);
+    }
   }
 
   RunCallbacks(&callbacks_to_run);
+
+  // if we deferred some, make sure we wake again promptly
+  bool more;
+  {
+    thread::MutexLocker lock(&m_incoming_mutex);
+    more = !m_incoming_callbacks.empty();
+  }
+  if (more) {
+    uint8_t wake_up = 'w';
+    m_incoming_descriptor.Send(&wake_up, sizeof(wake_up));
+  }
 }
 
 void SelectServer::RunCallbacks(Callbacks *callbacks) {
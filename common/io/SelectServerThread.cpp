@@ -0,0 +1,114 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SelectServerThread.cpp
+ * A thread that runs a SelectServer, and a group of such threads.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "ola/io/SelectServerThread.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ola/Logging.h"
+#include "ola/stl/STLUtils.h"
+
+namespace ola {
+namespace io {
+
+using std::string;
+
+namespace {
+ola::thread::Thread::Options MakeOptions(const string &name, int cpu) {
+  ola::thread::Thread::Options options(name);
+  options.cpu = cpu;
+  return options;
+}
+}  // namespace
+
+SelectServerThread::SelectServerThread(const string &name, int cpu)
+    : ola::thread::Thread(MakeOptions(name, cpu)),
+      m_cpu(cpu) {
+}
+
+SelectServerThread::~SelectServerThread() {
+  Stop();
+}
+
+bool SelectServerThread::Start() {
+  return ola::thread::Thread::Start();
+}
+
+bool SelectServerThread::Stop() {
+  if (!IsRunning())
+    return false;
+  // Terminate() is a no-op until the loop has entered Run(), so wait out
+  // the startup window.
+  for (unsigned int i = 0; !m_ss.IsRunning() && i < 1000; i++)
+    usleep(1000);
+  m_ss.Terminate();
+  return Join();
+}
+
+void *SelectServerThread::Run() {
+  // affinity is applied by Thread from Options::cpu
+  m_ss.Run();
+  return NULL;
+}
+
+
+SelectServerShardGroup::SelectServerShardGroup(unsigned int shard_count,
+                                               bool pin_cpus) {
+  for (unsigned int i = 0; i < shard_count; i++) {
+    std::ostringstream name;
+    name << "ss-shard-" << i;
+    m_shards.push_back(
+        new SelectServerThread(name.str(),
+                               pin_cpus ? static_cast<int>(i) : -1));
+  }
+}
+
+SelectServerShardGroup::~SelectServerShardGroup() {
+  Stop();
+  STLDeleteElements(&m_shards);
+}
+
+bool SelectServerShardGroup::Start() {
+  std::vector<SelectServerThread*>::iterator iter = m_shards.begin();
+  for (; iter != m_shards.end(); ++iter) {
+    if (!(*iter)->Start()) {
+      OLA_WARN << "Failed to start event loop shard";
+      Stop();
+      return false;
+    }
+  }
+  return true;
+}
+
+void SelectServerShardGroup::Stop() {
+  std::vector<SelectServerThread*>::iterator iter = m_shards.begin();
+  for (; iter != m_shards.end(); ++iter)
+    (*iter)->Stop();
+}
+}  // namespace io
+}  // namespace ola
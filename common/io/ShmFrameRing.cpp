@@ -0,0 +1,271 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * ShmFrameRing.cpp
+ * A shared memory ring of DMX frames between two local processes.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef _WIN32
+
+#include "ola/io/ShmFrameRing.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "ola/Logging.h"
+#include "ola/network/IPV4Address.h"
+#include "ola/network/SocketAddress.h"
+
+namespace ola {
+namespace io {
+
+using ola::network::IPV4Address;
+using ola::network::IPV4SocketAddress;
+using ola::network::UDPSocket;
+using std::string;
+
+namespace {
+const uint32_t RING_MAGIC = 0x4f4c4152;  // 'OLAR'
+const uint32_t RING_VERSION = 1;
+}  // namespace
+
+/*
+ * The layout at the start of the shared memory object. head & tail are
+ * free-running counters, slot = counter & (frame_count - 1).
+ */
+struct ShmFrameRing::RingHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t frame_size;
+  uint32_t frame_count;
+  uint32_t doorbell_port;  // written by the consumer
+  uint32_t reserved;
+  uint32_t head;  // owned by the consumer
+  uint32_t tail;  // owned by the producer
+  uint64_t dropped;  // frames lost because the ring was full
+};
+
+namespace {
+// each slot is a length header followed by the frame data
+unsigned int SlotSize(unsigned int frame_size) {
+  return sizeof(uint32_t) + frame_size;
+}
+}  // namespace
+
+ShmFrameRing::ShmFrameRing(const string &name,
+                           int shm_fd,
+                           uint8_t *shm,
+                           size_t shm_size,
+                           bool is_consumer)
+    : m_name(name),
+      m_shm_fd(shm_fd),
+      m_shm(shm),
+      m_shm_size(shm_size),
+      m_is_consumer(is_consumer),
+      m_header(reinterpret_cast<RingHeader*>(shm)),
+      m_frames(shm + sizeof(RingHeader)) {
+}
+
+ShmFrameRing::~ShmFrameRing() {
+  munmap(m_shm, m_shm_size);
+  close(m_shm_fd);
+  if (m_is_consumer)
+    shm_unlink(m_name.c_str());
+}
+
+ShmFrameRing *ShmFrameRing::Create(const string &name,
+                                   unsigned int frame_size,
+                                   unsigned int frame_count) {
+  if (!frame_count || (frame_count & (frame_count - 1))) {
+    OLA_WARN << "ShmFrameRing frame_count must be a power of 2";
+    return NULL;
+  }
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    OLA_WARN << "shm_open(" << name << ") failed: " << strerror(errno);
+    return NULL;
+  }
+
+  size_t size = sizeof(RingHeader) + frame_count * SlotSize(frame_size);
+  if (ftruncate(fd, size)) {
+    OLA_WARN << "ftruncate(" << name << ") failed: " << strerror(errno);
+    close(fd);
+    shm_unlink(name.c_str());
+    return NULL;
+  }
+
+  uint8_t *shm = reinterpret_cast<uint8_t*>(
+      mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  if (shm == MAP_FAILED) {
+    OLA_WARN << "mmap(" << name << ") failed: " << strerror(errno);
+    close(fd);
+    shm_unlink(name.c_str());
+    return NULL;
+  }
+
+  ShmFrameRing *ring = new ShmFrameRing(name, fd, shm, size, true);
+  memset(shm, 0, sizeof(RingHeader));
+  ring->m_header->frame_size = frame_size;
+  ring->m_header->frame_count = frame_count;
+
+  if (!ring->InitDoorbell(true)) {
+    delete ring;
+    return NULL;
+  }
+
+  // publish the magic last, Attach() spins on it
+  ring->m_header->version = RING_VERSION;
+  __atomic_store_n(&ring->m_header->magic, RING_MAGIC, __ATOMIC_RELEASE);
+  return ring;
+}
+
+ShmFrameRing *ShmFrameRing::Attach(const string &name) {
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    OLA_WARN << "shm_open(" << name << ") failed: " << strerror(errno);
+    return NULL;
+  }
+
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) || statbuf.st_size <
+      static_cast<off_t>(sizeof(RingHeader))) {
+    OLA_WARN << "ShmFrameRing " << name << " is too small";
+    close(fd);
+    return NULL;
+  }
+
+  size_t size = statbuf.st_size;
+  uint8_t *shm = reinterpret_cast<uint8_t*>(
+      mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  if (shm == MAP_FAILED) {
+    OLA_WARN << "mmap(" << name << ") failed: " << strerror(errno);
+    close(fd);
+    return NULL;
+  }
+
+  RingHeader *header = reinterpret_cast<RingHeader*>(shm);
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != RING_MAGIC ||
+      header->version != RING_VERSION) {
+    OLA_WARN << "ShmFrameRing " << name << " has a bad header";
+    munmap(shm, size);
+    close(fd);
+    return NULL;
+  }
+
+  ShmFrameRing *ring = new ShmFrameRing(name, fd, shm, size, false);
+  if (!ring->InitDoorbell(false)) {
+    delete ring;
+    return NULL;
+  }
+  return ring;
+}
+
+bool ShmFrameRing::InitDoorbell(bool is_consumer) {
+  m_doorbell.reset(new UDPSocket());
+  if (!m_doorbell->Init())
+    return false;
+  // kicks are advisory; neither side should ever block on the doorbell
+  int flags = fcntl(m_doorbell->ReadDescriptor(), F_GETFL, 0);
+  fcntl(m_doorbell->ReadDescriptor(), F_SETFL, flags | O_NONBLOCK);
+
+  if (is_consumer) {
+    // bind an ephemeral loopback port and publish it in the header
+    if (!m_doorbell->Bind(IPV4SocketAddress(IPV4Address::Loopback(), 0))) {
+      return false;
+    }
+    IPV4SocketAddress local;
+    if (!m_doorbell->GetSocketAddress(&local))
+      return false;
+    m_header->doorbell_port = local.Port();
+  } else {
+    m_doorbell_address = IPV4SocketAddress(
+        IPV4Address::Loopback(),
+        static_cast<uint16_t>(m_header->doorbell_port));
+  }
+  return true;
+}
+
+bool ShmFrameRing::Push(const uint8_t *data, unsigned int length) {
+  if (length > m_header->frame_size) {
+    __atomic_add_fetch(&m_header->dropped, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+
+  uint32_t head = __atomic_load_n(&m_header->head, __ATOMIC_ACQUIRE);
+  uint32_t tail = m_header->tail;
+  if (tail - head >= m_header->frame_count) {
+    __atomic_add_fetch(&m_header->dropped, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+
+  uint8_t *slot = m_frames +
+      (tail & (m_header->frame_count - 1)) * SlotSize(m_header->frame_size);
+  memcpy(slot, &length, sizeof(uint32_t));
+  memcpy(slot + sizeof(uint32_t), data, length);
+  __atomic_store_n(&m_header->tail, tail + 1, __ATOMIC_RELEASE);
+
+  static const uint8_t kick = 1;
+  m_doorbell->SendTo(&kick, sizeof(kick), m_doorbell_address);
+  return true;
+}
+
+bool ShmFrameRing::Pop(uint8_t *data, unsigned int *length) {
+  uint32_t tail = __atomic_load_n(&m_header->tail, __ATOMIC_ACQUIRE);
+  uint32_t head = m_header->head;
+  if (head == tail)
+    return false;
+
+  const uint8_t *slot = m_frames +
+      (head & (m_header->frame_count - 1)) * SlotSize(m_header->frame_size);
+  uint32_t frame_length;
+  memcpy(&frame_length, slot, sizeof(uint32_t));
+  if (frame_length > *length)
+    frame_length = *length;
+  memcpy(data, slot + sizeof(uint32_t), frame_length);
+  *length = frame_length;
+  __atomic_store_n(&m_header->head, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+void ShmFrameRing::DrainDoorbell() {
+  uint8_t buffer[64];
+  ssize_t length = sizeof(buffer);
+  while (m_doorbell->RecvFrom(buffer, &length) && length > 0) {
+    length = sizeof(buffer);
+  }
+}
+
+unsigned int ShmFrameRing::FrameSize() const {
+  return m_header->frame_size;
+}
+
+unsigned int ShmFrameRing::FrameCount() const {
+  return m_header->frame_count;
+}
+
+uint64_t ShmFrameRing::FramesDropped() const {
+  return __atomic_load_n(&m_header->dropped, __ATOMIC_RELAXED);
+}
+}  // namespace io
+}  // namespace ola
+#endif  // _WIN32
@@ -0,0 +1,124 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * StallWatchdog.cpp
+ * Detects event loop stalls that are too short to trip the process
+ * supervisor.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "ola/io/StallWatchdog.h"
+
+#include "ola/ExportMap.h"
+#include "ola/Logging.h"
+#include "ola/base/Flags.h"
+#include "ola/base/TraceRing.h"
+
+DEFINE_uint32(loop_stall_threshold_ms, 500,
+              "Report an event loop dispatch pass that runs longer than "
+              "this, 0 to disable the stall watchdog.");
+
+namespace ola {
+namespace io {
+
+const char StallWatchdog::K_STALL_COUNT_VAR[] = "ss-loop-stalls";
+
+int64_t StallWatchdog::s_dispatch_start_us = 0;
+
+namespace {
+// how often the heartbeat is sampled
+const unsigned int CHECK_INTERVAL_MS = 100;
+}  // namespace
+
+StallWatchdog::StallWatchdog(ExportMap *export_map,
+                             const TimeInterval &threshold)
+    : ola::thread::Thread(ola::thread::Thread::Options("stall-watchdog")),
+      m_export_map(export_map),
+      m_threshold(threshold),
+      m_shutdown(false) {
+}
+
+StallWatchdog::~StallWatchdog() {
+  Stop();
+}
+
+StallWatchdog *StallWatchdog::NewFromFlags(ExportMap *export_map) {
+  if (!FLAGS_loop_stall_threshold_ms) {
+    return NULL;
+  }
+  return new StallWatchdog(
+      export_map,
+      TimeInterval(FLAGS_loop_stall_threshold_ms / 1000,
+                   (FLAGS_loop_stall_threshold_ms % 1000) * 1000));
+}
+
+bool StallWatchdog::Start() {
+  return ola::thread::Thread::Start();
+}
+
+void StallWatchdog::Stop() {
+  {
+    ola::thread::MutexLocker locker(&m_mutex);
+    if (m_shutdown) {
+      return;
+    }
+    m_shutdown = true;
+    m_condition.Signal();
+  }
+  Join();
+}
+
+void *StallWatchdog::Run() {
+  int64_t reported_stall_start = 0;
+
+  ola::thread::MutexLocker locker(&m_mutex);
+  while (!m_shutdown) {
+    TimeStamp wake_at;
+    m_clock.CurrentTime(&wake_at);
+    wake_at += TimeInterval(0, CHECK_INTERVAL_MS * 1000);
+    m_condition.TimedWait(&m_mutex, wake_at);
+    if (m_shutdown) {
+      break;
+    }
+
+    int64_t start_us =
+        __atomic_load_n(&s_dispatch_start_us, __ATOMIC_RELAXED);
+    if (!start_us || start_us == reported_stall_start) {
+      continue;  // idle, or a stall we've already reported
+    }
+
+    TimeStamp now;
+    m_clock.CurrentTime(&now);
+    int64_t running_us =
+        now.Seconds() * 1000000ll + now.MicroSeconds() - start_us;
+    if (running_us < m_threshold.AsInt()) {
+      continue;
+    }
+
+    // report each stall once, while it's still in progress, so the
+    // evidence is captured even if the loop never comes back
+    reported_stall_start = start_us;
+    OLA_WARN << "event loop stalled for " << running_us / 1000
+             << "ms and counting, dumping the trace ring";
+    if (m_export_map) {
+      (*m_export_map->GetCounterVar(K_STALL_COUNT_VAR))++;
+    }
+    Trace(TraceRing::EVENT_LOOP_STALL, running_us);
+    TraceRing::Instance()->DumpToLog();
+  }
+  return NULL;
+}
+}  // namespace io
+}  // namespace ola
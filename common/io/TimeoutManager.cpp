@@ -14,11 +14,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  *
  * TimeoutManager.cpp
- * Manages timeout events.
+ * Manages timeout events using a hierarchical timer wheel.
  * Copyright (C) 2013 Simon Newton
  */
 
-#include <queue>
 #include <set>
 #include <vector>
 
@@ -30,6 +29,9 @@ namespace io {
 
 // Tracks the # of timer functions registered
 const char TimeoutManager::K_TIMER_VAR[] = "ss-timers";
+// Tracks the # of events linked into the timer wheel, including cancelled
+// events that haven't been reaped yet.
+const char TimeoutManager::K_WHEEL_OCCUPANCY_VAR[] = "ss-timer-wheel-events";
 
 using ola::Callback0;
 using ola::ExportMap;
@@ -39,52 +41,72 @@ using ola::thread::timeout_id;
 TimeoutManager::TimeoutManager(ExportMap *export_map,
                                Clock *clock)
     : m_export_map(export_map),
-      m_clock(clock) {
+      m_clock(clock),
+      m_pending_events(0) {
   if (m_export_map) {
     m_export_map->GetIntegerVar(K_TIMER_VAR);
+    m_export_map->GetIntegerVar(K_WHEEL_OCCUPANCY_VAR);
   }
+
+  for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+    for (unsigned int slot = 0; slot < WHEEL_SLOTS; slot++) {
+      m_wheel[level][slot] = NULL;
+    }
+  }
+
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+  m_current_tick = TickFor(now);
 }
 
 TimeoutManager::~TimeoutManager() {
   m_removed_timeouts.clear();
 
-  while (!m_events.empty()) {
-    delete m_events.top();
-    m_events.pop();
+  for (unsigned int level = 0; level < WHEEL_LEVELS; level++) {
+    for (unsigned int slot = 0; slot < WHEEL_SLOTS; slot++) {
+      Event *event = m_wheel[level][slot];
+      while (event) {
+        Event *next = event->m_wheel_next;
+        delete event;
+        event = next;
+      }
+    }
   }
 }
 
 timeout_id TimeoutManager::RegisterRepeatingTimeout(
     const TimeInterval &interval,
-    ola::Callback0<bool> *closure) {
+    ola::Callback0<bool> *closure,
+    const TimeInterval &slack) {
   if (!closure)
     return INVALID_TIMEOUT;
 
   if (m_export_map)
     (*m_export_map->GetIntegerVar(K_TIMER_VAR))++;
 
-  Event *event = new RepeatingEvent(interval, m_clock, closure);
-  m_events.push(event);
+  Event *event = new RepeatingEvent(interval, m_clock, closure, slack);
+  RegisterEvent(event);
   return event;
 }
 
 timeout_id TimeoutManager::RegisterSingleTimeout(
     const TimeInterval &interval,
-    ola::SingleUseCallback0<void> *closure) {
+    ola::SingleUseCallback0<void> *closure,
+    const TimeInterval &slack) {
   if (!closure)
     return INVALID_TIMEOUT;
 
   if (m_export_map)
     (*m_export_map->GetIntegerVar(K_TIMER_VAR))++;
 
-  Event *event = new SingleEvent(interval, m_clock, closure);
-  m_events.push(event);
+  Event *event = new SingleEvent(interval, m_clock, closure, slack);
+  RegisterEvent(event);
   return event;
 }
 
 void TimeoutManager::CancelTimeout(timeout_id id) {
-  // TODO(simon): just mark the timeouts as cancelled rather than using a
-  // remove set.
+  // The event stays linked in the wheel until its slot comes around, at
+  // which point it's reaped instead of triggered.
   if (id == INVALID_TIMEOUT)
     return;
 
@@ -93,38 +115,173 @@ void TimeoutManager::CancelTimeout(timeout_id id) {
 }
 
 TimeInterval TimeoutManager::ExecuteTimeouts(TimeStamp *now) {
-  Event *e;
-  if (m_events.empty())
+  if (!m_pending_events)
     return TimeInterval();
 
-  for (e = m_events.top(); !m_events.empty() && (e->NextTime() <= *now);
-       e = m_events.top()) {
-    m_events.pop();
+  uint64_t target_tick = TickFor(*now);
+  while (m_current_tick < target_tick) {
+    m_current_tick++;
 
-    // if this was removed, skip it
-    if (m_removed_timeouts.erase(e)) {
-      delete e;
-      if (m_export_map)
-        (*m_export_map->GetIntegerVar(K_TIMER_VAR))--;
-      continue;
+    // When a level rolls over, pull the matching slot of the levels above
+    // back down into the wheel.
+    for (unsigned int level = 1; level < WHEEL_LEVELS; level++) {
+      if (m_current_tick & ((1ull << (level * WHEEL_BITS)) - 1))
+        break;
+      CascadeLevel(
+          level,
+          (m_current_tick >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1));
     }
 
-    if (e->Trigger()) {
+    ExpireCurrentSlot(now);
+    // Triggers take time; catch up if we fell further behind.
+    target_tick = TickFor(*now);
+  }
+
+  if (!m_pending_events)
+    return TimeInterval();
+  return TimeToNextEvent();
+}
+
+
+/*
+ * Convert a TimeStamp to an absolute wheel tick.
+ */
+uint64_t TimeoutManager::TickFor(const TimeStamp &time) const {
+  return (static_cast<uint64_t>(time.Seconds()) * USEC_IN_SECONDS +
+          time.MicroSeconds()) / TICK_USECS;
+}
+
+
+/*
+ * Account for a new (or re-armed) event and link it into the wheel.
+ */
+void TimeoutManager::RegisterEvent(Event *event) {
+  if (m_export_map)
+    (*m_export_map->GetIntegerVar(K_WHEEL_OCCUPANCY_VAR))++;
+  m_pending_events++;
+  InsertEvent(event);
+}
+
+
+/*
+ * Link an event into the slot for its expiry time.
+ */
+void TimeoutManager::InsertEvent(Event *event) {
+  uint64_t expiry_tick = TickFor(event->NextTime());
+
+  // Round deadlines with slack up to a slack-sized boundary, so adjacent
+  // timeouts land on the same tick and share a wakeup.
+  uint64_t slack_ticks = static_cast<uint64_t>(event->Slack().AsInt()) /
+      TICK_USECS;
+  if (slack_ticks > 1)
+    expiry_tick += slack_ticks - 1 - (expiry_tick + slack_ticks - 1) %
+        slack_ticks;
+
+  if (expiry_tick <= m_current_tick)
+    expiry_tick = m_current_tick + 1;
+
+  // Clamp anything beyond the top level into the furthest slot; it'll
+  // re-cascade until it's actually due.
+  uint64_t max_delta = (1ull << (WHEEL_LEVELS * WHEEL_BITS)) - 1;
+  if (expiry_tick - m_current_tick > max_delta)
+    expiry_tick = m_current_tick + max_delta;
+
+  uint64_t delta = expiry_tick - m_current_tick;
+  unsigned int level = 0;
+  while (level < WHEEL_LEVELS - 1 &&
+         delta >= (1ull << ((level + 1) * WHEEL_BITS))) {
+    level++;
+  }
+
+  unsigned int slot =
+      (expiry_tick >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+
+  event->m_wheel_next = m_wheel[level][slot];
+  m_wheel[level][slot] = event;
+}
+
+
+/*
+ * Move all the events in a higher level slot down a level (or to their
+ * final slot).
+ */
+void TimeoutManager::CascadeLevel(unsigned int level, unsigned int slot) {
+  Event *event = m_wheel[level][slot];
+  m_wheel[level][slot] = NULL;
+
+  while (event) {
+    Event *next = event->m_wheel_next;
+    InsertEvent(event);
+    event = next;
+  }
+}
+
+
+/*
+ * Run (or reap) every event in the level 0 slot for the current tick.
+ */
+void TimeoutManager::ExpireCurrentSlot(TimeStamp *now) {
+  unsigned int slot = m_current_tick & (WHEEL_SLOTS - 1);
+  Event *event = m_wheel[0][slot];
+  m_wheel[0][slot] = NULL;
+
+  while (event) {
+    Event *next = event->m_wheel_next;
+    m_pending_events--;
+    if (m_export_map)
+      (*m_export_map->GetIntegerVar(K_WHEEL_OCCUPANCY_VAR))--;
+
+    if (m_removed_timeouts.erase(event)) {
+      delete event;
+      if (m_export_map)
+        (*m_export_map->GetIntegerVar(K_TIMER_VAR))--;
+    } else if (event->Trigger()) {
       // true implies we need to run this again
-      e->UpdateTime(*now);
-      m_events.push(e);
+      event->UpdateTime(*now);
+      RegisterEvent(event);
+      m_clock->CurrentTime(now);
     } else {
-      delete e;
+      delete event;
       if (m_export_map)
         (*m_export_map->GetIntegerVar(K_TIMER_VAR))--;
+      m_clock->CurrentTime(now);
     }
-    m_clock->CurrentTime(now);
+    event = next;
   }
+}
 
-  if (m_events.empty())
-    return TimeInterval();
-  else
-    return m_events.top()->NextTime() - *now;
+
+/*
+ * A lower bound on the time until the next event fires. Events still in
+ * the higher levels report the time until their slot cascades, which just
+ * means an extra pass through ExecuteTimeouts when we wake.
+ */
+TimeInterval TimeoutManager::TimeToNextEvent() const {
+  // level 0 gives an exact answer
+  for (unsigned int i = 1; i <= WHEEL_SLOTS; i++) {
+    if (m_wheel[0][(m_current_tick + i) & (WHEEL_SLOTS - 1)])
+      return TimeInterval(static_cast<int64_t>(i * TICK_USECS));
+  }
+
+  for (unsigned int level = 1; level < WHEEL_LEVELS; level++) {
+    uint64_t slot_span = 1ull << (level * WHEEL_BITS);
+    uint64_t level_index = m_current_tick >> (level * WHEEL_BITS);
+    for (unsigned int i = 0; i < WHEEL_SLOTS; i++) {
+      if (m_wheel[level][(level_index + i) & (WHEEL_SLOTS - 1)]) {
+        uint64_t slot_start_tick = (level_index + i) * slot_span;
+        // Wake one tick before the slot starts: an event whose expiry
+        // lands exactly on the slot boundary would otherwise get a
+        // wakeup equal to its full remaining time, overshooting the
+        // deadline. The early wakeup cascades the slot into level 0,
+        // which then answers exactly.
+        uint64_t delta = slot_start_tick > m_current_tick + 1 ?
+            slot_start_tick - m_current_tick - 1 : 1;
+        return TimeInterval(static_cast<int64_t>(delta * TICK_USECS));
+      }
+    }
+  }
+  // shouldn't happen while m_pending_events is non-zero
+  return TimeInterval(static_cast<int64_t>(TICK_USECS));
 }
 }  // namespace io
 }  // namespace ola
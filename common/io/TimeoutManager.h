@@ -21,7 +21,8 @@
 #ifndef COMMON_IO_TIMEOUTMANAGER_H_
 #define COMMON_IO_TIMEOUTMANAGER_H_
 
-#include <queue>
+#include <stdint.h>
+
 #include <set>
 #include <vector>
 
@@ -64,7 +65,8 @@ class TimeoutManager {
    */
   ola::thread::timeout_id RegisterRepeatingTimeout(
       const ola::TimeInterval &interval,
-      ola::Callback0<bool> *closure);
+      ola::Callback0<bool> *closure,
+      const ola::TimeInterval &slack = ola::TimeInterval());
 
   /**
    * @brief Register a single use timeout function.
@@ -75,7 +77,8 @@ class TimeoutManager {
    */
   ola::thread::timeout_id RegisterSingleTimeout(
       const ola::TimeInterval &interval,
-      ola::SingleUseCallback0<void> *closure);
+      ola::SingleUseCallback0<void> *closure,
+      const ola::TimeInterval &slack = ola::TimeInterval());
 
   /**
    * @brief Cancel a timeout.
@@ -89,7 +92,7 @@ class TimeoutManager {
    * @returns true if there are events pending, false otherwise.
    */
   bool EventsPending() const {
-    return !m_events.empty();
+    return m_pending_events != 0;
   }
 
   /**
@@ -101,12 +104,16 @@ class TimeoutManager {
   TimeInterval ExecuteTimeouts(TimeStamp *now);
 
   static const char K_TIMER_VAR[];
+  static const char K_WHEEL_OCCUPANCY_VAR[];
 
  private :
   class Event {
    public:
-    explicit Event(const TimeInterval &interval, const Clock *clock)
-        : m_interval(interval) {
+    Event(const TimeInterval &interval, const Clock *clock,
+          const TimeInterval &slack)
+        : m_wheel_next(NULL),
+          m_interval(interval),
+          m_slack(slack) {
       TimeStamp now;
       clock->CurrentTime(&now);
       m_next = now + m_interval;
@@ -120,8 +127,17 @@ class TimeoutManager {
 
     TimeStamp NextTime() const { return m_next; }
 
+    // A deadline may be deferred by up to this much so adjacent timeouts
+    // share a single wakeup.
+    const TimeInterval &Slack() const { return m_slack; }
+
+    // intrusive link for the timer wheel slot lists; removal is lazy
+    // (via m_removed_timeouts), so a single forward link suffices
+    Event *m_wheel_next;
+
    private:
     TimeInterval m_interval;
+    TimeInterval m_slack;
     TimeStamp m_next;
   };
 
@@ -130,8 +146,9 @@ class TimeoutManager {
    public:
     SingleEvent(const TimeInterval &interval,
                 const Clock *clock,
-                ola::BaseCallback0<void> *closure):
-      Event(interval, clock),
+                ola::BaseCallback0<void> *closure,
+                const TimeInterval &slack):
+      Event(interval, clock, slack),
       m_closure(closure) {
     }
 
@@ -161,8 +178,9 @@ class TimeoutManager {
    public:
     RepeatingEvent(const TimeInterval &interval,
                    const Clock *clock,
-                   ola::BaseCallback0<bool> *closure):
-      Event(interval, clock),
+                   ola::BaseCallback0<bool> *closure,
+                   const TimeInterval &slack):
+      Event(interval, clock, slack),
       m_closure(closure) {
     }
     ~RepeatingEvent() {
@@ -178,19 +196,29 @@ class TimeoutManager {
     ola::BaseCallback0<bool> *m_closure;
   };
 
-  struct ltevent {
-    bool operator()(Event *e1, Event *e2) const {
-      return e1->NextTime() > e2->NextTime();
-    }
-  };
-
-  typedef std::priority_queue<Event*, std::vector<Event*>, ltevent>
-      event_queue_t;
+  // The events are stored in a hierarchical timer wheel: each level is a
+  // ring of slots holding intrusive lists, level 0 has a tick granularity
+  // of TICK_USECS and each higher level spans WHEEL_SLOTS times the level
+  // below. Registration and expiry are O(1); events that land in a higher
+  // level cascade down as the wheel turns.
+  static const unsigned int WHEEL_BITS = 8;
+  static const unsigned int WHEEL_SLOTS = 1 << WHEEL_BITS;
+  static const unsigned int WHEEL_LEVELS = 4;
+  static const uint64_t TICK_USECS = 1000;  // 1ms ticks
+
+  uint64_t TickFor(const TimeStamp &time) const;
+  void InsertEvent(Event *event);
+  void CascadeLevel(unsigned int level, unsigned int slot);
+  void ExpireCurrentSlot(TimeStamp *now);
+  TimeInterval TimeToNextEvent() const;
+  void RegisterEvent(Event *event);
 
   ola::ExportMap *m_export_map;
   Clock *m_clock;
 
-  event_queue_t m_events;
+  Event *m_wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+  uint64_t m_current_tick;
+  unsigned int m_pending_events;
   std::set<ola::thread::timeout_id> m_removed_timeouts;
 
   DISALLOW_COPY_AND_ASSIGN(TimeoutManager);
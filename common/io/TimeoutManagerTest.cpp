@@ -44,6 +44,9 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testRepeatingTimeouts);
   CPPUNIT_TEST(testAbortedRepeatingTimeouts);
   CPPUNIT_TEST(testPendingEventShutdown);
+  CPPUNIT_TEST(testSlackCoalescing);
+  CPPUNIT_TEST(testLongTimeouts);
+  CPPUNIT_TEST(testLevelBoundaryTimeouts);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -51,6 +54,9 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
     void testRepeatingTimeouts();
     void testAbortedRepeatingTimeouts();
     void testPendingEventShutdown();
+    void testSlackCoalescing();
+    void testLongTimeouts();
+    void testLevelBoundaryTimeouts();
 
     void HandleEvent(unsigned int event_id) {
       m_event_counters[event_id]++;
@@ -241,3 +247,123 @@ void TimeoutManagerTest::testPendingEventShutdown() {
 
   OLA_ASSERT_TRUE(timeout_manager.EventsPending());
 }
+
+
+/*
+ * Check that timeouts with slack share a wakeup: both events land on the
+ * same coalesced tick and fire together.
+ */
+void TimeoutManagerTest::testSlackCoalescing() {
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock);
+
+  TimeStamp last_checked_time;
+  TimeInterval slack(0, 20000);  // 20ms
+
+  // two deadlines 5ms apart, each with 20ms of slack
+  timeout_manager.RegisterSingleTimeout(
+      TimeInterval(0, 100000),
+      NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 1u),
+      slack);
+  timeout_manager.RegisterSingleTimeout(
+      TimeInterval(0, 105000),
+      NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 2u),
+      slack);
+
+  // neither may fire before its own deadline
+  clock.AdvanceTime(0, 99000);
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(0u, GetEventCounter(1));
+  OLA_ASSERT_EQ(0u, GetEventCounter(2));
+
+  // within the slack window both coalesce onto one tick and fire in the
+  // same pass
+  clock.AdvanceTime(0, 21000);  // 120ms total
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(1u, GetEventCounter(1));
+  OLA_ASSERT_EQ(1u, GetEventCounter(2));
+  OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+}
+
+
+/*
+ * Check events that start life in the higher wheel levels cascade down
+ * and fire at the right time, including cancellation while still up
+ * there.
+ */
+void TimeoutManagerTest::testLongTimeouts() {
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock);
+
+  TimeStamp last_checked_time;
+
+  // 10s is well beyond level 0 (256ms per level-0 revolution)
+  timeout_manager.RegisterSingleTimeout(
+      TimeInterval(10, 0),
+      NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 1u));
+  timeout_id cancelled_id = timeout_manager.RegisterSingleTimeout(
+      TimeInterval(10, 0),
+      NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 2u));
+  timeout_manager.CancelTimeout(cancelled_id);
+
+  // step through in level-0 sized chunks so every cascade runs
+  for (unsigned int i = 0; i < 99; i++) {
+    clock.AdvanceTime(0, 100000);  // 100ms
+    clock.CurrentTime(&last_checked_time);
+    timeout_manager.ExecuteTimeouts(&last_checked_time);
+    OLA_ASSERT_EQ(0u, GetEventCounter(1));
+  }
+  clock.AdvanceTime(0, 200000);
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(1u, GetEventCounter(1));
+  OLA_ASSERT_EQ(0u, GetEventCounter(2));
+  OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+}
+
+
+/*
+ * Check the returned wakeup interval stays strictly below the remaining
+ * time when the expiry tick lands exactly on a higher-level slot
+ * boundary (256ms multiples), the case that used to return the full
+ * remaining time.
+ */
+void TimeoutManagerTest::testLevelBoundaryTimeouts() {
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock);
+
+  TimeStamp last_checked_time;
+
+  static const unsigned int BOUNDARY_MS[] = {256, 512, 65536};
+  for (unsigned int i = 0; i < sizeof(BOUNDARY_MS) / sizeof(unsigned int);
+       i++) {
+    TimeInterval timeout_interval(BOUNDARY_MS[i] / 1000,
+                                  (BOUNDARY_MS[i] % 1000) * 1000);
+    timeout_manager.RegisterSingleTimeout(
+        timeout_interval,
+        NewSingleCallback(this, &TimeoutManagerTest::HandleEvent,
+                          10u + i));
+
+    clock.AdvanceTime(0, 1);
+    clock.CurrentTime(&last_checked_time);
+    TimeInterval next = timeout_manager.ExecuteTimeouts(&last_checked_time);
+    OLA_ASSERT_LT(next, timeout_interval);
+
+    // walk to the deadline following the returned wakeups; the event
+    // must fire by then
+    int64_t remaining_usecs = timeout_interval.AsInt();
+    while (GetEventCounter(10u + i) == 0 && remaining_usecs > 0) {
+      int64_t step_usecs = next.AsInt();
+      if (!step_usecs || step_usecs > remaining_usecs)
+        step_usecs = remaining_usecs < 1000 ? remaining_usecs : 1000;
+      clock.AdvanceTime(TimeInterval(step_usecs));
+      remaining_usecs -= step_usecs;
+      clock.CurrentTime(&last_checked_time);
+      next = timeout_manager.ExecuteTimeouts(&last_checked_time);
+    }
+    OLA_ASSERT_EQ(1u, GetEventCounter(10u + i));
+    OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+  }
+}
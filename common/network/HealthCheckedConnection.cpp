@@ -59,9 +59,12 @@ bool HealthCheckedConnection::Setup() {
 void HealthCheckedConnection::HeartbeatSent() {
   if (m_send_timeout_id != ola::thread::INVALID_TIMEOUT)
     m_scheduler->RemoveTimeout(m_send_timeout_id);
+  // a quarter interval of slack lets the scheduler merge our wakeup with
+  // other connections' timers
   m_send_timeout_id = m_scheduler->RegisterRepeatingTimeout(
     m_heartbeat_interval,
-    NewCallback(this, &HealthCheckedConnection::SendNextHeartbeat));
+    NewCallback(this, &HealthCheckedConnection::SendNextHeartbeat),
+    TimeInterval(m_heartbeat_interval.AsInt() / 4));
 }
 
 
@@ -106,7 +109,8 @@ void HealthCheckedConnection::UpdateReceiveTimer() {
   m_receive_timeout_id = m_scheduler->RegisterSingleTimeout(
     timeout_interval,
     NewSingleCallback(
-      this, &HealthCheckedConnection::InternalHeartbeatTimeout));
+      this, &HealthCheckedConnection::InternalHeartbeatTimeout),
+    TimeInterval(m_heartbeat_interval.AsInt() / 4));
 }
 
 void HealthCheckedConnection::InternalHeartbeatTimeout() {
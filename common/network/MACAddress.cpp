@@ -115,6 +115,17 @@ void MACAddress::Get(uint8_t ptr[LENGTH]) const {
   memcpy(ptr, m_address, LENGTH);
 }
 
+uint32_t MACAddress::Hash() const {
+  uint8_t bytes[LENGTH];
+  Get(bytes);
+  uint32_t hash = 2166136261u;
+  for (unsigned int i = 0; i < LENGTH; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 string MACAddress::ToString() const {
   /**
    * ether_ntoa_r doesn't exist on Mac, so can't use it; ether_ntoa isn't
@@ -54,7 +54,9 @@
 
 #include "common/network/NetworkUtilsInternal.h"
 #include "common/network/PosixInterfacePicker.h"
+#include "ola/Clock.h"
 #include "ola/Logging.h"
+#include "ola/thread/Mutex.h"
 #include "ola/network/IPV4Address.h"
 #include "ola/network/MACAddress.h"
 #include "ola/network/NetworkUtils.h"
@@ -69,10 +71,43 @@ using std::vector;
 /*
  * Return a vector of interfaces on the system.
  */
+namespace {
+// A process-wide cache of the enumeration result. Walking every
+// interface with ioctls takes hundreds of ms on many-VLAN gateways and
+// several plugins enumerate during init; interface config changes on
+// show networks are rare, so a short TTL keeps everyone honest without
+// a netlink subscription (which would need an event loop this utility
+// class doesn't have).
+struct InterfaceCache {
+  ola::thread::Mutex mutex;
+  std::vector<ola::network::Interface> interfaces[2];  // by include_loopback
+  ola::TimeStamp fetched[2];
+};
+InterfaceCache *GetInterfaceCache() {
+  static InterfaceCache cache;
+  return &cache;
+}
+const unsigned int CACHE_TTL_SECONDS = 5;
+}  // namespace
+
 vector<Interface> PosixInterfacePicker::GetInterfaces(
     bool include_loopback) const {
   vector<Interface> interfaces;
 
+  InterfaceCache *cache = GetInterfaceCache();
+  const unsigned int cache_slot = include_loopback ? 1 : 0;
+  ola::TimeStamp now;
+  ola::Clock clock;
+  clock.CurrentTime(&now);
+  {
+    ola::thread::MutexLocker locker(&cache->mutex);
+    if (cache->fetched[cache_slot].IsSet() &&
+        now - cache->fetched[cache_slot] <
+            ola::TimeInterval(CACHE_TTL_SECONDS, 0)) {
+      return cache->interfaces[cache_slot];
+    }
+  }
+
 #ifdef HAVE_SOCKADDR_DL_STRUCT
   string last_dl_iface_name;
   uint8_t hwlen = 0;
@@ -246,6 +281,11 @@ vector<Interface> PosixInterfacePicker::GetInterfaces(
     interfaces.push_back(interface);
   }
   delete[] buffer;
+  {
+    ola::thread::MutexLocker locker(&cache->mutex);
+    cache->interfaces[cache_slot] = interfaces;
+    cache->fetched[cache_slot] = now;
+  }
   return interfaces;
 }
 
@@ -341,6 +341,199 @@ bool UDPSocket::RecvFrom(uint8_t *buffer,
   return ok;
 }
 
+/*
+ * The default single-datagram implementation of the batched receive.
+ */
+int UDPSocketInterface::RecvFromBatch(uint8_t *buffers,
+                                      unsigned int datagram_size,
+                                      ReceivedDatagram *datagrams,
+                                      unsigned int datagram_count) {
+  if (!datagram_count)
+    return 0;
+  ssize_t length = datagram_size;
+  if (!RecvFrom(buffers, &length, &datagrams[0].source))
+    return 0;
+  datagrams[0].data = buffers;
+  datagrams[0].length = length;
+  return 1;
+}
+
+
+/*
+ * Ask the kernel to attach software receive timestamps (SO_TIMESTAMPNS);
+ * they're picked out of the control messages in RecvFromBatch.
+ */
+bool UDPSocket::EnableReceiveTimestamps() {
+#if defined(__linux__) && defined(SO_TIMESTAMPNS)
+  int flag = 1;
+  if (setsockopt(m_handle, SOL_SOCKET, SO_TIMESTAMPNS, &flag,
+                 sizeof(flag))) {
+    OLA_WARN << "Failed to enable receive timestamps: " << strerror(errno);
+    return false;
+  }
+  m_receive_timestamps = true;
+  return true;
+#else
+  return false;
+#endif  // defined(__linux__) && defined(SO_TIMESTAMPNS)
+}
+
+
+/*
+ * Drain a burst of datagrams with a single syscall where the platform
+ * allows it.
+ */
+int UDPSocket::RecvFromBatch(uint8_t *buffers,
+                             unsigned int datagram_size,
+                             ReceivedDatagram *datagrams,
+                             unsigned int datagram_count) {
+#if defined(__linux__)
+  if (datagram_count > MAX_RECV_BATCH)
+    datagram_count = MAX_RECV_BATCH;
+
+  struct mmsghdr messages[MAX_RECV_BATCH];
+  struct iovec iovecs[MAX_RECV_BATCH];
+  struct sockaddr_in sources[MAX_RECV_BATCH];
+  uint8_t control[MAX_RECV_BATCH][64];
+  memset(messages, 0, datagram_count * sizeof(messages[0]));
+
+  for (unsigned int i = 0; i < datagram_count; i++) {
+    iovecs[i].iov_base = buffers + i * datagram_size;
+    iovecs[i].iov_len = datagram_size;
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &sources[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+    if (m_receive_timestamps) {
+      messages[i].msg_hdr.msg_control = control[i];
+      messages[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+  }
+
+  int received = recvmmsg(m_handle, messages, datagram_count, MSG_DONTWAIT,
+                          NULL);
+  if (received < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+      OLA_WARN << "recvmmsg fd: " << m_handle << " failed: "
+               << strerror(errno);
+    return 0;
+  }
+
+  for (int i = 0; i < received; i++) {
+    datagrams[i].data = buffers + i * datagram_size;
+    datagrams[i].length = messages[i].msg_len;
+    datagrams[i].source = IPV4SocketAddress(
+        IPV4Address(sources[i].sin_addr.s_addr),
+        NetworkToHost(sources[i].sin_port));
+#ifdef SO_TIMESTAMPNS
+    if (m_receive_timestamps) {
+      for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr);
+           cmsg; cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET &&
+            cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+          struct timespec ts;
+          memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+          struct timeval tv;
+          tv.tv_sec = ts.tv_sec;
+          tv.tv_usec = ts.tv_nsec / 1000;
+          datagrams[i].receive_time = TimeStamp(tv);
+          break;
+        }
+      }
+    }
+#endif  // SO_TIMESTAMPNS
+  }
+  return received;
+#else
+  return UDPSocketInterface::RecvFromBatch(buffers, datagram_size,
+                                           datagrams, datagram_count);
+#endif  // defined(__linux__)
+}
+
+/*
+ * The default batched send just loops.
+ */
+int UDPSocketInterface::SendToBatch(const OutgoingDatagram *datagrams,
+                                    unsigned int datagram_count) {
+  unsigned int sent = 0;
+  uint8_t assembly[MAX_DATAGRAM_ASSEMBLY_SIZE];
+  for (; sent < datagram_count; sent++) {
+    const OutgoingDatagram &datagram = datagrams[sent];
+    const uint8_t *data = datagram.data;
+    unsigned int length = datagram.length;
+    if (datagram.payload) {
+      // assemble two-part datagrams for the portable path
+      if (length + datagram.payload_length > sizeof(assembly))
+        break;
+      memcpy(assembly, datagram.data, length);
+      memcpy(assembly + length, datagram.payload, datagram.payload_length);
+      data = assembly;
+      length += datagram.payload_length;
+    }
+    if (SendTo(data, length, datagram.destination) !=
+        static_cast<ssize_t>(length)) {
+      break;
+    }
+  }
+  return sent;
+}
+
+
+/*
+ * Submit a burst of datagrams with single syscalls where the platform
+ * allows it.
+ */
+int UDPSocket::SendToBatch(const OutgoingDatagram *datagrams,
+                           unsigned int datagram_count) {
+#if defined(__linux__)
+  unsigned int total_sent = 0;
+  while (total_sent < datagram_count) {
+    unsigned int batch = datagram_count - total_sent;
+    if (batch > MAX_SEND_BATCH)
+      batch = MAX_SEND_BATCH;
+
+    struct mmsghdr messages[MAX_SEND_BATCH];
+    struct iovec iovecs[2 * MAX_SEND_BATCH];
+    struct sockaddr_in destinations[MAX_SEND_BATCH];
+    memset(messages, 0, batch * sizeof(messages[0]));
+
+    for (unsigned int i = 0; i < batch; i++) {
+      const OutgoingDatagram &datagram = datagrams[total_sent + i];
+      iovecs[2 * i].iov_base = const_cast<uint8_t*>(datagram.data);
+      iovecs[2 * i].iov_len = datagram.length;
+      messages[i].msg_hdr.msg_iov = &iovecs[2 * i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+      if (datagram.payload) {
+        // two-part datagram: the kernel gathers header & payload
+        iovecs[2 * i + 1].iov_base = const_cast<uint8_t*>(datagram.payload);
+        iovecs[2 * i + 1].iov_len = datagram.payload_length;
+        messages[i].msg_hdr.msg_iovlen = 2;
+      }
+      if (!datagram.destination.ToSockAddr(
+              reinterpret_cast<struct sockaddr*>(&destinations[i]),
+              sizeof(destinations[i]))) {
+        return total_sent;
+      }
+      messages[i].msg_hdr.msg_name = &destinations[i];
+      messages[i].msg_hdr.msg_namelen = sizeof(destinations[i]);
+    }
+
+    int sent = sendmmsg(m_handle, messages, batch, 0);
+    if (sent < 0) {
+      OLA_WARN << "sendmmsg fd: " << m_handle << " failed: "
+               << strerror(errno);
+      return total_sent;
+    }
+    total_sent += sent;
+    if (static_cast<unsigned int>(sent) < batch)
+      break;
+  }
+  return total_sent;
+#else
+  return UDPSocketInterface::SendToBatch(datagrams, datagram_count);
+#endif  // defined(__linux__)
+}
+
 bool UDPSocket::EnableBroadcast() {
   if (m_handle == ola::io::INVALID_DESCRIPTOR)
     return false;
@@ -446,6 +639,65 @@ bool UDPSocket::LeaveMulticast(const IPV4Address &iface,
   return true;
 }
 
+/*
+ * Per-universe sizing: a full sACN frame is ~638 bytes on the wire;
+ * hold 4 frames per universe so a scheduler tick's burst fits.
+ */
+UDPSocketInterface::SocketProfile UDPSocketInterface::ProfileForUniverseCount(
+    unsigned int universes) {
+  SocketProfile profile;
+  const unsigned int per_universe = 4 * 638;
+  unsigned int size = universes * per_universe;
+  if (size < MIN_PROFILE_BUFFER_SIZE)
+    size = MIN_PROFILE_BUFFER_SIZE;
+  profile.receive_buffer_size = size;
+  profile.send_buffer_size = size;
+  return profile;
+}
+
+
+bool UDPSocket::ApplyProfile(const SocketProfile &profile) {
+  bool ok = true;
+  struct BufferOption {
+    int option;
+    const char *name;
+    unsigned int size;
+  };
+  const BufferOption options[] = {
+    { SO_RCVBUF, "SO_RCVBUF", profile.receive_buffer_size },
+    { SO_SNDBUF, "SO_SNDBUF", profile.send_buffer_size },
+  };
+
+  for (unsigned int i = 0; i < sizeof(options) / sizeof(options[0]); i++) {
+    if (!options[i].size)
+      continue;
+    int size = static_cast<int>(options[i].size);
+    if (setsockopt(m_handle, SOL_SOCKET, options[i].option,
+                   reinterpret_cast<char*>(&size), sizeof(size))) {
+      OLA_WARN << "Failed to set " << options[i].name << ": "
+               << strerror(errno);
+      ok = false;
+      continue;
+    }
+    // verify what we actually got; the kernel may clamp to rmem/wmem_max
+    int actual = 0;
+    socklen_t actual_size = sizeof(actual);
+    if (getsockopt(m_handle, SOL_SOCKET, options[i].option,
+                   reinterpret_cast<char*>(&actual), &actual_size) == 0 &&
+        actual < size) {
+      OLA_WARN << options[i].name << " clamped to " << actual
+               << ", wanted " << size
+               << "; raise net.core.rmem_max/wmem_max to avoid drops";
+      ok = false;
+    }
+  }
+
+  if (profile.tos)
+    ok &= SetTos(profile.tos);
+  return ok;
+}
+
+
 bool UDPSocket::SetTos(uint8_t tos) {
   unsigned int value = tos & 0xFC;  // zero the ECN fields
 #ifdef _WIN32
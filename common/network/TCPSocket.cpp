@@ -113,6 +113,26 @@ bool TCPSocket::Close() {
 /*
  * Set the TCP_NODELAY option
  */
+bool TCPSocket::SetCork(bool corked) {
+#if defined(__linux__) && defined(TCP_CORK)
+  int flag = corked ? 1 : 0;
+#ifdef _WIN32
+  int sd = m_handle.m_handle.m_fd;
+#else
+  int sd = m_handle;
+#endif
+  if (setsockopt(sd, IPPROTO_TCP, TCP_CORK,
+                 reinterpret_cast<char*>(&flag), sizeof(flag))) {
+    OLA_WARN << "Can't set TCP_CORK for " << sd << ", " << strerror(errno);
+    return false;
+  }
+  return true;
+#else
+  (void) corked;
+  return false;
+#endif  // defined(__linux__) && defined(TCP_CORK)
+}
+
 bool TCPSocket::SetNoDelay() {
   int flag = 1;
 #ifdef _WIN32
@@ -124,8 +144,13 @@ bool TCPSocket::SetNoDelay() {
                           reinterpret_cast<char*>(&flag),
                           sizeof(flag));
   if (result < 0) {
-    OLA_WARN << "Can't set TCP_NODELAY for " << sd << ", "
-             << strerror(errno);
+    if (errno == EOPNOTSUPP) {
+      // not a TCP socket, e.g. the Unix domain RPC endpoint
+      OLA_DEBUG << "TCP_NODELAY not supported for " << sd;
+    } else {
+      OLA_WARN << "Can't set TCP_NODELAY for " << sd << ", "
+               << strerror(errno);
+    }
     return false;
   }
   return true;
@@ -279,7 +304,10 @@ void TCPAcceptingSocket::PerformRead() {
   if (m_handle == ola::io::INVALID_DESCRIPTOR)
     return;
 
-  while (1) {
+  // Bound the accepts per loop iteration so a reconnect storm interleaves
+  // with frame processing instead of monopolizing the loop; the remaining
+  // backlog keeps the descriptor readable for the next iteration.
+  for (unsigned int i = 0; i < MAX_ACCEPTS_PER_CYCLE; i++) {
     struct sockaddr_in cli_address;
     socklen_t length = sizeof(cli_address);
 
@@ -50,6 +50,8 @@ QueueingRDMController::QueueingRDMController(
     unsigned int max_queue_size)
   : m_controller(controller),
     m_max_queue_size(max_queue_size),
+    m_dispatches_since_yield(0),
+    m_active_queue(NULL),
     m_rdm_request_pending(false),
     m_active(true),
     m_response(NULL) {
@@ -64,12 +66,16 @@ QueueingRDMController::QueueingRDMController(
 QueueingRDMController::~QueueingRDMController() {
   // delete all outstanding requests
   vector<string> packets;
-  while (!m_pending_requests.empty()) {
-    outstanding_rdm_request outstanding_request = m_pending_requests.front();
-    if (outstanding_request.on_complete)
-      outstanding_request.on_complete->Run(RDM_FAILED_TO_SEND, NULL, packets);
-    delete outstanding_request.request;
-    m_pending_requests.pop();
+  for (unsigned int i = 0; i < 3; i++) {
+    while (!m_pending_requests[i].empty()) {
+      outstanding_rdm_request outstanding_request =
+          m_pending_requests[i].front();
+      if (outstanding_request.on_complete)
+        outstanding_request.on_complete->Run(RDM_FAILED_TO_SEND, NULL,
+                                             packets);
+      delete outstanding_request.request;
+      m_pending_requests[i].pop();
+    }
   }
 
   if (m_response)
@@ -102,7 +108,17 @@ void QueueingRDMController::Resume() {
  */
 void QueueingRDMController::SendRDMRequest(const RDMRequest *request,
                                            RDMCallback *on_complete) {
-  if (m_pending_requests.size() >= m_max_queue_size) {
+  SendRDMRequest(request, on_complete, PRIORITY_NORMAL);
+}
+
+
+/**
+ * Queue an RDM request for sending with a scheduling class.
+ */
+void QueueingRDMController::SendRDMRequest(const RDMRequest *request,
+                                           RDMCallback *on_complete,
+                                           RequestPriority priority) {
+  if (TotalQueueDepth() >= m_max_queue_size) {
     OLA_WARN << "RDM Queue is full, dropping request";
     if (on_complete) {
       vector<string> packets;
@@ -115,11 +131,56 @@ void QueueingRDMController::SendRDMRequest(const RDMRequest *request,
   outstanding_rdm_request outstanding_request;
   outstanding_request.request = request;
   outstanding_request.on_complete = on_complete;
-  m_pending_requests.push(outstanding_request);
+  m_clock.CurrentTime(&outstanding_request.enqueue_time);
+  m_pending_requests[priority].push(outstanding_request);
   TakeNextAction();
 }
 
 
+unsigned int QueueingRDMController::TotalQueueDepth() const {
+  unsigned int depth = 0;
+  for (unsigned int i = 0; i < 3; i++)
+    depth += static_cast<unsigned int>(m_pending_requests[i].size());
+  return depth;
+}
+
+
+bool QueueingRDMController::PendingRequests() const {
+  return TotalQueueDepth() != 0;
+}
+
+
+/*
+ * Pick the queue the next request is dispatched from. Interactive wins,
+ * with a starvation guard that serves a lower class at least every
+ * fourth dispatch under sustained interactive load.
+ */
+std::queue<QueueingRDMController::outstanding_rdm_request>*
+QueueingRDMController::NextQueue() {
+  static const unsigned int YIELD_INTERVAL = 4;
+  if (m_dispatches_since_yield >= YIELD_INTERVAL &&
+      !m_pending_requests[PRIORITY_INTERACTIVE].empty()) {
+    for (unsigned int p = PRIORITY_NORMAL; p <= PRIORITY_BACKGROUND; p++) {
+      if (!m_pending_requests[p].empty()) {
+        m_dispatches_since_yield = 0;
+        return &m_pending_requests[p];
+      }
+    }
+  }
+  for (unsigned int p = 0; p < 3; p++) {
+    if (!m_pending_requests[p].empty()) {
+      if (p == PRIORITY_INTERACTIVE) {
+        m_dispatches_since_yield++;
+      } else {
+        m_dispatches_since_yield = 0;
+      }
+      return &m_pending_requests[p];
+    }
+  }
+  return NULL;
+}
+
+
 /**
  * Do the next action.
  */
@@ -146,7 +207,8 @@ bool QueueingRDMController::CheckForBlockingCondition() {
  * If we're not paused, send the next request.
  */
 void QueueingRDMController::MaybeSendRDMRequest() {
-  if (m_pending_requests.empty())
+  m_active_queue = NextQueue();
+  if (!m_active_queue)
     return;
 
   m_rdm_request_pending = true;
@@ -158,7 +220,8 @@ void QueueingRDMController::MaybeSendRDMRequest() {
  * Send the next RDM request.
  */
 void QueueingRDMController::DispatchNextRequest() {
-  outstanding_rdm_request outstanding_request = m_pending_requests.front();
+  m_clock.CurrentTime(&m_dispatch_time);
+  outstanding_rdm_request outstanding_request = m_active_queue->front();
   // We have to make a copy here because we pass ownership of the request to
   // the underlying controller.
   // We need to have the original request because we use it if we receive an
@@ -177,7 +240,7 @@ void QueueingRDMController::HandleRDMResponse(
     const vector<string> &packets) {
   m_rdm_request_pending = false;
 
-  if (m_pending_requests.empty()) {
+  if (!m_active_queue || m_active_queue->empty()) {
     OLA_FATAL << "Received a response but the queue was empty!";
     return;
   }
@@ -205,7 +268,11 @@ void QueueingRDMController::HandleRDMResponse(
     // combine correctly.
     if (m_response) {
       if (original_type == ACK_OVERFLOW) {
-        // send the same command again;
+        // This is the overflow fast path: the continuation request goes
+        // out immediately (no queue re-entry, no caller round trip) and
+        // the fragments are reassembled in place via CombineResponses,
+        // so a full sensor dump or 512-slot SLOT_INFO costs back-to-back
+        // wire transactions and the caller sees one combined response.
         DispatchNextRequest();
         return;
       }
@@ -218,13 +285,37 @@ void QueueingRDMController::HandleRDMResponse(
       delete m_response;
     m_response = NULL;
   }
-  outstanding_rdm_request outstanding_request = m_pending_requests.front();
+  outstanding_rdm_request outstanding_request = m_active_queue->front();
+
+  // latency accounting: queued-until-dispatch and dispatch-until-response
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  int64_t wire_usecs = (now - m_dispatch_time).AsInt();
+  int64_t queue_usecs = (m_dispatch_time -
+                         outstanding_request.enqueue_time).AsInt();
+  m_latency_stats.completed++;
+  m_latency_stats.queue_time_usecs += queue_usecs > 0 ? queue_usecs : 0;
+  m_latency_stats.wire_time_usecs += wire_usecs > 0 ? wire_usecs : 0;
+  unsigned int bucket;
+  if (wire_usecs < 1000) {
+    bucket = 0;
+  } else if (wire_usecs < 10000) {
+    bucket = 1;
+  } else if (wire_usecs < 100000) {
+    bucket = 2;
+  } else if (wire_usecs < 1000000) {
+    bucket = 3;
+  } else {
+    bucket = 4;
+  }
+  m_latency_stats.wire_time_buckets[bucket]++;
+
   if (outstanding_request.on_complete)
     outstanding_request.on_complete->Run(status, m_response, m_packets);
   m_packets.clear();
   m_response = NULL;
   delete outstanding_request.request;
-  m_pending_requests.pop();
+  m_active_queue->pop();
   TakeNextAction();
 }
 
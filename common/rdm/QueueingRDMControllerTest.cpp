@@ -58,6 +58,7 @@ class QueueingRDMControllerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testMultipleDiscovery);
   CPPUNIT_TEST(testReentrantDiscovery);
   CPPUNIT_TEST(testRequestAndDiscovery);
+  CPPUNIT_TEST(testPriorityLanes);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -72,6 +73,7 @@ class QueueingRDMControllerTest: public CppUnit::TestFixture {
     void testMultipleDiscovery();
     void testReentrantDiscovery();
     void testRequestAndDiscovery();
+    void testPriorityLanes();
 
     void VerifyResponse(
         ola::rdm::rdm_response_code expected_code,
@@ -991,3 +993,115 @@ void QueueingRDMControllerTest::testRequestAndDiscovery() {
   OLA_ASSERT_TRUE(m_discovery_complete_count);
   mock_controller.Verify();
 }
+
+
+/*
+ * Requests queued while the controller is busy drain in priority order,
+ * not submission order.
+ */
+void QueueingRDMControllerTest::testPriorityLanes() {
+  UID source(1, 2);
+  UID dest_active(3, 1);
+  UID dest_background(3, 2);
+  UID dest_normal(3, 3);
+  UID dest_interactive(3, 4);
+
+  MockRDMController mock_controller;
+  ola::rdm::QueueingRDMController controller(&mock_controller, 10);
+
+  // the first request dispatches immediately and is left in flight
+  RDMRequest *active_request = NewGetRequest(source, dest_active);
+  RDMGetResponse active_response(dest_active, source, 0, RDM_ACK, 0,
+                                 10, 296, NULL, 0);
+  mock_controller.AddExpectedCall(active_request,
+                                  ola::rdm::RDM_COMPLETED_OK,
+                                  NULL,
+                                  "",
+                                  false);
+  vector<string> packets;
+  packets.push_back("foo");
+  controller.SendRDMRequest(
+      active_request,
+      ola::NewSingleCallback(
+          this,
+          &QueueingRDMControllerTest::VerifyResponse,
+          ola::rdm::RDM_COMPLETED_OK,
+          static_cast<const RDMResponse*>(&active_response),
+          packets,
+          false));
+
+  // now queue one request per lane, in worst-first submission order
+  RDMRequest *background_request = NewGetRequest(source, dest_background);
+  RDMRequest *normal_request = NewGetRequest(source, dest_normal);
+  RDMRequest *interactive_request = NewGetRequest(source, dest_interactive);
+
+  RDMGetResponse background_response(dest_background, source, 0, RDM_ACK,
+                                     0, 10, 296, NULL, 0);
+  RDMGetResponse normal_response(dest_normal, source, 0, RDM_ACK, 0, 10,
+                                 296, NULL, 0);
+  RDMGetResponse interactive_response(dest_interactive, source, 0,
+                                      RDM_ACK, 0, 10, 296, NULL, 0);
+
+  // the mock expects the dispatches in priority order
+  mock_controller.AddExpectedCall(interactive_request,
+                                  ola::rdm::RDM_COMPLETED_OK,
+                                  &interactive_response,
+                                  "foo");
+  mock_controller.AddExpectedCall(normal_request,
+                                  ola::rdm::RDM_COMPLETED_OK,
+                                  &normal_response,
+                                  "foo");
+  mock_controller.AddExpectedCall(background_request,
+                                  ola::rdm::RDM_COMPLETED_OK,
+                                  &background_response,
+                                  "foo");
+
+  controller.SendRDMRequest(
+      background_request,
+      ola::NewSingleCallback(
+          this,
+          &QueueingRDMControllerTest::VerifyResponse,
+          ola::rdm::RDM_COMPLETED_OK,
+          static_cast<const RDMResponse*>(&background_response),
+          packets,
+          false),
+      ola::rdm::QueueingRDMController::PRIORITY_BACKGROUND);
+  controller.SendRDMRequest(
+      normal_request,
+      ola::NewSingleCallback(
+          this,
+          &QueueingRDMControllerTest::VerifyResponse,
+          ola::rdm::RDM_COMPLETED_OK,
+          static_cast<const RDMResponse*>(&normal_response),
+          packets,
+          false),
+      ola::rdm::QueueingRDMController::PRIORITY_NORMAL);
+  controller.SendRDMRequest(
+      interactive_request,
+      ola::NewSingleCallback(
+          this,
+          &QueueingRDMControllerTest::VerifyResponse,
+          ola::rdm::RDM_COMPLETED_OK,
+          static_cast<const RDMResponse*>(&interactive_response),
+          packets,
+          false),
+      ola::rdm::QueueingRDMController::PRIORITY_INTERACTIVE);
+
+  OLA_ASSERT_EQ(1u, controller.QueueDepth(
+      ola::rdm::QueueingRDMController::PRIORITY_BACKGROUND));
+  // the in-flight request (default priority) still occupies its queue
+  // slot until it completes
+  OLA_ASSERT_EQ(2u, controller.QueueDepth(
+      ola::rdm::QueueingRDMController::PRIORITY_NORMAL));
+  OLA_ASSERT_EQ(1u, controller.QueueDepth(
+      ola::rdm::QueueingRDMController::PRIORITY_INTERACTIVE));
+
+  // completing the in-flight request drains the lanes in priority order;
+  // the mock verifies the dispatch sequence
+  mock_controller.RunRDMCallback(ola::rdm::RDM_COMPLETED_OK,
+                                 &active_response,
+                                 "foo");
+  mock_controller.Verify();
+  OLA_ASSERT_EQ(0u, controller.QueueDepth(
+      ola::rdm::QueueingRDMController::PRIORITY_BACKGROUND));
+}
@@ -68,7 +68,7 @@ RDMCommand::RDMCommand(const UID &source,
 
 
 RDMCommand::~RDMCommand() {
-  if (m_data)
+  if (m_data && m_data != m_inline_data)
     delete[] m_data;
 }
 
@@ -181,10 +181,12 @@ RDMCommand *RDMCommand::Inflate(const uint8_t *data, unsigned int length) {
 void RDMCommand::SetParamData(const uint8_t *data, unsigned int length) {
   m_data_length = length;
   if (m_data_length > 0 && data != NULL) {
-    if (m_data)
+    if (m_data && m_data != m_inline_data)
       delete[] m_data;
 
-    m_data = new uint8_t[m_data_length];
+    // the typical GET/SET payload is a handful of bytes; keep it inline
+    m_data = m_data_length <= INLINE_DATA_SIZE ?
+        m_inline_data : new uint8_t[m_data_length];
     memcpy(m_data, data, m_data_length);
   }
 }
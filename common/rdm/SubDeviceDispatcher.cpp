@@ -65,6 +65,16 @@ void SubDeviceDispatcher::SendRDMRequest(const RDMRequest *request,
 
 /**
  * Handle commands sent to the SUB_DEVICE_ALL_CALL target.
+ *
+ * The command arrives here already parsed and validated once - sub
+ * devices receive an RDMRequest object and dispatch it through their
+ * class-shared flat PID table, so no re-parsing happens per sub device.
+ * What each sub device does cost is a Duplicate() of the request, because
+ * SendRDMRequest transfers ownership and every callee deletes its copy;
+ * with small param data stored inline that's one allocation per sub
+ * device. Sharing a single request across the fanout means changing the
+ * RDMControllerInterface ownership contract for every responder, which
+ * isn't worth it at this fanout size.
  */
 void SubDeviceDispatcher::FanOutToSubDevices(
     const RDMRequest *request,
@@ -38,6 +38,7 @@ class UIDTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testUIDInequalities);
   CPPUNIT_TEST(testUIDSet);
   CPPUNIT_TEST(testUIDSetUnion);
+  CPPUNIT_TEST(testUIDSetLazySort);
   CPPUNIT_TEST(testUIDParse);
   CPPUNIT_TEST(testDirectedToUID);
   CPPUNIT_TEST_SUITE_END();
@@ -47,6 +48,7 @@ class UIDTest: public CppUnit::TestFixture {
     void testUIDInequalities();
     void testUIDSet();
     void testUIDSetUnion();
+    void testUIDSetLazySort();
     void testUIDParse();
     void testDirectedToUID();
 };
@@ -322,3 +324,49 @@ void UIDTest::testDirectedToUID() {
   UID other_vendorcast_uid_2 = UID::VendorcastAddress(other_manufacturer_uid);
   OLA_ASSERT_FALSE(other_vendorcast_uid_2.DirectedToUID(device_uid));
 }
+
+
+/*
+ * The set is backed by a lazily-sorted vector: out of order and
+ * duplicate adds must still yield a sorted, deduplicated view through
+ * every read path.
+ */
+void UIDTest::testUIDSetLazySort() {
+  UIDSet set1;
+  // insert out of order, with duplicates interleaved between reads
+  set1.AddUID(UID(3, 30));
+  set1.AddUID(UID(1, 10));
+  set1.AddUID(UID(2, 20));
+  OLA_ASSERT_EQ(3u, set1.Size());
+  OLA_ASSERT_EQ(string("0001:0000000a,0002:00000014,0003:0000001e"),
+                set1.ToString());
+
+  // a duplicate added after the sorted view was materialized
+  set1.AddUID(UID(1, 10));
+  OLA_ASSERT_EQ(3u, set1.Size());
+
+  // iteration is sorted even when more unsorted adds happened since
+  set1.AddUID(UID(0, 5));
+  UIDSet::Iterator iter = set1.Begin();
+  UID last = *iter;
+  unsigned int count = 1;
+  for (++iter; iter != set1.End(); ++iter, ++count) {
+    OLA_ASSERT_TRUE(last < *iter);
+    last = *iter;
+  }
+  OLA_ASSERT_EQ(4u, count);
+
+  // removal after unsorted adds
+  set1.RemoveUID(UID(2, 20));
+  OLA_ASSERT_EQ(3u, set1.Size());
+  OLA_ASSERT_FALSE(set1.Contains(UID(2, 20)));
+  OLA_ASSERT_TRUE(set1.Contains(UID(0, 5)));
+
+  // SetDifference across sets that are both pending a sort
+  UIDSet set2;
+  set2.AddUID(UID(3, 30));
+  set2.AddUID(UID(0, 5));
+  UIDSet difference = set1.SetDifference(set2);
+  OLA_ASSERT_EQ(1u, difference.Size());
+  OLA_ASSERT_TRUE(difference.Contains(UID(1, 10)));
+}
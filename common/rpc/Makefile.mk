@@ -9,6 +9,8 @@ built_sources += \
 # LIBRARIES
 ##################################################
 common_libolacommon_la_SOURCES += \
+    common/rpc/MarshalledRpcService.cpp \
+    common/rpc/MarshalledRpcService.h \
     common/rpc/RpcChannel.cpp \
     common/rpc/RpcChannel.h \
     common/rpc/RpcSession.h \
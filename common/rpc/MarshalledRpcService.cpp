@@ -0,0 +1,83 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MarshalledRpcService.cpp
+ * An RpcService decorator that runs the wrapped service on another thread's
+ * event loop.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "common/rpc/MarshalledRpcService.h"
+
+#include <google/protobuf/message.h>
+
+#include "ola/Callback.h"
+
+namespace ola {
+namespace rpc {
+
+using google::protobuf::Message;
+using google::protobuf::MethodDescriptor;
+
+void MarshalledRpcService::CallMethod(const MethodDescriptor *method,
+                                      RpcController *controller,
+                                      const Message *request,
+                                      Message *response,
+                                      CompletionCallback *done) {
+  // The channel owns (and will reuse) the request, so it's copied for the
+  // cross-thread handoff. The copy is freed when the service completes.
+  MarshalledCall *call = new MarshalledCall;
+  call->method = method;
+  call->controller = controller;
+  call->request = request->New();
+  call->request->CopyFrom(*request);
+  call->response = response;
+  call->done = done;
+  m_service_executor->Execute(ola::NewSingleCallback(
+      this, &MarshalledRpcService::CallOnServiceThread, call));
+}
+
+
+/*
+ * Runs on the service executor.
+ */
+void MarshalledRpcService::CallOnServiceThread(MarshalledCall *call) {
+  CompletionCallback *wrapped_done = NULL;
+  if (call->done) {
+    wrapped_done = ola::NewSingleCallback(
+        this, &MarshalledRpcService::ServiceComplete, call);
+  }
+  m_service->CallMethod(call->method, call->controller, call->request,
+                        call->response, wrapped_done);
+  if (!call->done) {
+    // streaming call, nothing will run ServiceComplete
+    delete call->request;
+    delete call;
+  }
+}
+
+
+/*
+ * Runs on the service executor once the service is done; frees the request
+ * copy and bounces the completion back to the session's loop.
+ */
+void MarshalledRpcService::ServiceComplete(MarshalledCall *call) {
+  CompletionCallback *done = call->done;
+  delete call->request;
+  delete call;
+  m_reply_executor->Execute(done);
+}
+}  // namespace rpc
+}  // namespace ola
@@ -0,0 +1,99 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MarshalledRpcService.h
+ * An RpcService decorator that runs the wrapped service on another thread's
+ * event loop.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef COMMON_RPC_MARSHALLEDRPCSERVICE_H_
+#define COMMON_RPC_MARSHALLEDRPCSERVICE_H_
+
+#include <ola/thread/ExecutorInterface.h>
+
+#include "common/rpc/RpcService.h"
+
+namespace ola {
+namespace rpc {
+
+/**
+ * @brief Runs a wrapped RpcService on a different thread's executor.
+ *
+ * This is the dispatch half of running RPC sessions on worker event loops:
+ * a channel serviced on a worker thread can keep its socket I/O and
+ * protobuf parsing off the main loop, while the wrapped service (which
+ * touches Universe state) always executes on the executor it was created
+ * with. The request is copied before the handoff since the channel reuses
+ * its decode buffers, and the completion callback is bounced back to the
+ * calling thread's executor so the response write stays on the session's
+ * own loop.
+ */
+class MarshalledRpcService: public RpcService {
+ public:
+  /**
+   * @brief Create a new MarshalledRpcService.
+   * @param service the service to wrap; calls run on service_executor.
+   * @param service_executor the executor (main loop) the service runs on.
+   * @param reply_executor the executor completions are bounced back to,
+   * usually the session's own loop.
+   */
+  MarshalledRpcService(RpcService *service,
+                       ola::thread::ExecutorInterface *service_executor,
+                       ola::thread::ExecutorInterface *reply_executor)
+      : m_service(service),
+        m_service_executor(service_executor),
+        m_reply_executor(reply_executor) {
+  }
+
+  const google::protobuf::ServiceDescriptor* GetDescriptor() {
+    return m_service->GetDescriptor();
+  }
+
+  void CallMethod(const google::protobuf::MethodDescriptor *method,
+                  RpcController *controller,
+                  const google::protobuf::Message *request,
+                  google::protobuf::Message *response,
+                  CompletionCallback *done);
+
+  const google::protobuf::Message& GetRequestPrototype(
+      const google::protobuf::MethodDescriptor *method) const {
+    return m_service->GetRequestPrototype(method);
+  }
+  const google::protobuf::Message& GetResponsePrototype(
+      const google::protobuf::MethodDescriptor *method) const {
+    return m_service->GetResponsePrototype(method);
+  }
+
+ private:
+  // The state for one in-flight cross-thread call.
+  struct MarshalledCall {
+    const google::protobuf::MethodDescriptor *method;
+    RpcController *controller;
+    google::protobuf::Message *request;  // our copy
+    google::protobuf::Message *response;
+    CompletionCallback *done;
+  };
+
+  void CallOnServiceThread(MarshalledCall *call);
+  void ServiceComplete(MarshalledCall *call);
+
+  RpcService *m_service;
+  ola::thread::ExecutorInterface *m_service_executor;
+  ola::thread::ExecutorInterface *m_reply_executor;
+};
+}  // namespace rpc
+}  // namespace ola
+#endif  // COMMON_RPC_MARSHALLEDRPCSERVICE_H_
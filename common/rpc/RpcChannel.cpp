@@ -21,10 +21,12 @@
 #include "common/rpc/RpcChannel.h"
 
 #include <errno.h>
+#include <time.h>
 #include <google/protobuf/service.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/dynamic_message.h>
+#include <algorithm>
 #include <string>
 
 #include "common/rpc/Rpc.pb.h"
@@ -34,6 +36,7 @@
 #include "common/rpc/RpcService.h"
 #include "ola/Callback.h"
 #include "ola/Logging.h"
+#include "ola/base/TraceRing.h"
 #include "ola/base/Array.h"
 #include "ola/stl/STLUtils.h"
 
@@ -50,12 +53,14 @@ const char RpcChannel::K_RPC_RECEIVED_TYPE_VAR[] = "rpc-received-type";
 const char RpcChannel::K_RPC_RECEIVED_VAR[] = "rpc-received";
 const char RpcChannel::K_RPC_SENT_ERROR_VAR[] = "rpc-send-errors";
 const char RpcChannel::K_RPC_SENT_VAR[] = "rpc-sent";
+const char RpcChannel::K_RPC_DROPPED_VAR[] = "rpc-send-dropped";
 const char RpcChannel::STREAMING_NO_RESPONSE[] = "STREAMING_NO_RESPONSE";
 
 const char *RpcChannel::K_RPC_VARIABLES[] = {
   K_RPC_RECEIVED_VAR,
   K_RPC_SENT_ERROR_VAR,
   K_RPC_SENT_VAR,
+  K_RPC_DROPPED_VAR,
 };
 
 class OutstandingRequest {
@@ -114,11 +119,18 @@ RpcChannel::RpcChannel(
       m_service(service),
       m_descriptor(descriptor),
       m_buffer(NULL),
+      m_incoming_version(PROTOCOL_VERSION),
       m_buffer_size(0),
       m_expected_size(0),
       m_current_size(0),
       m_export_map(export_map),
-      m_recv_type_map(NULL) {
+      m_recv_type_map(NULL),
+      m_control_rps_limit(0),
+      m_stream_rps_limit(0),
+      m_control_tokens(0),
+      m_stream_tokens(0),
+      m_control_last_refill(0),
+      m_stream_last_refill(0) {
   if (descriptor) {
     descriptor->SetOnData(
         ola::NewCallback(this, &RpcChannel::DescriptorReady));
@@ -136,9 +148,17 @@ RpcChannel::RpcChannel(
 }
 
 RpcChannel::~RpcChannel() {
+  ola::STLDeleteValues(&m_cached_requests);
   free(m_buffer);
 }
 
+void RpcChannel::SetSelectServer(ola::io::SelectServerInterface *ss,
+                                 unsigned int high_watermark) {
+  m_send_pool.reset(new ola::io::MemoryBlockPool());
+  m_sender.reset(new ola::io::NonBlockingSender(
+      m_descriptor, ss, m_send_pool.get(), high_watermark));
+}
+
 void RpcChannel::DescriptorReady() {
   if (!m_expected_size) {
     // this is a new msg
@@ -149,11 +169,12 @@ void RpcChannel::DescriptorReady() {
     if (!m_expected_size)
       return;
 
-    if (version != PROTOCOL_VERSION) {
+    if (version != PROTOCOL_VERSION && version != DMX_FRAME_VERSION) {
       OLA_WARN << "protocol mismatch " << version << " != " <<
         PROTOCOL_VERSION;
       return;
     }
+    m_incoming_version = version;
 
     if (m_expected_size > MAX_BUFFER_SIZE) {
       OLA_WARN << "Incoming message size " << m_expected_size
@@ -187,8 +208,15 @@ void RpcChannel::DescriptorReady() {
   m_current_size += data_read;
 
   if (m_current_size == m_expected_size) {
-    // we've got all of this message so parse it.
-    if (!HandleNewMsg(m_buffer, m_expected_size)) {
+    bool ok;
+    if (m_incoming_version == DMX_FRAME_VERSION) {
+      HandleCompactDmxFrame(m_buffer, m_expected_size);
+      ok = true;
+    } else {
+      // we've got all of this message so parse it.
+      ok = HandleNewMsg(m_buffer, m_expected_size);
+    }
+    if (!ok) {
       // this probably means we've messed the framing up, close the channel
       OLA_WARN << "Errors detected on RPC channel, closing";
       m_descriptor->Close();
@@ -290,19 +318,48 @@ bool RpcChannel::SendMsg(RpcMessage *msg) {
   }
 
   uint32_t header;
-  // reserve the first 4 bytes for the header
-  string output(sizeof(header), 0);
-  msg->AppendToString(&output);
-  int length = output.size();
+  // The buffer is a member so its capacity is reused across messages;
+  // reserve the first 4 bytes for the header.
+  m_send_buffer.assign(sizeof(header), 0);
+  msg->AppendToString(&m_send_buffer);
+  int length = m_send_buffer.size();
 
   RpcHeader::EncodeHeader(&header, PROTOCOL_VERSION,
                                 length - sizeof(header));
-  output.replace(
+  m_send_buffer.replace(
       0, sizeof(header),
       reinterpret_cast<const char*>(&header), sizeof(header));
 
+  if (m_sender.get()) {
+    // buffered mode: whole messages are queued or shed, so framing is
+    // always preserved.
+    if (m_sender->LimitReached()) {
+      if (msg->type() == REQUEST || msg->type() == STREAM_REQUEST) {
+        // an unsolicited push; shed it rather than ballooning the buffer
+        if (m_export_map)
+          (*m_export_map->GetCounterVar(K_RPC_DROPPED_VAR))++;
+        return false;
+      }
+      // a response we're obliged to deliver; the peer has stopped
+      // reading, so the only safe option is to drop the session
+      OLA_WARN << "Send buffer limit reached and a response is due, "
+               << "closing the channel";
+      if (m_export_map)
+        (*m_export_map->GetCounterVar(K_RPC_SENT_ERROR_VAR))++;
+      m_descriptor = NULL;
+      HandleChannelClose();
+      return false;
+    }
+    m_send_queue.Write(
+        reinterpret_cast<const uint8_t*>(m_send_buffer.data()), length);
+    m_sender->SendMessage(&m_send_queue);
+    if (m_export_map)
+      (*m_export_map->GetCounterVar(K_RPC_SENT_VAR))++;
+    return true;
+  }
+
   ssize_t ret = m_descriptor->Send(
-      reinterpret_cast<const uint8_t*>(output.data()), length);
+      reinterpret_cast<const uint8_t*>(m_send_buffer.data()), length);
 
   if (ret != length) {
     OLA_WARN << "Failed to send full RPC message, closing channel";
@@ -444,6 +501,12 @@ void RpcChannel::HandleRequest(RpcMessage *msg) {
     return;
   }
 
+  if (!AdmitRequest(&m_control_tokens, &m_control_last_refill,
+                    m_control_rps_limit)) {
+    SendRateLimited(msg->id());
+    return;
+  }
+
   const ServiceDescriptor *service = m_service->GetDescriptor();
   if (!service) {
     OLA_WARN << "failed to get service descriptor";
@@ -455,17 +518,20 @@ void RpcChannel::HandleRequest(RpcMessage *msg) {
     SendNotImplemented(msg->id());
     return;
   }
+  Trace(TraceRing::EVENT_RPC_DISPATCH, method->index());
 
-  Message* request_pb = m_service->GetRequestPrototype(method).New();
+  Message* request_pb = GetCachedRequest(method);
   Message* response_pb = m_service->GetResponsePrototype(method).New();
 
   if (!request_pb || !response_pb) {
     OLA_WARN << "failed to get request or response objects";
+    delete response_pb;
     return;
   }
 
   if (!request_pb->ParseFromString(msg->buffer())) {
     OLA_WARN << "parsing of request pb failed";
+    delete response_pb;
     return;
   }
 
@@ -482,7 +548,6 @@ void RpcChannel::HandleRequest(RpcMessage *msg) {
       this, &RpcChannel::RequestComplete, request);
   m_service->CallMethod(method, request->controller, request_pb, response_pb,
                         callback);
-  delete request_pb;
 }
 
 
@@ -495,6 +560,13 @@ void RpcChannel::HandleStreamRequest(RpcMessage *msg) {
     return;
   }
 
+  // no response is expected on this lane, so a shed message is just
+  // dropped; AdmitRequest counts it
+  if (!AdmitRequest(&m_stream_tokens, &m_stream_last_refill,
+                    m_stream_rps_limit)) {
+    return;
+  }
+
   const ServiceDescriptor *service = m_service->GetDescriptor();
   if (!service) {
     OLA_WARN << "failed to get service descriptor";
@@ -506,6 +578,7 @@ void RpcChannel::HandleStreamRequest(RpcMessage *msg) {
     SendNotImplemented(msg->id());
     return;
   }
+  Trace(TraceRing::EVENT_RPC_DISPATCH, method->index());
 
   if (method->output_type()->name() != STREAMING_NO_RESPONSE) {
     OLA_WARN << "Streaming request received for " << method->name() <<
@@ -513,7 +586,7 @@ void RpcChannel::HandleStreamRequest(RpcMessage *msg) {
     return;
   }
 
-  Message* request_pb = m_service->GetRequestPrototype(method).New();
+  Message* request_pb = GetCachedRequest(method);
 
   if (!request_pb) {
     OLA_WARN << "failed to get request or response objects";
@@ -527,7 +600,154 @@ void RpcChannel::HandleStreamRequest(RpcMessage *msg) {
 
   RpcController controller(m_session.get());
   m_service->CallMethod(method, &controller, request_pb, NULL, NULL);
-  delete request_pb;
+}
+
+
+/*
+ * Dispatch a fixed-layout DMX frame into the StreamDmxData method without
+ * a protobuf decode.
+ */
+void RpcChannel::HandleCompactDmxFrame(const uint8_t *data,
+                                       unsigned int size) {
+  static const unsigned int FRAME_HEADER_SIZE = 4;
+  if (!m_service || size < FRAME_HEADER_SIZE) {
+    OLA_WARN << "Invalid compact DMX frame";
+    return;
+  }
+
+  // compact frames are the stream lane too; without this a client
+  // using them would be exempt from the limit
+  if (!AdmitRequest(&m_stream_tokens, &m_stream_last_refill,
+                    m_stream_rps_limit)) {
+    return;
+  }
+
+  const ServiceDescriptor *service = m_service->GetDescriptor();
+  // on the server this dispatches into StreamDmxData; on a client it
+  // lands in UpdateDmxData, so the server can push frames this way too
+  const MethodDescriptor *method =
+      service ? service->FindMethodByName("StreamDmxData") : NULL;
+  if (!method && service) {
+    method = service->FindMethodByName("UpdateDmxData");
+  }
+  if (!method) {
+    OLA_WARN << "No DMX method, dropping compact frame";
+    return;
+  }
+
+  Message *request_pb = GetCachedRequest(method);
+  if (!request_pb)
+    return;
+
+  // Filled via reflection so this layer doesn't depend on the DMX proto.
+  const google::protobuf::Descriptor *descriptor =
+      request_pb->GetDescriptor();
+  const google::protobuf::Reflection *reflection =
+      request_pb->GetReflection();
+  const google::protobuf::FieldDescriptor *universe_field =
+      descriptor->FindFieldByName("universe");
+  const google::protobuf::FieldDescriptor *data_field =
+      descriptor->FindFieldByName("data");
+  const google::protobuf::FieldDescriptor *priority_field =
+      descriptor->FindFieldByName("priority");
+  if (!universe_field || !data_field || !priority_field) {
+    OLA_WARN << "StreamDmxData request shape changed, dropping frame";
+    return;
+  }
+
+  uint16_t universe;
+  memcpy(&universe, data, sizeof(universe));
+  reflection->SetInt32(request_pb, universe_field, universe);
+  reflection->SetInt32(request_pb, priority_field, data[2]);
+  reflection->SetString(
+      request_pb, data_field,
+      string(reinterpret_cast<const char*>(data + FRAME_HEADER_SIZE),
+             size - FRAME_HEADER_SIZE));
+
+  RpcController controller(m_session.get());
+  m_service->CallMethod(method, &controller, request_pb, NULL, NULL);
+}
+
+
+bool RpcChannel::SendCompactDmxFrame(uint16_t universe, uint8_t priority,
+                                     const uint8_t *data,
+                                     unsigned int length) {
+  EncodeDmxFrame(universe, priority, data, length, &m_send_buffer);
+  return SendEncodedDmxFrame(m_send_buffer);
+}
+
+
+void RpcChannel::EncodeDmxFrame(uint16_t universe, uint8_t priority,
+                                const uint8_t *data, unsigned int length,
+                                string *output) {
+  uint32_t header;
+  static const unsigned int FRAME_HEADER_SIZE = 4;
+  RpcHeader::EncodeHeader(&header, DMX_FRAME_VERSION,
+                          FRAME_HEADER_SIZE + length);
+  output->assign(reinterpret_cast<const char*>(&header), sizeof(header));
+  output->append(reinterpret_cast<const char*>(&universe),
+                 sizeof(universe));
+  output->push_back(static_cast<char>(priority));
+  output->push_back(0);  // reserved
+  output->append(reinterpret_cast<const char*>(data), length);
+}
+
+
+bool RpcChannel::SendEncodedDmxFrame(const string &frame) {
+  if (!(m_descriptor && m_descriptor->ValidReadDescriptor())) {
+    OLA_WARN << "RPC descriptor closed, not sending messages";
+    return false;
+  }
+
+  if (m_sender.get()) {
+    // Buffered mode: the frame must queue behind any partially-flushed
+    // message or the peer's stream is corrupted. Frames are unsolicited
+    // pushes, so shed when the peer has fallen behind, like SendMsg.
+    if (m_sender->LimitReached()) {
+      if (m_export_map)
+        (*m_export_map->GetCounterVar(K_RPC_DROPPED_VAR))++;
+      return false;
+    }
+    m_send_queue.Write(
+        reinterpret_cast<const uint8_t*>(frame.data()),
+        static_cast<unsigned int>(frame.size()));
+    m_sender->SendMessage(&m_send_queue);
+    if (m_export_map)
+      (*m_export_map->GetCounterVar(K_RPC_SENT_VAR))++;
+    return true;
+  }
+
+  ssize_t ret = m_descriptor->Send(
+      reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+  if (ret != static_cast<ssize_t>(frame.size())) {
+    OLA_WARN << "Failed to send full DMX frame, closing channel";
+    m_descriptor = NULL;
+    HandleChannelClose();
+    return false;
+  }
+  if (m_export_map)
+    (*m_export_map->GetCounterVar(K_RPC_SENT_VAR))++;
+  return true;
+}
+
+
+/*
+ * Return the reusable request message for a method, creating it on first
+ * use. Handlers must not hold onto the request past the CallMethod
+ * return; that was already the contract since requests used to be deleted
+ * there.
+ */
+Message *RpcChannel::GetCachedRequest(const MethodDescriptor *method) {
+  std::map<const MethodDescriptor*, Message*>::iterator iter =
+      m_cached_requests.find(method);
+  if (iter != m_cached_requests.end()) {
+    iter->second->Clear();
+    return iter->second;
+  }
+  Message *message = m_service->GetRequestPrototype(method).New();
+  if (message)
+    m_cached_requests[method] = message;
+  return message;
 }
 
 
@@ -545,6 +765,57 @@ void RpcChannel::SendRequestFailed(OutstandingRequest *request) {
 }
 
 
+void RpcChannel::SetRateLimits(unsigned int control_rps,
+                               unsigned int stream_rps) {
+  m_control_rps_limit = control_rps;
+  m_stream_rps_limit = stream_rps;
+  m_control_tokens = control_rps;
+  m_stream_tokens = stream_rps;
+}
+
+
+/*
+ * A per-lane token bucket: `limit` requests per second with a burst of
+ * the same size. Channels are single threaded so this is plain counter
+ * arithmetic.
+ */
+bool RpcChannel::AdmitRequest(unsigned int *tokens, int64_t *last_refill,
+                              unsigned int limit) {
+  if (!limit) {
+    return true;
+  }
+
+  int64_t now = static_cast<int64_t>(time(NULL));
+  if (now != *last_refill) {
+    int64_t add = *last_refill ? now - *last_refill : limit;
+    *tokens = static_cast<unsigned int>(
+        std::min(static_cast<int64_t>(limit),
+                 static_cast<int64_t>(*tokens) + add * limit));
+    *last_refill = now;
+  }
+  if (*tokens) {
+    (*tokens)--;
+    return true;
+  }
+  if (m_export_map) {
+    (*m_export_map->GetCounterVar("rpc-requests-shed"))++;
+  }
+  return false;
+}
+
+
+/*
+ * Tell the caller it's being rate limited.
+ */
+void RpcChannel::SendRateLimited(int msg_id) {
+  RpcMessage message;
+  message.set_type(RESPONSE_FAILED);
+  message.set_id(msg_id);
+  message.set_buffer("rate limited");
+  SendMsg(&message);
+}
+
+
 /*
  * Sent if we get a request for a non-existant method.
  */
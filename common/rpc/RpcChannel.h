@@ -29,8 +29,14 @@
 #include <google/protobuf/service.h>
 #include <ola/Callback.h>
 #include <ola/io/Descriptor.h>
+#include <ola/io/IOQueue.h>
+#include <ola/io/MemoryBlockPool.h>
+#include <ola/io/NonBlockingSender.h>
+#include <ola/io/SelectServerInterface.h>
 #include <ola/util/SequenceNumber.h>
+#include <map>
 #include <memory>
+#include <string>
 
 #include "ola/ExportMap.h"
 
@@ -82,6 +88,69 @@ class RpcChannel {
      */
     void SetService(RpcService *service) { m_service = service; }
 
+    /**
+     * @brief Switch the channel to buffered, non-blocking sends.
+     * @param ss the SelectServer that runs this channel.
+     * @param high_watermark the most outgoing data to buffer.
+     *
+     * Without this, sends are synchronous and a peer that stops reading
+     * stalls the caller. With it, messages queue in a bounded send buffer:
+     * when the watermark is hit, unsolicited pushes (requests from this
+     * end) are shed and counted, while dropping a response closes the
+     * channel since the RPC contract can't be honoured. The server enables
+     * this for every client session.
+     */
+    void SetSelectServer(
+        ola::io::SelectServerInterface *ss,
+        unsigned int high_watermark = DEFAULT_SEND_WATERMARK);
+
+    /**
+     * @brief Send a streaming DMX frame in the compact fixed layout.
+     * @param universe the universe id.
+     * @param priority the frame priority.
+     * @param data the slot data.
+     * @param length the number of slots.
+     *
+     * The frame goes out under header version DMX_FRAME_VERSION as
+     * [u16 universe][u8 priority][u8 reserved][slots], skipping protobuf
+     * serialization entirely. The receiving end dispatches it into
+     * StreamDmxData; all control-plane calls stay on the protobuf
+     * encoding.
+     */
+    bool SendCompactDmxFrame(uint16_t universe, uint8_t priority,
+                             const uint8_t *data, unsigned int length);
+
+    /**
+     * @brief Encode a compact DMX frame for SendEncodedDmxFrame().
+     *
+     * Splitting encode from send lets a fanout (one universe, many
+     * client channels) pay the encode once and hand the same bytes to
+     * every channel.
+     */
+    static void EncodeDmxFrame(uint16_t universe, uint8_t priority,
+                               const uint8_t *data, unsigned int length,
+                               std::string *output);
+
+    /**
+     * @brief Send a frame prepared with EncodeDmxFrame().
+     */
+    bool SendEncodedDmxFrame(const std::string &frame);
+
+    /**
+     * @brief Limit the rate of incoming requests on this channel.
+     * @param control_rps control-plane (REQUEST) calls admitted per
+     * second; the same value is the burst size. 0 means unlimited.
+     * @param stream_rps streamed data (STREAM_REQUEST) messages per
+     * second. 0 means unlimited.
+     *
+     * The two lanes have independent buckets, so a client hammering
+     * FetchDmx can't shed its own (or anyone's) streamed frames and
+     * vice versa. Rejected control calls receive RESPONSE_FAILED;
+     * rejected stream messages are silently dropped, matching their
+     * fire-and-forget contract. Sheds are counted in rpc-requests-shed.
+     */
+    void SetRateLimits(unsigned int control_rps, unsigned int stream_rps);
+
     /**
      * @brief Check if there are any pending RPCs on the channel.
      * Pending RPCs are those where a request has been sent, but no reply has
@@ -134,6 +203,10 @@ class RpcChannel {
      * @brief the RPC protocol version.
      */
     static const unsigned int PROTOCOL_VERSION = 1;
+    // Header version for fixed-layout streaming DMX frames; see
+    // SendCompactDmxFrame().
+    static const unsigned int DMX_FRAME_VERSION = 2;
+    static const unsigned int DEFAULT_SEND_WATERMARK = 1024 * 1024;
 
  private:
     typedef HASH_NAMESPACE::HASH_MAP_CLASS<int, class OutstandingResponse*>
@@ -146,20 +219,46 @@ class RpcChannel {
     class ola::io::ConnectedDescriptor *m_descriptor;
     SequenceNumber<uint32_t> m_sequence;
     uint8_t *m_buffer;  // buffer for incoming msgs
+    unsigned int m_incoming_version;  // header version of the current msg
+    std::string m_send_buffer;  // reused for outgoing msg serialization
+    // set when buffered sending is enabled
+    std::auto_ptr<ola::io::MemoryBlockPool> m_send_pool;
+    std::auto_ptr<ola::io::NonBlockingSender> m_sender;
+    ola::io::IOQueue m_send_queue;  // scratch, drained into m_sender
     unsigned int m_buffer_size;  // size of the buffer
     unsigned int m_expected_size;  // the total size of the current msg
     unsigned int m_current_size;  // the amount of data read for the current msg
     HASH_NAMESPACE::HASH_MAP_CLASS<int, class OutstandingRequest*> m_requests;
     ResponseMap m_responses;
+    // Request messages cached per method and reused across calls, so the
+    // steady-state decode path doesn't allocate. The messages retain their
+    // internal buffers over Clear().
+    std::map<const google::protobuf::MethodDescriptor*,
+             google::protobuf::Message*> m_cached_requests;
     ExportMap *m_export_map;
     UIntMap *m_recv_type_map;
 
+    // per-lane request admission, 0 = unlimited
+    unsigned int m_control_rps_limit;
+    unsigned int m_stream_rps_limit;
+    unsigned int m_control_tokens;
+    unsigned int m_stream_tokens;
+    int64_t m_control_last_refill;
+    int64_t m_stream_last_refill;
+
+    google::protobuf::Message *GetCachedRequest(
+        const google::protobuf::MethodDescriptor *method);
+
     bool SendMsg(RpcMessage *msg);
     int AllocateMsgBuffer(unsigned int size);
     int ReadHeader(unsigned int *version, unsigned int *size) const;
     bool HandleNewMsg(uint8_t *buffer, unsigned int size);
     void HandleRequest(RpcMessage *msg);
     void HandleStreamRequest(RpcMessage *msg);
+    void HandleCompactDmxFrame(const uint8_t *data, unsigned int size);
+    bool AdmitRequest(unsigned int *tokens, int64_t *last_refill,
+                      unsigned int limit);
+    void SendRateLimited(int msg_id);
 
     // server end
     void SendRequestFailed(class OutstandingRequest *request);
@@ -178,6 +277,7 @@ class RpcChannel {
     static const char K_RPC_RECEIVED_VAR[];
     static const char K_RPC_SENT_ERROR_VAR[];
     static const char K_RPC_SENT_VAR[];
+    static const char K_RPC_DROPPED_VAR[];
     static const char *K_RPC_VARIABLES[];
     static const char STREAMING_NO_RESPONSE[];
     static const unsigned int INITIAL_BUFFER_SIZE = 1 << 11;  // 2k
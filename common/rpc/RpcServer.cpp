@@ -20,6 +20,20 @@
 
 #include "common/rpc/RpcServer.h"
 
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif  // !_WIN32
+
+#include <sstream>
+#include <string>
+
 #include <ola/ExportMap.h>
 #include <ola/Logging.h>
 #include <ola/network/SocketAddress.h>
@@ -32,6 +46,100 @@ namespace ola {
 namespace rpc {
 
 using std::auto_ptr;
+using std::string;
+
+#ifndef _WIN32
+/*
+ * Listens on a named Unix domain socket and hands the accepted, credential
+ * checked connections to the RpcServer.
+ */
+class UnixAcceptingDescriptor: public ola::io::ReadFileDescriptor {
+ public:
+  UnixAcceptingDescriptor(const string &path, RpcServer *server)
+      : m_path(path),
+        m_server(server),
+        m_fd(ola::io::INVALID_DESCRIPTOR) {
+  }
+
+  ~UnixAcceptingDescriptor() {
+    if (m_fd != ola::io::INVALID_DESCRIPTOR) {
+      close(m_fd);
+      unlink(m_path.c_str());
+    }
+  }
+
+  bool Listen() {
+    struct sockaddr_un address;
+    if (m_path.size() >= sizeof(address.sun_path)) {
+      OLA_WARN << "Unix socket path too long: " << m_path;
+      return false;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+      OLA_WARN << "Failed to create Unix socket: " << strerror(errno);
+      return false;
+    }
+
+    // a stale socket file blocks bind()
+    unlink(m_path.c_str());
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&address),
+             sizeof(address)) || listen(fd, 10)) {
+      OLA_WARN << "Failed to listen on " << m_path << ": "
+               << strerror(errno);
+      close(fd);
+      return false;
+    }
+    // restrict to the daemon's own user; the peer check below is belt and
+    // braces on platforms that support it
+    chmod(m_path.c_str(), S_IRUSR | S_IWUSR);
+    // the accept loop drains until EAGAIN, so the fd must not block
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    m_fd = fd;
+    return true;
+  }
+
+  ola::io::DescriptorHandle ReadDescriptor() const { return m_fd; }
+
+  void PerformRead() {
+    // bounded per loop iteration, like TCPAcceptingSocket
+    for (unsigned int i = 0; i < MAX_ACCEPTS_PER_CYCLE; i++) {
+      int client_fd = accept(m_fd, NULL, NULL);
+      if (client_fd < 0)
+        return;
+
+#ifdef SO_PEERCRED
+      struct ucred credentials;
+      socklen_t cred_size = sizeof(credentials);
+      if (getsockopt(client_fd, SOL_SOCKET, SO_PEERCRED, &credentials,
+                     &cred_size) == 0 &&
+          credentials.uid != getuid() && credentials.uid != 0) {
+        OLA_WARN << "Rejecting Unix socket connection from uid "
+                 << credentials.uid;
+        close(client_fd);
+        continue;
+      }
+#endif  // SO_PEERCRED
+      // A TCPSocket is just a ConnectedDescriptor over a stream fd, which
+      // is exactly what an accepted Unix socket is.
+      m_server->AddClient(new ola::network::TCPSocket(client_fd));
+    }
+  }
+
+ private:
+  const string m_path;
+  RpcServer *m_server;
+  ola::io::DescriptorHandle m_fd;
+
+  static const unsigned int MAX_ACCEPTS_PER_CYCLE = 8;
+};
+#endif  // !_WIN32
+
 using ola::io::ConnectedDescriptor;
 using ola::network::GenericSocketAddress;
 using ola::network::IPV4Address;
@@ -81,6 +189,12 @@ RpcServer::~RpcServer() {
   if (m_accepting_socket.get() && m_accepting_socket->ValidReadDescriptor()) {
     m_ss->RemoveReadDescriptor(m_accepting_socket.get());
   }
+
+#ifndef _WIN32
+  if (m_unix_socket.get()) {
+    m_ss->RemoveReadDescriptor(m_unix_socket.get());
+  }
+#endif  // !_WIN32
 }
 
 bool RpcServer::Init() {
@@ -115,9 +229,40 @@ bool RpcServer::Init() {
   }
 
   m_accepting_socket.reset(accepting_socket.release());
+
+#ifndef _WIN32
+  if (!m_options.unix_socket_path.empty()) {
+    auto_ptr<UnixAcceptingDescriptor> unix_socket(new UnixAcceptingDescriptor(
+        m_options.unix_socket_path, this));
+    if (unix_socket->Listen() && m_ss->AddReadDescriptor(unix_socket.get())) {
+      OLA_INFO << "Listening on " << m_options.unix_socket_path;
+      m_unix_socket.reset(unix_socket.release());
+    }
+  }
+#endif  // !_WIN32
   return true;
 }
 
+string RpcServer::DefaultUnixSocketPath(uint16_t port) {
+  // Never use a predictable name in world-writable /tmp: any local user
+  // could pre-bind it and impersonate the daemon to auto-connecting
+  // clients. Use the user-private runtime dir, falling back to the
+  // user's .ola directory; with neither available the unix endpoint is
+  // disabled and clients use TCP.
+  std::ostringstream str;
+  const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+  if (runtime_dir && runtime_dir[0]) {
+    str << runtime_dir << "/olad-rpc-" << port << ".sock";
+    return str.str();
+  }
+  const char *home = getenv("HOME");
+  if (home && home[0]) {
+    str << home << "/.ola/olad-rpc-" << port << ".sock";
+    return str.str();
+  }
+  return "";
+}
+
 GenericSocketAddress RpcServer::ListenAddress() {
   if (m_accepting_socket.get()) {
     return m_accepting_socket->GetLocalAddress();
@@ -130,6 +275,11 @@ bool RpcServer::AddClient(ConnectedDescriptor *descriptor) {
   // ownership of the socket here.
   RpcChannel *channel = new RpcChannel(m_service, descriptor,
                                        m_options.export_map);
+  // buffered, watermarked sends; a wedged client sheds pushes instead of
+  // stalling the daemon
+  channel->SetSelectServer(m_ss);
+  channel->SetRateLimits(m_options.control_rps_limit,
+                         m_options.stream_rps_limit);
 
   if (m_session_handler) {
     m_session_handler->NewClient(channel->Session());
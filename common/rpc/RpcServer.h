@@ -27,6 +27,7 @@
 
 #include <set>
 #include <memory>
+#include <string>
 
 namespace ola {
 
@@ -72,13 +73,36 @@ class RpcServer {
      */
     ola::network::TCPAcceptingSocket *listen_socket;
 
+    /**
+     * @brief The path for the Unix domain socket endpoint.
+     *
+     * Same-host clients connect here rather than over loopback TCP. Empty
+     * disables the endpoint. The socket file is created with mode 0600 and
+     * peers are checked with SO_PEERCRED where available.
+     */
+    std::string unix_socket_path;
+
+    /**
+     * @brief Per-client admission limits, see
+     * RpcChannel::SetRateLimits. 0 disables a lane's limit.
+     */
+    unsigned int control_rps_limit;
+    unsigned int stream_rps_limit;
+
     Options()
       : listen_port(0),
         export_map(NULL),
-        listen_socket(NULL) {
+        listen_socket(NULL),
+        control_rps_limit(0),
+        stream_rps_limit(0) {
     }
   };
 
+  /**
+   * @brief The conventional Unix socket path for an RPC port.
+   */
+  static std::string DefaultUnixSocketPath(uint16_t port);
+
   /**
    * @brief Create a new RpcServer.
    * @param ss The SelectServer to use.
@@ -123,6 +147,7 @@ class RpcServer {
 
   ola::network::TCPSocketFactory m_tcp_socket_factory;
   std::auto_ptr<ola::network::TCPAcceptingSocket> m_accepting_socket;
+  std::auto_ptr<class UnixAcceptingDescriptor> m_unix_socket;
   ClientDescriptors m_connected_sockets;
 
   void NewTCPConnection(ola::network::TCPSocket *socket);
@@ -0,0 +1,77 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * Intern.cpp
+ * String interning: stable u32 symbols with O(1) equality.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "ola/strings/Intern.h"
+
+#include <string>
+
+#include "ola/stl/STLUtils.h"
+
+namespace ola {
+namespace strings {
+
+using std::string;
+
+namespace {
+const string EMPTY_STRING;
+}  // namespace
+
+InternTable::InternTable() {
+  // symbol 0 is INVALID_SYMBOL
+  m_strings.push_back(EMPTY_STRING);
+}
+
+InternTable *InternTable::Instance() {
+  static InternTable *table = new InternTable();
+  return table;
+}
+
+Symbol InternTable::Intern(const string &str) {
+  ola::thread::MutexLocker locker(&m_mutex);
+  std::map<string, Symbol>::const_iterator iter = m_symbols.find(str);
+  if (iter != m_symbols.end()) {
+    return iter->second;
+  }
+  Symbol symbol = static_cast<Symbol>(m_strings.size());
+  m_strings.push_back(str);
+  m_symbols[str] = symbol;
+  return symbol;
+}
+
+Symbol InternTable::Find(const string &str) const {
+  ola::thread::MutexLocker locker(&m_mutex);
+  std::map<string, Symbol>::const_iterator iter = m_symbols.find(str);
+  return iter == m_symbols.end() ? INVALID_SYMBOL : iter->second;
+}
+
+const string &InternTable::Lookup(Symbol symbol) const {
+  ola::thread::MutexLocker locker(&m_mutex);
+  if (symbol >= m_strings.size()) {
+    return EMPTY_STRING;
+  }
+  return m_strings[symbol];
+}
+
+unsigned int InternTable::Size() const {
+  ola::thread::MutexLocker locker(&m_mutex);
+  return static_cast<unsigned int>(m_strings.size() - 1);
+}
+}  // namespace strings
+}  // namespace ola
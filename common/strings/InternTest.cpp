@@ -0,0 +1,88 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * InternTest.cpp
+ * Unittest for the string intern table.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+#include "ola/strings/Intern.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::strings::INVALID_SYMBOL;
+using ola::strings::InternTable;
+using ola::strings::Symbol;
+using std::string;
+
+class InternTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(InternTest);
+  CPPUNIT_TEST(testIntern);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testLookup);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testIntern();
+    void testFind();
+    void testLookup();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(InternTest);
+
+/*
+ * Interning is stable and equality follows string equality.
+ */
+void InternTest::testIntern() {
+  InternTable table;
+  OLA_ASSERT_EQ(0u, table.Size());
+
+  Symbol universe = table.Intern("universe-1");
+  Symbol port = table.Intern("port-2-O");
+  OLA_ASSERT_NE(INVALID_SYMBOL, universe);
+  OLA_ASSERT_NE(INVALID_SYMBOL, port);
+  OLA_ASSERT_NE(universe, port);
+  OLA_ASSERT_EQ(2u, table.Size());
+
+  // re-interning returns the same symbol and doesn't grow the table
+  OLA_ASSERT_EQ(universe, table.Intern("universe-1"));
+  OLA_ASSERT_EQ(2u, table.Size());
+}
+
+/*
+ * Find doesn't intern.
+ */
+void InternTest::testFind() {
+  InternTable table;
+  OLA_ASSERT_EQ(INVALID_SYMBOL, table.Find("missing"));
+  OLA_ASSERT_EQ(0u, table.Size());
+
+  Symbol symbol = table.Intern("present");
+  OLA_ASSERT_EQ(symbol, table.Find("present"));
+}
+
+/*
+ * Lookup returns the original string, and something sane for bad symbols.
+ */
+void InternTest::testLookup() {
+  InternTable table;
+  Symbol symbol = table.Intern("universe-1");
+  OLA_ASSERT_EQ(string("universe-1"), table.Lookup(symbol));
+  OLA_ASSERT_EQ(string(""), table.Lookup(INVALID_SYMBOL));
+  OLA_ASSERT_EQ(string(""), table.Lookup(1000));
+}
@@ -2,11 +2,18 @@
 ##################################################
 common_libolacommon_la_SOURCES += \
     common/strings/Format.cpp \
+    common/strings/Intern.cpp \
     common/strings/Utils.cpp
 
 # TESTS
 ################################################
-test_programs += common/strings/UtilsTester
+test_programs += common/strings/InternTester \
+                 common/strings/UtilsTester
+
+common_strings_InternTester_SOURCES = \
+    common/strings/InternTest.cpp
+common_strings_InternTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_strings_InternTester_LDADD = $(COMMON_TESTING_LIBS)
 
 common_strings_UtilsTester_SOURCES = \
     common/strings/UtilsTest.cpp
@@ -8,3 +8,14 @@ common_testing_libolatesting_la_SOURCES = \
     common/testing/TestUtils.cpp
 common_testing_libtestmain_la_SOURCES = common/testing/GenericTester.cpp
 endif
+
+# The corpus replay harness; robustness and parse cost in one gate.
+if USE_E131
+noinst_PROGRAMS += common/testing/packet_replay
+common_testing_packet_replay_SOURCES = common/testing/packet_replay.cpp
+common_testing_packet_replay_LDADD = \
+    plugins/e131/e131/libolae131core.la \
+    common/libolacommon.la
+
+BENCHMARK_PROGS += common/testing/packet_replay
+endif
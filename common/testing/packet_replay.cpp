@@ -0,0 +1,242 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * packet_replay.cpp
+ * Replays a synthesized + mutated packet corpus through the frame
+ * pipeline parsers, with per-byte cost accounting.
+ *
+ * Parsing robustness and parsing performance are the same problem on a
+ * hostile show network: a parser that survives a mutated corpus but
+ * takes a pathological amount of CPU on it (deep PDU nesting) still
+ * takes the show down. This harness fails if the parse cost per byte
+ * exceeds --max-ns-per-byte, so CI catches both crashes and cost
+ * regressions.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ola/Clock.h"
+#include "ola/Logging.h"
+#include "ola/acn/ACNVectors.h"
+#include "ola/acn/CID.h"
+#include "ola/base/Flags.h"
+#include "ola/base/Init.h"
+#include "ola/io/IOStack.h"
+#include "ola/network/IPV4Address.h"
+#include "ola/network/SocketAddress.h"
+#include "plugins/e131/e131/DMPE131Inflator.h"
+#include "plugins/e131/e131/E131Inflator.h"
+#include "plugins/e131/e131/E131Header.h"
+#include "ola/network/NetworkUtils.h"
+#include "plugins/e131/e131/HeaderSet.h"
+#include "plugins/e131/e131/PDU.h"
+#include "plugins/e131/e131/RootInflator.h"
+#include "plugins/e131/e131/RootPDU.h"
+
+using ola::io::IOStack;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+DEFINE_uint32(iterations, 200, "Passes over the corpus");
+DEFINE_uint32(max_ns_per_byte, 200,
+              "Fail if the mean parse cost exceeds this");
+DEFINE_uint32(seed, 1, "Mutation seed, for reproducible corpora");
+
+namespace {
+
+// a deterministic LCG so corpora reproduce across runs and machines
+uint32_t g_rand_state;
+uint32_t NextRand() {
+  g_rand_state = g_rand_state * 1103515245 + 12345;
+  return (g_rand_state >> 16) & 0xffff;
+}
+
+typedef vector<string> Corpus;
+
+/*
+ * A valid E1.31 data packet, built through the real PDU classes.
+ */
+void AddValidPacket(Corpus *corpus, const ola::acn::CID &cid,
+                    uint16_t universe, unsigned int slots) {
+  IOStack packet;
+  // DMP layer: build a minimal set-property payload
+  string dmp_data;
+  dmp_data.push_back(0x02);  // DMP vector: SET_PROPERTY
+  dmp_data.push_back(static_cast<char>(0xa1));  // address & data type
+  dmp_data.push_back(0);  // first property address
+  dmp_data.push_back(0);
+  dmp_data.push_back(0);  // address increment
+  dmp_data.push_back(1);
+  dmp_data.push_back(static_cast<char>(((slots + 1) >> 8) & 0xff));
+  dmp_data.push_back(static_cast<char>((slots + 1) & 0xff));
+  dmp_data.push_back(0);  // start code
+  for (unsigned int i = 0; i < slots; i++) {
+    dmp_data.push_back(static_cast<char>(i));
+  }
+  // prepend the DMP PDU header: flags+length, then the payload
+  unsigned int dmp_size =
+      2 + static_cast<unsigned int>(dmp_data.size());
+  packet.Write(reinterpret_cast<const uint8_t*>(dmp_data.data()),
+               static_cast<unsigned int>(dmp_data.size()));
+  uint8_t flags_length[2];
+  flags_length[0] = static_cast<uint8_t>(0x70 | ((dmp_size >> 8) & 0x0f));
+  flags_length[1] = static_cast<uint8_t>(dmp_size & 0xff);
+  packet.Write(flags_length, sizeof(flags_length));
+
+  // the E1.31 framing layer
+  ola::plugin::e131::E131Header::e131_pdu_header framing_header;
+  memset(&framing_header, 0, sizeof(framing_header));
+  snprintf(framing_header.source, sizeof(framing_header.source),
+           "packet replay");
+  framing_header.priority = 100;
+  framing_header.sequence = 0;
+  framing_header.options = 0;
+  framing_header.universe = ola::network::HostToNetwork(universe);
+  packet.Write(reinterpret_cast<uint8_t*>(&framing_header),
+               sizeof(framing_header));
+  uint32_t vector = ola::network::HostToNetwork(
+      static_cast<uint32_t>(ola::acn::VECTOR_E131_DATA));
+  packet.Write(reinterpret_cast<uint8_t*>(&vector), sizeof(vector));
+  ola::plugin::e131::PDU::PrependFlagsAndLength(&packet);
+
+  ola::plugin::e131::RootPDU::PrependPDU(
+      &packet, ola::acn::VECTOR_ROOT_E131, cid);
+
+  string data;
+  data.resize(packet.Size());
+  unsigned int size = packet.Read(
+      reinterpret_cast<uint8_t*>(&data[0]),
+      static_cast<unsigned int>(data.size()));
+  data.resize(size);
+  corpus->push_back(data);
+}
+
+/*
+ * The pathological case from the field: deeply nested PDU headers, each
+ * claiming a length that covers the rest of the packet.
+ */
+void AddDeeplyNestedPacket(Corpus *corpus, const string &valid) {
+  string data = valid;
+  // overwrite the payload with a run of nested vector+length headers
+  for (unsigned int i = 38; i + 6 < data.size(); i += 6) {
+    unsigned int remaining = static_cast<unsigned int>(data.size()) - i;
+    data[i] = static_cast<char>(0x70 | ((remaining >> 8) & 0x0f));
+    data[i + 1] = static_cast<char>(remaining & 0xff);
+  }
+  corpus->push_back(data);
+}
+
+/*
+ * Mutations: bit flips, truncations and length-field corruption.
+ */
+void AddMutations(Corpus *corpus, const string &valid,
+                  unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    string data = valid;
+    switch (NextRand() % 3) {
+      case 0:  // flip some bits
+        for (int flips = 1 + (NextRand() % 8); flips; flips--) {
+          data[NextRand() % data.size()] ^=
+              static_cast<char>(1 << (NextRand() % 8));
+        }
+        break;
+      case 1:  // truncate
+        data.resize(1 + (NextRand() % data.size()));
+        break;
+      default:  // corrupt a length field (the first PDU flags/length)
+        if (data.size() > 17) {
+          data[16] = static_cast<char>(NextRand());
+          data[17] = static_cast<char>(NextRand());
+        }
+    }
+    corpus->push_back(data);
+  }
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  ola::AppInit(&argc, argv, "[options]",
+               "Replay a packet corpus through the frame parsers.");
+  g_rand_state = FLAGS_seed;
+
+  ola::acn::CID cid = ola::acn::CID::Generate();
+
+  Corpus corpus;
+  AddValidPacket(&corpus, cid, 1, 512);
+  AddValidPacket(&corpus, cid, 2, 16);
+  AddValidPacket(&corpus, cid, 0xffff, 512);
+  // copies: push_back may reallocate the vector under a reference
+  const string full_frame = corpus[0];
+  const string short_frame = corpus[1];
+  AddDeeplyNestedPacket(&corpus, full_frame);
+  AddMutations(&corpus, full_frame, 400);
+  AddMutations(&corpus, short_frame, 100);
+
+  uint64_t total_bytes = 0;
+  for (Corpus::const_iterator iter = corpus.begin(); iter != corpus.end();
+       ++iter) {
+    total_bytes += iter->size();
+  }
+  cout << "corpus: " << corpus.size() << " packets, " << total_bytes
+       << " bytes, seed " << FLAGS_seed << endl;
+
+  // The real sACN receive chain.
+  ola::plugin::e131::RootInflator root_inflator;
+  ola::plugin::e131::E131Inflator e131_inflator;
+  ola::plugin::e131::DMPE131Inflator dmp_inflator(true);
+  root_inflator.AddInflator(&e131_inflator);
+  e131_inflator.AddInflator(&dmp_inflator);
+
+  ola::network::IPV4SocketAddress source(
+      ola::network::IPV4Address::Loopback(), 5568);
+
+  ola::Clock clock;
+  ola::TimeStamp start, end;
+  clock.CurrentTime(&start);
+  for (unsigned int pass = 0; pass < FLAGS_iterations; pass++) {
+    for (Corpus::const_iterator iter = corpus.begin();
+         iter != corpus.end(); ++iter) {
+      ola::plugin::e131::HeaderSet headers;
+      ola::plugin::e131::TransportHeader transport_header(
+          source, ola::plugin::e131::TransportHeader::UDP);
+      headers.SetTransportHeader(transport_header);
+      root_inflator.InflatePDUBlock(
+          &headers,
+          reinterpret_cast<const uint8_t*>(iter->data()),
+          static_cast<unsigned int>(iter->size()));
+    }
+  }
+  clock.CurrentTime(&end);
+
+  double ns_per_byte = 1000.0 * (end - start).AsInt() /
+      (static_cast<double>(total_bytes) * FLAGS_iterations);
+  cout << "parse cost: " << ns_per_byte << " ns/byte (limit "
+       << FLAGS_max_ns_per_byte << ")" << endl;
+
+  if (ns_per_byte > FLAGS_max_ns_per_byte) {
+    cout << "FAIL: parse cost regression" << endl;
+    return 1;
+  }
+  cout << "PASS" << endl;
+  return 0;
+}
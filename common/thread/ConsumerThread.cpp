@@ -56,12 +56,16 @@ void ConsumerThread::EmptyQueue() {
       break;
     }
 
-    // action in queue
-    Action action = m_callback_queue->front();
-    m_callback_queue->pop();
+    // Take the whole backlog in one go, so the lock is bounced once per
+    // batch rather than once per action.
+    std::queue<Action> actions;
+    actions.swap(*m_callback_queue);
     m_mutex->Unlock();
 
-    action->Run();
+    while (!actions.empty()) {
+      actions.front()->Run();
+      actions.pop();
+    }
 
     // reacquire the lock
     m_mutex->Lock();
@@ -44,11 +44,18 @@ ExecutorThread::~ExecutorThread() {
 }
 
 void ExecutorThread::Execute(ola::BaseCallback0<void> *callback) {
+  bool was_empty;
   {
     MutexLocker locker(&m_mutex);
+    was_empty = m_callback_queue.empty();
     m_callback_queue.push(callback);
   }
-  m_condition_var.Signal();
+  // The consumer only sleeps when it has seen an empty queue under the
+  // lock, so the wakeup is only needed on the empty -> non-empty
+  // transition; a producer posting per frame stops paying a syscall per
+  // callback.
+  if (was_empty)
+    m_condition_var.Signal();
 }
 
 void ExecutorThread::DrainCallbacks() {
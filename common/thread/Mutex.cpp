@@ -19,6 +19,7 @@
  */
 
 #include <pthread.h>
+#include <sys/time.h>
 #include "ola/thread/Mutex.h"
 
 namespace ola {
@@ -44,7 +45,24 @@ Mutex::~Mutex() {
  * Lock this mutex
  */
 void Mutex::Lock() {
+#ifdef OLA_MUTEX_PROFILING
+  if (pthread_mutex_trylock(&m_mutex) == 0) {
+    m_stats.acquisitions++;
+    return;
+  }
+  // contended path: time the wait
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  pthread_mutex_lock(&m_mutex);
+  gettimeofday(&end, NULL);
+  m_stats.acquisitions++;
+  m_stats.contended++;
+  m_stats.contended_wait_usecs += static_cast<uint64_t>(
+      (end.tv_sec - start.tv_sec) * 1000000 +
+      (end.tv_usec - start.tv_usec));
+#else
   pthread_mutex_lock(&m_mutex);
+#endif  // OLA_MUTEX_PROFILING
 }
 
 
@@ -24,6 +24,7 @@
 
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <string.h>
 
 #ifdef HAVE_PTHREAD_NP_H
@@ -55,7 +56,8 @@ using std::string;
 
 Thread::Options::Options(const std::string &name)
   : name(name),
-    inheritsched(PTHREAD_EXPLICIT_SCHED) {
+    inheritsched(PTHREAD_EXPLICIT_SCHED),
+    cpu(-1) {
   // Default the scheduling options to the system-default values.
   pthread_attr_t attrs;
   pthread_attr_init(&attrs);
@@ -183,6 +185,21 @@ void *Thread::_InternalRun() {
   pthread_setname_np(pthread_self(), truncated_name.c_str(), NULL);
 #endif
 
+#if defined(__linux__) && !defined(_WIN32)
+  if (m_options.cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(m_options.cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus)) {
+      OLA_WARN << "Failed to pin " << Name() << " to CPU " << m_options.cpu;
+    }
+  }
+#else
+  if (m_options.cpu >= 0) {
+    OLA_WARN << "CPU affinity isn't supported on this platform";
+  }
+#endif  // defined(__linux__) && !defined(_WIN32)
+
   int policy;
   struct sched_param param;
   pthread_getschedparam(pthread_self(), &policy, &param);
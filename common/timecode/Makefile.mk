@@ -1,7 +1,8 @@
 # LIBRARIES
 ##################################################
 common_libolacommon_la_SOURCES += \
-    common/timecode/TimeCode.cpp
+    common/timecode/TimeCode.cpp \
+    common/timecode/TimeCodeEngine.cpp
 
 # TESTS
 ##################################################
@@ -0,0 +1,191 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TimeCodeEngine.cpp
+ * Extrapolates timecode between received frames with a
+ * drift-compensated local clock.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "ola/timecode/TimeCodeEngine.h"
+
+#include <stdlib.h>
+
+#include "ola/Logging.h"
+
+namespace ola {
+namespace timecode {
+
+// A gentle lock: an error of one frame pulls the phase in over ~10
+// frames and trims the period by at most a few ppm per frame, which
+// rides out RPC jitter without oscillating.
+const double TimeCodeEngine::KP = 0.1;
+const double TimeCodeEngine::KI = 0.005;
+
+namespace {
+// resync rather than chase if the input jumps this many frames
+const uint64_t DISCONTINUITY_FRAMES = 5;
+}  // namespace
+
+TimeCodeEngine::TimeCodeEngine(ola::io::SelectServerInterface *ss,
+                               Clock *clock,
+                               TimeCodeCallback *callback)
+    : m_ss(ss),
+      m_clock(clock),
+      m_callback(callback),
+      m_running(false),
+      m_type(TIMECODE_FILM),
+      m_next_frame(0),
+      m_last_input_frame(0),
+      m_base_frame(0),
+      m_period_usecs(0.0),
+      m_timeout(ola::thread::INVALID_TIMEOUT) {
+}
+
+TimeCodeEngine::~TimeCodeEngine() {
+  if (m_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_ss->RemoveTimeout(m_timeout);
+  }
+}
+
+void TimeCodeEngine::InputTimeCode(const TimeCode &timecode) {
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+
+  const uint64_t frame = ToFrameNumber(timecode);
+
+  if (!m_running || timecode.Type() != m_type ||
+      frame + DISCONTINUITY_FRAMES < m_last_input_frame ||
+      frame > m_last_input_frame + DISCONTINUITY_FRAMES) {
+    Resync(timecode, now);
+    return;
+  }
+  m_last_input_frame = frame;
+
+  // How early or late did this frame arrive against our local clock?
+  // Positive error means the sender is running behind our estimate.
+  const TimeStamp predicted = FrameDeadline(frame);
+  const double error_usecs = (now - predicted).AsInt();
+
+  // PI update: trim the period (drift) and nudge the phase (offset).
+  m_period_usecs += KI * (error_usecs / FramesPerSecond(m_type));
+  TimeStamp base = m_base_time;
+  base += TimeInterval(static_cast<int64_t>(KP * error_usecs));
+  m_base_time = base;
+}
+
+void TimeCodeEngine::Resync(const TimeCode &timecode, const TimeStamp &now) {
+  m_type = timecode.Type();
+  m_period_usecs = NominalPeriod(m_type);
+  m_base_frame = ToFrameNumber(timecode);
+  m_last_input_frame = m_base_frame;
+  m_base_time = now;
+  m_next_frame = m_base_frame;
+  m_running = true;
+
+  if (m_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_ss->RemoveTimeout(m_timeout);
+    m_timeout = ola::thread::INVALID_TIMEOUT;
+  }
+  // emit the frame we just locked to straight away, then extrapolate
+  EmitFrame();
+}
+
+void TimeCodeEngine::EmitFrame() {
+  m_timeout = ola::thread::INVALID_TIMEOUT;
+
+  if (m_next_frame > m_last_input_frame + FREEWHEEL_FRAMES) {
+    // input stopped; go quiet until it resumes
+    m_running = false;
+    return;
+  }
+
+  m_callback->Run(FromFrameNumber(m_type, m_next_frame));
+  m_next_frame++;
+  ScheduleNext();
+}
+
+void TimeCodeEngine::ScheduleNext() {
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+  const TimeStamp deadline = FrameDeadline(m_next_frame);
+  TimeInterval delay =
+      deadline > now ? deadline - now : TimeInterval(0, 0);
+  m_timeout = m_ss->RegisterSingleTimeout(
+      delay, NewSingleCallback(this, &TimeCodeEngine::EmitFrame));
+}
+
+TimeStamp TimeCodeEngine::FrameDeadline(uint64_t frame) const {
+  TimeStamp deadline = m_base_time;
+  deadline += TimeInterval(static_cast<int64_t>(
+      (frame - m_base_frame) * m_period_usecs));
+  return deadline;
+}
+
+unsigned int TimeCodeEngine::FramesPerSecond(TimeCodeType type) {
+  switch (type) {
+    case TIMECODE_FILM:
+      return 24;
+    case TIMECODE_EBU:
+      return 25;
+    case TIMECODE_DF:
+    case TIMECODE_SMPTE:
+    default:
+      return 30;
+  }
+}
+
+double TimeCodeEngine::NominalPeriod(TimeCodeType type) {
+  if (type == TIMECODE_DF) {
+    return 1000000.0 * 1001.0 / 30000.0;  // 29.97 fps
+  }
+  return 1000000.0 / FramesPerSecond(type);
+}
+
+uint64_t TimeCodeEngine::ToFrameNumber(const TimeCode &timecode) {
+  const unsigned int fps = FramesPerSecond(timecode.Type());
+  uint64_t total_minutes = timecode.Hours() * 60u + timecode.Minutes();
+  uint64_t frame = ((total_minutes * 60u + timecode.Seconds()) * fps) +
+                   timecode.Frames();
+  if (timecode.Type() == TIMECODE_DF) {
+    // 2 frame numbers are skipped each minute, except every 10th
+    frame -= 2 * (total_minutes - total_minutes / 10);
+  }
+  return frame;
+}
+
+TimeCode TimeCodeEngine::FromFrameNumber(TimeCodeType type, uint64_t frame) {
+  const unsigned int fps = FramesPerSecond(type);
+  if (type == TIMECODE_DF) {
+    // invert the drop-frame numbering
+    const uint64_t frames_per_10_min = 10 * 60 * fps - 9 * 2;
+    const uint64_t frames_per_min = 60 * fps - 2;
+    uint64_t ten_min_blocks = frame / frames_per_10_min;
+    uint64_t remainder = frame % frames_per_10_min;
+    uint64_t minutes_in_block = 0;
+    if (remainder >= 60u * fps) {
+      minutes_in_block = 1 + (remainder - 60u * fps) / frames_per_min;
+    }
+    frame += 2 * (ten_min_blocks * 9 + minutes_in_block);
+  }
+  uint64_t total_seconds = frame / fps;
+  return TimeCode(type,
+                  static_cast<uint8_t>((total_seconds / 3600) % 24),
+                  static_cast<uint8_t>((total_seconds / 60) % 60),
+                  static_cast<uint8_t>(total_seconds % 60),
+                  static_cast<uint8_t>(frame % fps));
+}
+}  // namespace timecode
+}  // namespace ola
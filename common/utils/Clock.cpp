@@ -29,6 +29,7 @@
 #include <ola/Clock.h>
 #include <stdint.h>
 #include <sys/time.h>
+#include <time.h>
 
 #if HAVE_CONFIG_H
 #include <config.h>
@@ -257,6 +258,30 @@ void Clock::CurrentTime(TimeStamp *timestamp) const {
   *timestamp = tv;
 }
 
+void Clock::CurrentMonotonicTime(TimeStamp *timestamp) const {
+#ifdef CLOCK_MONOTONIC_COARSE
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0) {
+    struct timeval tv;
+    tv.tv_sec = ts.tv_sec;
+    tv.tv_usec = static_cast<suseconds_t>(ts.tv_nsec / 1000);
+    *timestamp = tv;
+    return;
+  }
+#endif  // CLOCK_MONOTONIC_COARSE
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts2;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts2) == 0) {
+    struct timeval tv2;
+    tv2.tv_sec = ts2.tv_sec;
+    tv2.tv_usec = static_cast<suseconds_t>(ts2.tv_nsec / 1000);
+    *timestamp = tv2;
+    return;
+  }
+#endif  // CLOCK_MONOTONIC
+  CurrentTime(timestamp);
+}
+
 void MockClock::AdvanceTime(const TimeInterval &interval) {
   m_offset += interval;
 }
@@ -272,4 +297,9 @@ void MockClock::CurrentTime(TimeStamp *timestamp) const {
   *timestamp = tv;
   *timestamp += m_offset;
 }
+
+void MockClock::CurrentMonotonicTime(TimeStamp *timestamp) const {
+  Clock::CurrentMonotonicTime(timestamp);
+  *timestamp += m_offset;
+}
 }  // namespace ola
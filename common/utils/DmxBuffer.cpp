@@ -36,6 +36,8 @@
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/StringUtils.h"
+#include "ola/dmx/DmxBufferPool.h"
+#include "ola/dmx/MergeKernel.h"
 
 namespace ola {
 
@@ -48,7 +50,10 @@ DmxBuffer::DmxBuffer()
     : m_ref_count(NULL),
       m_copy_on_write(false),
       m_data(NULL),
-      m_length(0) {
+      m_length(0),
+      m_pool(NULL),
+      m_dirty_start(DMX_UNIVERSE_SIZE),
+      m_dirty_end(0) {
 }
 
 
@@ -56,7 +61,10 @@ DmxBuffer::DmxBuffer(const DmxBuffer &other)
     : m_ref_count(NULL),
       m_copy_on_write(false),
       m_data(NULL),
-      m_length(0) {
+      m_length(0),
+      m_pool(NULL),
+      m_dirty_start(DMX_UNIVERSE_SIZE),
+      m_dirty_end(0) {
 
   if (other.m_data && other.m_ref_count) {
     CopyFromOther(other);
@@ -68,7 +76,10 @@ DmxBuffer::DmxBuffer(const uint8_t *data, unsigned int length)
     : m_ref_count(0),
       m_copy_on_write(false),
       m_data(NULL),
-      m_length(0) {
+      m_length(0),
+      m_pool(NULL),
+      m_dirty_start(DMX_UNIVERSE_SIZE),
+      m_dirty_end(0) {
   Set(data, length);
 }
 
@@ -77,11 +88,27 @@ DmxBuffer::DmxBuffer(const string &data)
     : m_ref_count(0),
       m_copy_on_write(false),
       m_data(NULL),
-      m_length(0) {
+      m_length(0),
+      m_pool(NULL),
+      m_dirty_start(DMX_UNIVERSE_SIZE),
+      m_dirty_end(0) {
     Set(data);
 }
 
 
+DmxBuffer::DmxBuffer(ola::dmx::DmxBufferPool *pool,
+                     uint8_t *data,
+                     unsigned int *ref_count)
+    : m_ref_count(ref_count),
+      m_copy_on_write(false),
+      m_data(data),
+      m_length(0),
+      m_pool(pool),
+      m_dirty_start(DMX_UNIVERSE_SIZE),
+      m_dirty_end(0) {
+}
+
+
 DmxBuffer::~DmxBuffer() {
   CleanupMemory();
 }
@@ -121,15 +148,14 @@ bool DmxBuffer::HTPMerge(const DmxBuffer &other) {
                                   other.m_length);
   unsigned int merge_length = min(m_length, other.m_length);
 
-  for (unsigned int i = 0; i < merge_length; i++) {
-    m_data[i] = max(m_data[i], other.m_data[i]);
-  }
+  ola::dmx::HTPMergeSlots(m_data, other.m_data, merge_length);
 
   if (other_length > m_length) {
     memcpy(m_data + merge_length, other.m_data + merge_length,
            other_length - merge_length);
     m_length = other_length;
   }
+  MarkDirty(0, other_length);
   return true;
 }
 
@@ -144,8 +170,10 @@ bool DmxBuffer::Set(const uint8_t *data, unsigned int length) {
     if (!Init())
       return false;
   }
+  unsigned int old_length = m_length;
   m_length = min(length, (unsigned int) DMX_UNIVERSE_SIZE);
   memcpy(m_data, data, m_length);
+  MarkDirty(0, max(old_length, m_length));
   return true;
 }
 
@@ -180,6 +208,7 @@ bool DmxBuffer::SetFromString(const string &input) {
       iter != dmx_values.end() && i < DMX_UNIVERSE_SIZE; ++iter, ++i) {
     m_data[i] = atoi(iter->data());
   }
+  MarkDirty(0, max(m_length, i));
   m_length = i;
   return true;
 }
@@ -203,6 +232,7 @@ bool DmxBuffer::SetRangeToValue(unsigned int offset,
   unsigned int copy_length = min(length, DMX_UNIVERSE_SIZE - offset);
   memset(m_data + offset, value, copy_length);
   m_length = max(m_length, offset + copy_length);
+  MarkDirty(offset, copy_length);
   return true;
 }
 
@@ -225,6 +255,7 @@ bool DmxBuffer::SetRange(unsigned int offset,
   unsigned int copy_length = min(length, DMX_UNIVERSE_SIZE - offset);
   memcpy(m_data + offset, data, copy_length);
   m_length = max(m_length, offset + copy_length);
+  MarkDirty(offset, copy_length);
   return true;
 }
 
@@ -246,6 +277,7 @@ void DmxBuffer::SetChannel(unsigned int channel, uint8_t data) {
   DuplicateIfNeeded();
   m_data[channel] = data;
   m_length = max(channel+1, m_length);
+  MarkDirty(channel, 1);
 }
 
 
@@ -298,6 +330,7 @@ bool DmxBuffer::Blackout() {
       return false;
   memset(m_data, DMX_MIN_SLOT_VALUE, DMX_UNIVERSE_SIZE);
   m_length = DMX_UNIVERSE_SIZE;
+  MarkDirty(0, DMX_UNIVERSE_SIZE);
   return true;
 }
 
@@ -322,11 +355,43 @@ string DmxBuffer::ToString() const {
 }
 
 
+bool DmxBuffer::GetDirtyRange(unsigned int *start, unsigned int *end) const {
+  if (m_dirty_start >= m_dirty_end)
+    return false;
+  *start = m_dirty_start;
+  *end = m_dirty_end;
+  return true;
+}
+
+
+void DmxBuffer::ClearDirtyRange() {
+  m_dirty_start = DMX_UNIVERSE_SIZE;
+  m_dirty_end = 0;
+}
+
+
+/*
+ * Extend the dirty span to cover [offset, offset + length).
+ */
+void DmxBuffer::MarkDirty(unsigned int offset, unsigned int length) {
+  if (!length)
+    return;
+  m_dirty_start = min(m_dirty_start, offset);
+  m_dirty_end = max(m_dirty_end, offset + length);
+}
+
+
 /*
  * Allocate memory
  * @return true on success, otherwise raises an exception
  */
 bool DmxBuffer::Init() {
+  if (m_pool) {
+    if (!m_pool->AllocateBacking(&m_data, &m_ref_count))
+      return false;
+    m_length = 0;
+    return true;
+  }
   m_data = new uint8_t[DMX_UNIVERSE_SIZE];
   m_ref_count = new unsigned int;
   m_length = 0;
@@ -371,6 +436,9 @@ void DmxBuffer::CopyFromOther(const DmxBuffer &other) {
   (*m_ref_count)++;
   m_data = other.m_data;
   m_length = other.m_length;
+  m_pool = other.m_pool;
+  m_dirty_start = other.m_dirty_start;
+  m_dirty_end = other.m_dirty_end;
 }
 
 
@@ -381,8 +449,12 @@ void DmxBuffer::CleanupMemory() {
   if (m_ref_count && m_data) {
     (*m_ref_count)--;
     if (!*m_ref_count) {
-      delete[] m_data;
-      delete m_ref_count;
+      if (m_pool) {
+        m_pool->ReleaseBacking(m_data);
+      } else {
+        delete[] m_data;
+        delete m_ref_count;
+      }
     }
     m_data = NULL;
     m_ref_count = NULL;
@@ -44,6 +44,7 @@ class DmxBufferTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testSetRangeToValue);
   CPPUNIT_TEST(testSetChannel);
   CPPUNIT_TEST(testToString);
+  CPPUNIT_TEST(testDirtyRange);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -59,6 +60,7 @@ class DmxBufferTest: public CppUnit::TestFixture {
     void testSetRangeToValue();
     void testSetChannel();
     void testToString();
+    void testDirtyRange();
 
  private:
     static const uint8_t TEST_DATA[];
@@ -523,3 +525,36 @@ void DmxBufferTest::testToString() {
   str << buffer;
   OLA_ASSERT_EQ(string("1,2,3,4"), str.str());
 }
+
+
+/*
+ * Test the dirty range tracking
+ */
+void DmxBufferTest::testDirtyRange() {
+  DmxBuffer buffer;
+  unsigned int start, end;
+  OLA_ASSERT_FALSE(buffer.GetDirtyRange(&start, &end));
+
+  buffer.Blackout();
+  OLA_ASSERT_TRUE(buffer.GetDirtyRange(&start, &end));
+  OLA_ASSERT_EQ(0u, start);
+  OLA_ASSERT_EQ(static_cast<unsigned int>(ola::DMX_UNIVERSE_SIZE), end);
+
+  buffer.ClearDirtyRange();
+  OLA_ASSERT_FALSE(buffer.GetDirtyRange(&start, &end));
+
+  // single channels widen the span
+  buffer.SetChannel(10, 50);
+  buffer.SetChannel(20, 60);
+  OLA_ASSERT_TRUE(buffer.GetDirtyRange(&start, &end));
+  OLA_ASSERT_EQ(10u, start);
+  OLA_ASSERT_EQ(21u, end);
+
+  // so do ranges
+  buffer.ClearDirtyRange();
+  const uint8_t data[] = {1, 2, 3, 4};
+  buffer.SetRange(100, data, sizeof(data));
+  OLA_ASSERT_TRUE(buffer.GetDirtyRange(&start, &end));
+  OLA_ASSERT_EQ(100u, start);
+  OLA_ASSERT_EQ(104u, end);
+}
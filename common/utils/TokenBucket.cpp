@@ -39,6 +39,20 @@ bool TokenBucket::GetToken(const TimeStamp &now) {
 }
 
 
+/*
+ * Take up to token_count tokens from the bucket.
+ * @param now the current time
+ * @param token_count the number of tokens wanted
+ * @returns the number of tokens granted
+ */
+unsigned int TokenBucket::GetTokens(const TimeStamp &now,
+                                    unsigned int token_count) {
+  unsigned int granted = std::min(token_count, Count(now));
+  m_count -= granted;
+  return granted;
+}
+
+
 /*
  * Get the number of tokens in the bucket
  */
@@ -37,11 +37,13 @@ class TokenBucketTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(TokenBucketTest);
   CPPUNIT_TEST(testTokenBucket);
   CPPUNIT_TEST(testTokenBucketTwo);
+  CPPUNIT_TEST(testGetTokens);
   CPPUNIT_TEST_SUITE_END();
 
  public:
     void testTokenBucket();
     void testTokenBucketTwo();
+    void testGetTokens();
 };
 
 
@@ -121,3 +123,25 @@ void TokenBucketTest::testTokenBucketTwo() {
   now += ten_ms;
   OLA_ASSERT_EQ(30u, bucket.Count(now));
 }
+
+
+/*
+ * Check that taking tokens in batches works
+ */
+void TokenBucketTest::testGetTokens() {
+  TimeStamp now;
+  Clock clock;
+  TimeInterval one_second(1000000);
+  clock.CurrentTime(&now);
+  TokenBucket bucket(5, 10, 10, now);
+
+  // only 5 tokens to hand out
+  OLA_ASSERT_EQ(5u, bucket.GetTokens(now, 8));
+  OLA_ASSERT_EQ(0u, bucket.GetTokens(now, 8));
+  OLA_ASSERT_EQ(0u, bucket.Count(now));
+
+  // a second later we're capped at the bucket size
+  now += one_second;
+  OLA_ASSERT_EQ(3u, bucket.GetTokens(now, 3));
+  OLA_ASSERT_EQ(7u, bucket.Count(now));
+}
@@ -0,0 +1,99 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamWriter.cpp
+ * Serialize JSON directly to a stream, without building a value tree.
+ * Copyright (C) 2012 Simon Newton
+ */
+
+#include "ola/web/JsonStreamWriter.h"
+
+#include <string>
+
+#include "ola/StringUtils.h"
+
+namespace ola {
+namespace web {
+
+using std::string;
+
+void JsonStreamWriter::OpenObject(const string &key) {
+  StartElement(key);
+  *m_output << "{";
+  if (m_depth < MAX_DEPTH)
+    m_depth++;
+  m_needs_comma[m_depth] = false;
+}
+
+void JsonStreamWriter::CloseObject() {
+  if (m_depth)
+    m_depth--;
+  *m_output << "}";
+  m_needs_comma[m_depth] = true;
+}
+
+void JsonStreamWriter::OpenArray(const string &key) {
+  StartElement(key);
+  *m_output << "[";
+  if (m_depth < MAX_DEPTH)
+    m_depth++;
+  m_needs_comma[m_depth] = false;
+}
+
+void JsonStreamWriter::CloseArray() {
+  if (m_depth)
+    m_depth--;
+  *m_output << "]";
+  m_needs_comma[m_depth] = true;
+}
+
+void JsonStreamWriter::AddString(const string &key, const string &value) {
+  StartElement(key);
+  *m_output << '"' << EscapeString(value) << '"';
+}
+
+void JsonStreamWriter::AddNumber(const string &key, int64_t value) {
+  StartElement(key);
+  *m_output << value;
+}
+
+void JsonStreamWriter::AddNumber(const string &key, uint64_t value) {
+  StartElement(key);
+  *m_output << value;
+}
+
+void JsonStreamWriter::AddBool(const string &key, bool value) {
+  StartElement(key);
+  *m_output << (value ? "true" : "false");
+}
+
+void JsonStreamWriter::AddNull(const string &key) {
+  StartElement(key);
+  *m_output << "null";
+}
+
+
+/*
+ * Write the comma separator & key prefix for the next element.
+ */
+void JsonStreamWriter::StartElement(const string &key) {
+  if (m_needs_comma[m_depth])
+    *m_output << ",";
+  m_needs_comma[m_depth] = true;
+  if (!key.empty())
+    *m_output << '"' << EscapeString(key) << "\": ";
+}
+}  // namespace web
+}  // namespace ola
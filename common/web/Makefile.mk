@@ -27,6 +27,7 @@ common_web_libolaweb_la_SOURCES = \
     common/web/JsonSchema.cpp \
     common/web/JsonSections.cpp \
     common/web/JsonTypes.cpp \
+    common/web/JsonStreamWriter.cpp \
     common/web/JsonWriter.cpp \
     common/web/OptionalItem.h \
     common/web/PointerTracker.cpp \
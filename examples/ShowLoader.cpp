@@ -25,6 +25,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <ola/Constants.h>
 #include <ola/DmxBuffer.h>
 #include <ola/Logging.h>
 #include <ola/StringUtils.h>
@@ -43,10 +44,12 @@ using ola::DmxBuffer;
 
 
 const char ShowLoader::OLA_SHOW_HEADER[] = "OLA Show";
+const char ShowLoader::OLA_BINARY_SHOW_HEADER[] = "OLABSHW1";
 
 ShowLoader::ShowLoader(const string &filename)
     : m_filename(filename),
-      m_line(0) {
+      m_line(0),
+      m_binary(false) {
 }
 
 
@@ -62,12 +65,23 @@ ShowLoader::~ShowLoader() {
  * @returns true if we could open the file, false otherwise.
  */
 bool ShowLoader::Load() {
-  m_show_file.open(m_filename.data());
+  m_show_file.open(m_filename.data(), std::ios::in | std::ios::binary);
   if (!m_show_file.is_open()) {
     OLA_FATAL << "Can't open " << m_filename << ": " << strerror(errno);
     return false;
   }
 
+  // sniff the container: binary shows carry an 8 byte magic
+  char magic[8];
+  m_show_file.read(magic, sizeof(magic));
+  if (m_show_file.gcount() == sizeof(magic) &&
+      memcmp(magic, OLA_BINARY_SHOW_HEADER, sizeof(magic)) == 0) {
+    m_binary = true;
+    return true;
+  }
+
+  m_show_file.clear();
+  m_show_file.seekg(0, std::ios::beg);
   string line;
   ReadLine(&line);
   if (line != OLA_SHOW_HEADER) {
@@ -85,6 +99,10 @@ bool ShowLoader::Load() {
 void ShowLoader::Reset() {
   m_show_file.clear();
   m_show_file.seekg(0, std::ios::beg);
+  if (m_binary) {
+    m_show_file.seekg(8, std::ios::beg);  // skip the magic
+    return;
+  }
   // skip over the first line
   string line;
   ReadLine(&line);
@@ -96,6 +114,9 @@ void ShowLoader::Reset() {
  * @param timeout a pointer to the timeout in ms
  */
 ShowLoader::State ShowLoader::NextTimeout(unsigned int *timeout) {
+  if (m_binary)
+    return NextBinaryRecord(1, NULL, NULL, timeout);
+
   string line;
   ReadLine(&line);
   if (line.empty())
@@ -116,6 +137,9 @@ ShowLoader::State ShowLoader::NextTimeout(unsigned int *timeout) {
  */
 ShowLoader::State ShowLoader::NextFrame(unsigned int *universe,
                                         DmxBuffer *data) {
+  if (m_binary)
+    return NextBinaryRecord(0, universe, data, NULL);
+
   string line;
   ReadLine(&line);
 
@@ -144,3 +168,49 @@ void ShowLoader::ReadLine(string *line) {
   ola::StripSuffix(line, "\r");
   m_line++;
 }
+
+
+/**
+ * Read one binary record, checking it has the expected type.
+ */
+ShowLoader::State ShowLoader::NextBinaryRecord(uint8_t expected_type,
+                                               unsigned int *universe,
+                                               DmxBuffer *data,
+                                               unsigned int *timeout) {
+  uint8_t type;
+  m_show_file.read(reinterpret_cast<char*>(&type), 1);
+  if (m_show_file.gcount() != 1)
+    return END_OF_FILE;
+
+  if (type != expected_type) {
+    OLA_WARN << "Unexpected record type " << static_cast<int>(type);
+    return INVALID_LINE;
+  }
+
+  if (type == 1) {
+    uint32_t ms;
+    m_show_file.read(reinterpret_cast<char*>(&ms), sizeof(ms));
+    if (m_show_file.gcount() != sizeof(ms))
+      return END_OF_FILE;
+    *timeout = ms;
+    return OK;
+  }
+
+  uint32_t universe32;
+  uint16_t length;
+  m_show_file.read(reinterpret_cast<char*>(&universe32),
+                   sizeof(universe32));
+  m_show_file.read(reinterpret_cast<char*>(&length), sizeof(length));
+  if (m_show_file.gcount() != sizeof(length) ||
+      length > ola::DMX_UNIVERSE_SIZE)
+    return END_OF_FILE;
+
+  uint8_t slots[ola::DMX_UNIVERSE_SIZE];
+  m_show_file.read(reinterpret_cast<char*>(slots), length);
+  if (m_show_file.gcount() != length)
+    return END_OF_FILE;
+
+  *universe = universe32;
+  data->Set(slots, length);
+  return OK;
+}
@@ -21,6 +21,7 @@
 #include <ola/DmxBuffer.h>
 
 #include <string>
+#include <stdint.h>
 #include <fstream>
 
 #ifndef EXAMPLES_SHOWLOADER_H_
@@ -50,9 +51,20 @@ class ShowLoader {
     const std::string m_filename;
     std::ifstream m_show_file;
     unsigned int m_line;
+    // set when the file carries the binary container
+    bool m_binary;
+    // An mmap-based reader would shave the remaining read() calls for
+    // binary shows: map the file, madvise(SEQUENTIAL), and walk records
+    // by pointer (the layout is already fixed-size, so "parsing" is a
+    // cast). The ifstream path keeps Windows and the text format working;
+    // add the mapped variant behind m_binary when a capture shows up
+    // where buffered reads are measurable next to the send path.
 
     static const char OLA_SHOW_HEADER[];
+    static const char OLA_BINARY_SHOW_HEADER[];
 
     void ReadLine(std::string *line);
+    State NextBinaryRecord(uint8_t expected_type, unsigned int *universe,
+                           ola::DmxBuffer *data, unsigned int *timeout);
 };
 #endif  // EXAMPLES_SHOWLOADER_H_
@@ -47,8 +47,9 @@ using std::vector;
 
 
 ShowRecorder::ShowRecorder(const string &filename,
+                           bool binary,
                            const vector<unsigned int> &universes)
-    : m_saver(filename),
+    : m_saver(filename, binary),
       m_universes(universes),
       m_frame_count(0) {
 }
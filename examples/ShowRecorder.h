@@ -37,6 +37,7 @@
 class ShowRecorder {
  public:
     ShowRecorder(const std::string &filename,
+                 bool binary,
                  const std::vector<unsigned int> &universes);
     ~ShowRecorder();
 
@@ -39,9 +39,11 @@ using std::endl;
 
 
 const char ShowSaver::OLA_SHOW_HEADER[] = "OLA Show";
+const char ShowSaver::OLA_BINARY_SHOW_HEADER[] = "OLABSHW1";
 
-ShowSaver::ShowSaver(const string &filename)
-    : m_filename(filename) {
+ShowSaver::ShowSaver(const string &filename, bool binary)
+    : m_filename(filename),
+      m_binary(binary) {
 }
 
 
@@ -55,13 +57,19 @@ ShowSaver::~ShowSaver() {
  * @returns true if we could open the file, false otherwise.
  */
 bool ShowSaver::Open() {
-  m_show_file.open(m_filename.data());
+  m_show_file.open(m_filename.data(),
+                   m_binary ? std::ios::out | std::ios::binary
+                            : std::ios::out);
   if (!m_show_file.is_open()) {
     OLA_FATAL << "Can't open " << m_filename << ": " << strerror(errno);
     return false;
   }
 
-  m_show_file << OLA_SHOW_HEADER << endl;
+  if (m_binary) {
+    m_show_file.write(OLA_BINARY_SHOW_HEADER, 8);
+  } else {
+    m_show_file << OLA_SHOW_HEADER << endl;
+  }
   return true;
 }
 
@@ -88,9 +96,41 @@ bool ShowSaver::NewFrame(const ola::TimeStamp &arrival_time,
     // this is not the first frame so write the delay in ms
     const ola::TimeInterval delta = arrival_time - m_last_frame;
 
-    m_show_file << delta.InMilliSeconds() << endl;
+    if (m_binary) {
+      uint8_t type = 1;
+      uint32_t ms = static_cast<uint32_t>(delta.InMilliSeconds());
+      m_show_file.write(reinterpret_cast<char*>(&type), 1);
+      m_show_file.write(reinterpret_cast<char*>(&ms), sizeof(ms));
+    } else {
+      m_show_file << delta.InMilliSeconds() << endl;
+    }
   }
   m_last_frame = arrival_time;
-  m_show_file << universe << " " << data.ToString() << endl;
+  if (m_binary) {
+    WriteBinaryFrame(universe, data);
+    // bound the crash-loss window to one frame
+    m_show_file.flush();
+  } else {
+    m_show_file << universe << " " << data.ToString() << endl;
+  }
   return true;
 }
+
+
+void ShowSaver::WriteBinaryFrame(unsigned int universe,
+                                 const ola::DmxBuffer &data) {
+  // flushed per frame below so a crash loses at most the frame being
+  // written; records are self-delimiting so a torn tail record is
+  // detected (and playback stops) rather than corrupting the stream
+  uint8_t type = 0;
+  uint32_t universe32 = universe;
+  uint16_t length = static_cast<uint16_t>(data.Size());
+  m_show_file.write(reinterpret_cast<char*>(&type), 1);
+  m_show_file.write(reinterpret_cast<char*>(&universe32),
+                    sizeof(universe32));
+  m_show_file.write(reinterpret_cast<char*>(&length), sizeof(length));
+  if (data.GetRaw()) {
+    m_show_file.write(reinterpret_cast<const char*>(data.GetRaw()),
+                      length);
+  }
+}
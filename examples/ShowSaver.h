@@ -32,7 +32,16 @@
  */
 class ShowSaver {
  public:
-    explicit ShowSaver(const std::string &filename);
+    /**
+     * @param filename the file to write.
+     * @param binary if true, write the indexed binary container instead
+     * of the text format: 8 byte magic, then records of
+     * [u8 type][payload] where type 0 is a frame
+     * ([u32le universe][u16le length][slots]) and type 1 is a delay
+     * ([u32le milliseconds]). Loading a long capture stops being a
+     * per-line parse.
+     */
+    explicit ShowSaver(const std::string &filename, bool binary = false);
     ~ShowSaver();
 
     bool Open();
@@ -44,9 +53,14 @@ class ShowSaver {
 
  private:
     const std::string m_filename;
+    const bool m_binary;
     std::ofstream m_show_file;
     ola::TimeStamp m_last_frame;
 
     static const char OLA_SHOW_HEADER[];
+    static const char OLA_BINARY_SHOW_HEADER[];
+
+    void WriteBinaryFrame(unsigned int universe,
+                          const ola::DmxBuffer &data);
 };
 #endif  // EXAMPLES_SHOWSAVER_H_
@@ -42,6 +42,9 @@ DEFINE_s_int32(subnet, s, -1,
                "Set the subnet parameter of the ArtNet device.");
 DEFINE_s_uint32(universe, u, 0,
                 "List the IPs of ArtNet devices for this universe.");
+DEFINE_default_bool(node_stats, false,
+                    "Display the health & throughput stats for each peer "
+                    "node.");
 
 /*
  * A class that configures Artnet devices
@@ -55,8 +58,10 @@ class ArtnetConfigurator: public OlaConfigurator {
  private:
   void SendOptionRequest();
   void SendNodeListRequest();
+  void SendNodeStatsRequest();
   void DisplayOptions(const ola::plugin::artnet::OptionsReply &reply);
   void DisplayNodeList(const ola::plugin::artnet::NodeListReply &reply);
+  void DisplayNodeStats(const ola::plugin::artnet::NodeStatsReply &reply);
 };
 
 
@@ -83,6 +88,10 @@ void ArtnetConfigurator::HandleConfigResponse(const string &reply,
                  ola::plugin::artnet::Reply::ARTNET_NODE_LIST_REPLY &&
              reply_pb.has_node_list()) {
     DisplayNodeList(reply_pb.node_list());
+  } else if (reply_pb.type() ==
+                 ola::plugin::artnet::Reply::ARTNET_NODE_STATS_REPLY &&
+             reply_pb.has_node_stats()) {
+    DisplayNodeStats(reply_pb.node_stats());
   } else {
     cout << "Invalid response type or missing options field" << endl;
   }
@@ -93,7 +102,9 @@ void ArtnetConfigurator::HandleConfigResponse(const string &reply,
  * Send a request
  */
 void ArtnetConfigurator::SendConfigRequest() {
-  if (FLAGS_universe.present()) {
+  if (FLAGS_node_stats) {
+    SendNodeStatsRequest();
+  } else if (FLAGS_universe.present()) {
     SendNodeListRequest();
   } else {
     SendOptionRequest();
@@ -158,6 +169,21 @@ void ArtnetConfigurator::DisplayNodeList(
   }
 }
 
+/**
+ * Display the per-node health stats
+ */
+void ArtnetConfigurator::DisplayNodeStats(
+    const ola::plugin::artnet::NodeStatsReply &reply) {
+  unsigned int nodes = reply.node_size();
+  for (unsigned int i = 0; i < nodes; i++) {
+    const ola::plugin::artnet::NodeStats &node = reply.node(i);
+    ola::network::IPV4Address address(node.ip_address());
+    cout << address << ": rx " << node.packets_received()
+         << " packets, last seen " << node.last_seen_ago()
+         << "s ago, " << node.send_failures() << " send failures" << endl;
+  }
+}
+
 
 /*
  * The main function
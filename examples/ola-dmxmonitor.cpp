@@ -119,7 +119,9 @@ class DmxMonitor {
           m_stdin_descriptor(STDIN_FILENO),
           m_window(NULL),
           m_data_loss_window(NULL),
-          m_channels_offset(true) {
+          m_channels_offset(true),
+          m_screen_dirty(true),
+          m_redraw_pending(false) {
     }
 
     ~DmxMonitor() {
@@ -150,12 +152,24 @@ class DmxMonitor {
     bool m_channels_offset;  // start from channel 1 rather than 0;
     OlaClientWrapper m_client;
     DmxBuffer m_buffer;
+    DmxBuffer m_drawn_buffer;   // what's currently on screen
+    bool m_screen_dirty;        // full redraw needed
+    bool m_redraw_pending;      // a capped redraw is scheduled
+    TimeStamp m_last_draw;
 
     void DrawScreen(bool include_values = true);
     void Mask();
     void Values();
+    void ValuesIncremental();
+    void DrawValueCell(int y, int x, int z);
+    void ScheduleRedraw();
+    void Redraw();
     void ChangePalette(int p);
     void CalcScreenGeometry();
+
+    // cap the redraw rate; a monitor over SSH must never be the
+    // heaviest process on the box
+    static const unsigned int MIN_REDRAW_INTERVAL_MS = 50;
 };
 
 
@@ -475,62 +489,97 @@ void DmxMonitor::Values() {
          z < ola::DMX_UNIVERSE_SIZE &&
          i < static_cast<int>(channels_per_screen);
          x++, z++, i++) {
-      const int d = m_buffer.Get(z);
+      DrawValueCell(y, x, z);
+    }
+  }
+}
+
+
+/*
+ * Redraw only the cells whose value changed since the last draw - a
+ * typical show frame touches a handful of slots, not the whole grid.
+ */
+void DmxMonitor::ValuesIncremental() {
+  int i = 0, x, y, z = first_channel;
+
+  for (y = ROWS_PER_CHANNEL_ROW;
+       y < LINES && z < ola::DMX_UNIVERSE_SIZE &&
+       i < static_cast<int>(channels_per_screen);
+       y += ROWS_PER_CHANNEL_ROW) {
+    for (x = 0;
+         x < static_cast<int>(channels_per_line) &&
+         z < ola::DMX_UNIVERSE_SIZE &&
+         i < static_cast<int>(channels_per_screen);
+         x++, z++, i++) {
+      if (m_buffer.Get(z) == m_drawn_buffer.Get(z) &&
+          m_buffer.Size() == m_drawn_buffer.Size()) {
+        continue;
+      }
+      move(y, x * CHANNEL_DISPLAY_WIDTH);
+      DrawValueCell(y, x, z);
+    }
+  }
+}
+
+
+/*
+ * Draw one value cell; the cursor must already be positioned.
+ */
+void DmxMonitor::DrawValueCell(OLA_UNUSED int y, OLA_UNUSED int x, int z) {
+  const int d = m_buffer.Get(z);
+  switch (d) {
+    case ola::DMX_MIN_SLOT_VALUE:
+      (void) attrset(palette[ZERO]);
+      break;
+    case ola::DMX_MAX_SLOT_VALUE:
+      (void) attrset(palette[FULL]);
+      break;
+    default:
+      (void) attrset(palette[NORM]);
+  }
+  if (static_cast<int>(z) == current_channel)
+    attron(A_REVERSE);
+  switch (display_mode) {
+    case DISP_MODE_HEX:
+      if (d == 0) {
+        if (static_cast<int>(m_buffer.Size()) <= z) {
+          addstr("--- ");
+        } else {
+          addstr("    ");
+        }
+      } else {
+        printw(" %02x ", d);
+      }
+      break;
+    case DISP_MODE_DEC:
+      if (d == 0) {
+        if (static_cast<int>(m_buffer.Size()) <= z) {
+          addstr("--- ");
+        } else {
+          addstr("    ");
+        }
+      } else if (d < 100) {
+        printw(" %02d ", d);
+      } else {
+        printw("%03d ", d);
+      }
+      break;
+    case DISP_MODE_DMX:
+    default:
       switch (d) {
         case ola::DMX_MIN_SLOT_VALUE:
-          (void) attrset(palette[ZERO]);
-          break;
-        case ola::DMX_MAX_SLOT_VALUE:
-          (void) attrset(palette[FULL]);
-          break;
-        default:
-          (void) attrset(palette[NORM]);
-      }
-      if (static_cast<int>(z) == current_channel)
-        attron(A_REVERSE);
-      switch (display_mode) {
-        case DISP_MODE_HEX:
-          if (d == 0) {
-            if (static_cast<int>(m_buffer.Size()) <= z) {
-              addstr("--- ");
-            } else {
-              addstr("    ");
-            }
+          if (static_cast<int>(m_buffer.Size()) <= z) {
+            addstr("--- ");
           } else {
-            printw(" %02x ", d);
+            addstr("    ");
           }
           break;
-        case DISP_MODE_DEC:
-          if (d == 0) {
-            if (static_cast<int>(m_buffer.Size()) <= z) {
-              addstr("--- ");
-            } else {
-              addstr("    ");
-            }
-          } else if (d < 100) {
-            printw(" %02d ", d);
-          } else {
-            printw("%03d ", d);
-          }
+        case ola::DMX_MAX_SLOT_VALUE:
+          addstr(" FL ");
           break;
-        case DISP_MODE_DMX:
         default:
-          switch (d) {
-            case ola::DMX_MIN_SLOT_VALUE:
-              if (static_cast<int>(m_buffer.Size()) <= z) {
-                addstr("--- ");
-              } else {
-                addstr("    ");
-              }
-              break;
-            case ola::DMX_MAX_SLOT_VALUE:
-              addstr(" FL ");
-              break;
-            default:
-              printw(" %02d ", (d * 100) / ola::DMX_MAX_SLOT_VALUE);
-          }
+          printw(" %02d ", (d * 100) / ola::DMX_MAX_SLOT_VALUE);
       }
-    }
   }
 }
 
@@ -28,6 +28,8 @@
 #include <ola/base/Init.h>
 #include <ola/thread/SignalThread.h>
 
+#include <algorithm>
+#include <vector>
 #include <iostream>
 #include <string>
 
@@ -63,6 +65,7 @@ class Tracker {
     uint32_t m_count;
     uint64_t m_sum;
     TimeInterval m_max;
+    std::vector<uint64_t> m_latencies_usecs;
     ola::DmxBuffer m_buffer;
     OlaCallbackClientWrapper m_wrapper;
     ola::Clock m_clock;
@@ -72,6 +75,7 @@ class Tracker {
     void SendRequest();
     void LogTime();
     void StartSignalThread();
+    uint64_t Percentile(unsigned int pct) const;
 };
 
 bool Tracker::Setup() {
@@ -98,6 +102,37 @@ void Tracker::Start() {
   cout << "Sent " << m_count << " RPCs" << endl;
   cout << "Max was " << m_max.MicroSeconds() << " microseconds" << endl;
   cout << "Mean " << m_sum / m_count << " microseconds" << endl;
+
+  if (!m_latencies_usecs.empty()) {
+    std::sort(m_latencies_usecs.begin(), m_latencies_usecs.end());
+    cout << "p50 " << Percentile(50) << " microseconds" << endl;
+    cout << "p95 " << Percentile(95) << " microseconds" << endl;
+    cout << "p99 " << Percentile(99) << " microseconds" << endl;
+    // jitter as the spread of the middle of the distribution
+    cout << "p95-p50 jitter " << (Percentile(95) - Percentile(50))
+         << " microseconds" << endl;
+
+    // a coarse log2 histogram so outliers are visible at a glance
+    cout << "histogram:" << endl;
+    uint64_t bucket_limit = 64;
+    size_t index = 0;
+    while (index < m_latencies_usecs.size()) {
+      size_t start = index;
+      while (index < m_latencies_usecs.size() &&
+             m_latencies_usecs[index] <= bucket_limit) {
+        index++;
+      }
+      if (index > start) {
+        cout << "  <= " << bucket_limit << "us: " << (index - start)
+             << endl;
+      }
+      bucket_limit *= 2;
+    }
+  }
+}
+
+uint64_t Tracker::Percentile(unsigned int pct) const {
+  return m_latencies_usecs[(m_latencies_usecs.size() - 1) * pct / 100];
 }
 
 void Tracker::GotDmx(const DmxBuffer &, const string &) {
@@ -131,6 +166,7 @@ void Tracker::LogTime() {
     m_max = delta;
   }
   m_sum += delta.MicroSeconds();
+  m_latencies_usecs.push_back(delta.MicroSeconds());
 
   OLA_INFO << "RPC took " << delta;
   if (FLAGS_count == ++m_count) {
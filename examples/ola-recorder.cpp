@@ -46,6 +46,9 @@ using std::string;
 
 DEFINE_s_string(playback, p, "", "The show file to playback.");
 DEFINE_s_string(record, r, "", "The show file to record data to.");
+DEFINE_default_bool(binary, false,
+                    "Record in the binary show format; loads much faster "
+                    "for long captures. Playback auto-detects the format.");
 DEFINE_string(verify, "", "The show file to verify.");
 DEFINE_s_string(universes, u, "",
                 "A comma separated list of universes to record");
@@ -81,7 +84,8 @@ int RecordShow() {
     universes.push_back(universe);
   }
 
-  ShowRecorder show_recorder(FLAGS_record.str(), universes);
+  ShowRecorder show_recorder(FLAGS_record.str(), FLAGS_binary,
+                             universes);
   int status = show_recorder.Init();
   if (status)
     return status;
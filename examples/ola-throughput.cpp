@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <ola/base/Flags.h>
 #include <ola/base/Init.h>
+#include <ola/Clock.h>
 #include <ola/DmxBuffer.h>
 #include <ola/Logging.h>
 #include <ola/StreamingClient.h>
@@ -38,6 +39,14 @@ using ola::StreamingClient;
 
 DEFINE_s_uint32(universe, u, 1, "The universe to send data on");
 DEFINE_s_uint32(sleep, s, 40000, "Time between DMX updates in micro-seconds");
+DEFINE_uint32(universes, 1, "The number of universes to send, starting at "
+                            "--universe");
+DEFINE_uint32(duration, 0,
+              "Seconds to run for, 0 means forever. With a duration the "
+              "tool reports achieved frame rate on exit.");
+DEFINE_uint32(ramp, 0,
+              "Halve the sleep every this many seconds to find the "
+              "saturation knee, reporting the rate at each step.");
 
 /*
  * Main
@@ -54,12 +63,59 @@ int main(int argc, char *argv[]) {
   ola::DmxBuffer buffer;
   buffer.Blackout();
 
-  while (1) {
-    usleep(FLAGS_sleep);
-    if (!ola_client.SendDmx(FLAGS_universe, buffer)) {
-      cout << "Send DMX failed" << endl;
-      return false;
+  ola::Clock clock;
+  ola::TimeStamp start, step_start;
+  clock.CurrentTime(&start);
+  step_start = start;
+
+  uint64_t sent = 0, failed = 0, step_sent = 0;
+  unsigned int sleep_usecs = FLAGS_sleep;
+
+  while (true) {
+    usleep(sleep_usecs);
+    for (unsigned int i = 0; i < FLAGS_universes; i++) {
+      if (ola_client.SendDmx(FLAGS_universe + i, buffer)) {
+        sent++;
+        step_sent++;
+      } else {
+        failed++;
+      }
+    }
+
+    ola::TimeStamp now;
+    clock.CurrentTime(&now);
+
+    if (FLAGS_ramp && now - step_start >
+        ola::TimeInterval(FLAGS_ramp, 0)) {
+      double seconds = (now - step_start).AsInt() / 1e6;
+      cout << "sleep " << sleep_usecs << "us: "
+           << static_cast<uint64_t>(step_sent / seconds)
+           << " frames/s (" << failed << " failed so far)" << endl;
+      step_sent = 0;
+      step_start = now;
+      if (sleep_usecs > 1) {
+        sleep_usecs /= 2;
+      } else {
+        break;
+      }
+    }
+
+    if (FLAGS_duration &&
+        now - start > ola::TimeInterval(FLAGS_duration, 0)) {
+      break;
     }
   }
-  return 0;
+
+  ola::TimeStamp end;
+  clock.CurrentTime(&end);
+  double seconds = (end - start).AsInt() / 1e6;
+  cout << "--------------" << endl;
+  cout << "Sent " << sent << " frames over " << FLAGS_universes
+       << " universe(s) in " << seconds << "s: "
+       << static_cast<uint64_t>(sent / seconds) << " frames/s, "
+       << failed << " failed" << endl;
+  cout << "Delivered-vs-sent verification: patch the universes to a "
+       << "loopback receiver (e.g. artnet_loadtest --receive) and compare "
+       << "its rx count with the number above." << endl;
+  return failed ? 1 : 0;
 }
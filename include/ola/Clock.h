@@ -224,6 +224,23 @@ class Clock {
   virtual ~Clock() {}
   virtual void CurrentTime(TimeStamp *timestamp) const;
 
+  /**
+   * @brief Fetch the current monotonic time, cheaply.
+   *
+   * Uses CLOCK_MONOTONIC_COARSE where the platform provides it: a ~1ms
+   * resolution read served from the vDSO without a timer-hardware access,
+   * which is plenty for token buckets, staleness checks and timeout
+   * registration. Falls back to CLOCK_MONOTONIC and then to the wall
+   * clock. Keep using CurrentTime() where sub-millisecond accuracy
+   * matters (latency instrumentation) or where the value is compared
+   * against wall-clock times.
+   *
+   * @note code running on the main loop should prefer
+   * SelectServerInterface::WakeUpTime(), which is one real read per
+   * iteration shared by everything in that iteration.
+   */
+  virtual void CurrentMonotonicTime(TimeStamp *timestamp) const;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Clock);
 };
@@ -241,6 +258,7 @@ class MockClock: public Clock {
   void AdvanceTime(int32_t sec, int32_t usec);
 
   void CurrentTime(TimeStamp *timestamp) const;
+  void CurrentMonotonicTime(TimeStamp *timestamp) const;
 
  private:
   TimeInterval m_offset;
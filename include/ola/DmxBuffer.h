@@ -33,6 +33,10 @@
 
 namespace ola {
 
+namespace dmx {
+class DmxBufferPool;
+}  // namespace dmx
+
 /**
  * @class DmxBuffer ola/DmxBuffer.h
  * @brief Used to hold a single universe of DMX data.
@@ -240,6 +244,23 @@ class DmxBuffer {
      */
     std::string Get() const;
 
+    /**
+     * @brief Get the range of slots modified since the last
+     * ClearDirtyRange().
+     * All the Set methods, Blackout() and HTPMerge() extend the dirty
+     * range, which lets consumers recompute or forward only the slots that
+     * changed.
+     * @param[out] start the first dirty slot
+     * @param[out] end one past the last dirty slot
+     * @return true if any slots are dirty, false if the buffer is clean
+     */
+    bool GetDirtyRange(unsigned int *start, unsigned int *end) const;
+
+    /**
+     * @brief Mark all slots as clean.
+     */
+    void ClearDirtyRange();
+
     /**
      * @brief Set the buffer to all zeros.
      * @post Size() == DMX_UNIVERSE_SIZE
@@ -265,14 +286,30 @@ class DmxBuffer {
     std::string ToString() const;
 
  private:
+    friend class ola::dmx::DmxBufferPool;
+
+    /**
+     * @brief Create a buffer backed by a DmxBufferPool.
+     * Only used by DmxBufferPool::Create().
+     */
+    DmxBuffer(ola::dmx::DmxBufferPool *pool,
+              uint8_t *data,
+              unsigned int *ref_count);
+
     bool Init();
     bool DuplicateIfNeeded();
     void CopyFromOther(const DmxBuffer &other);
     void CleanupMemory();
+    void MarkDirty(unsigned int offset, unsigned int length);
     unsigned int *m_ref_count;
     mutable bool m_copy_on_write;
     uint8_t *m_data;
     unsigned int m_length;
+    // Set if the backing store came from a DmxBufferPool.
+    ola::dmx::DmxBufferPool *m_pool;
+    // The dirty span, m_dirty_start >= m_dirty_end means clean.
+    unsigned int m_dirty_start;
+    unsigned int m_dirty_end;
 };
 
 /**
@@ -32,6 +32,7 @@
 
 #include <ola/base/Macro.h>
 #include <ola/StringUtils.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include <functional>
@@ -195,6 +196,216 @@ class CounterVariable: public BaseVariable {
 };
 
 
+/**
+ * @brief A counter that can be bumped from any thread.
+ *
+ * The count is split across a small set of cache-line-padded shards, each
+ * bumped with a relaxed atomic add; a thread picks its shard once and
+ * sticks with it, so concurrent writers on different cores don't bounce a
+ * line between them. Reads sum the shards, which makes Get() more
+ * expensive than CounterVariable::Get() - the right trade for packet-path
+ * instrumentation that's written millions of times and read once a second.
+ *
+ * Callers should resolve the variable once
+ * (ExportMap::GetAtomicCounterVar) and cache the pointer; the per-bump
+ * cost is then a single uncontended atomic add.
+ */
+class AtomicCounterVariable: public BaseVariable {
+ public:
+  explicit AtomicCounterVariable(const std::string &name)
+      : BaseVariable(name) {
+    for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+      m_shards[i].value = 0;
+    }
+  }
+  ~AtomicCounterVariable() {}
+
+  void Increment(uint64_t value = 1) {
+    __atomic_fetch_add(&m_shards[PickShard()].value, value, __ATOMIC_RELAXED);
+  }
+  void operator++(int) { Increment(); }
+  void operator+=(uint64_t value) { Increment(value); }
+
+  void Reset() {
+    for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+      __atomic_store_n(&m_shards[i].value, 0, __ATOMIC_RELAXED);
+    }
+  }
+
+  uint64_t Get() const {
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+      total += __atomic_load_n(&m_shards[i].value, __ATOMIC_RELAXED);
+    }
+    return total;
+  }
+
+  const std::string Value() const {
+    std::ostringstream out;
+    out << Get();
+    return out.str();
+  }
+
+ private:
+  enum { SHARD_COUNT = 16 };
+
+  // padded to a cache line so two threads on different shards don't
+  // false-share
+  struct Shard {
+    uint64_t value;
+    char padding[64 - sizeof(uint64_t)];
+  };
+
+  static unsigned int PickShard() {
+    static __thread unsigned int shard = 0;
+    if (!shard) {
+      static unsigned int next_shard = 0;
+      shard = 1 + __atomic_fetch_add(&next_shard, 1u, __ATOMIC_RELAXED)
+          % SHARD_COUNT;
+    }
+    return shard - 1;
+  }
+
+  Shard m_shards[SHARD_COUNT];
+};
+
+
+/**
+ * @brief A fixed-bucket, log-scale histogram for latency / jitter style
+ * measurements.
+ *
+ * Samples land in one of 32 preallocated power-of-two buckets (sample 0
+ * in bucket 0, then one bucket per bit position), so Record() is a
+ * leading-zero count and a relaxed atomic add - safe from any thread and
+ * cheap enough for per-packet use. Percentiles are estimated on read by
+ * walking the cumulative counts and reporting the bucket's upper bound,
+ * so they're accurate to within a factor of two, which is what you want
+ * from a log-scale histogram: the shape and the tail, not exact values.
+ *
+ * Value() renders a one-line text summary for /debug and ola_mon;
+ * JsonValue() renders the full bucket array for structured consumers.
+ * The unit is whatever the caller records - document it in the variable
+ * name (e.g. "ss-loop-time-us").
+ */
+class HistogramVariable: public BaseVariable {
+ public:
+  explicit HistogramVariable(const std::string &name)
+      : BaseVariable(name) {
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      m_buckets[i] = 0;
+    }
+    m_max = 0;
+  }
+  ~HistogramVariable() {}
+
+  /**
+   * @brief Record a sample. Safe from any thread.
+   */
+  void Record(uint64_t value) {
+    __atomic_fetch_add(&m_buckets[BucketFor(value)], 1, __ATOMIC_RELAXED);
+    uint64_t seen_max = __atomic_load_n(&m_max, __ATOMIC_RELAXED);
+    while (value > seen_max &&
+           !__atomic_compare_exchange_n(&m_max, &seen_max, value, true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+  }
+
+  void Reset() {
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      __atomic_store_n(&m_buckets[i], 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&m_max, 0, __ATOMIC_RELAXED);
+  }
+
+  uint64_t Count() const {
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      total += __atomic_load_n(&m_buckets[i], __ATOMIC_RELAXED);
+    }
+    return total;
+  }
+
+  uint64_t Max() const {
+    return __atomic_load_n(&m_max, __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief Estimate a percentile from the bucket counts.
+   * @param percentile the percentile, 0 - 100.
+   * @returns the upper bound of the bucket the percentile falls in, or 0
+   * if nothing has been recorded.
+   */
+  uint64_t EstimatePercentile(unsigned int percentile) const {
+    uint64_t total = Count();
+    if (!total) {
+      return 0;
+    }
+    uint64_t target = (total * percentile + 99) / 100;
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      seen += __atomic_load_n(&m_buckets[i], __ATOMIC_RELAXED);
+      if (seen >= target) {
+        return BucketUpperBound(i);
+      }
+    }
+    return Max();
+  }
+
+  /**
+   * @brief A one line summary, suitable for /debug and ola_mon.
+   */
+  const std::string Value() const {
+    std::ostringstream out;
+    out << "count:" << Count()
+        << " p50:" << EstimatePercentile(50)
+        << " p90:" << EstimatePercentile(90)
+        << " p99:" << EstimatePercentile(99)
+        << " max:" << Max();
+    return out.str();
+  }
+
+  /**
+   * @brief The full histogram as a JSON object.
+   */
+  const std::string JsonValue() const {
+    std::ostringstream out;
+    out << "{\"count\":" << Count()
+        << ",\"p50\":" << EstimatePercentile(50)
+        << ",\"p90\":" << EstimatePercentile(90)
+        << ",\"p99\":" << EstimatePercentile(99)
+        << ",\"max\":" << Max()
+        << ",\"buckets\":[";
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      if (i) {
+        out << ",";
+      }
+      out << __atomic_load_n(&m_buckets[i], __ATOMIC_RELAXED);
+    }
+    out << "]}";
+    return out.str();
+  }
+
+ private:
+  enum { BUCKET_COUNT = 32 };
+
+  static unsigned int BucketFor(uint64_t value) {
+    if (!value) {
+      return 0;
+    }
+    unsigned int bucket = 64 - __builtin_clzll(value);
+    return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+  }
+
+  static uint64_t BucketUpperBound(unsigned int bucket) {
+    return bucket ? (1ull << bucket) - 1 : 0;
+  }
+
+  uint64_t m_buckets[BUCKET_COUNT];
+  uint64_t m_max;
+};
+
+
 /*
  * A Map variable holds string -> type mappings
  */
@@ -356,6 +567,28 @@ class ExportMap {
    */
   CounterVariable *GetCounterVar(const std::string &name);
 
+  /**
+   * @brief Lookup or create an AtomicCounterVariable, safe to bump from
+   * any thread.
+   * @param name the name of this variable.
+   * @return an AtomicCounterVariable.
+   *
+   * The variable is created if it doesn't already exist. The pointer is
+   * valid for the lifetime of the ExportMap; cache it rather than
+   * resolving the name per update.
+   */
+  AtomicCounterVariable *GetAtomicCounterVar(const std::string &name);
+
+  /**
+   * @brief Lookup or create a HistogramVariable.
+   * @param name the name of this variable.
+   * @return a HistogramVariable.
+   *
+   * The variable is created if it doesn't already exist. The pointer is
+   * valid for the lifetime of the ExportMap.
+   */
+  HistogramVariable *GetHistogramVar(const std::string &name);
+
   /**
    * @brief Lookup or create a StringVariable.
    * @param name the name of this variable.
@@ -388,6 +621,8 @@ class ExportMap {
                   const std::string &name,
                   const std::string &label);
 
+  std::map<std::string, AtomicCounterVariable*> m_atomic_counter_variables;
+  std::map<std::string, HistogramVariable*> m_histogram_variables;
   std::map<std::string, BoolVariable*> m_bool_variables;
   std::map<std::string, CounterVariable*> m_counter_variables;
   std::map<std::string, IntegerVariable*> m_int_variables;
@@ -44,6 +44,9 @@
 #ifndef INCLUDE_OLA_LOGGING_H_
 #define INCLUDE_OLA_LOGGING_H_
 
+#include <stdint.h>
+#include <time.h>
+
 #include <ostream>
 #include <string>
 #include <sstream>
@@ -88,6 +91,29 @@
  */
 #define OLA_DEBUG OLA_LOG(ola::OLA_LOG_DEBUG)
 
+/**
+ * Rate-limited log statement for per-packet warning sites. Each use of the
+ * macro gets its own static token bucket (5 lines, refilled one per
+ * second), so pathological traffic can't turn a hot warning into the
+ * bottleneck: the first few lines and a periodic sample always get
+ * through, and when a line does get through after suppression it's
+ * prefixed with the number of lines that didn't.
+ *
+ * Expands to more than one statement - always use inside braces.
+ * @code
+ *     OLA_WARN_RATE_LIMITED << "bad sequence number from " << source;
+ * @endcode
+ */
+#define OLA_LOG_RATE_LIMITED(level) \
+  static ola::LogSiteLimiter ola_log_site_limiter; \
+  (level <= ola::LogLevel()) && \
+      ola_log_site_limiter.Allow() && \
+      ola::LogLine(__FILE__, __LINE__, level).stream() \
+          << ola_log_site_limiter.SuppressionReport()
+
+#define OLA_WARN_RATE_LIMITED OLA_LOG_RATE_LIMITED(ola::OLA_LOG_WARN)
+#define OLA_INFO_RATE_LIMITED OLA_LOG_RATE_LIMITED(ola::OLA_LOG_INFO)
+
 namespace ola {
 
 /**
@@ -104,6 +130,86 @@ enum log_level {
   OLA_LOG_MAX,
 };
 
+/**
+ * @brief The per-call-site state behind OLA_LOG_RATE_LIMITED.
+ *
+ * A token bucket: BURST_SIZE lines may pass back to back, then one per
+ * second. Everything is relaxed atomics, so a site being hammered from
+ * several threads stays cheap; a token miscounted in a race costs one
+ * line either way, which doesn't matter for a limiter.
+ */
+class LogSiteLimiter {
+ public:
+  LogSiteLimiter() : m_tokens(BURST_SIZE), m_last_refill(0),
+                     m_suppressed(0) {}
+
+  /**
+   * @brief Returns true if this line should be logged.
+   */
+  bool Allow() {
+    Refill();
+    int32_t tokens = __atomic_load_n(&m_tokens, __ATOMIC_RELAXED);
+    while (tokens > 0 &&
+           !__atomic_compare_exchange_n(&m_tokens, &tokens, tokens - 1,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+    if (tokens > 0) {
+      return true;
+    }
+    __atomic_fetch_add(&m_suppressed, 1u, __ATOMIC_RELAXED);
+    return false;
+  }
+
+  /**
+   * @brief A prefix reporting lines suppressed since the last one that got
+   * through, or the empty string. Resets the suppressed count.
+   */
+  std::string SuppressionReport() {
+    uint32_t suppressed =
+        __atomic_exchange_n(&m_suppressed, 0u, __ATOMIC_RELAXED);
+    if (!suppressed) {
+      return "";
+    }
+    std::ostringstream str;
+    str << "(" << suppressed << " similar suppressed) ";
+    return str.str();
+  }
+
+ private:
+  static const int32_t BURST_SIZE = 5;
+
+  void Refill() {
+    int64_t now = static_cast<int64_t>(time(NULL));
+    int64_t last = __atomic_load_n(&m_last_refill, __ATOMIC_RELAXED);
+    if (now == last) {
+      return;
+    }
+    if (!__atomic_compare_exchange_n(&m_last_refill, &last, now, false,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      return;  // another thread owns this refill
+    }
+    int64_t add = last ? now - last : static_cast<int64_t>(BURST_SIZE);
+    if (add > BURST_SIZE) {
+      add = BURST_SIZE;
+    }
+    int32_t tokens = __atomic_load_n(&m_tokens, __ATOMIC_RELAXED);
+    while (tokens < BURST_SIZE &&
+           !__atomic_compare_exchange_n(
+               &m_tokens, &tokens,
+               static_cast<int32_t>(
+                   tokens + add > BURST_SIZE
+                       ? static_cast<int64_t>(BURST_SIZE)
+                       : tokens + add),
+               true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+  }
+
+  int32_t m_tokens;
+  int64_t m_last_refill;
+  uint32_t m_suppressed;
+};
+
 /**
  * @private
  * @brief Application global logging level
@@ -138,6 +244,59 @@ class LogDestination {
   virtual void Write(log_level level, const std::string &log_line) = 0;
 };
 
+/**
+ * @brief A LogDestination that decouples the caller from the actual write.
+ *
+ * Log lines are copied into a bounded, preallocated ring and written to the
+ * wrapped destination by a background thread. This keeps a burst of
+ * warnings (e.g. malformed packets during a network storm) from stalling
+ * the main loop on synchronous I/O; if the ring fills, lines are dropped
+ * and a summary line is emitted once the writer catches up. The trade off
+ * is that lines may be lost if the process dies before the writer drains
+ * the ring.
+ */
+class AsyncLogDestination: public LogDestination {
+ public:
+  /**
+   * @brief Create a new AsyncLogDestination.
+   * @param destination the LogDestination to write to from the background
+   *   thread, ownership is transferred.
+   * @param ring_size the number of log lines to buffer.
+   */
+  explicit AsyncLogDestination(LogDestination *destination,
+                               unsigned int ring_size = DEFAULT_RING_SIZE);
+  ~AsyncLogDestination();
+
+  /**
+   * @brief Start the writer thread.
+   * @returns true if the thread started.
+   */
+  bool Start();
+
+  /**
+   * @brief Drain the ring and stop the writer thread.
+   */
+  void Stop();
+
+  /**
+   * @brief Queue a message for the background writer.
+   *
+   * This copies the line into a preallocated slot and never blocks on I/O;
+   * if the ring is full the line is counted as dropped instead.
+   */
+  void Write(log_level level, const std::string &log_line);
+
+  /**
+   * @brief The number of lines dropped because the ring was full.
+   */
+  uint64_t DroppedLines() const;
+
+  static const unsigned int DEFAULT_RING_SIZE = 1024;
+
+ private:
+  class AsyncLogWriter *m_writer;
+};
+
 /**
  * @brief A LogDestination that writes to stderr
  */
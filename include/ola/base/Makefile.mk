@@ -8,4 +8,5 @@ olabaseinclude_HEADERS = \
     include/ola/base/Init.h \
     include/ola/base/Macro.h \
     include/ola/base/SysExits.h \
+    include/ola/base/TraceRing.h \
     include/ola/base/Version.h
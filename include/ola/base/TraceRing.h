@@ -0,0 +1,118 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TraceRing.h
+ * A fixed-size in-memory ring of trace events, for postmortem debugging.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_BASE_TRACERING_H_
+#define INCLUDE_OLA_BASE_TRACERING_H_
+
+#include <ola/base/Macro.h>
+#include <stdint.h>
+
+#include <ostream>
+
+namespace ola {
+
+/**
+ * @brief A flight recorder: a fixed ring of compact trace events that key
+ * points on the frame path emit into, so that when a glitch is reported
+ * after the fact the last few seconds of activity can be reconstructed.
+ *
+ * Emit() claims a slot with a relaxed atomic increment and writes a
+ * (timestamp, event, arg) triple - no locks, no allocations, tens of
+ * nanoseconds - so it's cheap enough to leave on at full show load. The
+ * ring wraps; only the most recent RING_SIZE events are retained.
+ *
+ * A dump iterates the live ring without stopping writers, so an entry
+ * being overwritten mid-dump can appear torn. That's the accepted trade
+ * for a recorder that never stalls the path it's observing; torn entries
+ * are rare and obvious (wildly out-of-order timestamps).
+ */
+class TraceRing {
+ public:
+  enum Event {
+    EVENT_NONE = 0,
+    EVENT_PACKET_IN = 1,     /**< arg: universe */
+    EVENT_MERGE_START = 2,   /**< arg: universe */
+    EVENT_MERGE_END = 3,     /**< arg: universe */
+    EVENT_PORT_FLUSH = 4,    /**< arg: universe */
+    EVENT_RPC_DISPATCH = 5,  /**< arg: method index */
+    EVENT_LOOP_STALL = 6,    /**< arg: stall length in us */
+    EVENT_USER = 7,          /**< arg: caller defined */
+  };
+
+  /**
+   * @brief The process-wide ring.
+   */
+  static TraceRing *Instance();
+
+  /**
+   * @brief Record an event. Safe from any thread, never blocks.
+   * @param event one of the Event values.
+   * @param arg event specific context, e.g. the universe id.
+   */
+  void Emit(uint16_t event, uint64_t arg);
+
+  /**
+   * @brief Write the ring contents, oldest first, as text.
+   * @param output where to write the dump.
+   */
+  void Dump(std::ostream *output) const;
+
+  /**
+   * @brief Dump the ring via the logging system, at warning level so it
+   * survives the default log filter. Wired to SIGUSR2 in olad and to
+   * watchdog triggers.
+   */
+  void DumpToLog();
+
+  /**
+   * @brief The total number of events emitted since startup.
+   */
+  uint64_t EventCount() const;
+
+  /**
+   * @brief The name of an event, for rendering dumps.
+   */
+  static const char *EventName(uint16_t event);
+
+ private:
+  struct TraceEvent {
+    uint64_t timestamp_ns;  // CLOCK_MONOTONIC
+    uint64_t arg;
+    uint32_t event;
+  };
+
+  enum { RING_SIZE = 16384 };  // must be a power of 2
+
+  TraceRing();
+
+  TraceEvent m_events[RING_SIZE];
+  uint64_t m_next;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceRing);
+};
+
+/**
+ * @brief Shorthand for emitting to the process-wide ring.
+ */
+inline void Trace(uint16_t event, uint64_t arg) {
+  TraceRing::Instance()->Emit(event, arg);
+}
+}  // namespace ola
+#endif  // INCLUDE_OLA_BASE_TRACERING_H_
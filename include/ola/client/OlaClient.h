@@ -33,7 +33,10 @@
 #include <ola/timecode/TimeCode.h>
 
 #include <memory>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ola {
 namespace client {
@@ -238,6 +241,31 @@ class OlaClient {
                const DmxBuffer &data,
                const SendDMXArgs &args);
 
+  /**
+   * @brief Send DMX data for many universes in one message.
+   * @param frames the (universe, data) pairs to send.
+   * @param priority the priority to use for all the frames.
+   */
+  void SendDMXBatch(
+      const std::vector<std::pair<unsigned int, DmxBuffer> > &frames,
+      uint8_t priority);
+
+  /**
+   * @brief Subscribe to incremental universe change events.
+   * The client maintains a local cache queried with CachedUniverses(), so
+   * a UI can refresh without re-fetching the full universe list. The
+   * callback runs with the universe id after each delta; it may be NULL.
+   * Ownership of the callback is transferred.
+   */
+  void SubscribeUniverseChanges(
+      ola::Callback1<void, unsigned int> *callback);
+
+  /**
+   * @brief The locally cached universe state, maintained from server
+   * deltas.
+   */
+  const std::map<unsigned int, OlaUniverse> &CachedUniverses() const;
+
   /**
    * @brief Fetch the latest DMX data for a universe.
    * @param universe the universe id to get data for.
@@ -97,7 +97,11 @@ class StreamingClient : public StreamingClientInterface {
      * Create a new options structure with the default options. This
      * includes automatically starting olad if it's not already running.
      */
-    Options() : auto_start(true), server_port(OLA_DEFAULT_PORT) {}
+    Options()
+        : auto_start(true),
+          server_port(OLA_DEFAULT_PORT),
+          use_compact_frames(false) {
+    }
 
     /**
      * If true, the client will automatically start olad if it's not
@@ -109,6 +113,13 @@ class StreamingClient : public StreamingClientInterface {
      * The RPC port olad is listening on.
      */
     uint16_t server_port;
+
+    /**
+     * If true, frames are sent in the fixed-layout encoding instead of
+     * protobuf, skipping the per-frame varint encode. Requires a server
+     * from the same release or later.
+     */
+    bool use_compact_frames;
   };
 
   /**
@@ -169,6 +180,7 @@ class StreamingClient : public StreamingClientInterface {
  private:
   bool m_auto_start;
   uint16_t m_server_port;
+  bool m_use_compact_frames;
   ola::network::TCPSocket *m_socket;
   ola::io::SelectServer *m_ss;
   class ola::rpc::RpcChannel *m_channel;
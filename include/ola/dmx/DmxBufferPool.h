@@ -0,0 +1,102 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DmxBufferPool.h
+ * Header file for the DmxBufferPool class.
+ * Copyright (C) 2005 Simon Newton
+ */
+
+/**
+ * @file DmxBufferPool.h
+ * @brief A pool that recycles the backing store of DmxBuffers.
+ */
+
+#ifndef INCLUDE_OLA_DMX_DMXBUFFERPOOL_H_
+#define INCLUDE_OLA_DMX_DMXBUFFERPOOL_H_
+
+#include <ola/DmxBuffer.h>
+#include <ola/io/MemoryBlockPool.h>
+#include <map>
+
+namespace ola {
+namespace dmx {
+
+/**
+ * @class DmxBufferPool ola/dmx/DmxBufferPool.h
+ * @brief Hands out DmxBuffers whose backing store is recycled through a
+ * ola::io::MemoryBlockPool.
+ *
+ * A DmxBuffer normally allocates its 512 byte slot array and reference count
+ * from the heap, and the copy-on-write path allocates again each time a
+ * shared buffer diverges. At high frame rates across many universes this is
+ * a large amount of allocator traffic. Buffers created from a pool draw
+ * their backing store from the pool instead, and return it when the last
+ * reference is dropped, so the steady state does no heap allocation at all.
+ *
+ * Like MemoryBlockPool this class is <b>NOT</b> thread safe. Use one pool
+ * per thread and keep pooled buffers (and copies of them) on the thread
+ * that owns the pool. The pool must outlive all buffers created from it.
+ */
+class DmxBufferPool {
+ public:
+    /**
+     * @brief Create a new DmxBufferPool.
+     * @param buffers_to_reserve the number of buffer backings to
+     * pre-allocate.
+     */
+    explicit DmxBufferPool(unsigned int buffers_to_reserve = 0);
+
+    /**
+     * @brief Destructor, this frees the pooled memory.
+     * @pre all buffers created from this pool have been destroyed.
+     */
+    ~DmxBufferPool();
+
+    /**
+     * @brief Create an empty DmxBuffer backed by this pool.
+     * @returns a DmxBuffer with Size() == 0.
+     */
+    DmxBuffer Create();
+
+    /**
+     * @brief The number of free buffer backings in the pool.
+     */
+    unsigned int FreeBuffers() const { return m_pool.FreeBlocks(); }
+
+    /**
+     * @brief The total number of buffer backings allocated by the pool.
+     */
+    unsigned int BuffersAllocated() const { return m_pool.BlocksAllocated(); }
+
+    /**
+     * @brief Delete all free buffer backings.
+     */
+    void Purge() { m_pool.Purge(); }
+
+ private:
+    friend class ola::DmxBuffer;
+
+    // Called by DmxBuffer when it needs a new backing store.
+    bool AllocateBacking(uint8_t **data, unsigned int **ref_count);
+    // Called by DmxBuffer when the last reference to a backing is dropped.
+    void ReleaseBacking(uint8_t *data);
+
+    ola::io::MemoryBlockPool m_pool;
+    // Maps the slot-data pointer back to the MemoryBlock it was carved from.
+    std::map<uint8_t*, ola::io::MemoryBlock*> m_blocks_in_use;
+};
+}  // namespace dmx
+}  // namespace ola
+#endif  // INCLUDE_OLA_DMX_DMXBUFFERPOOL_H_
@@ -1,4 +1,6 @@
 oladmxincludedir = $(pkgincludedir)/dmx/
 oladmxinclude_HEADERS = \
+    include/ola/dmx/DmxBufferPool.h \
+    include/ola/dmx/MergeKernel.h \
     include/ola/dmx/RunLengthEncoder.h \
     include/ola/dmx/SourcePriorities.h
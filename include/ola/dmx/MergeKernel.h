@@ -0,0 +1,57 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MergeKernel.h
+ * Header file for the slot merge kernels.
+ * Copyright (C) 2005 Simon Newton
+ */
+
+/**
+ * @file MergeKernel.h
+ * @brief Low level kernels used to merge DMX slot data.
+ *
+ * On platforms with vector units (SSE2 / AVX2 on x86, NEON on ARM) the HTP
+ * merge of a 512 slot frame is performed with wide unsigned-max operations
+ * rather than a per-slot compare. The best kernel for the host CPU is picked
+ * once at startup, with a scalar fallback on everything else.
+ */
+
+#ifndef INCLUDE_OLA_DMX_MERGEKERNEL_H_
+#define INCLUDE_OLA_DMX_MERGEKERNEL_H_
+
+#include <stdint.h>
+
+namespace ola {
+namespace dmx {
+
+/**
+ * @brief HTP (highest takes precedence) merge a run of slots.
+ * @param[in,out] dest the slots to merge into.
+ * @param src the slots to merge from.
+ * @param length the number of slots to merge.
+ *
+ * After the call, each slot in dest holds max(dest[i], src[i]). The regions
+ * must not overlap, neither needs to be aligned.
+ */
+void HTPMergeSlots(uint8_t *dest, const uint8_t *src, unsigned int length);
+
+/**
+ * @brief The name of the merge kernel selected for this host.
+ * @returns one of "avx2", "sse2", "neon" or "scalar".
+ */
+const char *MergeKernelName();
+}  // namespace dmx
+}  // namespace ola
+#endif  // INCLUDE_OLA_DMX_MERGEKERNEL_H_
@@ -68,6 +68,15 @@ class MessageBuilder {
     const CID m_cid;
     const string m_source_name;
     ola::io::MemoryBlockPool m_memory_pool;
+    // invariant framing, assembled once: the packed CID and the E1.33
+    // PDU header with the 64 byte source name pre-filled. Per message
+    // only the sequence and endpoint are patched.
+    string m_packed_cid;
+    string m_e133_header_template;
+
+    void PrependE133Header(IOStack *packet, uint32_t vector,
+                           uint32_t sequence_number, uint16_t endpoint_id);
+    void PrependRoot(IOStack *packet);
 
     DISALLOW_COPY_AND_ASSIGN(MessageBuilder);
 };
@@ -22,6 +22,8 @@
 #ifndef INCLUDE_OLA_HTTP_HTTPSERVER_H_
 #define INCLUDE_OLA_HTTP_HTTPSERVER_H_
 
+#include <ola/Clock.h>
+#include <ola/thread/Mutex.h>
 #include <ola/Callback.h>
 #include <ola/base/Macro.h>
 #include <ola/io/Descriptor.h>
@@ -129,6 +131,15 @@ class HTTPResponse {
  * This is a simple HTTP Server built around libmicrohttpd. It runs in a
  * separate thread.
  *
+ * All responses are built and sent synchronously from the handler; there's
+ * no connection-suspension support, which is the prerequisite for an SSE /
+ * websocket push channel. Adding push means running libmicrohttpd with
+ * MHD_USE_SUSPEND_RESUME, parking subscriber connections, and waking them
+ * from the daemon loop when a universe delta arrives (the UniverseStore
+ * change callback provides exactly that trigger); the JS client also has
+ * to switch from interval polling to an EventSource. Until then, pollers
+ * should lean on cached responses rather than rebuilding JSON per poll.
+ *
  * @examplepara
  * @code
  *   HTTPServer::HTTPServerOptions options;
@@ -242,12 +253,51 @@ class HTTPServer: public ola::thread::Thread {
   SocketSet m_sockets;
 
   std::map<std::string, BaseHTTPCallback*> m_handlers;
+  // static assets cached in memory after the first read, with their ETags
+  std::map<std::string, CachedFile> m_static_content_cache;
+
+ public:
+  /**
+   * @brief Per-handler service statistics.
+   */
+  struct HandlerStats {
+    uint64_t requests;
+    uint64_t total_usecs;
+    uint64_t max_usecs;
+    HandlerStats() : requests(0), total_usecs(0), max_usecs(0) {}
+  };
+
+  /**
+   * @brief Copy the per-handler stats. Thread safe.
+   */
+  void GetHandlerStats(std::map<std::string, HandlerStats> *stats);
+
+ private:
+  void RecordHandlerTime(const std::string &url,
+                         const ola::TimeStamp &start_time,
+                         const ola::Clock &clock);
+
+  static const int64_t SLOW_REQUEST_THRESHOLD_USECS = 100000;  // 100ms
+
+ public:
+
+ private:
+  // per-URL service timing, guarded by m_stats_mutex (handlers run on
+  // the libmicrohttpd thread)
+  std::map<std::string, HandlerStats> m_handler_stats;
+  ola::thread::Mutex m_stats_mutex;
   std::map<std::string, static_file_info> m_static_content;
   BaseHTTPCallback *m_default_handler;
   unsigned int m_port;
   std::string m_data_dir;
 
+  struct CachedFile {
+    std::string data;
+    std::string etag;
+  };
+
   int ServeStaticContent(static_file_info *file_info,
+                         const HTTPRequest *request,
                          HTTPResponse *response);
 
   void InsertSocket(bool is_readable, bool is_writeable, int fd);
@@ -0,0 +1,141 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * BackloggedWriter.h
+ * Writes to a non-blocking descriptor with a bounded backlog.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_IO_BACKLOGGEDWRITER_H_
+#define INCLUDE_OLA_IO_BACKLOGGEDWRITER_H_
+
+#include <ola/base/Macro.h>
+#include <ola/io/Descriptor.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace ola {
+namespace io {
+
+/**
+ * @brief Writes to a non-blocking serial descriptor, keeping bytes the
+ * device can't absorb right now in a bounded backlog.
+ *
+ * Cheap serial links (57.6k Renards, USB widgets on flaky hubs) stall
+ * for milliseconds at a time; a plain Send() then either blocks the main
+ * loop or silently truncates the frame. The writer keeps ordering - once
+ * anything is backlogged, later writes queue behind it - and flushes
+ * opportunistically ahead of each new write, so one slow device degrades
+ * only its own output. When the backlog exceeds the bound the Write()
+ * calls return false and the caller decides whether to drop frames or
+ * disconnect.
+ */
+class BackloggedWriter {
+ public:
+  /**
+   * @brief Create a new BackloggedWriter.
+   * @param descriptor the descriptor to write to, may be NULL until
+   * SetDescriptor() is called.
+   * @param max_backlog the backlog bound in bytes.
+   */
+  explicit BackloggedWriter(ConnectedDescriptor *descriptor = NULL,
+                            unsigned int max_backlog = DEFAULT_MAX_BACKLOG)
+      : m_descriptor(descriptor),
+        m_max_backlog(max_backlog),
+        m_bytes_sent(0) {
+  }
+
+  /**
+   * @brief Set (or clear) the descriptor to write to.
+   *
+   * Clearing drops the backlog; it belonged to the old device.
+   */
+  void SetDescriptor(ConnectedDescriptor *descriptor) {
+    m_descriptor = descriptor;
+    m_backlog.clear();
+  }
+
+  /**
+   * @brief Write, backlogging whatever the device can't take right now.
+   * @returns true if the backlog is within its bound, false if the
+   * device has fallen too far behind.
+   */
+  bool Write(const uint8_t *data, unsigned int length) {
+    if (!m_descriptor) {
+      return false;
+    }
+    Flush();
+
+    if (!m_backlog.empty()) {
+      // keep ordering; everything goes behind the backlog
+      m_backlog.append(reinterpret_cast<const char*>(data), length);
+      return m_backlog.size() <= m_max_backlog;
+    }
+
+    ssize_t bytes_sent = m_descriptor->Send(data, length);
+    if (bytes_sent < 0) {
+      bytes_sent = 0;
+    }
+    m_bytes_sent += bytes_sent;
+    if (static_cast<unsigned int>(bytes_sent) < length) {
+      m_backlog.append(reinterpret_cast<const char*>(data) + bytes_sent,
+                       length - bytes_sent);
+      return m_backlog.size() <= m_max_backlog;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Try to drain the backlog.
+   * @returns true if the backlog is within its bound.
+   */
+  bool Flush() {
+    if (m_backlog.empty()) {
+      return true;
+    }
+    ssize_t bytes_sent = m_descriptor->Send(
+        reinterpret_cast<const uint8_t*>(m_backlog.data()),
+        static_cast<unsigned int>(m_backlog.size()));
+    if (bytes_sent > 0) {
+      m_bytes_sent += bytes_sent;
+      m_backlog.erase(0, bytes_sent);
+    }
+    return m_backlog.size() <= m_max_backlog;
+  }
+
+  /**
+   * @brief True if nothing is waiting in the backlog.
+   */
+  bool Empty() const { return m_backlog.empty(); }
+
+  /**
+   * @brief The bytes handed to the descriptor so far.
+   */
+  uint64_t BytesSent() const { return m_bytes_sent; }
+
+  static const unsigned int DEFAULT_MAX_BACKLOG = 64 * 1024;
+
+ private:
+  ConnectedDescriptor *m_descriptor;
+  const unsigned int m_max_backlog;
+  std::string m_backlog;
+  uint64_t m_bytes_sent;
+
+  DISALLOW_COPY_AND_ASSIGN(BackloggedWriter);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // INCLUDE_OLA_IO_BACKLOGGEDWRITER_H_
@@ -28,6 +28,7 @@
 #include <deque>
 #include <iostream>
 #include <queue>
+#include <vector>
 #include <string>
 
 namespace ola {
@@ -62,6 +63,24 @@ class IOQueue: public InputBufferInterface,
 
     // From IOVecInterface
     const struct IOVec *AsIOVec(int *io_count) const;
+    void FreeIOVec(const struct IOVec *iov);
+
+    /**
+     * @brief Reserve writable space at the tail of the queue.
+     * @param[out] size set to the number of bytes that may be written to
+     * the returned pointer.
+     * @returns a pointer to the writable region.
+     *
+     * Fill the region (e.g. with a readv/recv straight off a socket) and
+     * then call Commit() with the number of bytes actually written, so
+     * received data lands in its final block with no bounce buffer.
+     */
+    uint8_t *Reserve(unsigned int *size);
+
+    /**
+     * @brief Commit bytes written into the region from Reserve().
+     */
+    void Commit(unsigned int length);
     void Pop(unsigned int n);
 
     // Append a MemoryBlock to this IOQueue. Ownership of the block is taken.
@@ -87,8 +106,14 @@ class IOQueue: public InputBufferInterface,
     bool m_delete_pool;
 
     BlockVector m_blocks;
+    // scratch space for AsIOVec, reused between flushes
+    mutable std::vector<struct IOVec> m_iovec;
+    // A drained block retained for the next append, so the steady state
+    // write/flush cycle doesn't round-trip through the pool.
+    class MemoryBlock *m_spare_block;
 
     void AppendBlock();
+    void ReleaseBlock(class MemoryBlock *block);
 
     // no copying / assignment for now
     IOQueue(const IOQueue&);
@@ -28,6 +28,7 @@
 #include <deque>
 #include <iostream>
 #include <queue>
+#include <vector>
 #include <string>
 
 namespace ola {
@@ -61,6 +62,7 @@ class IOStack: public IOVecInterface,
 
     // From IOVecInterface
     const struct IOVec *AsIOVec(int *io_count) const;
+    void FreeIOVec(const struct IOVec *iov);
     void Pop(unsigned int n);
 
     // 0-copy append to an IOQueue
@@ -78,6 +80,8 @@ class IOStack: public IOVecInterface,
     bool m_delete_pool;
 
     BlockVector m_blocks;
+    // scratch space for AsIOVec, reused between flushes
+    mutable std::vector<struct IOVec> m_iovec;
 
     void PrependBlock();
 
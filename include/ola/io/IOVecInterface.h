@@ -66,9 +66,12 @@ class IOVecInterface {
     virtual void Pop(unsigned int bytes) = 0;
 
     /*
-     * Frees the IOVec array returned by AsIOVec()
+     * Frees the IOVec array returned by AsIOVec().
+     * Implementations that hand out internal scratch storage from
+     * AsIOVec() override this to a no-op, so repeated flushes don't
+     * allocate.
      */
-    static void FreeIOVec(const struct IOVec *iov) {
+    virtual void FreeIOVec(const struct IOVec *iov) {
       if (iov)
         delete[] iov;
     }
@@ -1,5 +1,6 @@
 olaioincludedir = $(pkgincludedir)/io/
 olaioinclude_HEADERS = \
+    include/ola/io/BackloggedWriter.h \
     include/ola/io/BigEndianStream.h \
     include/ola/io/Descriptor.h \
     include/ola/io/ExtendedSerial.h \
@@ -16,6 +17,9 @@ olaioinclude_HEADERS = \
     include/ola/io/OutputBuffer.h \
     include/ola/io/OutputStream.h \
     include/ola/io/SelectServer.h \
+    include/ola/io/StallWatchdog.h \
     include/ola/io/SelectServerInterface.h \
+    include/ola/io/SelectServerThread.h \
+    include/ola/io/ShmFrameRing.h \
     include/ola/io/Serial.h \
     include/ola/io/StdinHandler.h
@@ -61,6 +61,15 @@ class MemoryBlock {
       delete[] m_data;
     }
 
+    /**
+     * @brief Extend the valid data region by length bytes, after the
+     * caller wrote directly into the block (see IOQueue::Reserve).
+     */
+    void SeekForward(unsigned int length) {
+      m_last += std::min(
+          length, static_cast<unsigned int>(m_data_end - m_last));
+    }
+
     /**
      * @brief Move the insertation point to the end of the block.
      * This is useful if you want to use the block in pre-pend mode.
@@ -21,54 +21,69 @@
 #ifndef INCLUDE_OLA_IO_MEMORYBLOCKPOOL_H_
 #define INCLUDE_OLA_IO_MEMORYBLOCKPOOL_H_
 
+#include <ola/ExportMap.h>
 #include <ola/Logging.h>
 #include <ola/io/MemoryBlock.h>
+#include <ola/thread/Mutex.h>
 #include <queue>
+#include <string>
+#include <vector>
 
 namespace ola {
 namespace io {
 
 /**
- * @brief MemoryBlockPool. This class is not thread safe.
- * @param block_size the size of blocks to use.
+ * @brief MemoryBlockPool. This class is not thread safe, see
+ * ThreadSafeMemoryBlockPool for sharing a pool between threads.
+ *
+ * The pool has two size classes: small blocks for tiny control frames and
+ * full size blocks for DMX / sACN payloads, each with its own free list.
+ * @param block_size the size of (large) blocks to use.
  */
 class MemoryBlockPool {
  public:
     explicit MemoryBlockPool(unsigned int block_size = DEFAULT_BLOCK_SIZE)
         : m_block_size(block_size),
-          m_blocks_allocated(0) {
+          m_blocks_allocated(0),
+          m_blocks_in_flight(0),
+          m_high_water_mark(0),
+          m_in_flight_var(NULL),
+          m_high_water_var(NULL) {
     }
     ~MemoryBlockPool() {
       Purge();
     }
 
-    // Allocate a new MemoryBlock from the pool. May return NULL if allocation
-    // fails.
+    // Allocate a new (large) MemoryBlock from the pool. May return NULL if
+    // allocation fails.
     MemoryBlock *Allocate() {
-      if (m_free_blocks.empty()) {
-        uint8_t* data = new uint8_t[m_block_size];
-        OLA_DEBUG << "new block allocated at @" << reinterpret_cast<int*>(data);
-        if (data) {
-          m_blocks_allocated++;
-          return new MemoryBlock(data, m_block_size);
-        } else {
-          return NULL;
-        }
-      } else {
-        MemoryBlock *block = m_free_blocks.front();
-        m_free_blocks.pop();
-        return block;
-      }
+      return AllocateFromList(&m_free_blocks, m_block_size);
+    }
+
+    // Allocate a block big enough to hold size bytes; requests up to
+    // SMALL_BLOCK_SIZE are served from the small size class.
+    MemoryBlock *Allocate(unsigned int size) {
+      if (size <= SMALL_BLOCK_SIZE)
+        return AllocateFromList(&m_small_free_blocks, SMALL_BLOCK_SIZE);
+      return AllocateFromList(&m_free_blocks, m_block_size);
     }
 
     // Release a MemoryBlock back to the pool.
     void Release(MemoryBlock *block) {
-      m_free_blocks.push(block);
+      if (block->Capacity() <= SMALL_BLOCK_SIZE)
+        m_small_free_blocks.push(block);
+      else
+        m_free_blocks.push(block);
+      m_blocks_in_flight--;
+      if (m_in_flight_var)
+        m_in_flight_var->Set(m_blocks_in_flight);
     }
 
-    // Returns the number of free blocks in the pool.
+    // Returns the number of free blocks in the pool, over both size
+    // classes.
     unsigned int FreeBlocks() const {
-      return static_cast<unsigned int>(m_free_blocks.size());
+      return static_cast<unsigned int>(m_free_blocks.size() +
+                                       m_small_free_blocks.size());
     }
 
     // Deletes all free blocks.
@@ -76,7 +91,8 @@ class MemoryBlockPool {
       Purge(0);
     }
 
-    // Delete all but remaining free blocks.
+    // Delete all but remaining free (large) blocks, and all free small
+    // blocks.
     void Purge(unsigned int remaining) {
       while (m_free_blocks.size() != remaining) {
         MemoryBlock *block = m_free_blocks.front();
@@ -84,17 +100,193 @@ class MemoryBlockPool {
         delete block;
         m_free_blocks.pop();
       }
+      while (!m_small_free_blocks.empty()) {
+        MemoryBlock *block = m_small_free_blocks.front();
+        m_blocks_allocated--;
+        delete block;
+        m_small_free_blocks.pop();
+      }
     }
 
     unsigned int BlocksAllocated() const { return m_blocks_allocated; }
 
+    // The number of blocks handed out and not yet released.
+    unsigned int BlocksInFlight() const { return m_blocks_in_flight; }
+
+    // The largest number of blocks ever in flight at once.
+    unsigned int HighWaterMark() const { return m_high_water_mark; }
+
+    /**
+     * @brief Publish the pool's stats through an ExportMap.
+     * @param export_map the ExportMap to use.
+     * @param name a prefix to distinguish this pool's variables.
+     */
+    void ExportStats(ExportMap *export_map, const std::string &name) {
+      m_in_flight_var = export_map->GetIntegerVar(
+          name + "-blocks-in-flight");
+      m_high_water_var = export_map->GetIntegerVar(
+          name + "-blocks-high-water");
+    }
+
     // default to 1k blocks
     static const unsigned int DEFAULT_BLOCK_SIZE = 1024;
+    // requests at or under this size use the small size class
+    static const unsigned int SMALL_BLOCK_SIZE = 128;
 
  private:
+    MemoryBlock *AllocateFromList(std::queue<MemoryBlock*> *free_blocks,
+                                  unsigned int block_size) {
+      MemoryBlock *block;
+      if (free_blocks->empty()) {
+        uint8_t* data = new uint8_t[block_size];
+        OLA_DEBUG << "new block allocated at @" << reinterpret_cast<int*>(
+            data);
+        if (!data)
+          return NULL;
+        m_blocks_allocated++;
+        block = new MemoryBlock(data, block_size);
+      } else {
+        block = free_blocks->front();
+        free_blocks->pop();
+      }
+      m_blocks_in_flight++;
+      if (m_blocks_in_flight > m_high_water_mark) {
+        m_high_water_mark = m_blocks_in_flight;
+        if (m_high_water_var)
+          m_high_water_var->Set(m_high_water_mark);
+      }
+      if (m_in_flight_var)
+        m_in_flight_var->Set(m_blocks_in_flight);
+      return block;
+    }
+
     std::queue<MemoryBlock*> m_free_blocks;
+    std::queue<MemoryBlock*> m_small_free_blocks;
     const unsigned int m_block_size;
     unsigned int m_blocks_allocated;
+    unsigned int m_blocks_in_flight;
+    unsigned int m_high_water_mark;
+    IntegerVariable *m_in_flight_var;
+    IntegerVariable *m_high_water_var;
+};
+
+
+/**
+ * @brief A MemoryBlockPool that can be shared between threads.
+ *
+ * Allocate / Release / Purge are serialized with a mutex. Threads doing
+ * frequent allocations should front this with a MemoryBlockMagazine so the
+ * lock is only taken on refill / flush.
+ */
+class ThreadSafeMemoryBlockPool {
+ public:
+    explicit ThreadSafeMemoryBlockPool(
+        unsigned int block_size = MemoryBlockPool::DEFAULT_BLOCK_SIZE)
+        : m_pool(block_size) {
+    }
+
+    MemoryBlock *Allocate() {
+      ola::thread::MutexLocker locker(&m_mutex);
+      return m_pool.Allocate();
+    }
+
+    MemoryBlock *Allocate(unsigned int size) {
+      ola::thread::MutexLocker locker(&m_mutex);
+      return m_pool.Allocate(size);
+    }
+
+    void Release(MemoryBlock *block) {
+      ola::thread::MutexLocker locker(&m_mutex);
+      m_pool.Release(block);
+    }
+
+    // Bulk variants used by MemoryBlockMagazine, one lock per batch.
+    unsigned int AllocateBatch(std::vector<MemoryBlock*> *blocks,
+                               unsigned int count) {
+      ola::thread::MutexLocker locker(&m_mutex);
+      unsigned int allocated = 0;
+      for (; allocated < count; allocated++) {
+        MemoryBlock *block = m_pool.Allocate();
+        if (!block)
+          break;
+        blocks->push_back(block);
+      }
+      return allocated;
+    }
+
+    void ReleaseBatch(std::vector<MemoryBlock*> *blocks) {
+      ola::thread::MutexLocker locker(&m_mutex);
+      std::vector<MemoryBlock*>::const_iterator iter = blocks->begin();
+      for (; iter != blocks->end(); ++iter)
+        m_pool.Release(*iter);
+      blocks->clear();
+    }
+
+    unsigned int FreeBlocks() {
+      ola::thread::MutexLocker locker(&m_mutex);
+      return m_pool.FreeBlocks();
+    }
+
+    void Purge() {
+      ola::thread::MutexLocker locker(&m_mutex);
+      m_pool.Purge();
+    }
+
+    unsigned int BlocksAllocated() {
+      ola::thread::MutexLocker locker(&m_mutex);
+      return m_pool.BlocksAllocated();
+    }
+
+    void ExportStats(ExportMap *export_map, const std::string &name) {
+      ola::thread::MutexLocker locker(&m_mutex);
+      m_pool.ExportStats(export_map, name);
+    }
+
+ private:
+    MemoryBlockPool m_pool;
+    ola::thread::Mutex m_mutex;
+};
+
+
+/**
+ * @brief A per-thread cache of MemoryBlocks over a shared pool.
+ *
+ * Each thread owns its own magazine; Allocate / Release work on the local
+ * cache and only hit the shared pool's lock when the magazine runs dry or
+ * overflows, moving MAGAZINE_SIZE blocks per trip.
+ */
+class MemoryBlockMagazine {
+ public:
+    explicit MemoryBlockMagazine(ThreadSafeMemoryBlockPool *pool)
+        : m_pool(pool) {
+    }
+
+    ~MemoryBlockMagazine() {
+      m_pool->ReleaseBatch(&m_blocks);
+    }
+
+    MemoryBlock *Allocate() {
+      if (m_blocks.empty()) {
+        if (!m_pool->AllocateBatch(&m_blocks, MAGAZINE_SIZE))
+          return NULL;
+      }
+      MemoryBlock *block = m_blocks.back();
+      m_blocks.pop_back();
+      return block;
+    }
+
+    void Release(MemoryBlock *block) {
+      m_blocks.push_back(block);
+      if (m_blocks.size() >= 2 * MAGAZINE_SIZE) {
+        m_pool->ReleaseBatch(&m_blocks);
+      }
+    }
+
+    static const unsigned int MAGAZINE_SIZE = 16;
+
+ private:
+    ThreadSafeMemoryBlockPool *m_pool;
+    std::vector<MemoryBlock*> m_blocks;
 };
 }  // namespace io
 }  // namespace ola
@@ -107,6 +107,24 @@ class SelectServer: public SelectServerInterface {
    */
   void Run();
 
+  /**
+   * @brief Run the event loop in simulated time.
+   * @param clock the MockClock this SelectServer was constructed with.
+   * @param duration how much simulated time to run for.
+   *
+   * Instead of blocking in poll(), each iteration executes due timers,
+   * RunInLoop() callbacks and the Execute() queue, then jumps the clock
+   * straight to the next timer deadline - so hours of timer traffic run
+   * in seconds, deterministically. The TimeoutManager and every timeout
+   * callback observe the same MockClock, so intervals behave exactly as
+   * they would in real time.
+   *
+   * Descriptor I/O is not serviced in this mode; simulations should use
+   * fake sockets (e.g. MockUDPSocket) driven from timer callbacks.
+   * Returns when the duration has elapsed or Terminate() is called.
+   */
+  void RunSimulated(MockClock *clock, const TimeInterval &duration);
+
   /**
    * @brief Do a single pass through the event loop. Does not block.
    */
@@ -134,6 +152,10 @@ class SelectServer: public SelectServerInterface {
   ola::thread::timeout_id RegisterRepeatingTimeout(
       const ola::TimeInterval &interval,
       ola::Callback0<bool> *callback);
+  ola::thread::timeout_id RegisterRepeatingTimeout(
+      const ola::TimeInterval &interval,
+      ola::Callback0<bool> *callback,
+      const ola::TimeInterval &slack);
 
   ola::thread::timeout_id RegisterSingleTimeout(
       unsigned int ms,
@@ -141,6 +163,10 @@ class SelectServer: public SelectServerInterface {
   ola::thread::timeout_id RegisterSingleTimeout(
       const ola::TimeInterval &interval,
       ola::SingleUseCallback0<void> *callback);
+  ola::thread::timeout_id RegisterSingleTimeout(
+      const ola::TimeInterval &interval,
+      ola::SingleUseCallback0<void> *callback,
+      const ola::TimeInterval &slack);
   void RemoveTimeout(ola::thread::timeout_id id);
 
   /**
@@ -171,6 +197,9 @@ class SelectServer: public SelectServerInterface {
 
   Clock *m_clock;
   bool m_free_clock;
+  // opt-in loop timing stats (--ss-loop-stats)
+  bool m_collect_loop_stats;
+  ola::CounterVariable *m_loop_callback_time;
   LoopClosureSet m_loop_callbacks;
   Callbacks m_incoming_callbacks;
   ola::thread::Mutex m_incoming_mutex;
@@ -182,6 +211,9 @@ class SelectServer: public SelectServerInterface {
   void SetTerminate() { m_terminate = true; }
 
   // the maximum time we'll wait in the select call
+  static const char K_LOOP_CALLBACK_TIME[];
+  // the most Execute() callbacks run per loop pass
+  static const unsigned int EXECUTE_DRAIN_BUDGET = 256;
   static const unsigned int POLL_INTERVAL_SECOND = 10;
   static const unsigned int POLL_INTERVAL_USECOND = 0;
 
@@ -0,0 +1,138 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SelectServerThread.h
+ * A thread that runs a SelectServer, and a group of such threads that can
+ * be used to shard I/O across cores.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_IO_SELECTSERVERTHREAD_H_
+#define INCLUDE_OLA_IO_SELECTSERVERTHREAD_H_
+
+#include <ola/Callback.h>
+#include <ola/base/Macro.h>
+#include <ola/io/SelectServer.h>
+#include <ola/thread/Thread.h>
+
+#include <string>
+#include <vector>
+
+namespace ola {
+namespace io {
+
+/**
+ * @brief A thread running its own SelectServer.
+ *
+ * Work is handed to the thread with Execute(), which is safe to call from
+ * any thread. Descriptors can be registered on SS() but, as usual, only
+ * from the thread that runs the loop (i.e. from within an Execute'd
+ * callback).
+ */
+class SelectServerThread : public ola::thread::Thread {
+ public:
+  /**
+   * @brief Create a new SelectServerThread.
+   * @param name the thread name.
+   * @param cpu the core to pin the thread to, or -1 for no affinity.
+   */
+  explicit SelectServerThread(const std::string &name, int cpu = -1);
+
+  ~SelectServerThread();
+
+  /**
+   * @brief Start the thread and wait for the loop to be running.
+   */
+  bool Start();
+
+  /**
+   * @brief Terminate the loop and join the thread.
+   */
+  bool Stop();
+
+  /**
+   * @brief The SelectServer run by this thread.
+   */
+  SelectServer *SS() { return &m_ss; }
+
+  /**
+   * @brief Run a callback on this thread's loop. Safe to call from any
+   * thread.
+   */
+  void Execute(ola::BaseCallback0<void> *callback) {
+    m_ss.Execute(callback);
+  }
+
+ protected:
+  void *Run();
+
+ private:
+  SelectServer m_ss;
+  const int m_cpu;
+
+  DISALLOW_COPY_AND_ASSIGN(SelectServerThread);
+};
+
+
+/**
+ * @brief A group of SelectServerThreads used to shard I/O across cores.
+ *
+ * Shards are picked with a stable key (e.g. a universe id or fd), so the
+ * descriptors for disjoint universe sets can run their receive, merge and
+ * send work in parallel while each individual descriptor keeps single
+ * threaded semantics on its own shard.
+ */
+class SelectServerShardGroup {
+ public:
+  /**
+   * @brief Create a group of shards.
+   * @param shard_count the number of threads to run.
+   * @param pin_cpus if true, pin shard i to core i.
+   */
+  explicit SelectServerShardGroup(unsigned int shard_count,
+                                  bool pin_cpus = false);
+
+  ~SelectServerShardGroup();
+
+  bool Start();
+  void Stop();
+
+  unsigned int ShardCount() const {
+    return static_cast<unsigned int>(m_shards.size());
+  }
+
+  /**
+   * @brief The shard for a key; the same key always maps to the same
+   * shard.
+   */
+  SelectServerThread *Shard(unsigned int key) {
+    return m_shards[key % m_shards.size()];
+  }
+
+  /**
+   * @brief Run a callback on the shard for the given key.
+   */
+  void Execute(unsigned int key, ola::BaseCallback0<void> *callback) {
+    Shard(key)->Execute(callback);
+  }
+
+ private:
+  std::vector<SelectServerThread*> m_shards;
+
+  DISALLOW_COPY_AND_ASSIGN(SelectServerShardGroup);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // INCLUDE_OLA_IO_SELECTSERVERTHREAD_H_
@@ -0,0 +1,138 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * ShmFrameRing.h
+ * A shared memory ring of DMX frames between two local processes.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_IO_SHMFRAMERING_H_
+#define INCLUDE_OLA_IO_SHMFRAMERING_H_
+
+#ifndef _WIN32
+
+#include <stdint.h>
+
+#include <ola/base/Macro.h>
+#include <ola/network/Socket.h>
+
+#include <memory>
+#include <string>
+
+namespace ola {
+namespace io {
+
+/**
+ * @class ShmFrameRing ola/io/ShmFrameRing.h
+ * @brief A single-producer single-consumer ring of fixed size frames in
+ * POSIX shared memory, with a datagram-socket doorbell.
+ *
+ * A same-host client can push DMX frames into the ring with a memcpy and
+ * an atomic publish, bypassing serialization and the stream socket. The
+ * consumer registers DoorbellDescriptor() with its SelectServer; one
+ * doorbell datagram may cover many frames, so the consumer should drain
+ * with Pop() until it returns false.
+ *
+ * Everything is name based (shm object + abstract socket), so no file
+ * descriptors need to be passed between the processes; the name only has
+ * to travel over an existing channel like the RPC connection.
+ */
+class ShmFrameRing {
+ public:
+  ~ShmFrameRing();
+
+  /**
+   * @brief Create a ring; the consumer side calls this first.
+   * @param name the name for the ring, e.g. "/ola-universe-1".
+   * @param frame_size the maximum size of each frame.
+   * @param frame_count the capacity of the ring, must be a power of 2.
+   * @returns a new ShmFrameRing or NULL on error.
+   */
+  static ShmFrameRing *Create(const std::string &name,
+                              unsigned int frame_size,
+                              unsigned int frame_count);
+
+  /**
+   * @brief Attach to a ring created by another process; the producer
+   * side.
+   * @param name the name used in Create().
+   * @returns a new ShmFrameRing or NULL on error.
+   */
+  static ShmFrameRing *Attach(const std::string &name);
+
+  /**
+   * @brief Push a frame into the ring and ring the doorbell.
+   * @returns false if the ring is full or data is larger than the frame
+   * size; the frame is counted as dropped.
+   */
+  bool Push(const uint8_t *data, unsigned int length);
+
+  /**
+   * @brief Pop the next frame from the ring.
+   * @param[out] data where to copy the frame, at least FrameSize() bytes.
+   * @param[in,out] length the size of data, set to the frame length.
+   * @returns false if the ring is empty.
+   */
+  bool Pop(uint8_t *data, unsigned int *length);
+
+  /**
+   * @brief The descriptor the consumer registers for doorbell kicks.
+   * Only valid on the ring returned by Create().
+   */
+  ola::network::UDPSocket *DoorbellDescriptor() {
+    return m_doorbell.get();
+  }
+
+  /**
+   * @brief Drain any pending doorbell datagrams.
+   */
+  void DrainDoorbell();
+
+  unsigned int FrameSize() const;
+  unsigned int FrameCount() const;
+
+  /**
+   * @brief The number of frames dropped because the ring was full.
+   */
+  uint64_t FramesDropped() const;
+
+ private:
+  struct RingHeader;
+
+  ShmFrameRing(const std::string &name,
+               int shm_fd,
+               uint8_t *shm,
+               size_t shm_size,
+               bool is_consumer);
+
+  bool InitDoorbell(bool is_consumer);
+
+  const std::string m_name;
+  int m_shm_fd;
+  uint8_t *m_shm;
+  size_t m_shm_size;
+  const bool m_is_consumer;
+  RingHeader *m_header;
+  uint8_t *m_frames;
+  std::auto_ptr<ola::network::UDPSocket> m_doorbell;
+  ola::network::IPV4SocketAddress m_doorbell_address;
+
+  DISALLOW_COPY_AND_ASSIGN(ShmFrameRing);
+};
+}  // namespace io
+}  // namespace ola
+
+#endif  // _WIN32
+#endif  // INCLUDE_OLA_IO_SHMFRAMERING_H_
@@ -0,0 +1,110 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * StallWatchdog.h
+ * Detects event loop stalls that are too short to trip the process
+ * supervisor.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_IO_STALLWATCHDOG_H_
+#define INCLUDE_OLA_IO_STALLWATCHDOG_H_
+
+#include <ola/Clock.h>
+#include <ola/base/Macro.h>
+#include <ola/thread/Thread.h>
+
+#include <string>
+
+namespace ola {
+
+class ExportMap;
+
+namespace io {
+
+/**
+ * @brief Watches the event loop's dispatch heartbeat and reports stalls.
+ *
+ * A process supervisor only catches full hangs; a 300ms stall ruins a
+ * chase and leaves no trace. The pollers mark the start and end of each
+ * dispatch pass through MarkDispatchStart() / MarkDispatchEnd(); this
+ * thread samples the marker every 100ms and when a dispatch has been
+ * running longer than the threshold it logs the stall, emits an
+ * EVENT_LOOP_STALL trace event and dumps the trace ring - whose last
+ * events identify what the loop was doing. Each stall is reported once,
+ * while it's still in progress, so the evidence is captured even if the
+ * stall never ends.
+ *
+ * Completed dispatch durations (including stalls) land in the
+ * "ss-dispatch-time-us" histogram via
+ * PollerInterface::RecordDispatchTime, so the stall distribution is
+ * visible without scraping logs.
+ */
+class StallWatchdog: private ola::thread::Thread {
+ public:
+  /**
+   * @brief Create a new StallWatchdog.
+   * @param export_map the ExportMap to count stalls in, may be NULL.
+   * @param threshold how long a dispatch pass may run before it's
+   * reported as a stall.
+   */
+  StallWatchdog(ExportMap *export_map, const TimeInterval &threshold);
+  ~StallWatchdog();
+
+  /**
+   * @brief Create a watchdog according to --loop-stall-threshold-ms.
+   * @returns a new StallWatchdog, or NULL if the watchdog is disabled.
+   */
+  static StallWatchdog *NewFromFlags(ExportMap *export_map);
+
+  bool Start();
+  void Stop();
+
+  /**
+   * @brief Called by the pollers when a dispatch pass begins.
+   */
+  static void MarkDispatchStart(const TimeStamp &start) {
+    __atomic_store_n(
+        &s_dispatch_start_us,
+        start.Seconds() * 1000000ll + start.MicroSeconds(),
+        __ATOMIC_RELAXED);
+  }
+
+  /**
+   * @brief Called by the pollers when a dispatch pass ends.
+   */
+  static void MarkDispatchEnd() {
+    __atomic_store_n(&s_dispatch_start_us, 0ll, __ATOMIC_RELAXED);
+  }
+
+  static const char K_STALL_COUNT_VAR[];
+
+ private:
+  ExportMap *m_export_map;
+  const TimeInterval m_threshold;
+  Clock m_clock;
+  bool m_shutdown;
+  ola::thread::Mutex m_mutex;
+  ola::thread::ConditionVariable m_condition;
+
+  void *Run();
+
+  static int64_t s_dispatch_start_us;  // 0 while the loop is idle
+
+  DISALLOW_COPY_AND_ASSIGN(StallWatchdog);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // INCLUDE_OLA_IO_STALLWATCHDOG_H_
@@ -44,6 +44,15 @@ namespace network {
  *  - This class only supports a single connection per IP:Port.
  *  - This class should work fine for a small number of TCP connections (100 or
  *    so). It'll need to be re-written if we want to support 1000s.
+ *
+ * Note on failover: every endpoint added here runs its own attempt/backoff
+ * state machine concurrently - nothing serializes attempts across
+ * endpoints. A happy-eyeballs race to a primary/secondary controller is
+ * therefore built by adding both endpoints and treating whichever
+ * OnConnect fires first as the winner (disconnecting the loser), which
+ * belongs in the caller that knows the endpoints are alternatives for the
+ * same logical peer; this class can't tell alternatives from independent
+ * connections.
  */
 class AdvancedTCPConnector {
  public:
@@ -53,6 +53,15 @@ namespace network {
 /**
  * An class that provides health checking for a connection.
  * The subclasses implement the SendHeartbeat and HeartbeatTimeout methods.
+ *
+ * Scheduling notes for deployments with many connections: the send and
+ * receive timers register with a quarter-interval of slack, so the timer
+ * wheel coalesces adjacent connections into shared wakeups - thirty E1.33
+ * links tick together rather than thirty times. And heartbeats are
+ * already adaptive in the sense that matters: call HeartbeatSent()
+ * whenever application traffic goes out and the explicit heartbeat for
+ * that interval is skipped, so busy links send no extra keepalive bytes
+ * at all.
  */
 class HealthCheckedConnection {
  public:
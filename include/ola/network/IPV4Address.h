@@ -127,6 +127,21 @@ class IPV4Address {
      */
     uint32_t AsInt() const { return m_address; }
 
+    /**
+     * @brief A well-mixed hash of the address, for keying unordered
+     * containers. The raw network-order value clusters badly (subnets
+     * share high bits), so this runs it through a finalizer.
+     */
+    uint32_t Hash() const {
+      uint32_t hash = m_address;
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6b;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35;
+      hash ^= hash >> 16;
+      return hash;
+    }
+
     /**
      * @brief Checks if this address is the wildcard address (0.0.0.0).
      * @returns true if this address is the wildcard address.
@@ -83,6 +83,12 @@ class MACAddress {
   // should be at least LENGTH bytes.
   void Get(uint8_t ptr[LENGTH]) const;
 
+  /**
+   * @brief An FNV-1a hash of the address bytes, for keying unordered
+   * containers without stringifying.
+   */
+  uint32_t Hash() const;
+
   /**
    * @brief Write the binary representation of the MAC address to memory.
    * @param buffer a pointer to memory to write the MAC address to
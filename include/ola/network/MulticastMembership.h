@@ -0,0 +1,106 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * MulticastMembership.h
+ * Reference counted multicast group membership for a UDP socket.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_NETWORK_MULTICASTMEMBERSHIP_H_
+#define INCLUDE_OLA_NETWORK_MULTICASTMEMBERSHIP_H_
+
+#include <ola/base/Macro.h>
+#include <ola/network/IPV4Address.h>
+#include <ola/network/Socket.h>
+
+#include <map>
+#include <utility>
+
+namespace ola {
+namespace network {
+
+/**
+ * @class MulticastMembershipManager ola/network/MulticastMembership.h
+ * @brief Reference counts multicast group joins on a socket.
+ *
+ * Several consumers on one socket (two ports patched to the same
+ * universe, a multi-homed box joining per interface) otherwise issue
+ * duplicate joins and - worse - an early leave that kills another
+ * consumer's traffic. Join/Leave here only touch the kernel membership
+ * on the 0 -> 1 and 1 -> 0 transitions.
+ */
+class MulticastMembershipManager {
+ public:
+  explicit MulticastMembershipManager(UDPSocketInterface *socket)
+      : m_socket(socket) {
+  }
+
+  /**
+   * @brief Join a group on an interface; only the first reference
+   * performs the kernel join.
+   * @returns true if the membership is (now) held.
+   */
+  bool Join(const IPV4Address &iface, const IPV4Address &group) {
+    Membership key(iface, group);
+    std::map<Membership, unsigned int>::iterator iter =
+        m_memberships.find(key);
+    if (iter != m_memberships.end()) {
+      iter->second++;
+      return true;
+    }
+    if (!m_socket->JoinMulticast(iface, group))
+      return false;
+    m_memberships[key] = 1;
+    return true;
+  }
+
+  /**
+   * @brief Drop a reference; the kernel leave happens when the last
+   * reference goes.
+   * @returns true if the reference was released.
+   */
+  bool Leave(const IPV4Address &iface, const IPV4Address &group) {
+    Membership key(iface, group);
+    std::map<Membership, unsigned int>::iterator iter =
+        m_memberships.find(key);
+    if (iter == m_memberships.end())
+      return false;
+    if (--iter->second)
+      return true;
+    m_memberships.erase(iter);
+    return m_socket->LeaveMulticast(iface, group);
+  }
+
+  /**
+   * @brief The number of references held for a group.
+   */
+  unsigned int RefCount(const IPV4Address &iface,
+                        const IPV4Address &group) const {
+    std::map<Membership, unsigned int>::const_iterator iter =
+        m_memberships.find(Membership(iface, group));
+    return iter == m_memberships.end() ? 0 : iter->second;
+  }
+
+ private:
+  typedef std::pair<IPV4Address, IPV4Address> Membership;
+
+  UDPSocketInterface *m_socket;
+  std::map<Membership, unsigned int> m_memberships;
+
+  DISALLOW_COPY_AND_ASSIGN(MulticastMembershipManager);
+};
+}  // namespace network
+}  // namespace ola
+#endif  // INCLUDE_OLA_NETWORK_MULTICASTMEMBERSHIP_H_
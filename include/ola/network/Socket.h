@@ -28,6 +28,7 @@
 #ifndef INCLUDE_OLA_NETWORK_SOCKET_H_
 #define INCLUDE_OLA_NETWORK_SOCKET_H_
 
+#include <ola/Clock.h>
 #include <stdint.h>
 
 #include <ola/Callback.h>
@@ -188,6 +189,96 @@ class UDPSocketInterface: public ola::io::BidirectionalFileDescriptor {
                         ssize_t *data_read,
                         IPV4SocketAddress *source) = 0;
 
+  /**
+   * @name Batched datagram I/O
+   * RecvFromBatch() and SendToBatch() are the first-class batch APIs:
+   * sendmmsg/recvmmsg on Linux, loop fallbacks elsewhere, with the
+   * source address carried per received datagram and two-part payloads
+   * on send. Receive timestamps ride with the SO_TIMESTAMPING support
+   * in the receive path rather than this struct, so non-timestamped
+   * receives stay lean.
+   * @{
+   */
+
+  /**
+   * @brief A datagram received by RecvFromBatch().
+   */
+  struct ReceivedDatagram {
+    uint8_t *data;  // points into the caller's buffer ring
+    ssize_t length;
+    IPV4SocketAddress source;
+    // the kernel receive timestamp; only set when
+    // EnableReceiveTimestamps() succeeded, unset otherwise
+    TimeStamp receive_time;
+  };
+
+  /**
+   * @brief Receive a batch of datagrams in one call.
+   * @param buffers a ring of datagram_count buffers, each datagram_size
+   * bytes.
+   * @param datagram_size the size of each buffer in the ring.
+   * @param[out] datagrams where to store the received datagram descriptors.
+   * @param datagram_count the size of the ring.
+   * @return the number of datagrams received, 0 if the socket would block.
+   *
+   * The default implementation receives a single datagram; UDPSocket
+   * drains a burst with one recvmmsg() on Linux. Receive-heavy callers
+   * like the sACN transport use this to avoid a poller round trip per
+   * packet.
+   */
+  virtual int RecvFromBatch(uint8_t *buffers,
+                            unsigned int datagram_size,
+                            ReceivedDatagram *datagrams,
+                            unsigned int datagram_count);
+
+  /**
+   * @brief A datagram to send with SendToBatch().
+   *
+   * A datagram may be split into two parts (e.g. a header template and a
+   * payload aliased straight out of a DmxBuffer); the parts are gathered
+   * by the kernel, so fanout cost scales with the header size rather
+   * than payload copies. payload may be NULL for single-part datagrams.
+   */
+  struct OutgoingDatagram {
+    const uint8_t *data;
+    unsigned int length;
+    const uint8_t *payload;
+    unsigned int payload_length;
+    IPV4SocketAddress destination;
+    OutgoingDatagram() : data(NULL), length(0), payload(NULL),
+                         payload_length(0) {}
+  };
+
+  /**
+   * @brief Send a batch of datagrams in one call.
+   * @param datagrams the datagrams to send.
+   * @param datagram_count the number of datagrams.
+   * @return the number of datagrams sent.
+   *
+   * The default implementation loops over SendTo(); UDPSocket sends the
+   * batch with a single sendmmsg() on Linux. Used by senders that emit a
+   * burst of per-universe packets in one flush.
+   */
+  virtual int SendToBatch(const OutgoingDatagram *datagrams,
+                          unsigned int datagram_count);
+
+  /**
+   * @brief Ask the kernel to timestamp received datagrams.
+   * @return true if timestamps will be delivered.
+   *
+   * When enabled, RecvFromBatch() fills ReceivedDatagram::receive_time
+   * with the kernel receive time, separating network jitter from our
+   * own queueing delay. Linux only; elsewhere this returns false and
+   * the field stays unset.
+   */
+  virtual bool EnableReceiveTimestamps() { return false; }
+
+  // the assembly limit for two-part datagrams on the portable path
+  static const unsigned int MAX_DATAGRAM_ASSEMBLY_SIZE = 2048;
+  // the floor for profile-sized socket buffers
+  static const unsigned int MIN_PROFILE_BUFFER_SIZE = 64 * 1024;
+  /** @} */
+
   /**
    * @brief Enable broadcasting for this socket.
    * @return true if it worked, false otherwise
@@ -227,6 +318,35 @@ class UDPSocketInterface: public ola::io::BidirectionalFileDescriptor {
    */
   virtual bool SetTos(uint8_t tos) = 0;
 
+  /**
+   * @brief A bundle of socket options sized for a deployment.
+   * Use ProfileForUniverseCount() for sensible defaults and
+   * ApplyProfile() to install them; under burst transmit the default
+   * kernel buffers overflow silently (ENOBUFS / dropped datagrams).
+   */
+  struct SocketProfile {
+    unsigned int receive_buffer_size;  // 0 leaves the kernel default
+    unsigned int send_buffer_size;     // 0 leaves the kernel default
+    uint8_t tos;                       // 0 leaves the default
+    SocketProfile() : receive_buffer_size(0), send_buffer_size(0),
+                      tos(0) {}
+  };
+
+  /**
+   * @brief Size a profile from the number of universes this socket
+   * carries: buffers hold a few full bursts of 638 byte sACN frames.
+   */
+  static SocketProfile ProfileForUniverseCount(unsigned int universes);
+
+  /**
+   * @brief Apply a SocketProfile; logs (and returns false) if the kernel
+   * clamped a buffer below what was asked for, so drops are explainable.
+   */
+  virtual bool ApplyProfile(const SocketProfile &profile) {
+    (void) profile;
+    return false;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(UDPSocketInterface);
 };
@@ -240,7 +360,8 @@ class UDPSocket: public UDPSocketInterface {
   UDPSocket()
       : UDPSocketInterface(),
         m_handle(ola::io::INVALID_DESCRIPTOR),
-        m_bound_to_port(false) {}
+        m_bound_to_port(false),
+        m_receive_timestamps(false) {}
   ~UDPSocket() { Close(); }
   bool Init();
   bool Bind(const IPV4SocketAddress &endpoint);
@@ -276,6 +397,21 @@ class UDPSocket: public UDPSocketInterface {
                 ssize_t *data_read,
                 IPV4SocketAddress *source);
 
+  int RecvFromBatch(uint8_t *buffers,
+                    unsigned int datagram_size,
+                    ReceivedDatagram *datagrams,
+                    unsigned int datagram_count);
+
+  int SendToBatch(const OutgoingDatagram *datagrams,
+                  unsigned int datagram_count);
+
+  bool EnableReceiveTimestamps();
+
+  // the largest batch a single RecvFromBatch() will return
+  static const unsigned int MAX_RECV_BATCH = 32;
+  // the largest batch a single SendToBatch() will submit at once
+  static const unsigned int MAX_SEND_BATCH = 32;
+
   bool EnableBroadcast();
   bool SetMulticastInterface(const IPV4Address &iface);
   bool JoinMulticast(const IPV4Address &iface,
@@ -285,10 +421,12 @@ class UDPSocket: public UDPSocketInterface {
                       const IPV4Address &group);
 
   bool SetTos(uint8_t tos);
+  bool ApplyProfile(const SocketProfile &profile);
 
  private:
   ola::io::DescriptorHandle m_handle;
   bool m_bound_to_port;
+  bool m_receive_timestamps;
 
   DISALLOW_COPY_AND_ASSIGN(UDPSocket);
 };
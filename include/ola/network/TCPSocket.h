@@ -58,6 +58,16 @@ class TCPSocket: public ola::io::ConnectedDescriptor {
 
   bool SetNoDelay();
 
+  /**
+   * @brief Cork or uncork the socket (TCP_CORK on Linux).
+   *
+   * Bracket a multi-write flush with SetCork(true) / SetCork(false) and
+   * the kernel assembles the writes into full segments rather than
+   * letting Nagle delay them or per-write flushes fragment them. A
+   * no-op (returning false) on platforms without TCP_CORK.
+   */
+  bool SetCork(bool corked);
+
  protected:
   bool IsSocket() const { return true; }
 
@@ -90,6 +100,9 @@ class TCPAcceptingSocket: public ola::io::ReadFileDescriptor {
   ola::io::DescriptorHandle m_handle;
   class TCPSocketFactoryInterface *m_factory;
 
+  // the most connections accepted in a single loop iteration
+  static const unsigned int MAX_ACCEPTS_PER_CYCLE = 8;
+
   DISALLOW_COPY_AND_ASSIGN(TCPAcceptingSocket);
 };
 }  // namespace network
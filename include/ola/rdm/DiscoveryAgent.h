@@ -72,6 +72,14 @@ class DiscoveryTargetInterface {
 
 /**
  * This class controls the discovery algorithm.
+ *
+ * Each agent drives exactly one transceiver, and everything on that wire
+ * must serialize: DUB probes are broadcast, so overlapping them with the
+ * unicast mute / unmute verification would collide responses on the line.
+ * Rig-wide parallelism therefore lives a level up - every port runs its
+ * own agent, and Universe::RunRDMDiscovery() already kicks all of a
+ * universe's ports off concurrently with a MultiCallback join - not
+ * inside the tree walk.
  */
 class DiscoveryAgent {
  public:
@@ -83,6 +91,19 @@ class DiscoveryAgent {
 
     void Abort();
     void StartFullDiscovery(DiscoveryCompleteCallback *on_complete);
+    /**
+     * @brief Start incremental discovery: the previously-found UIDs are
+     * verified with unicast mutes (lost devices fall out) and only the
+     * unmuted space is re-probed with DUB, so a newly plugged fixture is
+     * found without paying for a full tree walk. olad already drives this
+     * periodically from its housekeeping sweep.
+     *
+     * Hint-driven re-probing (queued STATUS messages or proxied
+     * device-change flags narrowing the branches to walk) would need a
+     * responder polling layer above this class that watches QUEUED_MESSAGE
+     * and PROXIED_DEVICE_COUNT per device; the incremental mode here is
+     * the mechanism such an engine would invoke.
+     */
     void StartIncrementalDiscovery(DiscoveryCompleteCallback *on_complete);
 
  private:
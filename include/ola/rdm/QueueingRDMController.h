@@ -29,6 +29,7 @@
 #ifndef INCLUDE_OLA_RDM_QUEUEINGRDMCONTROLLER_H_
 #define INCLUDE_OLA_RDM_QUEUEINGRDMCONTROLLER_H_
 
+#include <ola/Clock.h>
 #include <ola/rdm/RDMControllerInterface.h>
 #include <queue>
 #include <string>
@@ -51,18 +52,69 @@ class QueueingRDMController: public RDMControllerInterface {
     void Pause();
     void Resume();
 
+    /**
+     * The scheduling class for a request. Interactive requests (operator
+     * actions) jump ahead of background sensor polls; a starvation guard
+     * still drains the lower classes under sustained interactive load.
+     */
+    enum RequestPriority {
+      PRIORITY_INTERACTIVE = 0,
+      PRIORITY_NORMAL = 1,
+      PRIORITY_BACKGROUND = 2,
+    };
+
     // This can be called multiple times and the requests will be queued.
     void SendRDMRequest(const RDMRequest *request, RDMCallback *on_complete);
+    void SendRDMRequest(const RDMRequest *request,
+                        RDMCallback *on_complete,
+                        RequestPriority priority);
+
+    /**
+     * The number of queued requests in a class.
+     */
+    unsigned int QueueDepth(RequestPriority priority) const {
+      return static_cast<unsigned int>(
+          m_pending_requests[priority].size());
+    }
+
+    /**
+     * Per-transaction timing aggregates: how long requests waited in the
+     * queue and how long the wire round trip took, bucketed so transport
+     * comparisons (usbpro vs Art-Net vs E1.33) are one scrape away.
+     * Buckets are <1ms, <10ms, <100ms, <1s and >=1s.
+     */
+    struct LatencyStats {
+      uint64_t completed;
+      uint64_t queue_time_usecs;  // total time spent queued
+      uint64_t wire_time_usecs;   // total dispatch-to-response time
+      uint64_t wire_time_buckets[5];
+      LatencyStats() : completed(0), queue_time_usecs(0),
+                       wire_time_usecs(0) {
+        for (unsigned int i = 0; i < 5; i++)
+          wire_time_buckets[i] = 0;
+      }
+    };
+
+    const LatencyStats &GetLatencyStats() const { return m_latency_stats; }
 
  protected:
     typedef struct {
       const RDMRequest *request;
       RDMCallback *on_complete;
+      TimeStamp enqueue_time;
     } outstanding_rdm_request;
 
     RDMControllerInterface *m_controller;
     unsigned int m_max_queue_size;
-    std::queue<outstanding_rdm_request> m_pending_requests;
+    // one queue per priority class
+    std::queue<outstanding_rdm_request> m_pending_requests[3];
+    // dispatches since a lower class was served, for the starvation guard
+    unsigned int m_dispatches_since_yield;
+    // the queue the in-flight request came from
+    std::queue<outstanding_rdm_request> *m_active_queue;
+    ola::Clock m_clock;
+    TimeStamp m_dispatch_time;
+    LatencyStats m_latency_stats;
     bool m_rdm_request_pending;  // true if a request is in progress
     bool m_active;  // true if the controller is active
     RDMCallback *m_callback;
@@ -73,6 +125,9 @@ class QueueingRDMController: public RDMControllerInterface {
     virtual bool CheckForBlockingCondition();
     void MaybeSendRDMRequest();
     void DispatchNextRequest();
+    bool PendingRequests() const;
+    unsigned int TotalQueueDepth() const;
+    std::queue<outstanding_rdm_request> *NextQueue();
 
     void HandleRDMResponse(rdm_response_code status,
                            const ola::rdm::RDMResponse *response,
@@ -236,6 +236,10 @@ class RDMCommand {
     uint16_t m_param_id;
     uint8_t *m_data;
     unsigned int m_data_length;
+    // Most commands carry little or no param data; payloads up to this
+    // size live inline and skip the heap entirely.
+    enum { INLINE_DATA_SIZE = 32 };
+    uint8_t m_inline_data[INLINE_DATA_SIZE];
 
     RDMCommand(const RDMCommand &other);
     bool operator=(const RDMCommand &other) const;
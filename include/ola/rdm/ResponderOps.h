@@ -34,6 +34,7 @@
 #include <ola/rdm/RDMResponseCodes.h>
 
 #include <map>
+#include <vector>
 
 namespace ola {
 namespace rdm {
@@ -106,14 +107,19 @@ class ResponderOps {
 
  private:
     struct InternalParamHandler {
+      uint16_t pid;
       RDMHandler get_handler;
       RDMHandler set_handler;
     };
-    typedef std::map<uint16_t, InternalParamHandler> RDMHandlers;
+    // sorted by pid; built once per responder class and probed with a
+    // binary search per request
+    typedef std::vector<InternalParamHandler> RDMHandlers;
 
     bool m_include_required_pids;
     RDMHandlers m_handlers;
 
+    const InternalParamHandler *FindHandler(uint16_t pid) const;
+
     RDMResponse *HandleSupportedParams(const RDMRequest *request);
 };
 
@@ -45,23 +45,52 @@
 namespace ola {
 namespace rdm {
 
+namespace internal {
+template <typename Handler>
+bool HandlerLessThan(const Handler &a, const Handler &b) {
+  return a.pid < b.pid;
+}
+template <typename Handler>
+bool HandlerPidCompare(const Handler &handler, uint16_t pid) {
+  return handler.pid < pid;
+}
+}  // namespace internal
+
 template <class Target>
 ResponderOps<Target>::ResponderOps(const ParamHandler param_handlers[],
                                    bool include_required_pids)
     : m_include_required_pids(include_required_pids) {
   // We install placeholders for any pids which are handled internally.
-  struct InternalParamHandler placeholder = {NULL, NULL};
-  STLReplace(&m_handlers, PID_SUPPORTED_PARAMETERS, placeholder);
+  struct InternalParamHandler placeholder = {PID_SUPPORTED_PARAMETERS,
+                                             NULL, NULL};
+  m_handlers.push_back(placeholder);
 
   const ParamHandler *handler = param_handlers;
   while (handler->pid && (handler->get_handler || handler->set_handler)) {
     struct InternalParamHandler pid_handler = {
+      handler->pid,
       handler->get_handler,
       handler->set_handler
     };
-    STLReplace(&m_handlers, handler->pid, pid_handler);
+    m_handlers.push_back(pid_handler);
     handler++;
   }
+  // the table is shared per responder class and immutable from here, so
+  // sort it once and binary search per request
+  std::sort(m_handlers.begin(), m_handlers.end(),
+            internal::HandlerLessThan<InternalParamHandler>);
+}
+
+
+template <class Target>
+const typename ResponderOps<Target>::InternalParamHandler*
+ResponderOps<Target>::FindHandler(uint16_t pid) const {
+  typename RDMHandlers::const_iterator iter = std::lower_bound(
+      m_handlers.begin(), m_handlers.end(), pid,
+      internal::HandlerPidCompare<InternalParamHandler>);
+  if (iter == m_handlers.end() || iter->pid != pid)
+    return NULL;
+  return &(*iter);
 }
 
 template <class Target>
@@ -135,7 +164,7 @@ void ResponderOps<Target>::HandleRDMRequest(Target *target,
     return;
   }
 
-  InternalParamHandler *handler = STLFind(&m_handlers, request->ParamId());
+  const InternalParamHandler *handler = FindHandler(request->ParamId());
   if (!handler) {
     if (request->DestinationUID().IsBroadcast()) {
       on_complete->Run(RDM_WAS_BROADCAST, NULL, packets);
@@ -192,7 +221,7 @@ RDMResponse *ResponderOps<Target>::HandleSupportedParams(
   params.reserve(m_handlers.size());
   typename RDMHandlers::const_iterator iter = m_handlers.begin();
   for (; iter != m_handlers.end(); ++iter) {
-    uint16_t pid = iter->first;
+    uint16_t pid = iter->pid;
     // some pids never appear in supported_parameters.
     if (m_include_required_pids || (
         pid != PID_SUPPORTED_PARAMETERS &&
@@ -201,7 +230,7 @@ RDMResponse *ResponderOps<Target>::HandleSupportedParams(
         pid != PID_SOFTWARE_VERSION_LABEL &&
         pid != PID_DMX_START_ADDRESS &&
         pid != PID_IDENTIFY_DEVICE)) {
-      params.push_back(iter->first);
+      params.push_back(iter->pid);
     }
   }
   sort(params.begin(), params.end());
@@ -32,7 +32,7 @@
 #include <ola/rdm/UID.h>
 #include <algorithm>
 #include <iomanip>
-#include <set>
+#include <vector>
 #include <string>
 
 namespace ola {
@@ -50,19 +50,20 @@ class UIDSet {
     /**
      * @brief the Iterator for a UIDSets
      */
-    typedef std::set<UID>::const_iterator Iterator;
+    typedef std::vector<UID>::const_iterator Iterator;
 
     /**
      * @brief Construct an empty set
      */
-    UIDSet() {}
+    UIDSet() : m_sorted(true) {}
 
     /**
      * @brief Copy constructor.
      * @param other the UIDSet to copy.
      */
     UIDSet(const UIDSet &other):
-      m_uids(other.m_uids) {
+      m_uids(other.m_uids),
+      m_sorted(other.m_sorted) {
     }
 
     /**
@@ -71,6 +72,7 @@ class UIDSet {
     UIDSet& operator=(const UIDSet &other) {
       if (this != &other) {
         m_uids = other.m_uids;
+        m_sorted = other.m_sorted;
       }
       return *this;
     }
@@ -80,6 +82,7 @@ class UIDSet {
      */
     void Clear() {
       m_uids.clear();
+      m_sorted = true;
     }
 
     /**
@@ -87,15 +90,20 @@ class UIDSet {
      * @return the number of UIDs in the set.
      */
     unsigned int Size() const {
-      return m_uids.size();
+      EnsureSorted();
+      return static_cast<unsigned int>(m_uids.size());
     }
 
     /**
      * @brief Add a UID to the set.
      * @param uid the UID to add.
+     *
+     * Adds are O(1); the set sorts and de-duplicates itself lazily on the
+     * next read, so building a large set during discovery is linear.
      */
     void AddUID(const UID &uid) {
-      m_uids.insert(uid);
+      m_uids.push_back(uid);
+      m_sorted = false;
     }
 
     /**
@@ -103,7 +111,11 @@ class UIDSet {
      * @param uid the UID to remove.
      */
     void RemoveUID(const UID &uid) {
-      m_uids.erase(uid);
+      EnsureSorted();
+      std::vector<UID>::iterator iter = std::lower_bound(
+          m_uids.begin(), m_uids.end(), uid);
+      if (iter != m_uids.end() && *iter == uid)
+        m_uids.erase(iter);
     }
 
     /**
@@ -112,7 +124,8 @@ class UIDSet {
      * @return true if the set contains this UID.
      */
     bool Contains(const UID &uid) const {
-      return m_uids.find(uid) != m_uids.end();
+      EnsureSorted();
+      return std::binary_search(m_uids.begin(), m_uids.end(), uid);
     }
 
     /**
@@ -121,12 +134,15 @@ class UIDSet {
      * @return the union of the two UIDSets.
      */
     UIDSet Union(const UIDSet &other) {
-      std::set<UID> result;
-      set_union(m_uids.begin(),
-                m_uids.end(),
-                other.Begin(),
-                other.End(),
-                inserter(result, result.begin()));
+      EnsureSorted();
+      other.EnsureSorted();
+      std::vector<UID> result;
+      result.reserve(m_uids.size() + other.m_uids.size());
+      std::set_union(m_uids.begin(),
+                     m_uids.end(),
+                     other.m_uids.begin(),
+                     other.m_uids.end(),
+                     std::back_inserter(result));
       return UIDSet(result);
     }
 
@@ -134,6 +150,7 @@ class UIDSet {
      * @brief Return an Iterator to the first member of the set.
      */
     Iterator Begin() const {
+      EnsureSorted();
       return m_uids.begin();
     }
 
@@ -141,6 +158,7 @@ class UIDSet {
      * @brief Return an Iterator to one-pass-the-last member of the set.
      */
     Iterator End() const {
+      EnsureSorted();
       return m_uids.end();
     }
 
@@ -150,12 +168,14 @@ class UIDSet {
      * @return the difference between this UIDSet and other.
      */
     UIDSet SetDifference(const UIDSet &other) {
-      std::set<UID> difference;
+      EnsureSorted();
+      other.EnsureSorted();
+      std::vector<UID> difference;
       std::set_difference(m_uids.begin(),
                           m_uids.end(),
                           other.m_uids.begin(),
                           other.m_uids.end(),
-                          std::inserter(difference, difference.begin()));
+                          std::back_inserter(difference));
       return UIDSet(difference);
     }
 
@@ -164,6 +184,8 @@ class UIDSet {
      * @param other the UIDSet to compare to.
      */
     bool operator==(const UIDSet &other) const {
+      EnsureSorted();
+      other.EnsureSorted();
       return m_uids == other.m_uids;
     }
 
@@ -180,8 +202,9 @@ class UIDSet {
      * @returns a comma separated string with the UIDs from the set.
      */
     std::string ToString() const {
+      EnsureSorted();
       std::ostringstream str;
-      std::set<UID>::const_iterator iter;
+      std::vector<UID>::const_iterator iter;
       for (iter = m_uids.begin(); iter != m_uids.end(); ++iter) {
         if (iter != m_uids.begin())
           str << ",";
@@ -200,10 +223,22 @@ class UIDSet {
     }
 
  private:
-    std::set<UID> m_uids;
-
-    explicit UIDSet(const std::set<UID> uids) {
-      m_uids = uids;
+    // The UIDs are kept in a sorted flat vector (sorted lazily after
+    // adds); diffs and unions are linear merges with no node allocations.
+    mutable std::vector<UID> m_uids;
+    mutable bool m_sorted;
+
+    explicit UIDSet(const std::vector<UID> &uids)
+        : m_uids(uids),
+          m_sorted(true) {
+    }
+
+    void EnsureSorted() const {
+      if (m_sorted)
+        return;
+      std::sort(m_uids.begin(), m_uids.end());
+      m_uids.erase(std::unique(m_uids.begin(), m_uids.end()), m_uids.end());
+      m_sorted = true;
     }
 };
 }  // namespace rdm
@@ -0,0 +1,110 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * Intern.h
+ * String interning: stable u32 symbols with O(1) equality.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_STRINGS_INTERN_H_
+#define INCLUDE_OLA_STRINGS_INTERN_H_
+
+#include <ola/base/Macro.h>
+#include <ola/thread/Mutex.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ola {
+namespace strings {
+
+/**
+ * @brief A stable identifier for an interned string.
+ *
+ * Symbols from the same InternTable compare equal iff the strings they
+ * were interned from are equal, so keying maps by Symbol replaces string
+ * hashing / comparison with a u32 compare. Symbol 0 is never assigned.
+ */
+typedef uint32_t Symbol;
+
+/**
+ * @brief The invalid / not-yet-interned Symbol.
+ */
+static const Symbol INVALID_SYMBOL = 0;
+
+/**
+ * @brief Interns strings, handing out stable u32 Symbols.
+ *
+ * Names that are compared or hashed repeatedly - universe names,
+ * preference keys, variable names - pay the string cost once at intern
+ * time; from then on equality is an integer compare and the symbol is a
+ * dense index suitable for vector-backed side tables. Interned strings
+ * are never released, which is the right trade for name-like keys whose
+ * population is small and stable over the life of the daemon; don't
+ * intern unbounded user input.
+ *
+ * All methods are thread safe. For daemon-internal keying use the
+ * process-wide Instance(); separate tables only make sense in tests.
+ */
+class InternTable {
+ public:
+  InternTable();
+
+  /**
+   * @brief The process-wide table.
+   */
+  static InternTable *Instance();
+
+  /**
+   * @brief Intern a string.
+   * @param str the string to intern.
+   * @returns the Symbol for this string, stable for the lifetime of the
+   * table. Interning the same string again returns the same Symbol.
+   */
+  Symbol Intern(const std::string &str);
+
+  /**
+   * @brief Look up a previously interned string without interning it.
+   * @param str the string to look up.
+   * @returns the string's Symbol, or INVALID_SYMBOL if it has never been
+   * interned.
+   */
+  Symbol Find(const std::string &str) const;
+
+  /**
+   * @brief Fetch the string behind a Symbol.
+   * @param symbol a Symbol returned by Intern().
+   * @returns the interned string, or the empty string for
+   * INVALID_SYMBOL / unknown symbols.
+   */
+  const std::string &Lookup(Symbol symbol) const;
+
+  /**
+   * @brief The number of interned strings.
+   */
+  unsigned int Size() const;
+
+ private:
+  mutable ola::thread::Mutex m_mutex;
+  std::map<std::string, Symbol> m_symbols;
+  std::vector<std::string> m_strings;  // symbol -> string, index 0 unused
+
+  DISALLOW_COPY_AND_ASSIGN(InternTable);
+};
+}  // namespace strings
+}  // namespace ola
+#endif  // INCLUDE_OLA_STRINGS_INTERN_H_
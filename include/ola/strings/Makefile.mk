@@ -1,5 +1,6 @@
 olastringsincludedir = $(pkgincludedir)/strings/
 olastringsinclude_HEADERS = \
     include/ola/strings/Format.h \
+    include/ola/strings/Intern.h \
     include/ola/strings/FormatPrivate.h \
     include/ola/strings/Utils.h
@@ -0,0 +1,78 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * CancellationToken.h
+ * A cooperative cancellation primitive for long-running operations.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_THREAD_CANCELLATIONTOKEN_H_
+#define INCLUDE_OLA_THREAD_CANCELLATIONTOKEN_H_
+
+#include <ola/base/Macro.h>
+#include <stdint.h>
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief A cooperative cancellation flag shared between a requester and a
+ * long-running operation.
+ *
+ * The owner (e.g. the shutdown path) calls Cancel(); the operation checks
+ * IsCancelled() at its natural step boundaries - between RDM discovery
+ * branches, between connect attempts, between transfer resubmissions -
+ * and winds down early instead of making shutdown wait for the whole
+ * operation. Both sides may be on different threads: the flag is a single
+ * atomic, so checks are a load and cancellation never blocks.
+ *
+ * The token doesn't own completion signalling; pair it with a Future or
+ * callback if the canceller needs to know when the operation actually
+ * stopped.
+ */
+class CancellationToken {
+ public:
+  CancellationToken() : m_cancelled(0) {}
+
+  /**
+   * @brief Request cancellation. Safe from any thread, idempotent.
+   */
+  void Cancel() {
+    __atomic_store_n(&m_cancelled, 1, __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief Check for a pending cancellation request.
+   */
+  bool IsCancelled() const {
+    return __atomic_load_n(&m_cancelled, __ATOMIC_ACQUIRE) != 0;
+  }
+
+  /**
+   * @brief Re-arm the token for reuse, only once the previous operation
+   * has fully stopped.
+   */
+  void Reset() {
+    __atomic_store_n(&m_cancelled, 0, __ATOMIC_RELEASE);
+  }
+
+ private:
+  uint32_t m_cancelled;
+
+  DISALLOW_COPY_AND_ASSIGN(CancellationToken);
+};
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_CANCELLATIONTOKEN_H_
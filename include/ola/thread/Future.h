@@ -63,6 +63,17 @@ class Future {
       m_impl->Set(t);
     }
 
+    /**
+     * @brief Run a continuation on the executor when the value is set,
+     * instead of blocking in Get(). Ownership of the callback transfers;
+     * if the value is already set the continuation is posted
+     * immediately. One continuation per future.
+     */
+    void Then(ExecutorInterface *executor,
+              BaseCallback1<void, T> *continuation) {
+      m_impl->Then(executor, continuation);
+    }
+
  private:
     class FutureImpl<T> *m_impl;
 };
@@ -21,7 +21,9 @@
 #ifndef INCLUDE_OLA_THREAD_FUTUREPRIVATE_H_
 #define INCLUDE_OLA_THREAD_FUTUREPRIVATE_H_
 
+#include <ola/Callback.h>
 #include <ola/Logging.h>
+#include <ola/thread/ExecutorInterface.h>
 #include <ola/base/Macro.h>
 #include <ola/thread/Mutex.h>
 
@@ -34,7 +36,9 @@ class FutureImpl {
   FutureImpl()
       : m_ref_count(1),
         m_is_set(false),
-        m_value() {
+        m_value(),
+        m_executor(NULL),
+        m_continuation(NULL) {
   }
 
   void Ref() {
@@ -70,6 +74,8 @@ class FutureImpl {
   }
 
   void Set(const T &t) {
+    ExecutorInterface *executor = NULL;
+    BaseCallback1<void, T> *continuation = NULL;
     {
       MutexLocker l(&m_mutex);
       if (m_is_set) {
@@ -78,8 +84,34 @@ class FutureImpl {
       }
       m_is_set = true;
       m_value = t;
+      executor = m_executor;
+      continuation = m_continuation;
+      m_executor = NULL;
+      m_continuation = NULL;
     }
     m_condition.Broadcast();
+    if (continuation) {
+      executor->Execute(NewSingleCallback(&RunContinuation, continuation,
+                                          m_value));
+    }
+  }
+
+  void Then(ExecutorInterface *executor,
+            BaseCallback1<void, T> *continuation) {
+    bool run_now = false;
+    {
+      MutexLocker l(&m_mutex);
+      if (m_is_set) {
+        run_now = true;
+      } else {
+        m_executor = executor;
+        m_continuation = continuation;
+      }
+    }
+    if (run_now) {
+      executor->Execute(NewSingleCallback(&RunContinuation, continuation,
+                                          m_value));
+    }
   }
 
  private:
@@ -88,6 +120,13 @@ class FutureImpl {
   unsigned int m_ref_count;
   bool m_is_set;
   T m_value;
+  ExecutorInterface *m_executor;
+  BaseCallback1<void, T> *m_continuation;
+
+  static void RunContinuation(BaseCallback1<void, T> *continuation,
+                              T value) {
+    continuation->Run(value);
+  }
 
   DISALLOW_COPY_AND_ASSIGN(FutureImpl<T>);
 };
@@ -7,7 +7,9 @@ olathreadinclude_HEADERS = \
     include/ola/thread/Future.h \
     include/ola/thread/FuturePrivate.h \
     include/ola/thread/Mutex.h \
+    include/ola/thread/CancellationToken.h \
     include/ola/thread/SchedulerInterface.h \
+    include/ola/thread/SequencedSnapshot.h \
     include/ola/thread/SchedulingExecutorInterface.h \
     include/ola/thread/SignalThread.h \
     include/ola/thread/Thread.h \
@@ -25,12 +25,20 @@
 #include <ola/Clock.h>
 #include <ola/base/Macro.h>
 
+#include <stdint.h>
+
 namespace ola {
 namespace thread {
 
 
 /**
- * A Mutex object
+ * A Mutex object.
+ *
+ * Build with -DOLA_MUTEX_PROFILING to record per-mutex acquisition and
+ * contention counts plus total contended wait time; the default build
+ * carries no extra state or branches. The counters aren't synchronized
+ * (they're diagnostics) but are updated under the lock so they're
+ * consistent in practice.
  */
 class Mutex {
  public:
@@ -43,8 +51,23 @@ class Mutex {
     bool TryLock();
     void Unlock();
 
+#ifdef OLA_MUTEX_PROFILING
+    struct ContentionStats {
+      uint64_t acquisitions;
+      uint64_t contended;
+      uint64_t contended_wait_usecs;
+      ContentionStats()
+          : acquisitions(0), contended(0), contended_wait_usecs(0) {}
+    };
+
+    const ContentionStats &GetContentionStats() const { return m_stats; }
+#endif  // OLA_MUTEX_PROFILING
+
  private:
     pthread_mutex_t m_mutex;
+#ifdef OLA_MUTEX_PROFILING
+    ContentionStats m_stats;
+#endif  // OLA_MUTEX_PROFILING
 
     DISALLOW_COPY_AND_ASSIGN(Mutex);
 };
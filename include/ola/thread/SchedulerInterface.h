@@ -74,6 +74,24 @@ class SchedulerInterface {
       const ola::TimeInterval &period,
       Callback0<bool> *callback) = 0;
 
+  /**
+   * @brief Execute a callback periodically, with a coalescing slack.
+   * @param period the time interval between each execution of the callback.
+   * @param callback the callback to run. Ownership is transferred.
+   * @param slack each execution may be deferred by up to this much so that
+   *   adjacent timeouts share a single wakeup.
+   * @returns a timeout_id which can be used later to cancel the timeout.
+   *
+   * Schedulers that don't support coalescing ignore the slack.
+   */
+  virtual timeout_id RegisterRepeatingTimeout(
+      const ola::TimeInterval &period,
+      Callback0<bool> *callback,
+      const ola::TimeInterval &slack) {
+    (void) slack;
+    return RegisterRepeatingTimeout(period, callback);
+  }
+
   /**
    * @brief Execute a callback after a certain time interval.
    * @param delay the number of milliseconds before the callback is executed.
@@ -95,6 +113,25 @@ class SchedulerInterface {
       const ola::TimeInterval &delay,
       SingleUseCallback0<void> *callback) = 0;
 
+  /**
+   * @brief Execute a callback after a time interval, with a coalescing
+   *   slack.
+   * @param delay the time interval to wait before the callback is executed.
+   * @param callback the callback to run. Ownership is transferred.
+   * @param slack the callback may be deferred by up to this much so that
+   *   adjacent timeouts share a single wakeup.
+   * @returns a timeout_id which can be used later to cancel the timeout.
+   *
+   * Schedulers that don't support coalescing ignore the slack.
+   */
+  virtual timeout_id RegisterSingleTimeout(
+      const ola::TimeInterval &delay,
+      SingleUseCallback0<void> *callback,
+      const ola::TimeInterval &slack) {
+    (void) slack;
+    return RegisterSingleTimeout(delay, callback);
+  }
+
   /**
    * @brief Cancel an existing timeout
    * @param id the timeout_id returned by a call to RegisterRepeatingTimeout or
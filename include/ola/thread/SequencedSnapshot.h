@@ -0,0 +1,82 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SequencedSnapshot.h
+ * A seqlock-published value for single-writer, multi-reader sharing.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_THREAD_SEQUENCEDSNAPSHOT_H_
+#define INCLUDE_OLA_THREAD_SEQUENCEDSNAPSHOT_H_
+
+#include <ola/base/Macro.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief A seqlock-published value: one writer publishes, any number of
+ * threads read without blocking the writer.
+ *
+ * T must be trivially copyable (plain structs of counters / ids); the
+ * reader copies the bytes and retries if a write raced it, so neither
+ * side ever takes a lock. Use this to export summary stats (universe
+ * counters, port rates) from the main loop to monitoring threads; for
+ * types with real copy constructors use a mutex-guarded copy instead.
+ */
+template <typename T>
+class SequencedSnapshot {
+ public:
+  SequencedSnapshot() : m_sequence(0) {
+    memset(&m_value, 0, sizeof(m_value));
+  }
+
+  /**
+   * @brief Publish a new value. Single writer only.
+   */
+  void Publish(const T &value) {
+    __atomic_add_fetch(&m_sequence, 1, __ATOMIC_ACQ_REL);  // now odd
+    memcpy(&m_value, &value, sizeof(T));
+    __atomic_add_fetch(&m_sequence, 1, __ATOMIC_ACQ_REL);  // even again
+  }
+
+  /**
+   * @brief Read the current value. Safe from any thread.
+   * @returns false only if a writer raced us repeatedly.
+   */
+  bool Get(T *value) const {
+    for (unsigned int attempt = 0; attempt < 100; attempt++) {
+      uint32_t before = __atomic_load_n(&m_sequence, __ATOMIC_ACQUIRE);
+      if (before & 1)
+        continue;
+      memcpy(value, &m_value, sizeof(T));
+      uint32_t after = __atomic_load_n(&m_sequence, __ATOMIC_ACQUIRE);
+      if (before == after)
+        return true;
+    }
+    return false;
+  }
+
+ private:
+  uint32_t m_sequence;
+  T m_value;
+
+  DISALLOW_COPY_AND_ASSIGN(SequencedSnapshot);
+};
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_SEQUENCEDSNAPSHOT_H_
@@ -92,6 +92,15 @@ class Thread {
      */
     int inheritsched;
 
+    /**
+     * @brief The CPU to pin this thread to, or -1 for no affinity.
+     *
+     * Pinning needs platform support (cpusets on Linux); elsewhere the
+     * option is ignored with a warning. Use it to keep latency-critical
+     * threads (ingest shards, USB output) on isolated cores.
+     */
+    int cpu;
+
     /**
      * @brief Create new thread Options.
      * @param name the name of the thread.
@@ -1,6 +1,7 @@
 olatimecodeincludedir = $(pkgincludedir)/timecode/
 
-olatimecodeinclude_HEADERS = include/ola/timecode/TimeCode.h
+olatimecodeinclude_HEADERS = include/ola/timecode/TimeCode.h \
+                             include/ola/timecode/TimeCodeEngine.h
 nodist_olatimecodeinclude_HEADERS = include/ola/timecode/TimeCodeEnums.h
 
 dist_noinst_SCRIPTS += include/ola/timecode/make_timecode.sh
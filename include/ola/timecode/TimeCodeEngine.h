@@ -0,0 +1,114 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TimeCodeEngine.h
+ * Extrapolates timecode between received frames with a
+ * drift-compensated local clock.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_TIMECODE_TIMECODEENGINE_H_
+#define INCLUDE_OLA_TIMECODE_TIMECODEENGINE_H_
+
+#include <ola/Callback.h>
+#include <ola/Clock.h>
+#include <ola/base/Macro.h>
+#include <ola/io/SelectServerInterface.h>
+#include <ola/timecode/TimeCode.h>
+
+#include <memory>
+
+namespace ola {
+namespace timecode {
+
+/**
+ * @brief Re-times incoming timecode onto local frame boundaries.
+ *
+ * Timecode arriving over RPC carries the sender's scheduling and
+ * network jitter. The engine locks a local frame clock to the incoming
+ * stream: each received frame's arrival error against the predicted
+ * boundary feeds a PI controller that trims the local period (drift)
+ * and nudges the phase (offset), and the output callback fires from
+ * timer deadlines on the local clock - so downstream consumers see
+ * frame boundaries with timer jitter, not RPC jitter.
+ *
+ * A discontinuity (seek, stop, type change) resyncs immediately. If
+ * input stops, the engine freewheels for FREEWHEEL_FRAMES frames and
+ * then goes quiet until input resumes.
+ */
+class TimeCodeEngine {
+ public:
+  typedef Callback1<void, const TimeCode&> TimeCodeCallback;
+
+  /**
+   * @brief Create a new TimeCodeEngine.
+   * @param ss the SelectServer to schedule frame deadlines on.
+   * @param clock the Clock to use, must outlive the engine.
+   * @param callback run on each local frame boundary, ownership is
+   * transferred.
+   */
+  TimeCodeEngine(ola::io::SelectServerInterface *ss,
+                 Clock *clock,
+                 TimeCodeCallback *callback);
+  ~TimeCodeEngine();
+
+  /**
+   * @brief Feed a received timecode frame into the engine.
+   */
+  void InputTimeCode(const TimeCode &timecode);
+
+  /**
+   * @brief The current estimated frame period in microseconds, for
+   * diagnostics.
+   */
+  double EstimatedPeriod() const { return m_period_usecs; }
+
+  // how many frames to output past the last input before going quiet
+  static const unsigned int FREEWHEEL_FRAMES = 5;
+
+ private:
+  ola::io::SelectServerInterface *m_ss;
+  Clock *m_clock;
+  std::auto_ptr<TimeCodeCallback> m_callback;
+
+  bool m_running;
+  TimeCodeType m_type;
+  uint64_t m_next_frame;       // absolute frame number to emit next
+  uint64_t m_last_input_frame;
+  TimeStamp m_base_time;       // when frame m_base_frame starts
+  uint64_t m_base_frame;
+  double m_period_usecs;
+  ola::thread::timeout_id m_timeout;
+
+  void Resync(const TimeCode &timecode, const TimeStamp &now);
+  void EmitFrame();
+  void ScheduleNext();
+  TimeStamp FrameDeadline(uint64_t frame) const;
+
+  static uint64_t ToFrameNumber(const TimeCode &timecode);
+  static TimeCode FromFrameNumber(TimeCodeType type, uint64_t frame);
+  static unsigned int FramesPerSecond(TimeCodeType type);
+  static double NominalPeriod(TimeCodeType type);
+
+  // controller gains: the phase nudge per frame of observed error, and
+  // the period trim
+  static const double KP;
+  static const double KI;
+
+  DISALLOW_COPY_AND_ASSIGN(TimeCodeEngine);
+};
+}  // namespace timecode
+}  // namespace ola
+#endif  // INCLUDE_OLA_TIMECODE_TIMECODEENGINE_H_
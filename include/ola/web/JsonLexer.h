@@ -50,6 +50,16 @@ namespace web {
  * As the JsonLexer encounters each token in the document, it calls the
  * appropriate method on the JsonParserInterface. It's not quite a pure lexer
  * because it doesn't pass through tokens like ':' but you get the idea.
+ *
+ * This is the SAX-style entry point: implement JsonParserInterface and
+ * Parse() streams events to you with no intermediate tree. JsonParser (the
+ * JsonValue-building handler) is just one implementation layered on top,
+ * so code that only extracts a few fields - the JSON-RPC style POSTs, say -
+ * can implement a small handler here and skip materializing (and then
+ * re-walking) the document. The String() callbacks do hand over std::string
+ * values, so per-token strings are copied; in-situ slices would need the
+ * lexer to guarantee the input outlives the callbacks, which it currently
+ * doesn't require of callers.
  */
 class JsonLexer {
  public:
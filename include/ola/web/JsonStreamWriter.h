@@ -0,0 +1,132 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamWriter.h
+ * Serialize JSON directly to a stream, without building a value tree.
+ * Copyright (C) 2012 Simon Newton
+ */
+
+/**
+ * @addtogroup json
+ * @{
+ * @file JsonStreamWriter.h
+ * @brief Serialize JSON as it's built, straight into an output stream.
+ * @}
+ */
+
+#ifndef INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
+#define INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
+
+#include <ola/base/Macro.h>
+#include <stdint.h>
+#include <ostream>
+#include <string>
+
+namespace ola {
+namespace web {
+
+/**
+ * @addtogroup json
+ * @{
+ */
+
+/**
+ * @brief Serialize JSON directly into an output stream.
+ *
+ * Unlike JsonWriter, which walks a JsonValue tree that the caller first
+ * has to build (heap node per value), this writes each element as it's
+ * added, so a hot endpoint can serialize straight into the response buffer
+ * with no intermediate allocations. Commas and key/value punctuation are
+ * handled automatically; the caller is responsible for balancing
+ * Open/Close calls.
+ */
+class JsonStreamWriter {
+ public:
+  /**
+   * @brief Create a new JsonStreamWriter.
+   * @param output the stream to serialize to.
+   */
+  explicit JsonStreamWriter(std::ostream *output)
+      : m_output(output),
+        m_depth(0) {
+    m_needs_comma[0] = false;
+  }
+
+  /**
+   * @brief Open an object. If key is non-empty this writes "key": {.
+   */
+  void OpenObject(const std::string &key = "");
+
+  /**
+   * @brief Close the current object.
+   */
+  void CloseObject();
+
+  /**
+   * @brief Open an array. If key is non-empty this writes "key": [.
+   */
+  void OpenArray(const std::string &key = "");
+
+  /**
+   * @brief Close the current array.
+   */
+  void CloseArray();
+
+  /**
+   * @brief Add a string value, either to the current array, or as
+   * "key": "value" within an object.
+   */
+  void AddString(const std::string &key, const std::string &value);
+  void AddString(const std::string &value) { AddString("", value); }
+
+  /**
+   * @brief Add an integer value.
+   */
+  void AddNumber(const std::string &key, int64_t value);
+  void AddNumber(int64_t value) { AddNumber("", value); }
+
+  /**
+   * @brief Add an unsigned integer value.
+   */
+  void AddNumber(const std::string &key, uint64_t value);
+  void AddNumber(uint64_t value) { AddNumber("", value); }
+
+  /**
+   * @brief Add a bool value.
+   */
+  void AddBool(const std::string &key, bool value);
+  void AddBool(bool value) { AddBool("", value); }
+
+  /**
+   * @brief Add a null value.
+   */
+  void AddNull(const std::string &key = "");
+
+ private:
+  static const unsigned int MAX_DEPTH = 32;
+
+  std::ostream *m_output;
+  unsigned int m_depth;
+  // whether the next element at each depth needs a leading comma
+  bool m_needs_comma[MAX_DEPTH + 1];
+
+  void StartElement(const std::string &key);
+
+  DISALLOW_COPY_AND_ASSIGN(JsonStreamWriter);
+};
+/**@}*/
+}  // namespace web
+}  // namespace ola
+#endif  // INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
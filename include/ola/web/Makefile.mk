@@ -9,5 +9,6 @@ olawebinclude_HEADERS = \
     include/ola/web/JsonPointer.h \
     include/ola/web/JsonSchema.h \
     include/ola/web/JsonSections.h \
+    include/ola/web/JsonStreamWriter.h \
     include/ola/web/JsonTypes.h \
     include/ola/web/JsonWriter.h
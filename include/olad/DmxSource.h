@@ -68,6 +68,18 @@ class DmxSource {
       return *this;
     }
 
+    /*
+     * Update this source in place, reusing the buffer's backing store.
+     * This is the streaming-DMX fast path; a client sending at frame rate
+     * overwrites its existing source rather than building a new one.
+     */
+    void UpdateData(const uint8_t *data, unsigned int length,
+                    const TimeStamp &timestamp, uint8_t priority) {
+      m_buffer.Set(data, length);
+      m_timestamp = timestamp;
+      m_priority = priority;
+    }
+
     /*
      * Equality check
      */
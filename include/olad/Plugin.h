@@ -45,6 +45,12 @@ class AbstractPlugin {
    */
   virtual bool LoadPreferences() = 0;
 
+  /**
+   * @brief Re-read this plugin's preferences from the backing store, so
+   * a hot restart picks up config changes.
+   */
+  virtual bool ReloadPreferences() { return false; }
+
   /**
    * @brief The location for preferences. This can be anything really but should
    * indicate to the user how how the preferences were loaded.
@@ -113,6 +119,7 @@ class Plugin: public AbstractPlugin {
   virtual ~Plugin() {}
 
   bool LoadPreferences();
+  bool ReloadPreferences();
   std::string PreferenceSource() const;
   bool IsEnabled() const;
   virtual bool Start();
@@ -160,10 +160,44 @@ class InputPort: public Port {
 /**
  * @brief A port that sends DMX512 data.
  */
+/**
+ * @brief The standard per-output-port pipeline counters.
+ *
+ * Populated by the common send path (Universe::UpdateDependants), so
+ * every plugin gets the same visibility without doing its own counting.
+ * When output is dark these localize the dropping stage: offered but
+ * not sent means the plugin's WriteDMX refused the frame; a large max
+ * send time means the plugin is blocking the loop.
+ */
+struct OutputPortStats {
+  OutputPortStats()
+      : frames_offered(0),
+        frames_sent(0),
+        frames_dropped(0),
+        send_time_total_usecs(0),
+        send_time_max_usecs(0),
+        last_drop_time(0) {
+  }
+
+  uint64_t frames_offered;
+  uint64_t frames_sent;
+  uint64_t frames_dropped;  /**< WriteDMX returned false */
+  uint64_t send_time_total_usecs;
+  uint64_t send_time_max_usecs;
+  time_t last_drop_time;  /**< when WriteDMX last failed */
+};
+
+
 class OutputPort: public Port, ola::rdm::DiscoverableRDMControllerInterface {
  public:
   virtual ~OutputPort() {}
 
+  /**
+   * @brief The pipeline stats for this port, or NULL if the port doesn't
+   * track them. BasicOutputPort-derived ports (all in-tree plugins) do.
+   */
+  virtual OutputPortStats *GetOutputPortStats() { return NULL; }
+
   /**
    * @brief Write DMX data to this port
    * @param buffer the DmxBuffer to write
@@ -213,7 +247,10 @@ class BasicInputPort: public InputPort {
   virtual std::string UniqueId() const;
   bool SetPriority(uint8_t priority);
   uint8_t GetPriority() const { return m_priority; }
-  void SetPriorityMode(port_priority_mode mode) { m_priority_mode = mode; }
+  void SetPriorityMode(port_priority_mode mode) {
+    m_priority_mode = mode;
+    m_priority_policy = POLICY_UNRESOLVED;
+  }
   port_priority_mode GetPriorityMode() const { return m_priority_mode; }
 
   /**
@@ -262,7 +299,18 @@ class BasicInputPort: public InputPort {
   virtual bool SupportsPriorities() const { return false; }
 
  private:
+  // The capability / mode pair resolved to a flat policy, so the
+  // per-frame path doesn't re-derive it through virtual calls. Resolved
+  // lazily (the capability virtual can't be called from the
+  // constructor) and invalidated by SetPriorityMode.
+  enum PriorityPolicy {
+    POLICY_UNRESOLVED,
+    POLICY_STATIC,
+    POLICY_INHERIT,
+  };
+
   const unsigned int m_port_id;
+  mutable PriorityPolicy m_priority_policy;
   uint8_t m_priority;
   port_priority_mode m_priority_mode;
   mutable std::string m_port_string;
@@ -340,6 +388,8 @@ class BasicOutputPort: public OutputPort {
 
   virtual bool SupportsRDM() const { return m_supports_rdm; }
 
+  OutputPortStats *GetOutputPortStats() { return &m_output_stats; }
+
  protected:
   // indicates whether this port supports priorities, default to no
   virtual bool SupportsPriorities() const { return false; }
@@ -358,6 +408,7 @@ class BasicOutputPort: public OutputPort {
   Universe *m_universe;  // the universe this port belongs to
   AbstractDevice *m_device;
   bool m_supports_rdm;
+  OutputPortStats m_output_stats;
 
   DISALLOW_COPY_AND_ASSIGN(BasicOutputPort);
 };
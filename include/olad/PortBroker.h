@@ -30,7 +30,7 @@
 #include <ola/Callback.h>
 #include <olad/Universe.h>
 #include <olad/Port.h>
-#include <set>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -52,7 +52,7 @@ class PortBrokerInterface {
 
 class PortBroker: public PortBrokerInterface {
  public:
-    PortBroker() {}
+    PortBroker() : m_generation(0) {}
     ~PortBroker() {}
 
     void AddPort(const Port *port);
@@ -64,7 +64,12 @@ class PortBroker: public PortBrokerInterface {
                         ola::rdm::RDMCallback *callback);
 
  private:
-    typedef std::pair<std::string, const Port*> port_key;
+    // The port pointer plus a registration generation. The generation guards
+    // against the ABA problem where a port is deleted and a new one is
+    // allocated at the same address while a request is in flight. Comparing
+    // pointers & generations keeps the per-request liveness check free of
+    // string construction.
+    typedef std::pair<const Port*, uint64_t> port_key;
 
     void RequestComplete(port_key key,
                          ola::rdm::RDMCallback *callback,
@@ -72,7 +77,10 @@ class PortBroker: public PortBrokerInterface {
                          const ola::rdm::RDMResponse *response,
                          const std::vector<std::string> &packets);
 
-    std::set<port_key> m_ports;
+    bool PortIsRegistered(const port_key &key) const;
+
+    std::map<const Port*, uint64_t> m_ports;
+    uint64_t m_generation;
 
     DISALLOW_COPY_AND_ASSIGN(PortBroker);
 };
@@ -281,6 +281,12 @@ class Preferences {
    */
   virtual bool HasKey(const std::string &key) const = 0;
 
+  /**
+   * @brief Fetch all keys in this store.
+   * @param[out] keys the vector to append the keys to.
+   */
+  virtual void GetKeys(std::vector<std::string> *keys) const = 0;
+
   /**
    * @brief Remove a preference value.
    * @param key
@@ -367,6 +373,7 @@ class MemoryPreferences: public Preferences {
   virtual std::vector<std::string> GetMultipleValue(
       const std::string &key) const;
   virtual bool HasKey(const std::string &key) const;
+  virtual void GetKeys(std::vector<std::string> *keys) const;
 
   virtual void RemoveValue(const std::string &key);
 
@@ -422,12 +429,23 @@ class FilePreferenceSaverThread: public ola::thread::Thread {
 
  private:
   ola::io::SelectServer m_ss;
+  // saves coalesced per file, only touched from the saver thread
+  std::map<std::string, PreferencesMap> m_pending_saves;
+  ola::thread::timeout_id m_flush_timeout;
 
   /**
    * Notify the blocked thread we're done
    */
   void CompleteSyncronization(ola::thread::ConditionVariable *condition,
                               ola::thread::Mutex *mutex);
+
+  void QueueSave(const std::string *filename,
+                 const PreferencesMap *preferences);
+  void FlushPendingSaves();
+
+  // how long to hold a save waiting for more; a patch storm collapses
+  // into one rewrite per file
+  static const unsigned int SAVE_DELAY_MS = 500;
 };
 
 
@@ -39,6 +39,17 @@ class TokenBucket {
     }
 
     bool GetToken(const TimeStamp &now);
+
+    /**
+     * Take up to token_count tokens in one call, for callers that send a
+     * burst of packets per event loop. Pass the SelectServer's WakeUpTime()
+     * so checking costs no extra time reads.
+     * @param now the current time
+     * @param token_count the number of tokens wanted
+     * @returns the number of tokens granted, <= token_count.
+     */
+    unsigned int GetTokens(const TimeStamp &now, unsigned int token_count);
+
     unsigned int Count(const TimeStamp &now);
 
  private:
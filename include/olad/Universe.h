@@ -114,12 +114,57 @@ class Universe: public ola::rdm::RDMControllerInterface {
     bool AddSinkClient(Client *client);
     bool RemoveSinkClient(Client *client);
     bool ContainsSinkClient(Client *client) const;
+
+    /**
+     * @brief The in-daemon frame statistics, see SampleFrameStats().
+     */
+    struct SlotStats {
+      unsigned int changed_slots;
+      uint8_t slot_min;
+      uint8_t slot_max;
+      uint8_t slot_mean;
+      uint64_t sampled_frames;
+    };
+    SlotStats GetSlotStats() const {
+      SlotStats stats = {m_changed_slots, m_slot_min, m_slot_max,
+                         m_slot_mean, m_sampled_frames};
+      return stats;
+    }
+
+    static const unsigned int SLOT_STATS_SAMPLE_INTERVAL = 16;
+    // how long an unchanged frame may be suppressed before we refresh
+    // the outputs; well inside the E1.31 (2.5s) and ArtNet (~4s) data
+    // loss timeouts
+    static const unsigned int SUPPRESSION_REFRESH_INTERVAL_MS = 1000;
     unsigned int SinkClientCount() const { return m_sink_clients.size(); }
 
     // These are called when new data arrives on a port/client
     bool PortDataChanged(InputPort *port);
     bool SourceClientDataChanged(Client *client);
 
+    /**
+     * Defer merge & fanout until FlushPendingUpdates() is called, rather
+     * than running them inline from PortDataChanged() /
+     * SourceClientDataChanged(). This lets the server coalesce multiple
+     * updates that arrive in one poll cycle into a single fanout.
+     */
+    void SetDeferredUpdates(bool defer) { m_defer_updates = defer; }
+    bool FlushPendingUpdates();
+
+    /**
+     * When frame clocked, deferred updates are held until ClockTick()
+     * rather than being flushed every event loop, giving the outputs a
+     * fixed cadence that's decoupled from input arrival timing.
+     */
+    void SetFrameClock(bool enabled) { m_frame_clocked = enabled; }
+    bool FrameClocked() const { return m_frame_clocked; }
+
+    /**
+     * Merge any pending updates and emit the current frame to the
+     * dependants, called by the server's frame scheduler.
+     */
+    void ClockTick();
+
     // This is can be called periodically to clean stale clients
     //    stale == client that has not sent data
     void CleanStaleSourceClients();
@@ -163,6 +208,23 @@ class Universe: public ola::rdm::RDMControllerInterface {
     std::string m_universe_name;
     unsigned int m_universe_id;
     std::string m_universe_id_str;
+    // scratch for the encode-once client fanout
+    std::string m_encoded_client_frame;
+    // when we last fanned a frame out; bounds the unchanged-frame
+    // suppression so downstream nodes keep seeing traffic
+    TimeStamp m_last_fanout_time;
+    // slot stats, sampled every SLOT_STATS_SAMPLE_INTERVAL'th frame in
+    // the merge pass while the data is hot
+    uint64_t m_frames_since_sample;
+    uint64_t m_sampled_frames;
+    unsigned int m_changed_slots;
+    uint8_t m_slot_min;
+    uint8_t m_slot_max;
+    uint8_t m_slot_mean;
+    // resolved once at construction; the per-frame stats bump mustn't
+    // re-do two string-keyed map lookups (see ola/strings/Intern.h for
+    // the general facility)
+    unsigned int *m_fps_counter;
     uint8_t m_active_priority;
     enum merge_mode m_merge_mode;  // merge mode
     std::vector<InputPort*> m_input_ports;
@@ -174,10 +236,20 @@ class Universe: public ola::rdm::RDMControllerInterface {
      */
     SourceClientMap m_source_clients;
     class UniverseStore *m_universe_store;
+    bool m_defer_updates;
+    bool m_frame_clocked;
+    // The ports & clients with changes waiting for the next flush.
+    std::set<InputPort*> m_pending_ports;
+    std::set<Client*> m_pending_clients;
     DmxBuffer m_buffer;
+    // A copy of the last frame passed to the dependants, used to skip the
+    // fanout when a merge produces identical data.
+    DmxBuffer m_last_sent;
     ExportMap *m_export_map;
     std::map<ola::rdm::UID, OutputPort*> m_output_uids;
     Clock *m_clock;
+    // scratch space for MergeAll, reused to avoid per-frame allocation
+    std::vector<const DmxSource*> m_active_sources;
     TimeInterval m_rdm_discovery_interval;
     TimeStamp m_last_discovery_time;
 
@@ -189,10 +261,11 @@ class Universe: public ola::rdm::RDMControllerInterface {
                                   ola::rdm::rdm_response_code code,
                                   const ola::rdm::RDMResponse *response,
                                   const std::vector<std::string> &packets);
+    bool MergePendingUpdates();
     bool UpdateDependants();
     void UpdateName();
     void UpdateMode();
-    void HTPMergeSources(const std::vector<DmxSource> &sources);
+    void HTPMergeSources(const std::vector<const DmxSource*> &sources);
     bool MergeAll(const InputPort *port, const Client *client);
     void PortDiscoveryComplete(BaseCallback0<void> *on_complete,
                                OutputPort *output_port,
@@ -200,6 +273,7 @@ class Universe: public ola::rdm::RDMControllerInterface {
     void DiscoveryComplete(ola::rdm::RDMDiscoveryCallback *on_complete);
 
     void SafeIncrement(const std::string &name);
+    void SampleFrameStats();
     void SafeDecrement(const std::string &name);
 
     template<class PortClass>
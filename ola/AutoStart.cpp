@@ -30,9 +30,17 @@
 #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif  // !_WIN32
+
+#include <string>
+
 #include <ola/AutoStart.h>
 #include <ola/network/IPV4Address.h>
 #include <ola/network/SocketAddress.h>
+#include "common/rpc/RpcServer.h"
 #include <ola/Logging.h>
 
 namespace ola {
@@ -40,13 +48,48 @@ namespace client {
 
 using ola::network::TCPSocket;
 
+/*
+ * Try the Unix domain socket endpoint the server exposes for same-host
+ * clients; cheaper than loopback TCP and no TIME_WAIT churn across
+ * reconnects.
+ */
+static TCPSocket *ConnectUnixSocket(unsigned short port) {
+#ifdef _WIN32
+  (void) port;
+  return NULL;
+#else
+  struct sockaddr_un address;
+  const std::string path = ola::rpc::RpcServer::DefaultUnixSocketPath(port);
+  if (path.size() >= sizeof(address.sun_path))
+    return NULL;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return NULL;
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  if (connect(fd, reinterpret_cast<struct sockaddr*>(&address),
+              sizeof(address))) {
+    close(fd);
+    return NULL;
+  }
+  return new TCPSocket(fd);
+#endif  // _WIN32
+}
+
 /*
  * Open a connection to the server.
  */
 TCPSocket *ConnectToServer(unsigned short port) {
+  TCPSocket *socket = ConnectUnixSocket(port);
+  if (socket)
+    return socket;
+
   ola::network::IPV4SocketAddress server_address(
       ola::network::IPV4Address::Loopback(), port);
-  TCPSocket *socket = TCPSocket::Connect(server_address);
+  socket = TCPSocket::Connect(server_address);
   if (socket)
     return socket;
 
@@ -150,6 +150,22 @@ void OlaClient::RegisterUniverse(unsigned int universe,
   m_core->RegisterUniverse(universe, register_action, callback);
 }
 
+void OlaClient::SubscribeUniverseChanges(
+    ola::Callback1<void, unsigned int> *callback) {
+  m_core->SubscribeUniverseChanges(callback);
+}
+
+const std::map<unsigned int, OlaUniverse> &OlaClient::CachedUniverses()
+    const {
+  return m_core->CachedUniverses();
+}
+
+void OlaClient::SendDMXBatch(
+    const std::vector<std::pair<unsigned int, DmxBuffer> > &frames,
+    uint8_t priority) {
+  m_core->SendDMXBatch(frames, priority);
+}
+
 void OlaClient::SendDMX(unsigned int universe,
                         const DmxBuffer &data,
                         const SendDMXArgs &args) {
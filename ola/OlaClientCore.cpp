@@ -469,6 +469,75 @@ void OlaClientCore::SendDMX(unsigned int universe,
   }
 }
 
+void OlaClientCore::SubscribeUniverseChanges(
+    ola::Callback1<void, unsigned int> *callback) {
+  m_universe_change_callback.reset(callback);
+
+  ola::proto::UniverseChangeSubscription request;
+  request.set_action(ola::proto::REGISTER);
+  RpcController *controller = new RpcController();
+  ola::proto::Ack *reply = new ola::proto::Ack();
+
+  if (m_connected) {
+    CompletionCallback *cb = ola::NewSingleCallback(
+        this, &OlaClientCore::HandleAck, controller, reply,
+        static_cast<SetCallback*>(NULL));
+    m_stub->SubscribeUniverseChanges(controller, &request, reply, cb);
+  } else {
+    delete controller;
+    delete reply;
+  }
+}
+
+
+void OlaClientCore::UniverseChanged(
+    ola::rpc::RpcController*,
+    const ola::proto::UniverseChange* request,
+    ola::proto::STREAMING_NO_RESPONSE*,
+    CompletionCallback* done) {
+  unsigned int universe_id = request->universe();
+  if (request->change_type() == ola::proto::UNIVERSE_REMOVED) {
+    m_universe_cache.erase(universe_id);
+  } else {
+    client::OlaUniverse universe(
+        universe_id,
+        request->merge_mode() == ola::proto::HTP ?
+            client::OlaUniverse::MERGE_HTP : client::OlaUniverse::MERGE_LTP,
+        request->has_name() ? request->name() : "",
+        0, 0, 0);
+    m_universe_cache.erase(universe_id);
+    m_universe_cache.insert(std::make_pair(universe_id, universe));
+  }
+
+  if (m_universe_change_callback.get())
+    m_universe_change_callback->Run(universe_id);
+  if (done)
+    done->Run();
+}
+
+
+void OlaClientCore::SendDMXBatch(
+    const std::vector<std::pair<unsigned int, DmxBuffer> > &frames,
+    uint8_t priority) {
+  if (!m_connected || frames.empty())
+    return;
+
+  ola::proto::DmxBatch request;
+  std::vector<std::pair<unsigned int, DmxBuffer> >::const_iterator iter =
+      frames.begin();
+  for (; iter != frames.end(); ++iter) {
+    ola::proto::DmxData *frame = request.add_frames();
+    frame->set_universe(iter->first);
+    if (iter->second.GetRaw()) {
+      frame->set_data(iter->second.GetRaw(), iter->second.Size());
+    } else {
+      frame->set_data("");
+    }
+    frame->set_priority(priority);
+  }
+  m_stub->StreamDmxBatch(NULL, &request, NULL, NULL);
+}
+
 void OlaClientCore::FetchDMX(unsigned int universe,
                              DMXCallback *callback) {
   ola::proto::UniverseRequest request;
@@ -610,7 +679,10 @@ void OlaClientCore::UpdateDmxData(ola::rpc::RpcController*,
     DMXMetadata metadata(request->universe(), priority);
     m_dmx_callback->Run(metadata, buffer);
   }
-  done->Run();
+  // compact pushed frames are dispatched with a NULL done
+  if (done) {
+    done->Run();
+  }
 }
 
 void OlaClientCore::ChannelClosed(ClosedCallback *callback,
@@ -22,7 +22,10 @@
 #define OLA_OLACLIENTCORE_H_
 
 #include <memory>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
@@ -236,6 +239,19 @@ class OlaClientCore: public ola::proto::OlaClientService {
                const DmxBuffer &data,
                const SendDMXArgs &args);
 
+  /**
+   * @brief Send DMX data for many universes in a single message.
+   * @param frames the (universe, data) pairs to send.
+   * @param priority the priority to use for all the frames.
+   *
+   * The frames are packed into one RPC and one socket write, and the
+   * server applies them in a single pass. There's no ack; this uses the
+   * streaming path.
+   */
+  void SendDMXBatch(
+      const std::vector<std::pair<unsigned int, DmxBuffer> > &frames,
+      uint8_t priority);
+
   /**
    * @brief Fetch the latest DMX data for a universe.
    * @param universe the universe id to get data for.
@@ -312,8 +328,36 @@ class OlaClientCore: public ola::proto::OlaClientService {
                      ola::proto::Ack* response,
                      CompletionCallback* done);
 
+  void UniverseChanged(ola::rpc::RpcController* controller,
+                       const ola::proto::UniverseChange* request,
+                       ola::proto::STREAMING_NO_RESPONSE* response,
+                       CompletionCallback* done);
+
+  /**
+   * @brief Subscribe to universe change events from the server.
+   * The client keeps a local cache of the universes which can be queried
+   * synchronously with CachedUniverses(); the callback (if provided, may
+   * be NULL) runs after each delta is applied. Ownership of the callback
+   * is transferred.
+   */
+  void SubscribeUniverseChanges(
+      ola::Callback1<void, unsigned int> *callback);
+
+  /**
+   * @brief The locally cached universe state, maintained from the deltas
+   * pushed by the server. Only valid once SubscribeUniverseChanges() has
+   * been called.
+   */
+  const std::map<unsigned int, client::OlaUniverse> &CachedUniverses()
+      const {
+    return m_universe_cache;
+  }
+
  private:
   ola::io::ConnectedDescriptor *m_descriptor;
+  std::map<unsigned int, client::OlaUniverse> m_universe_cache;
+  std::auto_ptr<ola::Callback1<void, unsigned int> >
+      m_universe_change_callback;
   std::auto_ptr<RepeatableDMXCallback> m_dmx_callback;
   std::auto_ptr<ola::rpc::RpcChannel> m_channel;
   std::auto_ptr<ola::proto::OlaServerService_Stub> m_stub;
@@ -45,6 +45,7 @@ using ola::rpc::RpcChannel;
 StreamingClient::StreamingClient(bool auto_start)
     : m_auto_start(auto_start),
       m_server_port(OLA_DEFAULT_PORT),
+      m_use_compact_frames(false),
       m_socket(NULL),
       m_ss(NULL),
       m_channel(NULL),
@@ -55,6 +56,7 @@ StreamingClient::StreamingClient(bool auto_start)
 StreamingClient::StreamingClient(const Options &options)
     : m_auto_start(options.auto_start),
       m_server_port(options.server_port),
+      m_use_compact_frames(options.use_compact_frames),
       m_socket(NULL),
       m_ss(NULL),
       m_channel(NULL),
@@ -153,11 +155,16 @@ bool StreamingClient::Send(unsigned int universe, uint8_t priority,
     return false;
   }
 
-  ola::proto::DmxData request;
-  request.set_universe(universe);
-  request.set_data(data.Get());
-  request.set_priority(priority);
-  m_stub->StreamDmxData(NULL, &request, NULL, NULL);
+  if (m_use_compact_frames && data.GetRaw()) {
+    m_channel->SendCompactDmxFrame(static_cast<uint16_t>(universe),
+                                   priority, data.GetRaw(), data.Size());
+  } else {
+    ola::proto::DmxData request;
+    request.set_universe(universe);
+    request.set_data(data.Get());
+    request.set_priority(priority);
+    m_stub->StreamDmxData(NULL, &request, NULL, NULL);
+  }
 
   if (m_socket_closed) {
     Stop();
@@ -108,6 +108,7 @@ AvahiDiscoveryAgent::ServiceEntry::ServiceEntry(
       group(NULL),
       state(AVAHI_ENTRY_GROUP_UNCOMMITED),
       params(NULL),
+      txt_args(NULL),
       m_type_spec(type_spec) {
   vector<string> tokens;
   StringSplit(type_spec, &tokens, ",");
@@ -115,6 +116,19 @@ AvahiDiscoveryAgent::ServiceEntry::ServiceEntry(
   if (tokens.size() > 1) {
     copy(tokens.begin() + 1, tokens.end(), std::back_inserter(m_sub_types));
   }
+
+  // assemble the TXT record once
+  TxtData::const_iterator iter = txt_data.begin();
+  for (; iter != txt_data.end(); ++iter) {
+    txt_args = avahi_string_list_add_pair(
+        txt_args, iter->first.c_str(), iter->second.c_str());
+  }
+}
+
+AvahiDiscoveryAgent::ServiceEntry::~ServiceEntry() {
+  if (txt_args) {
+    avahi_string_list_free(txt_args);
+  }
 }
 
 string AvahiDiscoveryAgent::ServiceEntry::key() const {
@@ -298,22 +312,14 @@ bool AvahiDiscoveryAgent::InternalRegisterService(ServiceEntry *service) {
     return false;
   }
 
-  AvahiStringList *txt_args = NULL;
-  RegisterOptions::TxtData::const_iterator iter = service->txt_data.begin();
-  for (; iter != service->txt_data.end(); ++iter) {
-    txt_args = avahi_string_list_add_pair(
-        txt_args, iter->first.c_str(), iter->second.c_str());
-  }
-
-  // Populate the entry group
+  // Populate the entry group, reusing the TXT record assembled when the
+  // service was added.
   int r = avahi_entry_group_add_service_strlst(
       service->group,
       service->if_index > 0 ? service->if_index : AVAHI_IF_UNSPEC,
       AVAHI_PROTO_INET, static_cast<AvahiPublishFlags>(0),
       service->actual_service_name.c_str(), service->type().c_str(), NULL, NULL,
-      service->port, txt_args);
-
-  avahi_string_list_free(txt_args);
+      service->port, service->txt_args);
 
   if (r) {
     if (r == AVAHI_ERR_COLLISION) {
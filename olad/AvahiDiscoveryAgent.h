@@ -79,11 +79,15 @@ class AvahiDiscoveryAgent : public DiscoveryAgentInterface {
     AvahiEntryGroup *group;
     AvahiEntryGroupState state;
     struct EntryGroupParams *params;
+    // assembled once; re-registrations after collisions or daemon
+    // restarts reuse it
+    AvahiStringList *txt_args;
 
     ServiceEntry(const std::string &service_name,
                  const std::string &type_spec,
                  uint16_t port,
                  const RegisterOptions &options);
+    ~ServiceEntry();
 
     std::string key() const;
     const std::string &type() const { return m_type; }
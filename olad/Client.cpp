@@ -26,6 +26,7 @@
 #include "ola/Logging.h"
 #include "ola/rdm/UID.h"
 #include "ola/stl/STLUtils.h"
+#include "common/rpc/RpcChannel.h"
 #include "olad/Client.h"
 
 namespace ola {
@@ -37,7 +38,9 @@ using std::map;
 Client::Client(ola::proto::OlaClientService_Stub *client_stub,
                const ola::rdm::UID &uid)
     : m_client_stub(client_stub),
-      m_uid(uid) {
+      m_uid(uid),
+      m_subscribed_to_changes(false),
+      m_session_token(0) {
 }
 
 Client::~Client() {
@@ -68,19 +71,38 @@ bool Client::SendDMX(unsigned int universe, uint8_t priority,
   return true;
 }
 
+bool Client::SendDMXFrame(const std::string &encoded_frame) {
+  // no channel (e.g. test clients built on a NULL stub): the caller
+  // falls back to the protobuf path
+  if (!m_client_stub.get() || !m_client_stub->channel()) {
+    return false;
+  }
+  return m_client_stub->channel()->SendEncodedDmxFrame(encoded_frame);
+}
+
 void Client::DMXReceived(unsigned int universe, const DmxSource &source) {
   STLReplace(&m_data_map, universe, source);
 }
 
-const DmxSource Client::SourceData(unsigned int universe) const {
+void Client::SendUniverseChange(const ola::proto::UniverseChange &change) {
+  m_client_stub->UniverseChanged(NULL, &change, NULL, NULL);
+}
+
+void Client::DMXReceived(unsigned int universe, const uint8_t *data,
+                         unsigned int length, const TimeStamp &timestamp,
+                         uint8_t priority) {
+  m_data_map[universe].UpdateData(data, length, timestamp, priority);
+}
+
+const DmxSource &Client::SourceData(unsigned int universe) const {
+  static const DmxSource empty_source;
   map<unsigned int, DmxSource>::const_iterator iter =
     m_data_map.find(universe);
 
   if (iter != m_data_map.end()) {
     return iter->second;
   } else {
-    DmxSource source;
-    return source;
+    return empty_source;
   }
 }
 
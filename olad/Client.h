@@ -32,6 +32,7 @@ namespace ola {
 namespace proto {
 class OlaClientService_Stub;
 class Ack;
+class UniverseChange;
 }
 }
 
@@ -67,6 +68,16 @@ class Client {
   virtual bool SendDMX(unsigned int universe_id, uint8_t priority,
                        const DmxBuffer &buffer);
 
+  /**
+   * @brief Push a pre-encoded compact DMX frame to this client.
+   * @param encoded_frame a frame built with RpcChannel::EncodeDmxFrame.
+   * @return true if the frame was sent.
+   *
+   * Fanout paths encode the frame once and hand the same bytes to every
+   * sink client, so client count doesn't multiply serialization cost.
+   */
+  virtual bool SendDMXFrame(const std::string &encoded_frame);
+
   /**
    * @brief Called when this client sends us new data
    * @param universe the id of the universe for the new data
@@ -78,7 +89,42 @@ class Client {
    * @brief Get the most recent DMX data received from this client.
    * @param universe the id of the universe we're interested in
    */
-  const DmxSource SourceData(unsigned int universe) const;
+  const DmxSource &SourceData(unsigned int universe) const;
+
+  /**
+   * Store DMX data from this client without constructing an intermediate
+   * DmxSource; the existing source for the universe is updated in place.
+   */
+  void DMXReceived(unsigned int universe, const uint8_t *data,
+                   unsigned int length, const TimeStamp &timestamp,
+                   uint8_t priority);
+
+  /**
+   * @brief Push a universe change event to this client.
+   */
+  void SendUniverseChange(const ola::proto::UniverseChange &change);
+
+  void SubscribeToUniverseChanges(bool subscribed) {
+    m_subscribed_to_changes = subscribed;
+  }
+  bool SubscribedToUniverseChanges() const {
+    return m_subscribed_to_changes;
+  }
+
+  /**
+   * @brief The session resume token, 0 if the client never asked for
+   * one.
+   */
+  void SetSessionToken(uint32_t token) { m_session_token = token; }
+  uint32_t GetSessionToken() const { return m_session_token; }
+
+  /**
+   * @brief The full source data map, used to park a session on
+   * disconnect.
+   */
+  const std::map<unsigned int, DmxSource> &GetDataMap() const {
+    return m_data_map;
+  }
 
   /**
    * @brief Return the UID associated with this client.
@@ -102,6 +148,8 @@ class Client {
   std::auto_ptr<class ola::proto::OlaClientService_Stub> m_client_stub;
   std::map<unsigned int, DmxSource> m_data_map;
   ola::rdm::UID m_uid;
+  bool m_subscribed_to_changes;
+  uint32_t m_session_token;
 
   DISALLOW_COPY_AND_ASSIGN(Client);
 };
@@ -319,6 +319,14 @@ void DeviceManager::RestorePortSettings(const vector<PortClass*> &ports) const {
     return;
   }
 
+  // first boot / empty store: skip the per-port id construction and
+  // lookups entirely
+  std::vector<string> keys;
+  m_port_preferences->GetKeys(&keys);
+  if (keys.empty()) {
+    return;
+  }
+
   typename vector<PortClass*>::const_iterator iter = ports.begin();
   while (iter != ports.end()) {
     RestorePortPriority(*iter);
@@ -39,6 +39,8 @@ ola_server_sources = \
     olad/PluginManager.h \
     olad/Port.cpp \
     olad/Preferences.cpp \
+    olad/StartupProfiler.cpp \
+    olad/StartupProfiler.h \
     olad/RDMHTTPModule.h \
     olad/Universe.cpp \
     olad/UniverseStore.cpp \
@@ -24,6 +24,9 @@
 
 #include <errno.h>
 #include <signal.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif  // !_WIN32
 #include <stdio.h>
 #include <string.h>
 #include <memory>
@@ -42,6 +45,7 @@
 #include "ola/network/Socket.h"
 #include "ola/rdm/PidStore.h"
 #include "ola/rdm/UID.h"
+#include "ola/StringUtils.h"
 #include "ola/stl/STLUtils.h"
 #include "olad/Client.h"
 #include "olad/ClientBroker.h"
@@ -52,6 +56,7 @@
 #include "olad/Plugin.h"
 #include "olad/PluginAdaptor.h"
 #include "olad/PluginManager.h"
+#include "olad/StartupProfiler.h"
 #include "olad/Port.h"
 #include "olad/PortBroker.h"
 #include "olad/PortManager.h"
@@ -77,6 +82,7 @@ using ola::rpc::RpcSession;
 using ola::rpc::RpcServer;
 using std::auto_ptr;
 using std::pair;
+using std::string;
 using std::vector;
 
 const char OlaServer::INSTANCE_NAME_KEY[] = "instance-name";
@@ -87,6 +93,17 @@ const char OlaServer::UNIVERSE_PREFERENCES[] = "universe";
 // The Bonjour API expects <service>[,<sub-type>] so we use that form here.
 const char OlaServer::K_DISCOVERY_SERVICE_TYPE[] = "_http._tcp,_ola";
 const unsigned int OlaServer::K_HOUSEKEEPING_TIMEOUT_MS = 10000;
+// universes to run on the frame clock, e.g. "1,2,5"
+const char OlaServer::FRAME_CLOCK_UNIVERSES_KEY[] = "frame-clock-universes";
+const char OlaServer::FRAME_CLOCK_RATE_KEY[] = "frame-clock-rate";
+// the number of worker event loops to run, 0 disables sharding
+const char OlaServer::EVENT_LOOP_SHARDS_KEY[] = "event-loop-shards";
+const char OlaServer::LAZY_PLUGIN_LOADING_KEY[] = "lazy-plugin-loading";
+const char OlaServer::CLIENT_CONTROL_RPS_KEY[] = "client-control-rps";
+const char OlaServer::LOCK_MEMORY_KEY[] = "lock-memory";
+const char OlaServer::CLIENT_STREAM_RPS_KEY[] = "client-stream-rps";
+const char OlaServer::PRELOAD_PLUGINS_KEY[] = "preload-plugins";
+const unsigned int OlaServer::DEFAULT_FRAME_CLOCK_RATE = 40;
 
 OlaServer::OlaServer(const vector<PluginLoader*> &plugin_loaders,
                      PreferencesFactory *preferences_factory,
@@ -111,6 +128,8 @@ OlaServer::OlaServer(const vector<PluginLoader*> &plugin_loaders,
 }
 
 OlaServer::~OlaServer() {
+  if (m_pid_store_thread.get())
+    m_pid_store_thread->Join();
   m_ss->DrainCallbacks();
 
 #ifdef HAVE_LIBMICROHTTPD
@@ -129,6 +148,13 @@ OlaServer::~OlaServer() {
 
   StopPlugins();
 
+  // stop the worker loops after the plugins that may be using them
+  if (m_shard_group.get())
+    m_shard_group->Stop();
+
+  if (m_stall_watchdog.get())
+    m_stall_watchdog->Stop();
+
   m_broker.reset();
   m_port_broker.reset();
 
@@ -163,16 +189,16 @@ bool OlaServer::Init() {
   if (m_plugin_loaders.empty() || !m_preferences_factory)
     return false;
 
-  auto_ptr<const RootPidStore> pid_store(
-      RootPidStore::LoadFromDirectory(m_options.pid_data_dir));
-  if (!pid_store.get()) {
-    OLA_WARN << "No PID definitions loaded";
-  }
-
+  // The PID definitions are parsed off the main thread once the daemon
+  // is up; parsing the full store is a visible chunk of cold-start time
+  // and nothing needs it until the first RDM message is decoded.
 #ifndef _WIN32
   signal(SIGPIPE, SIG_IGN);
 #endif
 
+  StartupProfiler profiler(m_export_map);
+  profiler.StartPhase("interface-probe");
+
   // fetch the interface info
   ola::network::Interface iface;
   {
@@ -189,6 +215,7 @@ bool OlaServer::Init() {
   m_export_map->GetStringVar(K_UID_VAR)->Set(m_default_uid.ToString());
   OLA_INFO << "Server UID is " << m_default_uid;
 
+  profiler.StartPhase("preferences");
   m_server_preferences = m_preferences_factory->NewPreference(
       SERVER_PREFERENCES);
   m_server_preferences->Load();
@@ -205,6 +232,7 @@ bool OlaServer::Init() {
       UNIVERSE_PREFERENCES);
   universe_preferences->Load();
 
+  profiler.StartPhase("core-stores");
   auto_ptr<UniverseStore> universe_store(
       new UniverseStore(universe_preferences, m_export_map));
 
@@ -236,10 +264,28 @@ bool OlaServer::Init() {
       NewCallback(this, &OlaServer::ReloadPluginsInternal)));
 
   // Initialize the RPC server.
+  profiler.StartPhase("rpc-server");
   RpcServer::Options rpc_options;
   rpc_options.listen_socket = m_accepting_socket;
   rpc_options.listen_port = FLAGS_rpc_port;
   rpc_options.export_map = m_export_map;
+#ifndef _WIN32
+  rpc_options.unix_socket_path = RpcServer::DefaultUnixSocketPath(
+      FLAGS_rpc_port);
+#endif  // !_WIN32
+
+  // per-client admission limits, for multi-tenant installs where a
+  // misbehaving guest console mustn't starve the house console
+  unsigned int rps = 0;
+  if (StringToInt(m_server_preferences->GetValue(CLIENT_CONTROL_RPS_KEY),
+                  &rps)) {
+    rpc_options.control_rps_limit = rps;
+  }
+  rps = 0;
+  if (StringToInt(m_server_preferences->GetValue(CLIENT_STREAM_RPS_KEY),
+                  &rps)) {
+    rpc_options.stream_rps_limit = rps;
+  }
 
   auto_ptr<ola::rpc::RpcServer> rpc_server(
       new RpcServer(m_ss, service_impl.get(), this, rpc_options));
@@ -249,17 +295,14 @@ bool OlaServer::Init() {
     return false;
   }
 
-  // Discovery
+  // Discovery. The agent is only created here; connecting to the mDNS
+  // daemon and registering happen from the event loop after startup, so
+  // discovery never delays the first frame.
+  profiler.StartPhase("discovery");
   auto_ptr<DiscoveryAgentInterface> discovery_agent;
   if (FLAGS_register_with_dns_sd) {
     DiscoveryAgentFactory discovery_agent_factory;
     discovery_agent.reset(discovery_agent_factory.New());
-    if (discovery_agent.get()) {
-      if (!discovery_agent->Init()) {
-        OLA_WARN << "Failed to Init DiscoveryAgent";
-        return false;
-      }
-    }
   }
 
   bool web_server_started = false;
@@ -269,6 +312,7 @@ bool OlaServer::Init() {
   m_broker.reset(broker.release());
 
 #ifdef HAVE_LIBMICROHTTPD
+  profiler.StartPhase("http-server");
   if (m_options.http_enable) {
     if (StartHttpServer(rpc_server.get(), iface)) {
       web_server_started = true;
@@ -280,20 +324,16 @@ bool OlaServer::Init() {
   }
 #endif
 
-  if (web_server_started && discovery_agent.get()) {
-    DiscoveryAgentInterface::RegisterOptions options;
-    options.txt_data["path"] = "/";
-    discovery_agent->RegisterService(
-        m_instance_name,
-        K_DISCOVERY_SERVICE_TYPE,
-        m_options.http_port,
-        options);
-  }
+  const bool register_discovery = web_server_started &&
+      discovery_agent.get();
 
   // Ok, we've created and initialized everything correctly by this point. Now
   // we save all the pointers and schedule the last of the callbacks.
   m_device_manager.reset(device_manager.release());
   m_discovery_agent.reset(discovery_agent.release());
+  if (register_discovery) {
+    m_ss->Execute(NewSingleCallback(this, &OlaServer::StartDiscovery));
+  }
   m_plugin_adaptor.reset(plugin_adaptor.release());
   m_plugin_manager.reset(plugin_manager.release());
   m_port_broker.reset(port_broker.release());
@@ -302,27 +342,283 @@ bool OlaServer::Init() {
   m_service_impl.reset(service_impl.release());
   m_universe_store.reset(universe_store.release());
 
-  UpdatePidStore(pid_store.release());
+  // Coalesce input updates that arrive in the same poll cycle; universes
+  // queue their changes and we flush them once per event loop.
+  m_universe_store->SetDeferredUpdates(true);
+  m_universe_store->SetChangeCallback(NewCallback(
+      this, &OlaServer::OnUniverseChange));
+  // universes retire as soon as their last reference drops rather than
+  // on the housekeeping cadence
+  m_universe_store->SetGarbageCollectionCallback(NewCallback(
+      this, &OlaServer::ScheduleUniverseGC));
+  m_service_impl->SetReloadPluginCallback(NewCallback(
+      this, &OlaServer::ReloadPlugin));
+  // timecode is re-timed onto local frame boundaries before fanout
+  m_timecode_engine.reset(new ola::timecode::TimeCodeEngine(
+      m_ss, &m_clock,
+      NewCallback(this, &OlaServer::DistributeTimeCode)));
+  m_service_impl->SetTimeCodeEngine(m_timecode_engine.get());
+  m_ss->RunInLoop(NewCallback(this, &OlaServer::FlushUniverseUpdates));
+
+  SetupFrameClocks();
+
+  const string shards_str = m_server_preferences->GetValue(
+      EVENT_LOOP_SHARDS_KEY);
+  unsigned int shard_count = 0;
+  if (!shards_str.empty() && StringToInt(shards_str, &shard_count) &&
+      shard_count) {
+    m_shard_group.reset(
+        new ola::io::SelectServerShardGroup(shard_count, true));
+    if (m_shard_group->Start()) {
+      OLA_INFO << "Running " << shard_count << " event loop shards";
+    } else {
+      m_shard_group.reset();
+    }
+  }
+
+  // Opt-in for dedicated gateways: pin current and future allocations
+  // so the frame path never takes a major fault mid-show. The pools,
+  // the trace ring and the rx buffers are all heap allocations, so
+  // MCL_FUTURE covers them as they're created; failure (usually
+  // RLIMIT_MEMLOCK) downgrades with a warning.
+#ifndef _WIN32
+  if (m_server_preferences->GetValueAsBool(LOCK_MEMORY_KEY)) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE)) {
+      OLA_WARN << "lock-memory requested but mlockall() failed: "
+               << strerror(errno)
+               << ", check RLIMIT_MEMLOCK; continuing unlocked";
+    } else {
+      OLA_INFO << "Locked daemon memory, frame-path allocations won't "
+               << "fault";
+    }
+  }
+#endif  // !_WIN32
+
+  // watch for sub-second loop stalls that a supervisor can't see
+  m_stall_watchdog.reset(ola::io::StallWatchdog::NewFromFlags(m_export_map));
+  if (m_stall_watchdog.get()) {
+    m_stall_watchdog->Start();
+  }
+
+  // load the PID store in the background and swap it in when ready
+  ola::thread::Thread::Options pid_thread_options("pid-store-load");
+  m_pid_store_thread.reset(new PidStoreLoadThread(this, pid_thread_options));
+  m_pid_store_thread->Start();
 
   if (m_housekeeping_timeout != ola::thread::INVALID_TIMEOUT) {
     m_ss->RemoveTimeout(m_housekeeping_timeout);
   }
 
+  // Housekeeping is deadline-insensitive; a full second of slack lets
+  // the timer wheel coalesce it with whatever else is due, so it never
+  // forces its own wakeup between frames.
   m_housekeeping_timeout = m_ss->RegisterRepeatingTimeout(
-      K_HOUSEKEEPING_TIMEOUT_MS,
-      ola::NewCallback(this, &OlaServer::RunHousekeeping));
+      TimeInterval(K_HOUSEKEEPING_TIMEOUT_MS / 1000,
+                   (K_HOUSEKEEPING_TIMEOUT_MS % 1000) * 1000),
+      ola::NewCallback(this, &OlaServer::RunHousekeeping),
+      TimeInterval(1, 0));
+
+  // With lazy-plugin-loading enabled, only plugins referenced by a
+  // saved port patch or listed in preload-plugins probe their hardware;
+  // the rest are loaded (visible, configurable) but not started.
+  if (m_server_preferences->GetValueAsBool(LAZY_PLUGIN_LOADING_KEY)) {
+    std::set<ola_plugin_id> referenced;
+
+    Preferences *port_preferences =
+        m_preferences_factory->NewPreference("port");
+    port_preferences->Load();
+    std::vector<string> keys;
+    port_preferences->GetKeys(&keys);
+    std::vector<string>::const_iterator key_iter = keys.begin();
+    for (; key_iter != keys.end(); ++key_iter) {
+      // port keys are <plugin-id>-<device>..., see Device::UniqueId
+      unsigned int plugin_id = 0;
+      if (StringToInt(key_iter->substr(0, key_iter->find('-')),
+                      &plugin_id) && plugin_id) {
+        referenced.insert(static_cast<ola_plugin_id>(plugin_id));
+      }
+    }
+
+    std::vector<string> preload;
+    StringSplit(m_server_preferences->GetValue(PRELOAD_PLUGINS_KEY),
+                &preload, ",");
+    std::vector<string>::const_iterator preload_iter = preload.begin();
+    for (; preload_iter != preload.end(); ++preload_iter) {
+      unsigned int plugin_id = 0;
+      if (StringToInt(*preload_iter, &plugin_id) && plugin_id) {
+        referenced.insert(static_cast<ola_plugin_id>(plugin_id));
+      }
+    }
+    OLA_INFO << "Lazy plugin loading enabled, starting "
+             << referenced.size() << " referenced plugin(s)";
+    m_plugin_manager->SetStartWhitelist(referenced);
+  }
 
   // The plugin load procedure can take a while so we run it in the main loop.
   m_ss->Execute(
       ola::NewSingleCallback(m_plugin_manager.get(), &PluginManager::LoadAll));
 
+  // Plugins start from the event loop after this returns; their times land
+  // in the plugin-start-time-ms map as they come up.
+  profiler.Finish();
   return true;
 }
 
+void OlaServer::FlushUniverseUpdates() {
+  m_universe_store->FlushPendingUpdates();
+}
+
+/*
+ * Bring discovery up off the critical path: a slow or absent mDNS
+ * daemon costs the event loop one pass, not the startup sequence, and
+ * a failure downgrades discovery instead of killing the daemon.
+ */
+void OlaServer::StartDiscovery() {
+  if (!m_discovery_agent.get()) {
+    return;
+  }
+  if (!m_discovery_agent->Init()) {
+    OLA_WARN << "Failed to Init DiscoveryAgent, running without discovery";
+    m_discovery_agent.reset();
+    return;
+  }
+  DiscoveryAgentInterface::RegisterOptions options;
+  options.txt_data["path"] = "/";
+  m_discovery_agent->RegisterService(
+      m_instance_name,
+      K_DISCOVERY_SERVICE_TYPE,
+      m_options.http_port,
+      options);
+}
+
+void OlaServer::DistributeTimeCode(const ola::timecode::TimeCode &timecode) {
+  m_device_manager->SendTimeCode(timecode);
+}
+
+void OlaServer::ScheduleUniverseGC() {
+  // deletion can't happen inside the universe's own callstack
+  m_ss->Execute(NewSingleCallback(m_universe_store.get(),
+                                  &UniverseStore::GarbageCollectUniverses));
+}
+
+
+/*
+ * A universe was added/removed or changed its attributes: push the delta
+ * to subscribed clients and refresh the read-only snapshot.
+ */
+void OlaServer::OnUniverseChange(unsigned int universe_id,
+                                 UniverseStore::UniverseChange change) {
+  m_service_impl->BroadcastUniverseChange(universe_id, change);
+  RebuildUniverseSnapshot();
+}
+
+
+/*
+ * Rebuild the universe snapshot; runs on the main loop, readers copy it
+ * under the mutex from any thread.
+ */
+void OlaServer::RebuildUniverseSnapshot() {
+  vector<Universe*> universes;
+  m_universe_store->GetList(&universes);
+
+  std::vector<UniverseSnapshot> snapshot;
+  snapshot.reserve(universes.size());
+  vector<Universe*>::const_iterator iter = universes.begin();
+  for (; iter != universes.end(); ++iter) {
+    UniverseSnapshot entry;
+    entry.id = (*iter)->UniverseId();
+    entry.name = (*iter)->Name();
+    entry.htp_merge_mode = (*iter)->MergeMode() == Universe::MERGE_HTP;
+    entry.input_port_count = (*iter)->InputPortCount();
+    entry.output_port_count = (*iter)->OutputPortCount();
+    entry.source_client_count = (*iter)->SourceClientCount();
+    entry.sink_client_count = (*iter)->SinkClientCount();
+    snapshot.push_back(entry);
+  }
+
+  ola::thread::MutexLocker locker(&m_snapshot_mutex);
+  m_universe_snapshot.swap(snapshot);
+}
+
+
+void OlaServer::GetUniverseSnapshot(
+    std::vector<UniverseSnapshot> *snapshot) {
+  ola::thread::MutexLocker locker(&m_snapshot_mutex);
+  *snapshot = m_universe_snapshot;
+}
+
+
+/*
+ * Put the universes named in the frame-clock-universes preference on a
+ * fixed output cadence, decoupling their outputs from input arrival
+ * timing.
+ */
+void OlaServer::SetupFrameClocks() {
+  const string universes =
+      m_server_preferences->GetValue(FRAME_CLOCK_UNIVERSES_KEY);
+  if (universes.empty())
+    return;
+
+  unsigned int rate = DEFAULT_FRAME_CLOCK_RATE;
+  const string rate_str = m_server_preferences->GetValue(
+      FRAME_CLOCK_RATE_KEY);
+  if (!rate_str.empty() && (!StringToInt(rate_str, &rate) || !rate)) {
+    OLA_WARN << "Invalid " << FRAME_CLOCK_RATE_KEY << ": " << rate_str;
+    rate = DEFAULT_FRAME_CLOCK_RATE;
+  }
+  const TimeInterval tick_interval(1000000 / rate);
+
+  vector<string> universe_strs;
+  StringSplit(universes, &universe_strs, ",");
+  vector<string>::const_iterator iter = universe_strs.begin();
+  for (; iter != universe_strs.end(); ++iter) {
+    unsigned int universe_id;
+    if (!StringToInt(*iter, &universe_id)) {
+      OLA_WARN << "Invalid universe in " << FRAME_CLOCK_UNIVERSES_KEY
+               << ": " << *iter;
+      continue;
+    }
+    if (STLContains(m_frame_clocks, universe_id))
+      continue;
+
+    Universe *universe = m_universe_store->GetUniverseOrCreate(universe_id);
+    if (!universe)
+      continue;
+    universe->SetFrameClock(true);
+    m_frame_clocks[universe_id] = m_ss->RegisterRepeatingTimeout(
+        tick_interval,
+        NewCallback(this, &OlaServer::UniverseClockTick, universe_id));
+    OLA_INFO << "Universe " << universe_id << " clocked at " << rate
+             << " fps";
+  }
+}
+
+
+/*
+ * A frame clock tick; emit the universe's current frame.
+ */
+bool OlaServer::UniverseClockTick(unsigned int universe_id) {
+  Universe *universe = m_universe_store->GetUniverse(universe_id);
+  if (!universe) {
+    // the universe was garbage collected, stop the clock
+    m_frame_clocks.erase(universe_id);
+    return false;
+  }
+  universe->ClockTick();
+  return true;
+}
+
+
 void OlaServer::ReloadPlugins() {
   m_ss->Execute(NewCallback(this, &OlaServer::ReloadPluginsInternal));
 }
 
+void *OlaServer::PidStoreLoadThread::Run() {
+  m_server->ReloadPidStore();
+  return NULL;
+}
+
+
 void OlaServer::ReloadPidStore() {
   // We load the pids in this thread, and then hand the RootPidStore over to
   // the main thread. This avoids doing disk I/O in the network thread.
@@ -360,6 +656,7 @@ void OlaServer::ClientRemoved(RpcSession *session) {
   session->SetData(NULL);
 
   m_broker->RemoveClient(client.get());
+  m_service_impl->ClientRemoved(client.get());
 
   vector<Universe*> universe_list;
   m_universe_store->GetList(&universe_list);
@@ -376,8 +673,7 @@ void OlaServer::ClientRemoved(RpcSession *session) {
  * Run the garbage collector
  */
 bool OlaServer::RunHousekeeping() {
-  OLA_DEBUG << "Garbage collecting";
-  m_universe_store->GarbageCollectUniverses();
+  m_service_impl->ExpireParkedSessions(*m_ss->WakeUpTime());
 
   // Give the universes an opportunity to run discovery
   vector<Universe*> universes;
@@ -393,6 +689,27 @@ bool OlaServer::RunHousekeeping() {
       // run incremental discovery
       (*iter)->RunRDMDiscovery(NULL, false);
     }
+
+    // publish the per-port pipeline stats; the send path updates plain
+    // counters and this copies them out once a cycle, so the per-frame
+    // cost stays off the string-keyed maps
+    vector<OutputPort*> output_ports;
+    (*iter)->OutputPorts(&output_ports);
+    vector<OutputPort*>::iterator port_iter = output_ports.begin();
+    for (; port_iter != output_ports.end(); ++port_iter) {
+      OutputPortStats *stats = (*port_iter)->GetOutputPortStats();
+      if (!stats)
+        continue;
+      const string key = (*port_iter)->UniqueId();
+      (*m_export_map->GetUIntMapVar("port-frames-offered", "port"))[key] =
+          static_cast<unsigned int>(stats->frames_offered);
+      (*m_export_map->GetUIntMapVar("port-frames-sent", "port"))[key] =
+          static_cast<unsigned int>(stats->frames_sent);
+      (*m_export_map->GetUIntMapVar("port-frames-dropped", "port"))[key] =
+          static_cast<unsigned int>(stats->frames_dropped);
+      (*m_export_map->GetUIntMapVar("port-send-time-max-us", "port"))[key] =
+          static_cast<unsigned int>(stats->send_time_max_usecs);
+    }
   }
   return true;
 }
@@ -469,6 +786,16 @@ void OlaServer::ReloadPluginsInternal() {
   m_plugin_manager->LoadAll();
 }
 
+void OlaServer::ReloadPlugin(unsigned int plugin_id) {
+  m_ss->Execute(NewSingleCallback(
+      this, &OlaServer::ReloadPluginInternal, plugin_id));
+}
+
+void OlaServer::ReloadPluginInternal(unsigned int plugin_id) {
+  m_plugin_manager->RestartPlugin(
+      static_cast<ola_plugin_id>(plugin_id));
+}
+
 void OlaServer::UpdatePidStore(const RootPidStore *pid_store) {
   OLA_INFO << "Updated PID definitions.";
 #ifdef HAVE_LIBMICROHTTPD
@@ -29,6 +29,9 @@
 #include <ola/ExportMap.h>
 #include <ola/base/Macro.h>
 #include <ola/io/SelectServer.h>
+#include <ola/timecode/TimeCodeEngine.h>
+#include <ola/io/StallWatchdog.h>
+#include <ola/io/SelectServerThread.h>
 #include <ola/network/InterfacePicker.h>
 #include <ola/network/Socket.h>
 #include <ola/network/TCPSocketFactory.h>
@@ -37,6 +40,10 @@
 #include <ola/rdm/UID.h>
 #include <ola/rpc/RpcSessionHandler.h>
 
+#include "olad/UniverseStore.h"
+#include <ola/thread/Mutex.h>
+#include <ola/thread/Thread.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -111,6 +118,39 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
    */
   void ReloadPlugins();
 
+  /**
+   * @brief An immutable snapshot of a universe's state, safe to read from
+   * any thread via GetUniverseSnapshot().
+   */
+  struct UniverseSnapshot {
+    unsigned int id;
+    std::string name;
+    bool htp_merge_mode;
+    unsigned int input_port_count;
+    unsigned int output_port_count;
+    unsigned int source_client_count;
+    unsigned int sink_client_count;
+  };
+
+  /**
+   * @brief Copy the current universe snapshots. Thread safe; HTTP/JSON
+   * handlers serialize from this instead of walking the live objects on
+   * the main loop.
+   */
+  void GetUniverseSnapshot(std::vector<UniverseSnapshot> *snapshot);
+
+  /**
+   * @brief The worker event loop shards, if event-loop-shards was set.
+   * @returns the shard group, or NULL when sharding is disabled.
+   *
+   * Plugins with heavy per-universe I/O can register their descriptors on
+   * a shard keyed by universe id, keeping receive and send for disjoint
+   * universe sets off the main loop and in parallel.
+   */
+  ola::io::SelectServerShardGroup *ShardGroup() {
+    return m_shard_group.get();
+  }
+
   /**
    * @brief Reload the pid store.
    *
@@ -183,6 +223,20 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
   std::auto_ptr<class ClientBroker> m_broker;
   std::auto_ptr<class PortBroker> m_port_broker;
   std::auto_ptr<const ola::rdm::RootPidStore> m_pid_store;
+
+  // loads the PID store off the main thread at startup
+  class PidStoreLoadThread: public ola::thread::Thread {
+   public:
+    PidStoreLoadThread(OlaServer *server,
+                       const ola::thread::Thread::Options &options)
+        : ola::thread::Thread(options),
+          m_server(server) {
+    }
+    void *Run();
+   private:
+    OlaServer *m_server;
+  };
+  std::auto_ptr<PidStoreLoadThread> m_pid_store_thread;
   std::auto_ptr<class DiscoveryAgentInterface> m_discovery_agent;
   std::auto_ptr<ola::rpc::RpcServer> m_rpc_server;
   class Preferences *m_server_preferences;
@@ -190,6 +244,16 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
   std::string m_instance_name;
 
   ola::thread::timeout_id m_housekeeping_timeout;
+  // universe-id -> frame clock timeout, for universes on a fixed cadence.
+  std::map<unsigned int, ola::thread::timeout_id> m_frame_clocks;
+  // double-buffered universe state for off-loop readers
+  std::vector<UniverseSnapshot> m_universe_snapshot;
+  ola::thread::Mutex m_snapshot_mutex;
+  // optional worker event loops for plugins that shard their I/O
+  std::auto_ptr<ola::io::SelectServerShardGroup> m_shard_group;
+  std::auto_ptr<ola::io::StallWatchdog> m_stall_watchdog;
+  std::auto_ptr<ola::timecode::TimeCodeEngine> m_timecode_engine;
+  ola::Clock m_clock;
   std::auto_ptr<OladHTTPServer_t> m_httpd;
 
   bool RunHousekeeping();
@@ -205,18 +269,38 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
   bool InternalNewConnection(ola::rpc::RpcServer *server,
                              ola::io::ConnectedDescriptor *descriptor);
   void ReloadPluginsInternal();
+  void ReloadPlugin(unsigned int plugin_id);
+  void ReloadPluginInternal(unsigned int plugin_id);
+  void DistributeTimeCode(const ola::timecode::TimeCode &timecode);
+  void FlushUniverseUpdates();
+  void ScheduleUniverseGC();
+  void StartDiscovery();
+  void SetupFrameClocks();
+  void RebuildUniverseSnapshot();
+  void OnUniverseChange(unsigned int universe_id,
+                        UniverseStore::UniverseChange change);
+  bool UniverseClockTick(unsigned int universe_id);
   /**
    * @brief Update the Pid store with the new values.
    */
   void UpdatePidStore(const ola::rdm::RootPidStore *pid_store);
 
   static const char INSTANCE_NAME_KEY[];
+  static const char FRAME_CLOCK_UNIVERSES_KEY[];
+  static const char FRAME_CLOCK_RATE_KEY[];
+  static const char EVENT_LOOP_SHARDS_KEY[];
+  static const char LAZY_PLUGIN_LOADING_KEY[];
+  static const char CLIENT_CONTROL_RPS_KEY[];
+  static const char LOCK_MEMORY_KEY[];
+  static const char CLIENT_STREAM_RPS_KEY[];
+  static const char PRELOAD_PLUGINS_KEY[];
   static const char K_INSTANCE_NAME_VAR[];
   static const char K_DISCOVERY_SERVICE_TYPE[];
   static const char K_UID_VAR[];
   static const char SERVER_PREFERENCES[];
   static const char UNIVERSE_PREFERENCES[];
   static const unsigned int K_HOUSEKEEPING_TIMEOUT_MS;
+  static const unsigned int DEFAULT_FRAME_CLOCK_RATE;
 
   DISALLOW_COPY_AND_ASSIGN(OlaServer);
 };
@@ -25,6 +25,7 @@
 #include "common/protocol/Ola.pb.h"
 #include "common/rpc/RpcSession.h"
 #include "ola/Callback.h"
+#include "ola/stl/STLUtils.h"
 #include "ola/CallbackRunner.h"
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
@@ -93,7 +94,8 @@ OlaServerServiceImpl::OlaServerServiceImpl(
       m_port_manager(port_manager),
       m_broker(broker),
       m_wake_up_time(wake_up_time),
-      m_reload_plugins_callback(reload_plugins_callback) {
+      m_reload_plugins_callback(reload_plugins_callback),
+      m_timecode_engine(NULL) {
 }
 
 void OlaServerServiceImpl::GetDmx(
@@ -106,8 +108,12 @@ void OlaServerServiceImpl::GetDmx(
   if (!universe)
     return MissingUniverseError(controller);
 
-  const DmxBuffer buffer = universe->GetDMX();
-  response->set_data(buffer.Get());
+  const DmxBuffer &buffer = universe->GetDMX();
+  if (buffer.GetRaw()) {
+    response->set_data(buffer.GetRaw(), buffer.Size());
+  } else {
+    response->set_data("");
+  }
   response->set_universe(request->universe());
 }
 
@@ -141,8 +147,6 @@ void OlaServerServiceImpl::UpdateDmxData(
     return MissingUniverseError(controller);
 
   Client *client = GetClient(controller);
-  DmxBuffer buffer;
-  buffer.Set(request->data());
 
   uint8_t priority = ola::dmx::SOURCE_PRIORITY_DEFAULT;
   if (request->has_priority()) {
@@ -152,8 +156,12 @@ void OlaServerServiceImpl::UpdateDmxData(
     priority = std::min(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX),
                         priority);
   }
-  DmxSource source(buffer, *m_wake_up_time, priority);
-  client->DMXReceived(request->universe(), source);
+  // Update the client's source in place; this avoids allocating a buffer
+  // per frame on the highest-rate RPC in the system.
+  const std::string &data = request->data();
+  client->DMXReceived(request->universe(),
+                      reinterpret_cast<const uint8_t*>(data.data()),
+                      data.size(), *m_wake_up_time, priority);
   universe->SourceClientDataChanged(client);
 }
 
@@ -162,28 +170,206 @@ void OlaServerServiceImpl::StreamDmxData(
     const ola::proto::DmxData* request,
     ola::proto::STREAMING_NO_RESPONSE*,
     ola::rpc::RpcService::CompletionCallback*) {
-  Universe *universe = m_universe_store->GetUniverse(request->universe());
+  HandleStreamedFrame(controller, *request);
+}
+
+void OlaServerServiceImpl::StreamDmxBatch(
+    RpcController *controller,
+    const ola::proto::DmxBatch* request,
+    ola::proto::STREAMING_NO_RESPONSE*,
+    ola::rpc::RpcService::CompletionCallback*) {
+  for (int i = 0; i < request->frames_size(); i++) {
+    HandleStreamedFrame(controller, request->frames(i));
+  }
+}
+
+/*
+ * Apply one streamed frame; shared by the single and batch RPCs.
+ */
+void OlaServerServiceImpl::HandleStreamedFrame(
+    RpcController *controller,
+    const ola::proto::DmxData &request) {
+  Universe *universe = m_universe_store->GetUniverse(request.universe());
 
   if (!universe)
     return;
 
   Client *client = GetClient(controller);
-  DmxBuffer buffer;
-  buffer.Set(request->data());
 
   uint8_t priority = ola::dmx::SOURCE_PRIORITY_DEFAULT;
-  if (request->has_priority()) {
-    priority = request->priority();
+  if (request.has_priority()) {
+    priority = request.priority();
     priority = std::max(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MIN),
                         priority);
     priority = std::min(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX),
                         priority);
   }
-  DmxSource source(buffer, *m_wake_up_time, priority);
-  client->DMXReceived(request->universe(), source);
+  // Update the client's source in place; this avoids allocating a buffer
+  // per frame on the highest-rate RPC in the system.
+  const std::string &data = request.data();
+  client->DMXReceived(request.universe(),
+                      reinterpret_cast<const uint8_t*>(data.data()),
+                      data.size(), *m_wake_up_time, priority);
   universe->SourceClientDataChanged(client);
 }
 
+void OlaServerServiceImpl::SubscribeUniverseChanges(
+    RpcController* controller,
+    const ola::proto::UniverseChangeSubscription* request,
+    ola::proto::Ack*,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+  Client *client = GetClient(controller);
+  bool subscribe = request->action() == ola::proto::REGISTER;
+  client->SubscribeToUniverseChanges(subscribe);
+  if (subscribe) {
+    m_change_subscribers.insert(client);
+  } else {
+    m_change_subscribers.erase(client);
+  }
+}
+
+
+void OlaServerServiceImpl::CreateSession(
+    RpcController* controller,
+    const ola::proto::SessionTokenRequest*,
+    ola::proto::SessionToken* response,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+  Client *client = GetClient(controller);
+
+  uint32_t token = client->GetSessionToken();
+  while (!token || ola::STLContains(m_parked_sessions, token)) {
+    token = static_cast<uint32_t>(random());
+  }
+  client->SetSessionToken(token);
+  response->set_token(token);
+}
+
+
+void OlaServerServiceImpl::ResumeSession(
+    RpcController* controller,
+    const ola::proto::SessionToken* request,
+    ola::proto::SessionResumeReply* response,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+  Client *client = GetClient(controller);
+
+  std::map<uint32_t, ParkedSession>::iterator iter =
+      m_parked_sessions.find(request->token());
+  if (iter == m_parked_sessions.end()) {
+    // expired or bogus; the client falls back to a full re-register
+    response->set_restored_universes(0);
+    return;
+  }
+  const ParkedSession &session = iter->second;
+
+  std::set<unsigned int>::const_iterator universe_iter =
+      session.sink_universes.begin();
+  for (; universe_iter != session.sink_universes.end(); ++universe_iter) {
+    Universe *universe = m_universe_store->GetUniverseOrCreate(
+        *universe_iter);
+    if (universe) {
+      universe->AddSinkClient(client);
+    }
+  }
+
+  std::map<unsigned int, DmxSource>::const_iterator source_iter =
+      session.sources.begin();
+  for (; source_iter != session.sources.end(); ++source_iter) {
+    Universe *universe = m_universe_store->GetUniverseOrCreate(
+        source_iter->first);
+    if (!universe) {
+      continue;
+    }
+    // Refresh the timestamp: the parked copy carries the pre-disconnect
+    // time, and anything older than the 2.5s source timeout would be
+    // rejected as inactive by the merge, defeating the instant resume.
+    DmxSource source = source_iter->second;
+    source.UpdateData(source.Data(), *m_wake_up_time, source.Priority());
+    client->DMXReceived(source_iter->first, source);
+    universe->SourceClientDataChanged(client);
+  }
+
+  response->set_restored_universes(static_cast<uint32_t>(
+      session.sink_universes.size() + session.sources.size()));
+  client->SetSessionToken(request->token());
+  m_parked_sessions.erase(iter);
+}
+
+
+void OlaServerServiceImpl::ClientRemoved(Client *client) {
+  m_change_subscribers.erase(client);
+
+  // Park the session so a reconnecting client can resume with one RPC
+  // instead of re-establishing state over hundreds of round trips.
+  if (client->GetSessionToken()) {
+    ParkedSession &session = m_parked_sessions[client->GetSessionToken()];
+    session.sources = client->GetDataMap();
+
+    vector<Universe*> universes;
+    m_universe_store->GetList(&universes);
+    vector<Universe*>::iterator iter = universes.begin();
+    for (; iter != universes.end(); ++iter) {
+      if ((*iter)->ContainsSinkClient(client)) {
+        session.sink_universes.insert((*iter)->UniverseId());
+      }
+    }
+    session.expiry = *m_wake_up_time + TimeInterval(SESSION_GRACE_SECONDS,
+                                                    0);
+  }
+}
+
+
+void OlaServerServiceImpl::ExpireParkedSessions(const TimeStamp &now) {
+  std::map<uint32_t, ParkedSession>::iterator iter =
+      m_parked_sessions.begin();
+  while (iter != m_parked_sessions.end()) {
+    if (iter->second.expiry < now) {
+      m_parked_sessions.erase(iter++);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+
+void OlaServerServiceImpl::BroadcastUniverseChange(
+    unsigned int universe_id,
+    UniverseStore::UniverseChange change) {
+  if (m_change_subscribers.empty())
+    return;
+
+  ola::proto::UniverseChange event;
+  event.set_universe(universe_id);
+  switch (change) {
+    case UniverseStore::UNIVERSE_ADDED:
+      event.set_change_type(ola::proto::UNIVERSE_ADDED);
+      break;
+    case UniverseStore::UNIVERSE_REMOVED:
+      event.set_change_type(ola::proto::UNIVERSE_REMOVED);
+      break;
+    case UniverseStore::UNIVERSE_ATTRIBUTES_CHANGED:
+      event.set_change_type(ola::proto::UNIVERSE_ATTRIBUTES_CHANGED);
+      break;
+  }
+
+  if (change != UniverseStore::UNIVERSE_REMOVED) {
+    Universe *universe = m_universe_store->GetUniverse(universe_id);
+    if (universe) {
+      event.set_name(universe->Name());
+      event.set_merge_mode(
+          universe->MergeMode() == Universe::MERGE_HTP ?
+          ola::proto::HTP : ola::proto::LTP);
+    }
+  }
+
+  std::set<Client*>::iterator iter = m_change_subscribers.begin();
+  for (; iter != m_change_subscribers.end(); ++iter)
+    (*iter)->SendUniverseChange(event);
+}
+
+
 void OlaServerServiceImpl::SetUniverseName(
     RpcController* controller,
     const UniverseNameRequest* request,
@@ -325,6 +511,7 @@ void OlaServerServiceImpl::GetUniverseInfo(
     universe_info->set_input_port_count(universe->InputPortCount());
     universe_info->set_output_port_count(universe->OutputPortCount());
     universe_info->set_rdm_devices(universe->UIDCount());
+    AddSlotStats(*universe, universe_info);
   } else {
     // return all
     vector<Universe*> uni_list;
@@ -340,10 +527,29 @@ void OlaServerServiceImpl::GetUniverseInfo(
       universe_info->set_input_port_count((*iter)->InputPortCount());
       universe_info->set_output_port_count((*iter)->OutputPortCount());
       universe_info->set_rdm_devices((*iter)->UIDCount());
+      AddSlotStats(**iter, universe_info);
     }
   }
 }
 
+/*
+ * Attach the sampled in-daemon slot stats, once a sample exists.
+ */
+void OlaServerServiceImpl::AddSlotStats(const Universe &universe,
+                                        UniverseInfo *universe_info) {
+  Universe::SlotStats stats = universe.GetSlotStats();
+  if (!stats.sampled_frames) {
+    return;
+  }
+  ola::proto::UniverseSlotStats *slot_stats =
+      universe_info->mutable_slot_stats();
+  slot_stats->set_changed_slots(stats.changed_slots);
+  slot_stats->set_slot_min(stats.slot_min);
+  slot_stats->set_slot_max(stats.slot_max);
+  slot_stats->set_slot_mean(stats.slot_mean);
+  slot_stats->set_sampled_frames(stats.sampled_frames);
+}
+
 void OlaServerServiceImpl::GetPlugins(
     RpcController*,
     const PluginListRequest*,
@@ -362,10 +568,16 @@ void OlaServerServiceImpl::GetPlugins(
 
 void OlaServerServiceImpl::ReloadPlugins(
     RpcController*,
-    const ::ola::proto::PluginReloadRequest*,
+    const ::ola::proto::PluginReloadRequest* request,
     ola::proto::Ack*,
     ola::rpc::RpcService::CompletionCallback* done) {
   ClosureRunner runner(done);
+  if (request->has_plugin_id() && m_reload_plugin_callback.get()) {
+    // hot restart of a single plugin; everything else keeps streaming
+    m_reload_plugin_callback->Run(
+        static_cast<unsigned int>(request->plugin_id()));
+    return;
+  }
   if (m_reload_plugins_callback.get()) {
     m_reload_plugins_callback->Run();
   } else {
@@ -721,10 +933,16 @@ void OlaServerServiceImpl::SendTimeCode(
     request->seconds(),
     request->frames());
 
-  if (time_code.IsValid()) {
-    m_device_manager->SendTimeCode(time_code);
-  } else {
+  if (!time_code.IsValid()) {
     controller->SetFailed("Invalid TimeCode");
+    return;
+  }
+  if (m_timecode_engine) {
+    // re-timed onto local frame boundaries; the engine drives the
+    // device fanout from its own deadlines
+    m_timecode_engine->InputTimeCode(time_code);
+  } else {
+    m_device_manager->SendTimeCode(time_code);
   }
 }
 
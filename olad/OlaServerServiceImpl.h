@@ -18,15 +18,20 @@
  * Copyright (C) 2005 Simon Newton
  */
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
 #include "ola/Callback.h"
 #include "ola/rdm/RDMCommand.h"
+#include "ola/timecode/TimeCodeEngine.h"
 #include "ola/rdm/UID.h"
 #include "ola/rdm/UIDSet.h"
+#include "olad/DmxSource.h"
+#include "olad/UniverseStore.h"
 
 #ifndef OLAD_OLASERVERSERVICEIMPL_H_
 #define OLAD_OLASERVERSERVICEIMPL_H_
@@ -50,6 +55,7 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
    * @brief A Callback used to reload all the plugins.
    */
   typedef Callback0<void> ReloadPluginsCallback;
+  typedef Callback1<void, unsigned int> ReloadPluginCallback;
 
   /**
    * @brief Create a new OlaServerServiceImpl.
@@ -96,6 +102,78 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
                      ::ola::proto::STREAMING_NO_RESPONSE* response,
                      ola::rpc::RpcService::CompletionCallback* done);
 
+  /**
+   * @brief Handle a batch of streaming DMX updates for many universes,
+   * no response is sent.
+   */
+  void StreamDmxBatch(ola::rpc::RpcController* controller,
+                      const ::ola::proto::DmxBatch* request,
+                      ::ola::proto::STREAMING_NO_RESPONSE* response,
+                      ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Subscribe (or unsubscribe) this client to universe change
+   * events.
+   */
+  void SubscribeUniverseChanges(
+      ola::rpc::RpcController* controller,
+      const ::ola::proto::UniverseChangeSubscription* request,
+      ola::proto::Ack* response,
+      ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Issue a session resume token for this client.
+   */
+  void CreateSession(ola::rpc::RpcController* controller,
+                     const ::ola::proto::SessionTokenRequest* request,
+                     ola::proto::SessionToken* response,
+                     ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Restore a parked session onto this (reconnected) client.
+   */
+  void ResumeSession(ola::rpc::RpcController* controller,
+                     const ::ola::proto::SessionToken* request,
+                     ola::proto::SessionResumeReply* response,
+                     ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Set the TimeCodeEngine incoming timecode is fed through.
+   * NULL (the default) fans timecode straight to the devices. Not owned.
+   */
+  void SetTimeCodeEngine(ola::timecode::TimeCodeEngine *engine) {
+    m_timecode_engine = engine;
+  }
+
+  /**
+   * @brief Set the callback used to hot restart a single plugin.
+   * Ownership is transferred.
+   */
+  void SetReloadPluginCallback(ReloadPluginCallback *callback) {
+    m_reload_plugin_callback.reset(callback);
+  }
+
+  /**
+   * @brief Called when a client disconnects.
+   */
+  void ClientRemoved(class Client *client);
+
+  /**
+   * @brief Drop parked sessions whose grace period has passed. Called
+   * from the housekeeping timer.
+   */
+  void ExpireParkedSessions(const TimeStamp &now);
+
+  void AddSlotStats(const class Universe &universe,
+                    ola::proto::UniverseInfo *universe_info);
+
+  /**
+   * @brief Push a universe change to the subscribed clients. Wired to the
+   * UniverseStore's change callback by OlaServer.
+   */
+  void BroadcastUniverseChange(unsigned int universe_id,
+                               UniverseStore::UniverseChange change);
+
 
   /**
    * @brief Sets the name of a universe.
@@ -248,6 +326,22 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
                     ola::rpc::RpcService::CompletionCallback* done);
 
  private:
+  void HandleStreamedFrame(ola::rpc::RpcController *controller,
+                           const ola::proto::DmxData &request);
+
+  // clients subscribed to universe change events
+  std::set<class Client*> m_change_subscribers;
+
+  // sessions held for reconnecting clients, keyed by token
+  struct ParkedSession {
+    std::set<unsigned int> sink_universes;
+    std::map<unsigned int, DmxSource> sources;
+    TimeStamp expiry;
+  };
+  std::map<uint32_t, ParkedSession> m_parked_sessions;
+
+  static const unsigned int SESSION_GRACE_SECONDS = 30;
+
   void HandleRDMResponse(ola::proto::RDMResponse* response,
                          ola::rpc::RpcService::CompletionCallback* done,
                          bool include_raw_packets,
@@ -285,6 +379,8 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
   class ClientBroker *m_broker;
   const class TimeStamp *m_wake_up_time;
   std::auto_ptr<ReloadPluginsCallback> m_reload_plugins_callback;
+  std::auto_ptr<ReloadPluginCallback> m_reload_plugin_callback;
+  ola::timecode::TimeCodeEngine *m_timecode_engine;
 };
 }  // namespace ola
 #endif  // OLAD_OLASERVERSERVICEIMPL_H_
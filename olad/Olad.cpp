@@ -37,6 +37,7 @@
 #include "ola/base/Flags.h"
 #include "ola/base/Init.h"
 #include "ola/base/SysExits.h"
+#include "ola/base/TraceRing.h"
 #include "ola/base/Version.h"
 #include "ola/thread/SignalThread.h"
 #include "olad/OlaDaemon.h"
@@ -123,6 +124,10 @@ int main(int argc, char *argv[]) {
   signal_thread.InstallSignalHandler(SIGHUP, NULL);
   signal_thread.InstallSignalHandler(
       SIGUSR1, ola::NewCallback(&ola::IncrementLogLevel));
+  // dump the flight recorder on demand, e.g. after a reported glitch
+  signal_thread.InstallSignalHandler(
+      SIGUSR2, ola::NewCallback(ola::TraceRing::Instance(),
+                                &ola::TraceRing::DumpToLog));
 #endif
 
   ola::OlaServer::Options options;
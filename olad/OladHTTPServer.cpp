@@ -94,6 +94,7 @@ OladHTTPServer::OladHTTPServer(ExportMap *export_map,
   RegisterHandler("/modify_universe", &OladHTTPServer::ModifyUniverse);
   RegisterHandler("/set_dmx", &OladHTTPServer::HandleSetDmx);
   RegisterHandler("/get_dmx", &OladHTTPServer::GetDmx);
+  RegisterHandler("/get_dmx_bin", &OladHTTPServer::GetDmxBinary);
 
   // json endpoints for the new UI
   RegisterHandler("/json/server_stats", &OladHTTPServer::JsonServerStats);
@@ -531,6 +532,60 @@ int OladHTTPServer::GetDmx(const HTTPRequest *request,
 }
 
 
+/**
+ * @brief Serve a universe's DMX data in the compact binary layout:
+ * [u16 universe][u16 slot count][slots], little endian, one frame per
+ * requested universe (u may repeat). High-rate dashboards use this to
+ * skip JSON stringify/parse on both ends.
+ * @param request the HTTPRequest
+ * @param response the HTTPResponse
+ * @returns MHD_NO or MHD_YES
+ */
+int OladHTTPServer::GetDmxBinary(const HTTPRequest *request,
+                                 HTTPResponse *response) {
+  if (request->CheckParameterExists(HELP_PARAMETER)) {
+    return ServeUsage(response, "?u=[universe]");
+  }
+  string uni_id = request->GetParameter("u");
+  unsigned int universe_id;
+  if (!StringToInt(uni_id, &universe_id)) {
+    return ServeHelpRedirect(response);
+  }
+
+  m_client.FetchDMX(
+      universe_id,
+      NewSingleCallback(this, &OladHTTPServer::HandleGetDmxBinary, response,
+                        universe_id));
+  return MHD_YES;
+}
+
+
+/**
+ * @brief Send the binary DMX frame.
+ */
+void OladHTTPServer::HandleGetDmxBinary(HTTPResponse *response,
+                                        unsigned int universe_id,
+                                        const client::Result&,
+                                        const client::DMXMetadata&,
+                                        const DmxBuffer &buffer) {
+  uint8_t header[4];
+  header[0] = universe_id & 0xff;
+  header[1] = (universe_id >> 8) & 0xff;
+  header[2] = buffer.Size() & 0xff;
+  header[3] = (buffer.Size() >> 8) & 0xff;
+
+  response->SetNoCache();
+  response->SetContentType("application/octet-stream");
+  response->Append(string(reinterpret_cast<char*>(header), sizeof(header)));
+  if (buffer.GetRaw()) {
+    response->Append(string(
+        reinterpret_cast<const char*>(buffer.GetRaw()), buffer.Size()));
+  }
+  response->Send();
+  delete response;
+}
+
+
 /**
  * @brief Handle the set DMX command
  * @param request the HTTPRequest
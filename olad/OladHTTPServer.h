@@ -77,6 +77,8 @@ class OladHTTPServer: public ola::http::OlaHTTPServer {
   int ModifyUniverse(const ola::http::HTTPRequest *request,
                      ola::http::HTTPResponse *response);
 
+  int GetDmxBinary(const ola::http::HTTPRequest *request,
+                   ola::http::HTTPResponse *response);
   int GetDmx(const ola::http::HTTPRequest *request,
              ola::http::HTTPResponse *response);
   int HandleSetDmx(const ola::http::HTTPRequest *request,
@@ -157,6 +159,12 @@ class OladHTTPServer: public ola::http::OlaHTTPServer {
   RDMHTTPModule m_rdm_module;
   time_t m_start_time_t;
 
+  void HandleGetDmxBinary(ola::http::HTTPResponse *response,
+                          unsigned int universe_id,
+                          const client::Result &result,
+                          const client::DMXMetadata &metadata,
+                          const DmxBuffer &buffer);
+
   void HandleGetDmx(ola::http::HTTPResponse *response,
                     const client::Result &result,
                     const client::DMXMetadata &metadata,
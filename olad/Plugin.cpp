@@ -64,6 +64,13 @@ bool Plugin::LoadPreferences() {
   return true;
 }
 
+bool Plugin::ReloadPreferences() {
+  if (!m_preferences) {
+    return LoadPreferences();
+  }
+  return m_preferences->Load();
+}
+
 /*
  * Returns true if this plugin is enabled.
  */
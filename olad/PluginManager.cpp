@@ -21,7 +21,11 @@
 #include "olad/PluginManager.h"
 
 #include <set>
+#include <string>
 #include <vector>
+#include "ola/Clock.h"
+#include "ola/ExportMap.h"
+#include "ola/Callback.h"
 #include "ola/Logging.h"
 #include "ola/stl/STLUtils.h"
 #include "olad/Plugin.h"
@@ -36,13 +40,21 @@ using std::set;
 PluginManager::PluginManager(const vector<PluginLoader*> &plugin_loaders,
                              class PluginAdaptor *plugin_adaptor)
     : m_plugin_loaders(plugin_loaders),
-      m_plugin_adaptor(plugin_adaptor) {
+      m_plugin_adaptor(plugin_adaptor),
+      m_start_whitelist_active(false) {
 }
 
 PluginManager::~PluginManager() {
   UnloadAll();
 }
 
+void PluginManager::SetStartWhitelist(
+    const std::set<ola_plugin_id> &plugin_ids) {
+  m_start_whitelist = plugin_ids;
+  m_start_whitelist_active = true;
+}
+
+
 void PluginManager::LoadAll() {
   vector<AbstractPlugin*> enabled_plugins;
   set<ola_plugin_id> enabled_plugin_ids;
@@ -101,16 +113,108 @@ void PluginManager::LoadAll() {
     if (conflict)
       continue;
 
-    OLA_INFO << "Trying to start " << plugin->Name();
-    if (!plugin->Start())
-      OLA_WARN << "Failed to start " << plugin->Name();
-    else
-      OLA_INFO << "Started " << plugin->Name();
-    STLReplace(&m_active_plugins, plugin->Id(), plugin);
+    if (m_start_whitelist_active &&
+        !STLContains(m_start_whitelist, plugin->Id())) {
+      OLA_INFO << "Deferring " << plugin->Name()
+               << ", nothing references it; patch it or add it to "
+               << "preload-plugins and reload";
+      continue;
+    }
+
+    m_start_queue.push_back(plugin);
+  }
+
+  // Start one plugin per event loop pass rather than all of them
+  // back-to-back: the daemon accepts connections and pushes frames for
+  // already-started plugins while the slow probes (usbpro's serial
+  // discovery) are still working through the queue.
+  if (!m_start_queue.empty()) {
+    m_plugin_adaptor->Execute(
+        NewSingleCallback(this, &PluginManager::StartNextPlugin));
+  }
+}
+
+
+void PluginManager::StartNextPlugin() {
+  if (m_start_queue.empty()) {
+    return;
+  }
+  AbstractPlugin *plugin = m_start_queue.front();
+  m_start_queue.pop_front();
+
+  StartPlugin(plugin);
+
+  if (!m_start_queue.empty()) {
+    m_plugin_adaptor->Execute(
+        NewSingleCallback(this, &PluginManager::StartNextPlugin));
   }
 }
 
+
+void PluginManager::StartPlugin(AbstractPlugin *plugin) {
+  OLA_INFO << "Trying to start " << plugin->Name();
+  Clock clock;
+  TimeStamp start_time, end_time;
+  clock.CurrentTime(&start_time);
+  bool started = plugin->Start();
+  clock.CurrentTime(&end_time);
+  if (m_plugin_adaptor->GetExportMap()) {
+    UIntMap *start_times = m_plugin_adaptor->GetExportMap()->GetUIntMapVar(
+        "plugin-start-time-ms", "plugin");
+    (*start_times)[plugin->Name()] = static_cast<unsigned int>(
+        (end_time - start_time).InMilliSeconds());
+  }
+  if (!started)
+    OLA_WARN << "Failed to start " << plugin->Name();
+  else
+    OLA_INFO << "Started " << plugin->Name();
+  STLReplace(&m_active_plugins, plugin->Id(), plugin);
+}
+
+
+/*
+ * The hot path for config changes: only the named plugin restarts, so
+ * every other universe keeps streaming through the reload.
+ */
+bool PluginManager::RestartPlugin(ola_plugin_id plugin_id) {
+  AbstractPlugin *plugin = GetPlugin(plugin_id);
+  if (!plugin) {
+    OLA_WARN << "Plugin " << plugin_id << " isn't loaded";
+    return false;
+  }
+
+  if (STLContains(m_active_plugins, plugin_id)) {
+    plugin->Stop();
+    m_active_plugins.erase(plugin_id);
+  }
+
+  plugin->ReloadPreferences();
+
+  if (!plugin->IsEnabled()) {
+    OLA_INFO << plugin->Name() << " is now disabled";
+    return true;
+  }
+
+  // re-check conflicts against what's running now
+  std::set<ola_plugin_id> conflict_list;
+  plugin->ConflictsWith(&conflict_list);
+  std::set<ola_plugin_id>::const_iterator iter = conflict_list.begin();
+  for (; iter != conflict_list.end(); ++iter) {
+    if (STLContains(m_active_plugins, *iter)) {
+      OLA_WARN << "Not restarting " << plugin->Name()
+               << ", it conflicts with " << GetPlugin(*iter)->Name();
+      return false;
+    }
+  }
+
+  StartPlugin(plugin);
+  return true;
+}
+
 void PluginManager::UnloadAll() {
+  // anything still queued to start must not start after this
+  m_start_queue.clear();
+
   PluginMap::iterator plugin_iter = m_loaded_plugins.begin();
   for (; plugin_iter != m_loaded_plugins.end(); ++plugin_iter) {
     plugin_iter->second->Stop();
@@ -21,7 +21,9 @@
 #ifndef OLAD_PLUGINMANAGER_H_
 #define OLAD_PLUGINMANAGER_H_
 
+#include <deque>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "ola/base/Macro.h"
@@ -49,6 +51,17 @@ class AbstractPlugin;
  * Plugins are active if they weren't disabled, there were no conflicts that
  * prevented them from loading, and the call to Start() was successfull.
  */
+/**
+ * @brief Manages the plugin lifecycle.
+ *
+ * Like DeviceManager, this registry is only ever touched from the main
+ * loop: there are no mutexes here and the frame path's device/port
+ * lookups are already wait-free reads of single-threaded maps. If these
+ * registries ever become cross-thread (sharded frame paths reading them),
+ * the right shape is an immutable snapshot republished on change - the
+ * UniverseStore change callback shows the pattern - not locks on the
+ * read side.
+ */
 class PluginManager {
  public:
   /**
@@ -71,11 +84,31 @@ class PluginManager {
    */
   void LoadAll();
 
+  /**
+   * @brief Restrict which plugins LoadAll() will start.
+   * @param plugin_ids the plugins to start; everything else is loaded
+   * (so it shows as disabled/deferred in listings) but not started.
+   *
+   * Used for lazy activation: only plugins referenced by saved patches
+   * or named in the preload-plugins preference probe their hardware at
+   * startup. Must be called before LoadAll().
+   */
+  void SetStartWhitelist(const std::set<ola_plugin_id> &plugin_ids);
+
   /**
    * Unload all the plugins.
    */
   void UnloadAll();
 
+  /**
+   * @brief Hot restart a single plugin: stop it, re-read its
+   * preferences and start it again, without touching anything else.
+   * @param plugin_id the plugin to restart.
+   * @returns false if the plugin isn't loaded or now conflicts with an
+   * active plugin.
+   */
+  bool RestartPlugin(ola_plugin_id plugin_id);
+
   /**
    * @brief Return the list of loaded plugins.
    * @param[out] plugins the list of plugins.
@@ -119,6 +152,12 @@ class PluginManager {
   PluginMap m_loaded_plugins;  // plugins that are loaded
   PluginMap m_active_plugins;  // active plugins
   PluginAdaptor *m_plugin_adaptor;
+  bool m_start_whitelist_active;
+  std::set<ola_plugin_id> m_start_whitelist;
+  std::deque<AbstractPlugin*> m_start_queue;
+
+  void StartNextPlugin();
+  void StartPlugin(AbstractPlugin *plugin);
 
   DISALLOW_COPY_AND_ASSIGN(PluginManager);
 };
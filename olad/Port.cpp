@@ -38,6 +38,7 @@ BasicInputPort::BasicInputPort(AbstractDevice *parent,
                                const PluginAdaptor *plugin_adaptor,
                                bool supports_rdm):
     m_port_id(port_id),
+    m_priority_policy(POLICY_UNRESOLVED),
     m_priority(ola::dmx::SOURCE_PRIORITY_DEFAULT),
     m_priority_mode(PRIORITY_MODE_STATIC),
     m_port_string(""),
@@ -81,10 +82,17 @@ bool BasicInputPort::SetPriority(uint8_t priority) {
 void BasicInputPort::DmxChanged() {
   if (GetUniverse()) {
     const DmxBuffer &buffer = ReadDMX();
-    uint8_t priority = (PriorityCapability() == CAPABILITY_FULL &&
-                        GetPriorityMode() == PRIORITY_MODE_INHERIT ?
-                        InheritedPriority() :
-                        GetPriority());
+    if (m_priority_policy == POLICY_UNRESOLVED) {
+      m_priority_policy = (PriorityCapability() == CAPABILITY_FULL &&
+                           GetPriorityMode() == PRIORITY_MODE_INHERIT)
+          ? POLICY_INHERIT
+          : POLICY_STATIC;
+    }
+    // InheritedPriority is genuinely dynamic (e.g. sACN per-packet
+    // priority); the static case is now a plain member read.
+    uint8_t priority = m_priority_policy == POLICY_INHERIT
+        ? InheritedPriority()
+        : m_priority;
     m_dmx_source.UpdateData(buffer, *m_plugin_adaptor->WakeUpTime(), priority);
     GetUniverse()->PortDataChanged(this);
   }
@@ -18,17 +18,18 @@
  * Copyright (C) 2010 Simon Newton
  */
 
-#include <set>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 #include "ola/Callback.h"
 #include "ola/Logging.h"
+#include "ola/stl/STLUtils.h"
 #include "olad/PortBroker.h"
 
 namespace ola {
 
 using std::pair;
-using std::set;
 using std::string;
 using std::vector;
 
@@ -36,8 +37,9 @@ using std::vector;
  * Add a port to the broker
  */
 void PortBroker::AddPort(const Port *port) {
-  port_key key(port->UniqueId(), port);
-  m_ports.insert(key);
+  // If the port is already registered keep its generation, so requests in
+  // flight across an unpatch/repatch of the same port still complete.
+  STLInsertIfNotPresent(&m_ports, port, m_generation++);
 }
 
 
@@ -45,8 +47,7 @@ void PortBroker::AddPort(const Port *port) {
  * Remove a port from the broker
  */
 void PortBroker::RemovePort(const Port *port) {
-  port_key key(port->UniqueId(), port);
-  m_ports.erase(key);
+  STLRemove(&m_ports, port);
 }
 
 
@@ -61,12 +62,12 @@ void PortBroker::SendRDMRequest(const Port *port,
                                 Universe *universe,
                                 const ola::rdm::RDMRequest *request,
                                 ola::rdm::RDMCallback *callback) {
-  port_key key(port->UniqueId(), port);
-  set<port_key>::const_iterator iter = m_ports.find(key);
+  std::map<const Port*, uint64_t>::const_iterator iter = m_ports.find(port);
   if (iter == m_ports.end())
     OLA_WARN <<
       "Making an RDM call but the port doesn't exist in the broker!";
 
+  port_key key(port, iter == m_ports.end() ? m_generation : iter->second);
   universe->SendRDMRequest(request,
       NewSingleCallback(this,
                         &PortBroker::RequestComplete,
@@ -87,8 +88,7 @@ void PortBroker::RequestComplete(port_key key,
                                  ola::rdm::rdm_response_code code,
                                  const ola::rdm::RDMResponse *response,
                                  const vector<string> &packets) {
-  set<port_key>::const_iterator iter = m_ports.find(key);
-  if (iter == m_ports.end()) {
+  if (!PortIsRegistered(key)) {
     OLA_INFO << "Port no longer exists, cleaning up from RDM response";
     delete response;
     delete callback;
@@ -96,4 +96,15 @@ void PortBroker::RequestComplete(port_key key,
     callback->Run(code, response, packets);
   }
 }
+
+
+/**
+ * Check a port is still registered, under the generation it was captured
+ * with.
+ */
+bool PortBroker::PortIsRegistered(const port_key &key) const {
+  std::map<const Port*, uint64_t>::const_iterator iter =
+      m_ports.find(key.first);
+  return iter != m_ports.end() && iter->second == key.second;
+}
 }  // namespace ola
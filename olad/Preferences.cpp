@@ -301,6 +301,16 @@ bool MemoryPreferences::HasKey(const string &key) const {
 }
 
 
+void MemoryPreferences::GetKeys(std::vector<string> *keys) const {
+  PreferencesMap::const_iterator iter = m_pref_map.begin();
+  for (; iter != m_pref_map.end(); ++iter) {
+    if (keys->empty() || keys->back() != iter->first) {
+      keys->push_back(iter->first);
+    }
+  }
+}
+
+
 void MemoryPreferences::RemoveValue(const string &key) {
   m_pref_map.erase(key);
 }
@@ -329,7 +339,8 @@ void MemoryPreferences::SetValueAsBool(const string &key, bool value) {
 //-----------------------------------------------------------------------------
 
 FilePreferenceSaverThread::FilePreferenceSaverThread()
-    : Thread(Thread::Options("pref-saver")) {
+    : Thread(Thread::Options("pref-saver")),
+      m_flush_timeout(ola::thread::INVALID_TIMEOUT) {
   // set a long poll interval so we don't spin
   m_ss.SetDefaultInterval(TimeInterval(60, 0));
 }
@@ -339,14 +350,50 @@ void FilePreferenceSaverThread::SavePreferences(
     const PreferencesMap &preferences) {
   const string *file_name_ptr = new string(file_name);
   const PreferencesMap *save_map = new PreferencesMap(preferences);
-  SingleUseCallback0<void> *cb =
-      NewSingleCallback(SavePreferencesToFile, file_name_ptr, save_map);
-  m_ss.Execute(cb);
+  m_ss.Execute(NewSingleCallback(
+      this, &FilePreferenceSaverThread::QueueSave, file_name_ptr,
+      save_map));
+}
+
+
+/*
+ * Runs on the saver thread. Rapid successive saves of the same file -
+ * a showfile load patching 200 ports - collapse to the latest map,
+ * written once when the delay expires, instead of a full rewrite per
+ * save.
+ */
+void FilePreferenceSaverThread::QueueSave(
+    const string *filename,
+    const PreferencesMap *preferences) {
+  m_pending_saves[*filename] = *preferences;
+  delete filename;
+  delete preferences;
+
+  if (m_flush_timeout == ola::thread::INVALID_TIMEOUT) {
+    m_flush_timeout = m_ss.RegisterSingleTimeout(
+        SAVE_DELAY_MS,
+        NewSingleCallback(this,
+                          &FilePreferenceSaverThread::FlushPendingSaves));
+  }
+}
+
+
+void FilePreferenceSaverThread::FlushPendingSaves() {
+  m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  std::map<string, PreferencesMap>::const_iterator iter =
+      m_pending_saves.begin();
+  for (; iter != m_pending_saves.end(); ++iter) {
+    SavePreferencesToFile(new string(iter->first),
+                          new PreferencesMap(iter->second));
+  }
+  m_pending_saves.clear();
 }
 
 
 void *FilePreferenceSaverThread::Run() {
   m_ss.Run();
+  // write anything still held back before the thread exits
+  FlushPendingSaves();
   return NULL;
 }
 
@@ -373,6 +420,9 @@ void FilePreferenceSaverThread::Syncronize() {
 void FilePreferenceSaverThread::CompleteSyncronization(
     ConditionVariable *condition,
     Mutex *mutex) {
+  // Syncronize() promises the files are on disk when it returns
+  FlushPendingSaves();
+
   // calling lock here forces us to block until Wait() is called on the
   // condition_var.
   mutex->Lock();
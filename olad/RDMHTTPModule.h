@@ -41,6 +41,16 @@ namespace ola {
 
 /*
  * The module that deals with RDM requests.
+ *
+ * Every page view currently issues fresh GETs over the wire. A response
+ * cache needs to live at the RDMAPI layer rather than per page section:
+ * entries keyed by (universe, uid, pid, sub-device) with a short TTL,
+ * invalidated when this module performs a SET on the same key and flushed
+ * for a device when a queued message reports a change. The section
+ * handlers here are the wrong altitude - several sections share the same
+ * underlying PIDs, which is exactly the traffic a shared cache would
+ * collapse. See the QueueingRDMController latency stats for measuring the
+ * win per transport.
  */
 class RDMHTTPModule {
  public:
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * StartupProfiler.cpp
+ * Records per-phase timings during olad startup.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "olad/StartupProfiler.h"
+
+#include <iostream>
+#include <string>
+
+#include "ola/ExportMap.h"
+#include "ola/Logging.h"
+#include "ola/base/Flags.h"
+
+DEFINE_default_bool(trace_startup, false,
+                    "Print per-phase startup timings to stdout.");
+
+namespace ola {
+
+using std::string;
+
+const char K_STARTUP_PHASE_TIME_VAR[] = "startup-phase-time-ms";
+
+StartupProfiler::StartupProfiler(ExportMap *export_map)
+    : m_export_map(export_map) {
+  m_clock.CurrentTime(&m_start_time);
+}
+
+void StartupProfiler::StartPhase(const string &name) {
+  EndPhase();
+  m_current_phase = name;
+  m_clock.CurrentTime(&m_phase_start);
+}
+
+void StartupProfiler::Finish() {
+  EndPhase();
+
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  TimeInterval total = now - m_start_time;
+
+  UIntMap *phase_times = NULL;
+  if (m_export_map) {
+    phase_times = m_export_map->GetUIntMapVar(K_STARTUP_PHASE_TIME_VAR,
+                                              "phase");
+  }
+
+  std::vector<std::pair<string, TimeInterval> >::const_iterator iter;
+  for (iter = m_phases.begin(); iter != m_phases.end(); ++iter) {
+    unsigned int ms = static_cast<unsigned int>(
+        iter->second.InMilliSeconds());
+    if (phase_times) {
+      (*phase_times)[iter->first] = ms;
+    }
+    OLA_INFO << "startup phase " << iter->first << ": " << ms << "ms";
+    if (FLAGS_trace_startup) {
+      std::cout << "startup phase " << iter->first << ": " << ms << "ms"
+                << std::endl;
+    }
+  }
+  OLA_INFO << "startup total: " << total.InMilliSeconds() << "ms";
+  if (FLAGS_trace_startup) {
+    std::cout << "startup total: " << total.InMilliSeconds() << "ms"
+              << std::endl;
+  }
+}
+
+void StartupProfiler::EndPhase() {
+  if (m_current_phase.empty()) {
+    return;
+  }
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  m_phases.push_back(
+      std::make_pair(m_current_phase, now - m_phase_start));
+  m_current_phase.clear();
+}
+}  // namespace ola
@@ -0,0 +1,77 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * StartupProfiler.h
+ * Records per-phase timings during olad startup.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef OLAD_STARTUPPROFILER_H_
+#define OLAD_STARTUPPROFILER_H_
+
+#include <ola/Clock.h>
+#include <ola/base/Macro.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ola {
+
+class ExportMap;
+
+/**
+ * @brief Times the sequential phases of daemon startup.
+ *
+ * Cold start is seconds on embedded gateways and the total alone doesn't
+ * say where they go. StartPhase() closes the previous phase and opens the
+ * next; Finish() closes the last one, writes the per-phase millisecond
+ * timings into the "startup-phase-time-ms" map on the ExportMap and logs
+ * them. With --trace-startup the timings are also printed to stdout, so
+ * a gateway build can be profiled without raising the log level.
+ *
+ * Plugin start times are recorded separately by PluginManager into the
+ * "plugin-start-time-ms" map, since plugins load from the event loop
+ * after Init() returns.
+ */
+class StartupProfiler {
+ public:
+  explicit StartupProfiler(ExportMap *export_map);
+
+  /**
+   * @brief End the current phase (if any) and start a new one.
+   * @param name the name of the phase that's beginning.
+   */
+  void StartPhase(const std::string &name);
+
+  /**
+   * @brief End the current phase, then export and log all timings.
+   */
+  void Finish();
+
+ private:
+  ExportMap *m_export_map;
+  Clock m_clock;
+  TimeStamp m_start_time;
+  TimeStamp m_phase_start;
+  std::string m_current_phase;
+  std::vector<std::pair<std::string, TimeInterval> > m_phases;
+
+  void EndPhase();
+
+  DISALLOW_COPY_AND_ASSIGN(StartupProfiler);
+};
+}  // namespace ola
+#endif  // OLAD_STARTUPPROFILER_H_
@@ -39,11 +39,13 @@
 #include <vector>
 
 #include "ola/base/Array.h"
+#include "ola/base/TraceRing.h"
 #include "ola/Logging.h"
 #include "ola/MultiCallback.h"
 #include "ola/rdm/RDMCommand.h"
 #include "ola/rdm/RDMEnums.h"
 #include "ola/stl/STLUtils.h"
+#include "common/rpc/RpcChannel.h"
 #include "olad/Client.h"
 #include "olad/Port.h"
 #include "olad/Universe.h"
@@ -86,6 +88,8 @@ Universe::Universe(unsigned int universe_id, UniverseStore *store,
       m_active_priority(ola::dmx::SOURCE_PRIORITY_MIN),
       m_merge_mode(Universe::MERGE_LTP),
       m_universe_store(store),
+      m_defer_updates(false),
+      m_frame_clocked(false),
       m_export_map(export_map),
       m_clock(clock),
       m_rdm_discovery_interval(),
@@ -109,9 +113,20 @@ Universe::Universe(unsigned int universe_id, UniverseStore *store,
     K_UNIVERSE_UID_COUNT_VAR,
   };
 
+  m_fps_counter = NULL;
+  m_frames_since_sample = 0;
+  m_sampled_frames = 0;
+  m_changed_slots = 0;
+  m_slot_min = 0;
+  m_slot_max = 0;
+  m_slot_mean = 0;
   if (m_export_map) {
     for (unsigned int i = 0; i < arraysize(vars); ++i)
       (*m_export_map->GetUIntMapVar(vars[i]))[m_universe_id_str] = 0;
+    // std::map references stay valid until the entry is erased, so the
+    // per-frame counter can be bumped without any string lookups
+    m_fps_counter =
+        &(*m_export_map->GetUIntMapVar(K_FPS_VAR))[m_universe_id_str];
   }
 
   // we set the last discovery time to now, since most ports will trigger
@@ -155,6 +170,8 @@ Universe::~Universe() {
 void Universe::SetName(const string &name) {
   m_universe_name = name;
   UpdateName();
+  if (m_universe_store)
+    m_universe_store->UniverseAttributesChanged(this);
 
   // notify ports
   vector<OutputPort*>::const_iterator iter;
@@ -171,6 +188,8 @@ void Universe::SetName(const string &name) {
 void Universe::SetMergeMode(enum merge_mode merge_mode) {
   m_merge_mode = merge_mode;
   UpdateMode();
+  if (m_universe_store)
+    m_universe_store->UniverseAttributesChanged(this);
 }
 
 
@@ -198,6 +217,7 @@ bool Universe::AddPort(OutputPort *port) {
  * @return true if the port was removed, false if it didn't exist
  */
 bool Universe::RemovePort(InputPort *port) {
+  m_pending_ports.erase(port);
   return GenericRemovePort(port, &m_input_ports);
 }
 
@@ -286,6 +306,7 @@ bool Universe::AddSourceClient(Client *client) {
  * @return true is this client was removed, false if it didn't exist
  */
 bool Universe::RemoveSourceClient(Client *client) {
+  m_pending_clients.erase(client);
   if (!STLRemove(&m_source_clients, client))
     return false;
 
@@ -371,6 +392,7 @@ bool Universe::SetDMX(const DmxBuffer &buffer) {
     return true;
   }
   m_buffer.Set(buffer);
+  m_last_sent.Set(m_buffer);
   return UpdateDependants();
 }
 
@@ -385,6 +407,14 @@ bool Universe::PortDataChanged(InputPort *port) {
       << UniverseId();
     return false;
   }
+
+  if (m_defer_updates) {
+    m_pending_ports.insert(port);
+    if (!m_frame_clocked)
+      m_universe_store->AddPendingFlush(this);
+    return true;
+  }
+
   if (MergeAll(port, NULL))
     UpdateDependants();
   return true;
@@ -399,12 +429,64 @@ bool Universe::SourceClientDataChanged(Client *client) {
     return false;
 
   AddSourceClient(client);   // always add since this may be the first call
+
+  if (m_defer_updates) {
+    m_pending_clients.insert(client);
+    if (!m_frame_clocked)
+      m_universe_store->AddPendingFlush(this);
+    return true;
+  }
+
   if (MergeAll(NULL, client))
     UpdateDependants();
   return true;
 }
 
 
+/*
+ * Merge any changes deferred since the last flush, and fan the result out
+ * once if anything changed.
+ * @returns true if the dependants were updated.
+ */
+bool Universe::FlushPendingUpdates() {
+  bool changed = MergePendingUpdates();
+  if (changed)
+    UpdateDependants();
+  return changed;
+}
+
+
+/*
+ * A tick of the frame clock; merge anything pending and emit the current
+ * frame, whether or not it changed, so the outputs see a stable cadence.
+ */
+void Universe::ClockTick() {
+  MergePendingUpdates();
+  if (m_buffer.Size())
+    UpdateDependants();
+}
+
+
+/*
+ * Merge the changes deferred since the last flush.
+ * @returns true if the universe's data changed.
+ */
+bool Universe::MergePendingUpdates() {
+  bool changed = false;
+  std::set<InputPort*>::iterator port_iter = m_pending_ports.begin();
+  for (; port_iter != m_pending_ports.end(); ++port_iter) {
+    changed |= MergeAll(*port_iter, NULL);
+  }
+  std::set<Client*>::iterator client_iter = m_pending_clients.begin();
+  for (; client_iter != m_pending_clients.end(); ++client_iter) {
+    changed |= MergeAll(NULL, *client_iter);
+  }
+  m_pending_ports.clear();
+  m_pending_clients.clear();
+  return changed;
+}
+
+
 /**
  * @brief Clean old source clients
  */
@@ -609,22 +691,66 @@ bool Universe::IsActive() const {
  * updates everyone who needs to know (patched ports and network clients)
  */
 bool Universe::UpdateDependants() {
+  Trace(TraceRing::EVENT_PORT_FLUSH, UniverseId());
   vector<OutputPort*>::const_iterator iter;
   set<Client*>::const_iterator client_iter;
 
-  // write to all ports assigned to this universe
+  // write to all ports assigned to this universe, populating the
+  // standard pipeline stats so a dark output can be localized uniformly
+  // across plugins. The coarse clock keeps the timing cost negligible;
+  // it only needs to catch millisecond-scale blocking.
   for (iter = m_output_ports.begin(); iter != m_output_ports.end(); ++iter) {
-    (*iter)->WriteDMX(m_buffer, m_active_priority);
+    OutputPortStats *stats = (*iter)->GetOutputPortStats();
+    if (!stats) {
+      (*iter)->WriteDMX(m_buffer, m_active_priority);
+      continue;
+    }
+    stats->frames_offered++;
+    TimeStamp send_start, send_end;
+    m_clock->CurrentMonotonicTime(&send_start);
+    bool sent = (*iter)->WriteDMX(m_buffer, m_active_priority);
+    m_clock->CurrentMonotonicTime(&send_end);
+    uint64_t usecs = static_cast<uint64_t>((send_end - send_start).AsInt());
+    stats->send_time_total_usecs += usecs;
+    if (usecs > stats->send_time_max_usecs)
+      stats->send_time_max_usecs = usecs;
+    if (sent) {
+      stats->frames_sent++;
+    } else {
+      stats->frames_dropped++;
+      stats->last_drop_time = time(NULL);
+    }
   }
 
-  // write to all clients
-  for (client_iter = m_sink_clients.begin();
-       client_iter != m_sink_clients.end();
-       ++client_iter) {
-    (*client_iter)->SendDMX(m_universe_id, m_active_priority, m_buffer);
+  // Write to all clients. The frame is encoded once and the same bytes
+  // go to every sink channel, so eight monitors cost the same
+  // serialization as one.
+  if (!m_sink_clients.empty()) {
+    if (m_universe_id <= 0xffff) {
+      ola::rpc::RpcChannel::EncodeDmxFrame(
+          static_cast<uint16_t>(m_universe_id), m_active_priority,
+          m_buffer.GetRaw(), m_buffer.Size(), &m_encoded_client_frame);
+      for (client_iter = m_sink_clients.begin();
+           client_iter != m_sink_clients.end();
+           ++client_iter) {
+        // clients without a compact-frame channel get the protobuf path
+        if (!(*client_iter)->SendDMXFrame(m_encoded_client_frame)) {
+          (*client_iter)->SendDMX(m_universe_id, m_active_priority,
+                                  m_buffer);
+        }
+      }
+    } else {
+      // ids beyond the compact header's range use the protobuf path
+      for (client_iter = m_sink_clients.begin();
+           client_iter != m_sink_clients.end();
+           ++client_iter) {
+        (*client_iter)->SendDMX(m_universe_id, m_active_priority, m_buffer);
+      }
+    }
   }
 
-  SafeIncrement(K_FPS_VAR);
+  if (m_fps_counter)
+    (*m_fps_counter)++;
   return true;
 }
 
@@ -657,12 +783,12 @@ void Universe::UpdateMode() {
  * @pre sources.size >= 2
  * @param sources the list of DmxSources to merge
  */
-void Universe::HTPMergeSources(const vector<DmxSource> &sources) {
-  vector<DmxSource>::const_iterator iter;
+void Universe::HTPMergeSources(const vector<const DmxSource*> &sources) {
+  vector<const DmxSource*>::const_iterator iter;
   m_buffer.Reset();
 
   for (iter = sources.begin(); iter != sources.end(); ++iter) {
-    m_buffer.HTPMerge(iter->Data());
+    m_buffer.HTPMerge((*iter)->Data());
   }
 }
 
@@ -676,7 +802,11 @@ void Universe::HTPMergeSources(const vector<DmxSource> &sources) {
  * @returns true if the data for this universe changed, false otherwise
  */
 bool Universe::MergeAll(const InputPort *port, const Client *client) {
-  vector<DmxSource> active_sources;
+  Trace(TraceRing::EVENT_MERGE_START, UniverseId());
+  // reused between calls so the per-frame path doesn't allocate or copy
+  // DmxSources
+  vector<const DmxSource*> &active_sources = m_active_sources;
+  active_sources.clear();
 
   vector<InputPort*>::const_iterator iter;
   SourceClientMap::const_iterator client_iter;
@@ -688,7 +818,7 @@ bool Universe::MergeAll(const InputPort *port, const Client *client) {
 
   // Find the highest active ports
   for (iter = m_input_ports.begin(); iter != m_input_ports.end(); ++iter) {
-    DmxSource source = (*iter)->SourceData();
+    const DmxSource &source = (*iter)->SourceData();
     if (!source.IsSet() || !source.IsActive(now) || !source.Data().Size())
       continue;
 
@@ -699,7 +829,7 @@ bool Universe::MergeAll(const InputPort *port, const Client *client) {
     }
 
     if (source.Priority() == m_active_priority) {
-      active_sources.push_back(source);
+      active_sources.push_back(&source);
       if (*iter == port)
         changed_source_is_active = true;
     }
@@ -721,7 +851,7 @@ bool Universe::MergeAll(const InputPort *port, const Client *client) {
     }
 
     if (source.Priority() == m_active_priority) {
-      active_sources.push_back(source);
+      active_sources.push_back(&source);
       if (client_iter->first == client)
         changed_source_is_active = true;
     }
@@ -737,23 +867,23 @@ bool Universe::MergeAll(const InputPort *port, const Client *client) {
     // this source didn't have any effect, skip
     return false;
 
+  m_buffer.ClearDirtyRange();
+
   // only one source at the active priority
   if (active_sources.size() == 1) {
-    m_buffer.Set(active_sources[0].Data());
+    m_buffer.Set(active_sources[0]->Data());
   } else {
     // multi source merge
     if (m_merge_mode == Universe::MERGE_LTP) {
-      vector<DmxSource>::const_iterator source_iter = active_sources.begin();
-      DmxSource changed_source;
-      if (port)
-        changed_source = port->SourceData();
-      else
-        changed_source = client->SourceData(UniverseId());
+      vector<const DmxSource*>::const_iterator source_iter =
+          active_sources.begin();
+      const DmxSource &changed_source = port ?
+          port->SourceData() : client->SourceData(UniverseId());
 
       // check that the current port/client is newer than all other active
       // sources
       for (; source_iter != active_sources.end(); source_iter++) {
-        if (changed_source.Timestamp() < source_iter->Timestamp())
+        if (changed_source.Timestamp() < (*source_iter)->Timestamp())
           return false;
       }
       // if we made it to here this is the newest source
@@ -762,9 +892,69 @@ bool Universe::MergeAll(const InputPort *port, const Client *client) {
       HTPMergeSources(active_sources);
     }
   }
+
+  // Quiet frames are common; if the merge produced the same data we
+  // sent last time, skip the port and client fanout - but not forever.
+  // Downstream nodes declare source loss if the wire goes quiet (2.5s
+  // for E1.31, ~4s for ArtNet), so a static look must still be
+  // refreshed periodically.
+  TimeStamp fanout_now;
+  m_clock->CurrentMonotonicTime(&fanout_now);
+  if (m_buffer == m_last_sent &&
+      fanout_now - m_last_fanout_time <
+          TimeInterval(SUPPRESSION_REFRESH_INTERVAL_MS / 1000,
+                       (SUPPRESSION_REFRESH_INTERVAL_MS % 1000) * 1000)) {
+    return false;
+  }
+  m_last_fanout_time = fanout_now;
+
+  // sampled slot stats, computed here while both frames are hot in
+  // cache and before m_last_sent is overwritten
+  if (++m_frames_since_sample >= SLOT_STATS_SAMPLE_INTERVAL) {
+    m_frames_since_sample = 0;
+    SampleFrameStats();
+  }
+
+  m_last_sent.Set(m_buffer);
+  Trace(TraceRing::EVENT_MERGE_END, UniverseId());
   return true;
 }
 
+/*
+ * Compute changed-slot count and min/max/mean over the current frame.
+ * Runs on a small fraction of frames; the whole pass is two linear
+ * walks of data that's already in cache.
+ */
+void Universe::SampleFrameStats() {
+  const uint8_t *current = m_buffer.GetRaw();
+  const uint8_t *last = m_last_sent.GetRaw();
+  const unsigned int size = m_buffer.Size();
+  const unsigned int compare_size =
+      std::min(size, m_last_sent.Size());
+
+  unsigned int changed = 0;
+  for (unsigned int i = 0; i < compare_size; i++) {
+    changed += (current[i] != last[i]);
+  }
+  changed += size - compare_size;
+
+  uint8_t min_value = 255, max_value = 0;
+  unsigned int sum = 0;
+  for (unsigned int i = 0; i < size; i++) {
+    if (current[i] < min_value)
+      min_value = current[i];
+    if (current[i] > max_value)
+      max_value = current[i];
+    sum += current[i];
+  }
+
+  m_changed_slots = changed;
+  m_slot_min = size ? min_value : 0;
+  m_slot_max = max_value;
+  m_slot_mean = size ? static_cast<uint8_t>(sum / size) : 0;
+  m_sampled_frames++;
+}
+
 
 /**
  * Called when discovery completes on a single ports.
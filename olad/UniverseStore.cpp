@@ -21,6 +21,7 @@
 
 #include "olad/UniverseStore.h"
 
+#include <algorithm>
 #include <iostream>
 #include <set>
 #include <sstream>
@@ -43,11 +44,13 @@ using std::string;
 using std::vector;
 
 const unsigned int UniverseStore::MINIMUM_RDM_DISCOVERY_INTERVAL = 30;
+const unsigned int UniverseStore::MAX_INDEXED_UNIVERSE_ID = 65536;
 
 UniverseStore::UniverseStore(Preferences *preferences,
                              ExportMap *export_map)
     : m_preferences(preferences),
-      m_export_map(export_map) {
+      m_export_map(export_map),
+      m_defer_updates(false) {
   if (export_map) {
     export_map->GetStringMapVar(Universe::K_UNIVERSE_NAME_VAR, "universe");
     export_map->GetStringMapVar(Universe::K_UNIVERSE_MODE_VAR, "universe");
@@ -72,6 +75,10 @@ UniverseStore::~UniverseStore() {
 }
 
 Universe *UniverseStore::GetUniverse(unsigned int universe_id) const {
+  if (universe_id < m_universe_index.size())
+    return m_universe_index[universe_id];
+  if (universe_id < MAX_INDEXED_UNIVERSE_ID)
+    return NULL;
   return STLFindOrNull(m_universe_map, universe_id);
 }
 
@@ -83,9 +90,18 @@ Universe *UniverseStore::GetUniverseOrCreate(unsigned int universe_id) {
     iter->second = new Universe(universe_id, this, m_export_map, &m_clock);
 
     if (iter->second) {
+      iter->second->SetDeferredUpdates(m_defer_updates);
+      m_universes.push_back(iter->second);
+      if (universe_id < MAX_INDEXED_UNIVERSE_ID) {
+        if (universe_id >= m_universe_index.size())
+          m_universe_index.resize(universe_id + 1, NULL);
+        m_universe_index[universe_id] = iter->second;
+      }
       if (m_preferences) {
         RestoreUniverseSettings(iter->second);
       }
+      if (m_change_callback.get())
+        m_change_callback->Run(universe_id, UNIVERSE_ADDED);
     } else {
       OLA_WARN << "Failed to create universe " << universe_id;
     }
@@ -94,22 +110,31 @@ Universe *UniverseStore::GetUniverseOrCreate(unsigned int universe_id) {
 }
 
 void UniverseStore::GetList(vector<Universe*> *universes) const {
-  STLValues(m_universe_map, universes);
+  *universes = m_universes;
 }
 
 void UniverseStore::DeleteAll() {
-  UniverseMap::iterator iter;
+  vector<Universe*>::iterator iter;
 
-  for (iter = m_universe_map.begin(); iter != m_universe_map.end(); iter++) {
-    SaveUniverseSettings(iter->second);
-    delete iter->second;
+  for (iter = m_universes.begin(); iter != m_universes.end(); iter++) {
+    SaveUniverseSettings(*iter);
+    delete *iter;
   }
   m_deletion_candiates.clear();
+  m_pending_flush.clear();
   m_universe_map.clear();
+  m_universe_index.clear();
+  m_universes.clear();
 }
 
 void UniverseStore::AddUniverseGarbageCollection(Universe *universe) {
+  // The universe is mid-callstack here, so deletion must be deferred;
+  // the callback schedules a collection on the next loop pass.
+  bool first_candidate = m_deletion_candiates.empty();
   m_deletion_candiates.insert(universe);
+  if (first_candidate && m_gc_callback.get()) {
+    m_gc_callback->Run();
+  }
 }
 
 void UniverseStore::GarbageCollectUniverses() {
@@ -120,7 +145,7 @@ void UniverseStore::GarbageCollectUniverses() {
        iter != m_deletion_candiates.end(); iter++) {
     if (!(*iter)->IsActive()) {
       SaveUniverseSettings(*iter);
-      m_universe_map.erase((*iter)->UniverseId());
+      RemoveUniverseFromStore(*iter);
       delete *iter;
     }
   }
@@ -128,6 +153,56 @@ void UniverseStore::GarbageCollectUniverses() {
 }
 
 
+void UniverseStore::SetDeferredUpdates(bool defer) {
+  m_defer_updates = defer;
+  vector<Universe*>::iterator iter = m_universes.begin();
+  for (; iter != m_universes.end(); ++iter)
+    (*iter)->SetDeferredUpdates(defer);
+}
+
+
+void UniverseStore::AddPendingFlush(Universe *universe) {
+  m_pending_flush.insert(universe);
+}
+
+
+void UniverseStore::FlushPendingUpdates() {
+  if (m_pending_flush.empty())
+    return;
+  set<Universe*>::iterator iter = m_pending_flush.begin();
+  for (; iter != m_pending_flush.end(); ++iter)
+    (*iter)->FlushPendingUpdates();
+  m_pending_flush.clear();
+}
+
+
+/*
+ * Remove a universe from the map, index and iteration list.
+ */
+void UniverseStore::UniverseAttributesChanged(Universe *universe) {
+  if (m_change_callback.get())
+    m_change_callback->Run(universe->UniverseId(),
+                           UNIVERSE_ATTRIBUTES_CHANGED);
+}
+
+
+/*
+ * Remove a universe from the map, index and iteration list.
+ */
+void UniverseStore::RemoveUniverseFromStore(Universe *universe) {
+  if (m_change_callback.get())
+    m_change_callback->Run(universe->UniverseId(), UNIVERSE_REMOVED);
+  m_pending_flush.erase(universe);
+  m_universe_map.erase(universe->UniverseId());
+  if (universe->UniverseId() < m_universe_index.size())
+    m_universe_index[universe->UniverseId()] = NULL;
+  vector<Universe*>::iterator iter =
+      std::find(m_universes.begin(), m_universes.end(), universe);
+  if (iter != m_universes.end())
+    m_universes.erase(iter);
+}
+
+
 /*
  * Restore a universe's settings
  * @param uni  the universe to update
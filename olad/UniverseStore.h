@@ -22,10 +22,12 @@
 #define OLAD_UNIVERSESTORE_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "ola/Callback.h"
 #include "ola/Clock.h"
 #include "ola/base/Macro.h"
 
@@ -52,6 +54,7 @@ class UniverseStore {
 
   /**
    * @brief Lookup a universe from its universe-id.
+   * Lookups of universe-ids below MAX_INDEXED_UNIVERSE_ID are O(1).
    * @param universe_id the universe-id of the universe.
    * @return the universe, or NULL if the universe doesn't exist.
    */
@@ -70,8 +73,9 @@ class UniverseStore {
   unsigned int UniverseCount() const { return m_universe_map.size(); }
 
   /**
-   * @brief Returns a list of universes. This must be freed when you're
-   * done with it.
+   * @brief Returns a list of universes, in allocation order. Walking
+   * universes in allocation order keeps the periodic cleanup and stats
+   * sweeps cache friendly.
    * @param[out] universes a pointer to a vector of Universes.
    */
   void GetList(std::vector<Universe*> *universes) const;
@@ -92,20 +96,86 @@ class UniverseStore {
    */
   void GarbageCollectUniverses();
 
+  /**
+   * @brief Set a callback to run when a universe first becomes a
+   * deletion candidate. The server uses it to schedule a collection on
+   * the next loop pass, so retirement is event driven rather than
+   * waiting for a periodic sweep. Ownership is transferred.
+   */
+  void SetGarbageCollectionCallback(ola::Callback0<void> *callback) {
+    m_gc_callback.reset(callback);
+  }
+
+  /**
+   * @brief Put new universes into deferred-update mode.
+   * In deferred mode a universe queues input changes and the server
+   * flushes them once per event loop, coalescing updates that arrive in
+   * the same poll cycle. Applies to existing universes as well.
+   */
+  void SetDeferredUpdates(bool defer);
+
+  /**
+   * @brief Called by a Universe when it has updates waiting for a flush.
+   */
+  void AddPendingFlush(Universe *universe);
+
+  /**
+   * @brief Flush all universes with pending updates.
+   */
+  void FlushPendingUpdates();
+
+  enum UniverseChange {
+    UNIVERSE_ADDED,
+    UNIVERSE_REMOVED,
+    UNIVERSE_ATTRIBUTES_CHANGED,
+  };
+
+  /**
+   * @brief Set a callback to run when universes are added, removed or
+   * change their attributes. Used to push deltas to subscribed clients.
+   * Ownership is transferred.
+   */
+  void SetChangeCallback(
+      ola::Callback2<void, unsigned int, UniverseChange> *callback) {
+    m_change_callback.reset(callback);
+  }
+
+  /**
+   * @brief Called by a Universe when its name or merge mode changes.
+   */
+  void UniverseAttributesChanged(Universe *universe);
+
  private:
   typedef std::map<unsigned int, Universe*> UniverseMap;
 
   Preferences *m_preferences;
   ExportMap *m_export_map;
   UniverseMap m_universe_map;
+  // Direct index on universe-id for the common, low-numbered ids; NULL
+  // entries are unused ids. Ids >= MAX_INDEXED_UNIVERSE_ID fall back to
+  // m_universe_map.
+  std::vector<Universe*> m_universe_index;
+  // Universes in allocation order, used for iteration.
+  std::vector<Universe*> m_universes;
+  bool m_defer_updates;
+  // Universes with updates queued for the next flush.
+  std::set<Universe*> m_pending_flush;
+  std::auto_ptr<ola::Callback2<void, unsigned int, UniverseChange> >
+      m_change_callback;
+  std::auto_ptr<ola::Callback0<void> > m_gc_callback;
   std::set<Universe*> m_deletion_candiates;  // list of universes we may be
                                              // able to delete
   Clock m_clock;
 
+  void RemoveUniverseFromStore(Universe *universe);
+
   bool RestoreUniverseSettings(Universe *universe) const;
   bool SaveUniverseSettings(Universe *universe) const;
 
   static const unsigned int MINIMUM_RDM_DISCOVERY_INTERVAL;
+  // The upper bound on ids served from the direct index, this bounds the
+  // index memory for sparse, high-numbered ids.
+  static const unsigned int MAX_INDEXED_UNIVERSE_ID;
 
   DISALLOW_COPY_AND_ASSIGN(UniverseStore);
 };
@@ -172,6 +172,9 @@ void ArtNetDevice::Configure(RpcController *controller,
     case ola::plugin::artnet::Request::ARTNET_NODE_LIST_REQUEST:
       HandleNodeList(&request_pb, response, controller);
       break;
+    case ola::plugin::artnet::Request::ARTNET_NODE_STATS_REQUEST:
+      HandleNodeStats(response);
+      break;
     default:
       controller->SetFailed("Invalid Request");
   }
@@ -239,6 +242,30 @@ void ArtNetDevice::HandleNodeList(Request *request,
   }
   reply.SerializeToString(response);
 }
+/*
+ * Return the per-peer health stats.
+ */
+void ArtNetDevice::HandleNodeStats(string *response) {
+  std::vector<ArtNetNodeImpl::NodeStats> stats;
+  m_node->GetNodeStats(&stats);
+
+  const TimeStamp *now = m_plugin_adaptor->WakeUpTime();
+  ola::plugin::artnet::Reply reply;
+  reply.set_type(ola::plugin::artnet::Reply::ARTNET_NODE_STATS_REPLY);
+  ola::plugin::artnet::NodeStatsReply *stats_reply =
+      reply.mutable_node_stats();
+  std::vector<ArtNetNodeImpl::NodeStats>::const_iterator iter =
+      stats.begin();
+  for (; iter != stats.end(); ++iter) {
+    ola::plugin::artnet::NodeStats *node = stats_reply->add_node();
+    node->set_ip_address(iter->ip_address.AsInt());
+    node->set_packets_received(iter->packets_received);
+    node->set_last_seen_ago(iter->last_seen.IsSet() ?
+        static_cast<uint32_t>((*now - iter->last_seen).Seconds()) : 0);
+    node->set_send_failures(iter->send_failures);
+  }
+  reply.SerializeToString(response);
+}
 }  // namespace artnet
 }  // namespace plugin
 }  // namespace ola
@@ -118,6 +118,7 @@ class ArtNetDevice: public Device {
   /**
    * Handle a node list request
    */
+  void HandleNodeStats(std::string *response);
   void HandleNodeList(Request *request,
                       std::string *response,
                       ola::rpc::RpcController *controller);
@@ -83,11 +83,9 @@ class ArtNetNodeImpl::InputPort {
   InputPort()
       : enabled(false),
         sequence_number(0),
+        dmx_template_primed(false),
         discovery_callback(NULL),
         discovery_timeout(ola::thread::INVALID_TIMEOUT),
-        rdm_request_callback(NULL),
-        pending_request(NULL),
-        rdm_send_timeout(ola::thread::INVALID_TIMEOUT),
         m_port_address(0),
         m_tod_callback(NULL) {
   }
@@ -152,6 +150,10 @@ class ArtNetNodeImpl::InputPort {
   bool enabled;
   uint8_t sequence_number;
   map<IPV4Address, TimeStamp> subscribed_nodes;
+  // a preassembled ArtDmx packet; the header is built once and only
+  // sequence, length and payload are patched per frame
+  artnet_packet dmx_template;
+  bool dmx_template_primed;
   uid_map uids;  // used to keep track of the UIDs
   // NULL if discovery isn't running, otherwise the callback to run when it
   // finishes
@@ -160,13 +162,15 @@ class ArtNetNodeImpl::InputPort {
   set<IPV4Address> discovery_node_set;
   // the timeout_id for the discovery timer
   ola::thread::timeout_id discovery_timeout;
-  // the in-flight request and it's callback
-  ola::rdm::RDMCallback *rdm_request_callback;
-  const ola::rdm::RDMRequest *pending_request;
-  IPV4Address rdm_ip_destination;
-
-  // these control the sending of RDM requests.
-  ola::thread::timeout_id rdm_send_timeout;
+  // The in-flight RDM transactions, keyed by destination IP. Requests to
+  // distinct nodes run concurrently (one outstanding per node), which
+  // turns a rig-wide discovery from lock-step into a pipeline.
+  struct PendingRDMTransaction {
+    const ola::rdm::RDMRequest *request;
+    ola::rdm::RDMCallback *callback;
+    ola::thread::timeout_id timeout;
+  };
+  map<IPV4Address, PendingRDMTransaction> pending_rdm;
 
  private:
   uint8_t m_port_address;
@@ -189,6 +193,7 @@ ArtNetNodeImpl::ArtNetNodeImpl(const ola::network::Interface &iface,
                                const ArtNetNodeOptions &options,
                                ola::network::UDPSocketInterface *socket)
     : m_running(false),
+      m_storm_discards(0),
       m_net_address(0),
       m_send_reply_on_change(true),
       m_short_name(""),
@@ -201,12 +206,18 @@ ArtNetNodeImpl::ArtNetNodeImpl(const ola::network::Interface &iface,
       m_in_configuration_mode(false),
       m_artpoll_required(false),
       m_artpollreply_required(false),
+      m_poll_reply_dirty(true),
+      m_duplicate_frames(0),
       m_interface(iface),
       m_socket(socket) {
 
   if (!m_socket.get())
     m_socket.reset(new UDPSocket());
 
+  // nothing is patched yet; the bitmap is otherwise only rebuilt on
+  // configuration changes and must not be probed uninitialized
+  memset(m_patched_universes, 0, sizeof(m_patched_universes));
+
   for (unsigned int i = 0; i < options.input_port_count; i++) {
     m_input_ports.push_back(new InputPort());
   }
@@ -217,6 +228,7 @@ ArtNetNodeImpl::ArtNetNodeImpl(const ola::network::Interface &iface,
     m_output_ports[i].sequence_number = 0;
     m_output_ports[i].enabled = false;
     m_output_ports[i].is_merging = false;
+    m_output_ports[i].pending_sync_data = false;
     m_output_ports[i].merge_mode = ARTNET_MERGE_HTP;
     m_output_ports[i].buffer = NULL;
     m_output_ports[i].on_data = NULL;
@@ -270,21 +282,16 @@ bool ArtNetNodeImpl::Stop() {
     port->RunDiscoveryCallback();
 
     // clean up request state
-    if (port->rdm_send_timeout != ola::thread::INVALID_TIMEOUT) {
-      m_ss->RemoveTimeout(port->rdm_send_timeout);
-      port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-    }
-
-    if (port->pending_request) {
-      delete port->pending_request;
-      port->pending_request = NULL;
-    }
-
-    if (port->rdm_request_callback) {
-      RDMCallback *callback = port->rdm_request_callback;
-      port->rdm_request_callback = NULL;
-      callback->Run(ola::rdm::RDM_TIMEOUT, NULL, packets);
+    map<IPV4Address,
+        ArtNetNodeImpl::InputPort::PendingRDMTransaction>::iterator
+        rdm_iter = port->pending_rdm.begin();
+    for (; rdm_iter != port->pending_rdm.end(); ++rdm_iter) {
+      if (rdm_iter->second.timeout != ola::thread::INVALID_TIMEOUT)
+        m_ss->RemoveTimeout(rdm_iter->second.timeout);
+      delete rdm_iter->second.request;
+      rdm_iter->second.callback->Run(ola::rdm::RDM_TIMEOUT, NULL, packets);
     }
+    port->pending_rdm.clear();
   }
 
   m_ss->RemoveReadDescriptor(m_socket.get());
@@ -348,6 +355,8 @@ bool ArtNetNodeImpl::SetNetAddress(uint8_t net_address) {
   for (; iter != m_input_ports.end(); ++iter) {
     input_ports_enabled |= (*iter)->enabled;
     (*iter)->ClearSubscribedNodes();
+    // the ArtDmx template bakes the net byte; rebuild it on next send
+    (*iter)->dmx_template_primed = false;
   }
 
   if (input_ports_enabled)
@@ -507,23 +516,33 @@ bool ArtNetNodeImpl::SendDMX(uint8_t port_id, const DmxBuffer &buffer) {
     return true;
   }
 
-  artnet_packet packet;
-  PopulatePacketHeader(&packet, ARTNET_DMX);
-  memset(&packet.data.dmx, 0, sizeof(packet.data.dmx));
-
-  packet.data.poll.version = HostToNetwork(ARTNET_VERSION);
+  artnet_packet &packet = port->dmx_template;
+  if (!port->dmx_template_primed) {
+    PopulatePacketHeader(&packet, ARTNET_DMX);
+    memset(&packet.data.dmx, 0, sizeof(packet.data.dmx));
+    packet.data.dmx.version = HostToNetwork(ARTNET_VERSION);
+    packet.data.dmx.physical = port_id;
+    packet.data.dmx.net = m_net_address;
+    port->dmx_template_primed = true;
+  }
   packet.data.dmx.sequence = port->sequence_number;
-  packet.data.dmx.physical = port_id;
+  // the universe can be re-patched, so refresh it each frame
   packet.data.dmx.universe = port->PortAddress();
-  packet.data.dmx.net = m_net_address;
 
   unsigned int buffer_size = buffer.Size();
-  buffer.Get(packet.data.dmx.data, &buffer_size);
-
-  // the dmx frame size needs to be a multiple of two, correct here if needed
-  if (buffer_size % 2) {
-    packet.data.dmx.data[buffer_size] = 0;
-    buffer_size++;
+  // Even-sized frames can alias the DmxBuffer's backing store as a second
+  // iovec, so the unicast fanout never copies the payload; odd sizes need
+  // the pad byte and fall back to the copy.
+  const uint8_t *shared_payload =
+      (buffer.GetRaw() && !(buffer_size % 2)) ? buffer.GetRaw() : NULL;
+  if (!shared_payload) {
+    buffer.Get(packet.data.dmx.data, &buffer_size);
+    // the dmx frame size needs to be a multiple of two, correct here if
+    // needed
+    if (buffer_size % 2) {
+      packet.data.dmx.data[buffer_size] = 0;
+      buffer_size++;
+    }
   }
   packet.data.dmx.length[0] = buffer_size >> 8;
   packet.data.dmx.length[1] = buffer_size & 0xff;
@@ -533,6 +552,11 @@ bool ArtNetNodeImpl::SendDMX(uint8_t port_id, const DmxBuffer &buffer) {
   bool sent_ok = false;
   if (port->subscribed_nodes.size() >= m_broadcast_threshold ||
       m_always_broadcast) {
+    if (shared_payload) {
+      // the broadcast path sends one contiguous packet
+      buffer.Get(packet.data.dmx.data, &buffer_size);
+      shared_payload = NULL;
+    }
     sent_ok = SendPacket(
         packet,
         size,
@@ -544,24 +568,42 @@ bool ArtNetNodeImpl::SendDMX(uint8_t port_id, const DmxBuffer &buffer) {
     map<IPV4Address, TimeStamp>::iterator iter = port->subscribed_nodes.begin();
     TimeStamp last_heard_threshold = (
         *m_ss->WakeUpTime() - TimeInterval(NODE_TIMEOUT, 0));
+    // one packet, many destinations: submit the whole fanout as a batch
+    std::vector<ola::network::UDPSocketInterface::OutgoingDatagram>
+        datagrams;
+    const unsigned int wire_size = static_cast<unsigned int>(
+        size + sizeof(packet.id) + sizeof(packet.op_code));
     while (iter != port->subscribed_nodes.end()) {
       // if this node has timed out, remove it from the set
       if (iter->second < last_heard_threshold) {
         port->subscribed_nodes.erase(iter++);
         continue;
       }
-      sent_ok |= SendPacket(packet, size, iter->first);
+      ola::network::UDPSocketInterface::OutgoingDatagram datagram;
+      datagram.data = reinterpret_cast<const uint8_t*>(&packet);
+      if (shared_payload) {
+        datagram.length = wire_size - buffer_size;
+        datagram.payload = shared_payload;
+        datagram.payload_length = buffer_size;
+      } else {
+        datagram.length = wire_size;
+      }
+      datagram.destination = IPV4SocketAddress(iter->first, ARTNET_PORT);
+      datagrams.push_back(datagram);
       ++iter;
     }
+    if (!datagrams.empty()) {
+      sent_ok = m_socket->SendToBatch(
+          &datagrams[0], static_cast<unsigned int>(datagrams.size())) ==
+          static_cast<int>(datagrams.size());
+      port->sequence_number++;
+    }
 
     if (port->subscribed_nodes.empty()) {
       OLA_DEBUG <<
         "Suppressing data transmit due to no active nodes for universe " <<
         static_cast<int>(port->PortAddress());
       sent_ok = true;
-    } else {
-      // We sent at least one packet, increment the sequence number
-      port->sequence_number++;
     }
   }
 
@@ -641,14 +683,7 @@ void ArtNetNodeImpl::SendRDMRequest(uint8_t port_id,
     return;
   }
 
-  if (port->rdm_request_callback) {
-    OLA_FATAL << "Previous request hasn't completed yet, dropping request";
-    on_complete->Run(ola::rdm::RDM_FAILED_TO_SEND, NULL, packets);
-    delete request;
-    return;
-  }
-
-  port->rdm_ip_destination = m_interface.bcast_address;
+  IPV4Address ip_destination = m_interface.bcast_address;
   const UID &uid_destination = request->DestinationUID();
   uid_map::const_iterator iter = port->uids.find(uid_destination);
   if (iter == port->uids.end()) {
@@ -656,28 +691,35 @@ void ArtNetNodeImpl::SendRDMRequest(uint8_t port_id,
       OLA_WARN << "Couldn't find " << uid_destination
                << " in the uid map, broadcasting packet";
   } else {
-    port->rdm_ip_destination = iter->second.first;
+    ip_destination = iter->second.first;
+  }
+
+  // one outstanding transaction per target node; requests to other nodes
+  // proceed in parallel
+  if (STLContains(port->pending_rdm, ip_destination)) {
+    OLA_FATAL << "Previous request to " << ip_destination
+              << " hasn't completed yet, dropping request";
+    on_complete->Run(ola::rdm::RDM_FAILED_TO_SEND, NULL, packets);
+    delete request;
+    return;
   }
 
-  port->rdm_request_callback = on_complete;
-  port->pending_request = request;
-  bool r = SendRDMCommand(*request,
-                          port->rdm_ip_destination,
-                          port->PortAddress());
+  bool r = SendRDMCommand(*request, ip_destination, port->PortAddress());
   if (r) {
     if (uid_destination.IsBroadcast()) {
-      port->rdm_request_callback = NULL;
-      port->pending_request = NULL;
       delete request;
       on_complete->Run(ola::rdm::RDM_WAS_BROADCAST, NULL, packets);
     } else {
-      port->rdm_send_timeout = m_ss->RegisterSingleTimeout(
+      InputPort::PendingRDMTransaction &transaction =
+          port->pending_rdm[ip_destination];
+      transaction.request = request;
+      transaction.callback = on_complete;
+      transaction.timeout = m_ss->RegisterSingleTimeout(
         RDM_REQUEST_TIMEOUT_MS,
-        ola::NewSingleCallback(this, &ArtNetNodeImpl::TimeoutRDMRequest, port));
+        ola::NewSingleCallback(this, &ArtNetNodeImpl::TimeoutRDMRequest,
+                               port, ip_destination));
     }
   } else {
-    port->rdm_request_callback = NULL;
-    port->pending_request = NULL;
     delete request;
     on_complete->Run(ola::rdm::RDM_FAILED_TO_SEND, NULL, packets);
   }
@@ -840,6 +882,10 @@ bool ArtNetNodeImpl::SendPollIfAllowed() {
 }
 
 bool ArtNetNodeImpl::SendPollReplyIfRequired() {
+  // something changed, so the cached reply image and the receive filter
+  // are stale
+  m_poll_reply_dirty = true;
+  RebuildPatchedUniverseBitmap();
   if (m_running && m_send_reply_on_change) {
     if (m_in_configuration_mode) {
       m_artpollreply_required = true;
@@ -852,7 +898,48 @@ bool ArtNetNodeImpl::SendPollReplyIfRequired() {
 }
 
 bool ArtNetNodeImpl::SendPollReply(const IPV4Address &destination) {
-  artnet_packet packet;
+  // Answering a poll is a cached send: the image is only rebuilt when the
+  // node or port config changed, the cheap volatile bits are patched in
+  // place below.
+  if (m_poll_reply_dirty) {
+    RebuildPollReply();
+    m_poll_reply_dirty = false;
+  }
+
+  artnet_packet &packet = m_poll_reply_packet;
+  for (unsigned int i = 0; i < ARTNET_MAX_PORTS; i++) {
+    packet.data.reply.good_output[i] = (
+        (m_output_ports[i].enabled ? 0x80 : 0x00) |
+        (m_output_ports[i].merge_mode == ARTNET_MERGE_LTP ? 0x2 : 0x0) |
+        (m_output_ports[i].is_merging ? 0x8 : 0x0));
+  }
+
+  if (!SendPacket(packet, sizeof(packet.data.reply), destination)) {
+    OLA_INFO << "Failed to send ArtPollReply";
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Rebuild the bitmap of universe addresses our enabled output ports
+ * listen to; all port config changes funnel through
+ * SendPollReplyIfRequired() so this stays in step.
+ */
+void ArtNetNodeImpl::RebuildPatchedUniverseBitmap() {
+  memset(m_patched_universes, 0, sizeof(m_patched_universes));
+  for (unsigned int i = 0; i < ARTNET_MAX_PORTS; i++) {
+    if (m_output_ports[i].enabled) {
+      uint8_t address = m_output_ports[i].universe_address;
+      m_patched_universes[address / 8] |= static_cast<uint8_t>(
+          1 << (address & 7));
+    }
+  }
+}
+
+
+void ArtNetNodeImpl::RebuildPollReply() {
+  artnet_packet &packet = m_poll_reply_packet;
   PopulatePacketHeader(&packet, ARTNET_REPLY);
   memset(&packet.data.reply, 0, sizeof(packet.data.reply));
 
@@ -890,11 +977,6 @@ bool ArtNetNodeImpl::SendPollReply(const IPV4Address &destination) {
   m_interface.ip_address.Get(packet.data.reply.bind_ip);
   // maybe set status2 here if the web UI is enabled
   packet.data.reply.status2 = 0x08;  // node supports 15 bit port addresses
-  if (!SendPacket(packet, sizeof(packet.data.reply), destination)) {
-    OLA_INFO << "Failed to send ArtPollReply";
-    return false;
-  }
-  return true;
 }
 
 bool ArtNetNodeImpl::SendIPReply(const IPV4Address &destination) {
@@ -914,16 +996,38 @@ bool ArtNetNodeImpl::SendIPReply(const IPV4Address &destination) {
   return true;
 }
 
+void ArtNetNodeImpl::GetNodeStats(std::vector<NodeStats> *stats) const {
+  map<IPV4Address, NodeStats>::const_iterator iter = m_node_stats.begin();
+  for (; iter != m_node_stats.end(); ++iter)
+    stats->push_back(iter->second);
+}
+
+
 void ArtNetNodeImpl::HandlePacket(const IPV4Address &source_address,
                                   const artnet_packet &packet,
                                   unsigned int packet_size) {
   unsigned int header_size = sizeof(packet) - sizeof(packet.data);
 
   if (packet_size <= header_size) {
-    OLA_WARN << "Skipping small artnet packet received, size=" << packet_size;
+    OLA_WARN_RATE_LIMITED << "Skipping small artnet packet received, size="
+                          << packet_size;
     return;
   }
 
+  // a forged-source flood must not grow the stats map without bound
+  std::map<IPV4Address, NodeStats>::iterator stats_iter =
+      m_node_stats.find(source_address);
+  if (stats_iter == m_node_stats.end() &&
+      m_node_stats.size() >= MAX_TRACKED_SOURCES) {
+    OLA_WARN_RATE_LIMITED << "Too many ArtNet sources, not tracking stats "
+                          << "for " << source_address;
+  } else {
+    NodeStats &node_stats = m_node_stats[source_address];
+    node_stats.ip_address = source_address;
+    node_stats.packets_received++;
+    node_stats.last_seen = *m_ss->WakeUpTime();
+  }
+
   switch (LittleEndianToHost(packet.op_code)) {
     case ARTNET_POLL:
       HandlePollPacket(source_address,
@@ -940,6 +1044,11 @@ void ArtNetNodeImpl::HandlePacket(const IPV4Address &source_address,
                        packet.data.dmx,
                        packet_size - header_size);
       break;
+    case ARTNET_SYNC:
+      HandleSyncPacket(source_address,
+                       packet.data.sync,
+                       packet_size - header_size);
+      break;
     case ARTNET_TODREQUEST:
       HandleTodRequest(source_address,
                        packet.data.tod_request,
@@ -1055,21 +1164,61 @@ void ArtNetNodeImpl::HandleDataPacket(const IPV4Address &source_address,
   }
 
   uint16_t universe_id = LittleEndianToHost(packet.universe);
+
+  // Early discard for universes no enabled output port listens to: one
+  // bitmap probe before any further parsing. Failover storms broadcast
+  // every universe on the wire, most of which we'd throw away anyway.
+  if (!(m_patched_universes[(universe_id & 0xff) / 8] &
+        (1 << (universe_id & 7)))) {
+    m_storm_discards++;
+    if ((m_storm_discards & (STORM_WARN_INTERVAL - 1)) == 1) {
+      OLA_WARN << "Discarded " << m_storm_discards << " ArtDmx packets for "
+               << "unpatched universes (most recently "
+               << static_cast<int>(universe_id) << " from "
+               << source_address << ")";
+    }
+    return;
+  }
+
   uint16_t data_size = std::min(
       (unsigned int) ((packet.length[0] << 8) + packet.length[1]),
       packet_size - header_size);
 
+  // Looped networks can deliver the same ArtDmx twice via redundant
+  // paths; drop exact duplicates (same source, universe & sequence)
+  // within a short window before any copy or merge runs. A sequence of 0
+  // means sequencing is disabled, so those are never deduped.
+  if (packet.sequence) {
+    DedupKey key(source_address, universe_id);
+    std::map<DedupKey, DedupEntry>::iterator dedup_iter =
+        m_dedup_entries.find(key);
+    if (dedup_iter != m_dedup_entries.end() &&
+        dedup_iter->second.sequence == packet.sequence &&
+        *m_ss->WakeUpTime() - dedup_iter->second.timestamp <
+            TimeInterval(0, DEDUP_WINDOW_USECS)) {
+      m_duplicate_frames++;
+      return;
+    }
+    // bound the table against forged-source floods; with it full, new
+    // sources just skip duplicate detection
+    if (dedup_iter != m_dedup_entries.end() ||
+        m_dedup_entries.size() < MAX_TRACKED_SOURCES) {
+      DedupEntry &entry = m_dedup_entries[key];
+      entry.sequence = packet.sequence;
+      entry.timestamp = *m_ss->WakeUpTime();
+    }
+  }
+
   for (unsigned int port_id = 0; port_id < ARTNET_MAX_PORTS; port_id++) {
     if (m_output_ports[port_id].enabled &&
         m_output_ports[port_id].universe_address == universe_id &&
         m_output_ports[port_id].on_data &&
         m_output_ports[port_id].buffer) {
-      // update this port, doing a merge if necessary
-      DMXSource source;
-      source.address = source_address;
-      source.timestamp = *m_ss->WakeUpTime();
-      source.buffer.Set(packet.data, data_size);
-      UpdatePortFromSource(&m_output_ports[port_id], source);
+      // update this port, doing a merge if necessary. The slot data is
+      // copied straight into the tracked source's buffer, so no per-packet
+      // DmxBuffer is constructed.
+      UpdatePortFromSource(&m_output_ports[port_id], source_address,
+                           *m_ss->WakeUpTime(), packet.data, data_size);
     }
   }
 }
@@ -1295,11 +1444,16 @@ void ArtNetNodeImpl::HandleRDMResponse(InputPort *port,
   if (!response.get())
     return;
 
-  if (!port->pending_request) {
+  // find the transaction for this node; requests broadcast because the
+  // UID wasn't in the map are tracked against the broadcast address
+  map<IPV4Address, InputPort::PendingRDMTransaction>::iterator
+      transaction_iter = port->pending_rdm.find(source_address);
+  if (transaction_iter == port->pending_rdm.end())
+    transaction_iter = port->pending_rdm.find(m_interface.bcast_address);
+  if (transaction_iter == port->pending_rdm.end())
     return;
-  }
 
-  const RDMRequest *request = port->pending_request;
+  const RDMRequest *request = transaction_iter->second.request;
   if (request->SourceUID() != response->DestinationUID() ||
       request->DestinationUID() != response->SourceUID()) {
     OLA_INFO << "Got response from/to unexpected UID: req "
@@ -1341,26 +1495,15 @@ void ArtNetNodeImpl::HandleRDMResponse(InputPort *port,
     return;
   }
 
-  if (port->rdm_ip_destination != m_interface.bcast_address &&
-      port->rdm_ip_destination != source_address) {
-    OLA_INFO << "IP address of RDM response didn't match";
-    return;
-  }
-
   // at this point we've decided it's for us
-  port->pending_request = NULL;
   delete request;
-  ola::rdm::RDMCallback *callback = port->rdm_request_callback;
-  port->rdm_request_callback = NULL;
+  ola::rdm::RDMCallback *callback = transaction_iter->second.callback;
+  if (transaction_iter->second.timeout != ola::thread::INVALID_TIMEOUT)
+    m_ss->RemoveTimeout(transaction_iter->second.timeout);
+  port->pending_rdm.erase(transaction_iter);
+
   vector<string> packets;
   packets.push_back(response_data);
-
-  // remove the timeout
-  if (port->rdm_send_timeout != ola::thread::INVALID_TIMEOUT) {
-    m_ss->RemoveTimeout(port->rdm_send_timeout);
-    port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-  }
-
   callback->Run(ola::rdm::RDM_COMPLETED_OK, response.release(), packets);
 }
 
@@ -1396,18 +1539,27 @@ bool ArtNetNodeImpl::SendPacket(const artnet_packet &packet,
 
   if (bytes_sent != size) {
     OLA_INFO << "Only sent " << bytes_sent << " of " << size;
+    if (STLContains(m_node_stats, ip_destination) ||
+        m_node_stats.size() < MAX_TRACKED_SOURCES) {
+      NodeStats &node_stats = m_node_stats[ip_destination];
+      node_stats.ip_address = ip_destination;
+      node_stats.send_failures++;
+    }
     return false;
   }
   return true;
 }
 
-void ArtNetNodeImpl::TimeoutRDMRequest(InputPort *port) {
-  OLA_INFO << "RDM Request timed out.";
-  port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-  delete port->pending_request;
-  port->pending_request = NULL;
-  ola::rdm::RDMCallback *callback = port->rdm_request_callback;
-  port->rdm_request_callback = NULL;
+void ArtNetNodeImpl::TimeoutRDMRequest(InputPort *port,
+                                       IPV4Address ip_destination) {
+  OLA_INFO << "RDM Request to " << ip_destination << " timed out.";
+  map<IPV4Address, InputPort::PendingRDMTransaction>::iterator iter =
+      port->pending_rdm.find(ip_destination);
+  if (iter == port->pending_rdm.end())
+    return;
+  delete iter->second.request;
+  ola::rdm::RDMCallback *callback = iter->second.callback;
+  port->pending_rdm.erase(iter);
   vector<string> packets;
   callback->Run(ola::rdm::RDM_TIMEOUT, NULL, packets);
 }
@@ -1433,7 +1585,10 @@ bool ArtNetNodeImpl::SendRDMCommand(const RDMCommand &command,
 }
 
 void ArtNetNodeImpl::UpdatePortFromSource(OutputPort *port,
-                                          const DMXSource &source) {
+                                          const IPV4Address &source_address,
+                                          const TimeStamp &timestamp,
+                                          const uint8_t *data,
+                                          unsigned int length) {
   TimeStamp merge_time_threshold = (
       *m_ss->WakeUpTime() - TimeInterval(MERGE_TIMEOUT, 0));
   // the index of the first empty slot, of MAX_MERGE_SOURCES if we're already
@@ -1447,7 +1602,7 @@ void ArtNetNodeImpl::UpdatePortFromSource(OutputPort *port,
   // empty source location in case this source is new, and timeout any sources
   // we haven't heard from.
   for (unsigned int i = 0; i < MAX_MERGE_SOURCES; i++) {
-    if (port->sources[i].address == source.address) {
+    if (port->sources[i].address == source_address) {
       source_slot = i;
       continue;
     }
@@ -1482,19 +1637,24 @@ void ArtNetNodeImpl::UpdatePortFromSource(OutputPort *port,
     port->is_merging = false;
   }
 
-  port->sources[source_slot] = source;
+  // update the tracked source in place, reusing its buffer's backing
+  port->sources[source_slot].address = source_address;
+  port->sources[source_slot].timestamp = timestamp;
+  port->sources[source_slot].buffer.Set(data, length);
 
-  // Now we need to merge
+  // Now we need to merge. The port buffer takes a full copy rather than a
+  // copy-on-write share, so the tracked source's backing is never shared
+  // and the next frame's Set() reuses it in place.
   if (port->merge_mode == ARTNET_MERGE_LTP) {
     // the current source is the latest
-    (*port->buffer) = source.buffer;
+    port->buffer->Set(port->sources[source_slot].buffer);
   } else {
     // HTP merge
     bool first = true;
     for (unsigned int i = 0; i < MAX_MERGE_SOURCES; i++) {
       if (!port->sources[i].address.IsWildcard()) {
         if (first) {
-          (*port->buffer) = port->sources[i].buffer;
+          port->buffer->Set(port->sources[i].buffer);
           first = false;
         } else {
           port->buffer->HTPMerge(port->sources[i].buffer);
@@ -1502,7 +1662,65 @@ void ArtNetNodeImpl::UpdatePortFromSource(OutputPort *port,
       }
     }
   }
-  port->on_data->Run();
+  if (InSynchronousMode()) {
+    // ArtSync gated: hold the frame until the sync arrives
+    port->pending_sync_data = true;
+  } else {
+    port->on_data->Run();
+  }
+}
+
+
+/*
+ * True if a controller is gating our output with ArtSync. Synchronous
+ * mode lapses if no sync arrives for SYNC_MODE_TIMEOUT seconds, per the
+ * Art-Net 4 spec.
+ */
+bool ArtNetNodeImpl::InSynchronousMode() const {
+  return m_last_sync_seen.IsSet() &&
+      *m_ss->WakeUpTime() - m_last_sync_seen <
+          TimeInterval(SYNC_MODE_TIMEOUT, 0);
+}
+
+
+/*
+ * An ArtSync arrived; commit all the latched frames and (re)enter
+ * synchronous mode.
+ */
+void ArtNetNodeImpl::HandleSyncPacket(const IPV4Address &source_address,
+                                      const artnet_sync_t &packet,
+                                      unsigned int packet_size) {
+  if (!CheckPacketSize(source_address, "ArtSync", packet_size,
+                       sizeof(packet)))
+    return;
+  if (!CheckPacketVersion(source_address, "ArtSync", packet.version))
+    return;
+
+  m_last_sync_seen = *m_ss->WakeUpTime();
+  for (unsigned int i = 0; i < ARTNET_MAX_PORTS; i++) {
+    if (m_output_ports[i].pending_sync_data && m_output_ports[i].on_data) {
+      m_output_ports[i].pending_sync_data = false;
+      m_output_ports[i].on_data->Run();
+    }
+  }
+}
+
+
+/*
+ * Send an ArtSync, committing the frames of a batched multi-universe
+ * transmit on the receivers.
+ */
+bool ArtNetNodeImpl::SendSync() {
+  if (!m_running)
+    return false;
+  artnet_packet packet;
+  PopulatePacketHeader(&packet, ARTNET_SYNC);
+  memset(&packet.data.sync, 0, sizeof(packet.data.sync));
+  packet.data.sync.version = HostToNetwork(ARTNET_VERSION);
+  return SendPacket(
+      packet, sizeof(packet.data.sync),
+      m_use_limited_broadcast_address ?
+      IPV4Address::Broadcast() : m_interface.bcast_address);
 }
 
 bool ArtNetNodeImpl::CheckPacketVersion(const IPV4Address &source_address,
@@ -255,6 +255,12 @@ class ArtNetNodeImpl {
    */
   bool SendDMX(uint8_t port_id, const ola::DmxBuffer &buffer);
 
+  /**
+   * @brief Send an ArtSync, committing frames on receivers operating in
+   * synchronous mode. Call after a batched multi-universe transmit.
+   */
+  bool SendSync();
+
   /**
    * @brief Flush the TOD and force a full discovery.
    *
@@ -375,6 +381,8 @@ class ArtNetNodeImpl {
     bool enabled;
     artnet_merge_mode merge_mode;
     bool is_merging;
+    // a frame is latched waiting for ArtSync
+    bool pending_sync_data;
     DMXSource sources[MAX_MERGE_SOURCES];
     DmxBuffer *buffer;
     std::map<ola::rdm::UID, ola::network::IPV4Address> uid_map;
@@ -387,6 +395,31 @@ class ArtNetNodeImpl {
   };
 
   bool m_running;
+  // the last time we saw an ArtSync, unset if never
+  TimeStamp m_last_sync_seen;
+  // bitmap of the universe addresses our enabled output ports listen to
+  uint8_t m_patched_universes[256 / 8];
+  uint64_t m_storm_discards;
+
+ public:
+  /**
+   * @brief Health & throughput stats for a peer node.
+   */
+  struct NodeStats {
+    ola::network::IPV4Address ip_address;
+    uint64_t packets_received;
+    TimeStamp last_seen;
+    uint64_t send_failures;
+    NodeStats() : packets_received(0), send_failures(0) {}
+  };
+
+  /**
+   * @brief Get the stats for all the peers we've heard from or sent to.
+   */
+  void GetNodeStats(std::vector<NodeStats> *stats) const;
+
+ private:
+  std::map<ola::network::IPV4Address, NodeStats> m_node_stats;
   uint8_t m_net_address;  // this is the 'net' portion of the Artnet address
   bool m_send_reply_on_change;
   std::string m_short_name;
@@ -401,6 +434,21 @@ class ArtNetNodeImpl {
   bool m_in_configuration_mode;
   bool m_artpoll_required;
   bool m_artpollreply_required;
+  // cached ArtPollReply image, rebuilt when config changes
+  artnet_packet m_poll_reply_packet;
+  bool m_poll_reply_dirty;
+  // ArtDmx dedup state for looped networks
+  typedef std::pair<ola::network::IPV4Address, uint16_t> DedupKey;
+  struct DedupEntry {
+    uint8_t sequence;
+    TimeStamp timestamp;
+  };
+  std::map<DedupKey, DedupEntry> m_dedup_entries;
+  uint64_t m_duplicate_frames;
+
+  static const unsigned int DEDUP_WINDOW_USECS = 1000000;  // 1s
+  // bound on the per-source maps; beyond this new sources aren't tracked
+  static const unsigned int MAX_TRACKED_SOURCES = 512;
 
   InputPorts m_input_ports;
   OutputPort m_output_ports[ARTNET_MAX_PORTS];
@@ -543,7 +591,8 @@ class ArtNetNodeImpl {
    * @brief Timeout a pending RDM request
    * @param port the id of the port to timeout.
    */
-  void TimeoutRDMRequest(InputPort *port);
+  void TimeoutRDMRequest(InputPort *port,
+                         ola::network::IPV4Address ip_destination);
 
   /**
    * @brief Send a generic ArtRdm message
@@ -555,7 +604,25 @@ class ArtNetNodeImpl {
   /**
    * @brief Update a port from a source, merging if necessary
    */
-  void UpdatePortFromSource(OutputPort *port, const DMXSource &source);
+  void RebuildPollReply();
+  bool InSynchronousMode() const;
+  void RebuildPatchedUniverseBitmap();
+  void HandleSyncPacket(const ola::network::IPV4Address &source_address,
+                        const artnet_sync_t &packet,
+                        unsigned int packet_size);
+
+ public:
+  /**
+   * @brief The number of duplicate ArtDmx frames suppressed.
+   */
+  uint64_t DuplicateFramesSuppressed() const { return m_duplicate_frames; }
+
+ private:
+  void UpdatePortFromSource(OutputPort *port,
+                            const ola::network::IPV4Address &source_address,
+                            const TimeStamp &timestamp,
+                            const uint8_t *data,
+                            unsigned int length);
 
   /**
    * @brief Check the version number of a incoming packet
@@ -643,6 +710,10 @@ class ArtNetNodeImpl {
   static const unsigned int MERGE_TIMEOUT = 10;  // As per the spec
   // seconds after which a node is marked as inactive for the dmx merging
   static const unsigned int NODE_TIMEOUT = 31;
+  // synchronous mode lapses after this many seconds without an ArtSync
+  static const unsigned int SYNC_MODE_TIMEOUT = 4;
+  // warn every N discards during a storm (must be a power of 2)
+  static const unsigned int STORM_WARN_INTERVAL = 4096;
   // mseconds we wait for a TodData packet before declaring a node missing
   static const unsigned int RDM_TOD_TIMEOUT_MS = 4000;
   // Number of missed TODs before we decide a UID has gone
@@ -752,6 +823,8 @@ class ArtNetNode {
     return m_impl.InputPortState(port_id);
   }
 
+  bool SendSync() { return m_impl.SendSync(); }
+
   bool SetOutputPortUniverse(uint8_t port_id, uint8_t universe_id) {
     return m_impl.SetOutputPortUniverse(port_id, universe_id);
   }
@@ -811,6 +884,10 @@ class ArtNetNode {
       ola::Callback1<void, const ola::rdm::UIDSet&> *on_tod) {
     return m_impl.SetUnsolicitedUIDSetHandler(port_id, on_tod);
   }
+  void GetNodeStats(std::vector<ArtNetNodeImpl::NodeStats> *stats) const {
+    m_impl.GetNodeStats(stats);
+  }
+
   void GetSubscribedNodes(
       uint8_t port_id,
       std::vector<ola::network::IPV4Address> *node_addresses) {
@@ -19,10 +19,14 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "ola/Callback.h"
+#include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/base/Flags.h"
@@ -46,17 +50,139 @@ using std::min;
 DEFINE_s_uint32(fps, f, 10, "Frames per second per universe [1 - 1000]");
 DEFINE_s_uint16(universes, u, 1, "Number of universes to send");
 DEFINE_string(iface, "", "The interface to send from");
+DEFINE_uint32(entropy, 0,
+              "The number of random slots to change each frame, 0 means the "
+              "whole frame changes");
+DEFINE_uint32(burst, 0,
+              "Every second, send this many extra frames back-to-back to "
+              "simulate console bursts");
+DEFINE_uint32(duplicate_pct, 0,
+              "The percentage of frames to send twice, for testing dedup "
+              "[0 - 100]");
+DEFINE_default_bool(receive, false,
+                    "Also receive the universes and report latency "
+                    "percentiles; frames must come from a loadtest sender "
+                    "on a clock-synced host");
 
 /**
- * Send N DMX frames using ArtNet, where N is given by number_of_universes.
+ * Drives the load: per-tick frame generation with configurable entropy,
+ * periodic bursts and duplicate injection, plus optional receive-side
+ * latency accounting. The first 8 slots of each frame carry the send
+ * timestamp in usecs so the receiver can compute one-way latency.
  */
-bool SendFrames(ArtNetNode *node, DmxBuffer *buffer,
-                uint16_t number_of_universes) {
-  for (uint16_t i = 0; i < number_of_universes; i++) {
-    node->SendDMX(i, *buffer);
+class LoadTester {
+ public:
+  LoadTester(ArtNetNode *node, uint16_t number_of_universes)
+      : m_node(node),
+        m_universes(number_of_universes),
+        m_frames_sent(0),
+        m_frames_received(0),
+        m_ticks(0) {
+    m_buffer.Blackout();
+  }
+
+  bool Tick() {
+    m_ticks++;
+    SendAll();
+
+    if (FLAGS_burst && (m_ticks % TicksPerSecond()) == 0) {
+      for (unsigned int i = 0; i < FLAGS_burst; i++) {
+        SendAll();
+      }
+    }
+    return true;
+  }
+
+  void FrameReceived(uint16_t universe) {
+    m_frames_received++;
+    const DmxBuffer &buffer = m_rx_buffers[universe];
+    if (buffer.Size() < sizeof(uint64_t))
+      return;
+    uint64_t sent_usecs;
+    memcpy(&sent_usecs, buffer.GetRaw(), sizeof(sent_usecs));
+    ola::TimeStamp now;
+    m_clock.CurrentTime(&now);
+    uint64_t now_usecs = static_cast<uint64_t>(now.Seconds()) * 1000000 +
+        now.MicroSeconds();
+    if (now_usecs >= sent_usecs)
+      m_latencies_usecs.push_back(now_usecs - sent_usecs);
   }
-  return true;
-}
+
+  DmxBuffer *RxBuffer(uint16_t universe) { return &m_rx_buffers[universe]; }
+
+  bool PrintStats() {
+    cout << "tx: " << m_frames_sent << " frames";
+    if (FLAGS_receive) {
+      cout << ", rx: " << m_frames_received << " frames";
+      if (!m_latencies_usecs.empty()) {
+        std::sort(m_latencies_usecs.begin(), m_latencies_usecs.end());
+        cout << ", latency p50/p90/p99/max (us): "
+             << Percentile(50) << "/" << Percentile(90) << "/"
+             << Percentile(99) << "/" << m_latencies_usecs.back();
+      }
+      m_latencies_usecs.clear();
+    }
+    cout << endl;
+    return true;
+  }
+
+ private:
+  ArtNetNode *m_node;
+  const uint16_t m_universes;
+  DmxBuffer m_buffer;
+  std::map<uint16_t, DmxBuffer> m_rx_buffers;
+  ola::Clock m_clock;
+  uint64_t m_frames_sent;
+  uint64_t m_frames_received;
+  uint64_t m_ticks;
+  std::vector<uint64_t> m_latencies_usecs;
+
+  unsigned int TicksPerSecond() const {
+    return std::max(1u, std::min(1000u,
+                    static_cast<unsigned int>(FLAGS_fps)));
+  }
+
+  void SendAll() {
+    MutateFrame();
+    for (uint16_t i = 0; i < m_universes; i++) {
+      m_node->SendDMX(i, m_buffer);
+      m_frames_sent++;
+      if (FLAGS_duplicate_pct &&
+          static_cast<uint32_t>(random() % 100) < FLAGS_duplicate_pct) {
+        m_node->SendDMX(i, m_buffer);
+        m_frames_sent++;
+      }
+    }
+  }
+
+  void MutateFrame() {
+    if (FLAGS_entropy) {
+      for (unsigned int i = 0; i < FLAGS_entropy; i++) {
+        m_buffer.SetChannel(
+            sizeof(uint64_t) + (random() % (ola::DMX_UNIVERSE_SIZE -
+                                            sizeof(uint64_t))),
+            static_cast<uint8_t>(random()));
+      }
+    } else {
+      m_buffer.SetRangeToValue(sizeof(uint64_t),
+                               static_cast<uint8_t>(m_ticks),
+                               ola::DMX_UNIVERSE_SIZE - sizeof(uint64_t));
+    }
+    // stamp the send time into the first 8 slots
+    ola::TimeStamp now;
+    m_clock.CurrentTime(&now);
+    uint64_t now_usecs = static_cast<uint64_t>(now.Seconds()) * 1000000 +
+        now.MicroSeconds();
+    uint8_t stamp[sizeof(now_usecs)];
+    memcpy(stamp, &now_usecs, sizeof(now_usecs));
+    m_buffer.SetRange(0, stamp, sizeof(stamp));
+  }
+
+  uint64_t Percentile(unsigned int pct) const {
+    return m_latencies_usecs[
+        (m_latencies_usecs.size() - 1) * pct / 100];
+  }
+};
 
 int main(int argc, char* argv[]) {
   ola::AppInit(&argc, argv, "", "Run the E1.31 load test.");
@@ -67,9 +193,6 @@ int main(int argc, char* argv[]) {
   unsigned int fps = min(1000u, static_cast<unsigned int>(FLAGS_fps));
   uint16_t universes = FLAGS_universes;
 
-  DmxBuffer output;
-  output.Blackout();
-
   Interface iface;
   {
     auto_ptr<InterfacePicker> picker(InterfacePicker::NewPicker());
@@ -84,11 +207,19 @@ int main(int argc, char* argv[]) {
 
   SelectServer ss;
   ArtNetNode node(iface, &ss, options);
+  LoadTester tester(&node, universes);
 
   for (uint16_t i = 0; i < universes; i++) {
     if (!node.SetInputPortUniverse(i, i)) {
       OLA_WARN << "Failed to set port";
     }
+    if (FLAGS_receive) {
+      uint8_t rx_port = static_cast<uint8_t>(i % 4);
+      node.SetOutputPortUniverse(rx_port, i);
+      node.SetDMXHandler(
+          rx_port, tester.RxBuffer(i),
+          NewCallback(&tester, &LoadTester::FrameReceived, i));
+    }
   }
 
   if (!node.Start())
@@ -96,8 +227,12 @@ int main(int argc, char* argv[]) {
 
   ss.RegisterRepeatingTimeout(
       1000 / fps,
-      NewCallback(&SendFrames, &node, &output, universes));
+      NewCallback(&tester, &LoadTester::Tick));
+  ss.RegisterRepeatingTimeout(
+      1000,
+      NewCallback(&tester, &LoadTester::PrintStats));
   cout << "Starting loadtester: " << universes << " universe(s), " << fps
-       << " fps" << endl;
+       << " fps, entropy " << FLAGS_entropy << ", burst " << FLAGS_burst
+       << ", dup " << FLAGS_duplicate_pct << "%" << endl;
   ss.Run();
 }
@@ -64,6 +64,7 @@ E131Device::E131Device(Plugin *owner,
       m_options(options),
       m_ip_addr(ip_addr),
       m_cid(cid) {
+  m_stats_timeout = ola::thread::INVALID_TIMEOUT;
 }
 
 
@@ -98,6 +99,18 @@ bool E131Device::StartHook() {
   }
 
   m_plugin_adaptor->AddReadDescriptor(m_node->GetSocket());
+  // publish the ingest stats so ola_mon can scrape loss & reordering
+  m_stats_timeout = m_plugin_adaptor->RegisterRepeatingTimeout(
+      STATS_EXPORT_INTERVAL_MS,
+      ola::NewCallback(this, &E131Device::ExportIngestStats));
+  {
+    const std::vector<ola::network::UDPSocket*> &extra_sockets =
+        m_node->ExtraReceiveSockets();
+    std::vector<ola::network::UDPSocket*>::const_iterator iter =
+        extra_sockets.begin();
+    for (; iter != extra_sockets.end(); ++iter)
+      m_plugin_adaptor->AddReadDescriptor(*iter);
+  }
   return true;
 }
 
@@ -106,7 +119,19 @@ bool E131Device::StartHook() {
  * Stop this device
  */
 void E131Device::PrePortStop() {
+  if (m_stats_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_plugin_adaptor->RemoveTimeout(m_stats_timeout);
+    m_stats_timeout = ola::thread::INVALID_TIMEOUT;
+  }
   m_plugin_adaptor->RemoveReadDescriptor(m_node->GetSocket());
+  {
+    const std::vector<ola::network::UDPSocket*> &extra_sockets =
+        m_node->ExtraReceiveSockets();
+    std::vector<ola::network::UDPSocket*>::const_iterator iter =
+        extra_sockets.begin();
+    for (; iter != extra_sockets.end(); ++iter)
+      m_plugin_adaptor->RemoveReadDescriptor(*iter);
+  }
 }
 
 
@@ -247,6 +272,27 @@ E131InputPort *E131Device::GetE131InputPort(unsigned int port_id) {
 E131OutputPort *E131Device::GetE131OutputPort(unsigned int port_id) {
   return (port_id < m_output_ports.size()) ? m_output_ports[port_id] : NULL;
 }
+
+/*
+ * Copy the inflator's ingest counters into the ExportMap.
+ */
+bool E131Device::ExportIngestStats() {
+  ola::ExportMap *export_map = m_plugin_adaptor->GetExportMap();
+  if (!export_map)
+    return true;
+  const ola::plugin::e131::DMPE131Inflator::IngestStats &stats =
+      m_node->GetIngestStats();
+  export_map->GetIntegerVar("e131-rx-frames")->Set(
+      static_cast<int>(stats.frames));
+  export_map->GetIntegerVar("e131-rx-sequence-gaps")->Set(
+      static_cast<int>(stats.sequence_gaps));
+  export_map->GetIntegerVar("e131-rx-out-of-order")->Set(
+      static_cast<int>(stats.out_of_order));
+  export_map->GetIntegerVar("e131-rx-unjoined")->Set(
+      static_cast<int>(stats.unjoined_frames));
+  return true;
+}
+
 }  // namespace e131
 }  // namespace plugin
 }  // namespace ola
@@ -73,6 +73,11 @@ class E131Device: public ola::Device {
   class PluginAdaptor *m_plugin_adaptor;
   std::auto_ptr<E131Node> m_node;
   const E131DeviceOptions m_options;
+  ola::thread::timeout_id m_stats_timeout;
+
+  bool ExportIngestStats();
+
+  static const unsigned int STATS_EXPORT_INTERVAL_MS = 10000;
   std::vector<E131InputPort*> m_input_ports;
   std::vector<E131OutputPort*> m_output_ports;
   std::string m_ip_addr;
@@ -42,6 +42,7 @@ const char E131Plugin::DEFAULT_DSCP_VALUE[] = "0";
 const char E131Plugin::DSCP_KEY[] = "dscp";
 const char E131Plugin::DRAFT_DISCOVERY_KEY[] = "draft_discovery";
 const char E131Plugin::IGNORE_PREVIEW_DATA_KEY[] = "ignore_preview";
+const char E131Plugin::RECEIVE_SOCKETS_KEY[] = "receive_sockets";
 const char E131Plugin::INPUT_PORT_COUNT_KEY[] = "input_ports";
 const char E131Plugin::IP_KEY[] = "ip";
 const char E131Plugin::OUTPUT_PORT_COUNT_KEY[] = "output_ports";
@@ -65,6 +66,11 @@ bool E131Plugin::StartHook() {
   options.use_rev2 = (m_preferences->GetValue(REVISION_KEY) == REVISION_0_2);
   options.ignore_preview = m_preferences->GetValueAsBool(
       IGNORE_PREVIEW_DATA_KEY);
+  unsigned int receive_sockets;
+  if (StringToInt(m_preferences->GetValue(RECEIVE_SOCKETS_KEY),
+                  &receive_sockets) && receive_sockets > 0) {
+    options.receive_socket_count = receive_sockets;
+  }
   options.enable_draft_discovery = m_preferences->GetValueAsBool(
       DRAFT_DISCOVERY_KEY);
   if (m_preferences->GetValueAsBool(PREPEND_HOSTNAME_KEY)) {
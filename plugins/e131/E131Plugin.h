@@ -53,6 +53,7 @@ class E131Plugin: public ola::Plugin {
     static const char DRAFT_DISCOVERY_KEY[];
     static const char DSCP_KEY[];
     static const char IGNORE_PREVIEW_DATA_KEY[];
+    static const char RECEIVE_SOCKETS_KEY[];
     static const char INPUT_PORT_COUNT_KEY[];
     static const char IP_KEY[];
     static const char OUTPUT_PORT_COUNT_KEY[];
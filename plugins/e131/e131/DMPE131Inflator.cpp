@@ -24,6 +24,7 @@
 #include <memory>
 #include <vector>
 #include "ola/Logging.h"
+#include "ola/network/NetworkUtils.h"
 #include "plugins/e131/e131/DMPE131Inflator.h"
 #include "plugins/e131/e131/DMPHeader.h"
 #include "plugins/e131/e131/DMPPDU.h"
@@ -34,6 +35,7 @@ namespace e131 {
 
 using ola::Callback0;
 using ola::acn::CID;
+using ola::network::NetworkToHost;
 using ola::io::OutputStream;
 using std::map;
 using std::pair;
@@ -59,21 +61,24 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
                                     const uint8_t *data,
                                     unsigned int pdu_len) {
   if (vector != ola::acn::DMP_SET_PROPERTY_VECTOR) {
-    OLA_INFO << "not a set property msg: " << vector;
+    OLA_INFO_RATE_LIMITED << "not a set property msg: " << vector;
     return true;
   }
 
   E131Header e131_header = headers.GetE131Header();
-  UniverseHandlers::iterator universe_iter =
-      m_handlers.find(e131_header.Universe());
+  universe_handler *handler =
+      e131_header.Universe() < m_handler_index.size() ?
+      m_handler_index[e131_header.Universe()] : NULL;
 
   if (e131_header.PreviewData() && m_ignore_preview) {
     OLA_DEBUG << "Ignoring preview data";
     return true;
   }
 
-  if (universe_iter == m_handlers.end())
+  if (!handler) {
+    m_stats.unjoined_frames++;
     return true;
+  }
 
   DMPHeader dmp_header = headers.GetDMPHeader();
 
@@ -91,20 +96,23 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
     return true;
   }
 
-  unsigned int available_length = pdu_len;
-  std::auto_ptr<const BaseDMPAddress> address(
-      DecodeAddress(dmp_header.Size(),
-                    dmp_header.Type(),
-                    data,
-                    &available_length));
-
-  if (!address.get()) {
+  // The header was validated above as a two-byte, range-equal virtual
+  // address, so decode the (start, increment, count) triple in place
+  // rather than heap allocating a DMP address object per packet.
+  uint16_t address_fields[3];
+  if (pdu_len < sizeof(address_fields)) {
     OLA_INFO << "DMP address parsing failed, the length is probably too small";
     return true;
   }
-
-  if (address->Increment() != 1) {
-    OLA_INFO << "E1.31 DMP packet with increment " << address->Increment()
+  // memcpy to avoid word alignment issues on ARM
+  memcpy(address_fields, data, sizeof(address_fields));
+  const uint16_t address_start = NetworkToHost(address_fields[0]);
+  const uint16_t address_increment = NetworkToHost(address_fields[1]);
+  const uint16_t address_count = NetworkToHost(address_fields[2]);
+  unsigned int available_length = sizeof(address_fields);
+
+  if (address_increment != 1) {
+    OLA_INFO << "E1.31 DMP packet with increment " << address_increment
       << ", disarding";
     return true;
   }
@@ -112,54 +120,64 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
   unsigned int length_remaining = pdu_len - available_length;
   int start_code = -1;
   if (e131_header.UsingRev2())
-    start_code = static_cast<int>(address->Start());
-  else if (length_remaining && address->Number())
+    start_code = static_cast<int>(address_start);
+  else if (length_remaining && address_count)
     start_code = *(data + available_length);
 
   // The only time we want to continue processing a non-0 start code is if it
   // contains a Terminate message.
   if (start_code && !e131_header.StreamTerminated()) {
-    OLA_INFO << "Skipping packet with non-0 start code: " << start_code;
+    OLA_INFO_RATE_LIMITED << "Skipping packet with non-0 start code: "
+                          << start_code;
     return true;
   }
 
   DmxBuffer *target_buffer;
-  if (!TrackSourceIfRequired(&universe_iter->second, headers,
-                             &target_buffer)) {
+  if (!TrackSourceIfRequired(handler, headers, &target_buffer)) {
     // no need to continue processing
     return true;
   }
 
   // Reaching here means that we actually have new data and we should merge.
   if (target_buffer && start_code == 0) {
-    unsigned int channels = std::min(length_remaining, address->Number());
+    unsigned int channels = std::min(
+        length_remaining, static_cast<unsigned int>(address_count));
     if (e131_header.UsingRev2())
       target_buffer->Set(data + available_length, channels);
     else
      target_buffer->Set(data + available_length + 1, channels - 1);
   }
 
-  if (universe_iter->second.priority)
-    *universe_iter->second.priority = universe_iter->second.active_priority;
+  if (handler->priority)
+    *handler->priority = handler->active_priority;
+
+  // If the source asked for synchronization, latch the merged frame and
+  // defer the handler until the sync packet arrives.
+  bool latch = e131_header.SyncAddress() != 0;
+  if (latch) {
+    m_pending_sync[e131_header.SyncAddress()].insert(
+        e131_header.Universe());
+  }
 
   // merge the sources
-  switch (universe_iter->second.sources.size()) {
+  switch (handler->sources.size()) {
     case 0:
-      universe_iter->second.buffer->Reset();
+      handler->buffer->Reset();
       break;
     case 1:
-      universe_iter->second.buffer->Set(
-          universe_iter->second.sources[0].buffer);
-      universe_iter->second.closure->Run();
+      handler->buffer->Set(handler->sources[0].buffer);
+      if (!latch)
+        handler->closure->Run();
       break;
     default:
       // HTP Merge
-      universe_iter->second.buffer->Reset();
+      handler->buffer->Reset();
       std::vector<dmx_source>::const_iterator source_iter =
-        universe_iter->second.sources.begin();
-      for (; source_iter != universe_iter->second.sources.end(); ++source_iter)
-        universe_iter->second.buffer->HTPMerge(source_iter->buffer);
-      universe_iter->second.closure->Run();
+        handler->sources.begin();
+      for (; source_iter != handler->sources.end(); ++source_iter)
+        handler->buffer->HTPMerge(source_iter->buffer);
+      if (!latch)
+        handler->closure->Run();
   }
   return true;
 }
@@ -172,6 +190,28 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
  * @param handler the Callback0 to call when there is data for this universe.
  * Ownership of the closure is transferred to the node.
  */
+/*
+ * A sync packet arrived; run the handlers for every universe latched
+ * against its sync address, applying the whole set back to back.
+ */
+void DMPE131Inflator::HandleSync(uint16_t sync_address) {
+  std::map<uint16_t, std::set<uint16_t> >::iterator iter =
+      m_pending_sync.find(sync_address);
+  if (iter == m_pending_sync.end())
+    return;
+
+  std::set<uint16_t>::iterator universe_iter = iter->second.begin();
+  for (; universe_iter != iter->second.end(); ++universe_iter) {
+    universe_handler *handler =
+        *universe_iter < m_handler_index.size() ?
+        m_handler_index[*universe_iter] : NULL;
+    if (handler)
+      handler->closure->Run();
+  }
+  m_pending_sync.erase(iter);
+}
+
+
 bool DMPE131Inflator::SetHandler(uint16_t universe,
                                  ola::DmxBuffer *buffer,
                                  uint8_t *priority,
@@ -188,6 +228,9 @@ bool DMPE131Inflator::SetHandler(uint16_t universe,
     handler.active_priority = 0;
     handler.priority = priority;
     m_handlers[universe] = handler;
+    if (universe >= m_handler_index.size())
+      m_handler_index.resize(universe + 1, NULL);
+    m_handler_index[universe] = &m_handlers[universe];
   } else {
     Callback0<void> *old_closure = iter->second.closure;
     iter->second.closure = closure;
@@ -209,6 +252,8 @@ bool DMPE131Inflator::RemoveHandler(uint16_t universe) {
 
   if (iter != m_handlers.end()) {
     Callback0<void> *old_closure = iter->second.closure;
+    if (universe < m_handler_index.size())
+      m_handler_index[universe] = NULL;
     m_handlers.erase(iter);
     delete old_closure;
     return true;
@@ -302,6 +347,10 @@ bool DMPE131Inflator::TrackSourceIfRequired(
       new_source.cid = headers.GetRootHeader().GetCid();
       new_source.sequence = e131_header.Sequence();
       new_source.last_heard_from = now;
+      new_source.frames = 1;
+      new_source.sequence_gaps = 0;
+      new_source.out_of_order = 0;
+      m_stats.frames++;
       iter = sources.insert(sources.end(), new_source);
       *buffer = &iter->buffer;
       return true;
@@ -312,11 +361,19 @@ bool DMPE131Inflator::TrackSourceIfRequired(
     int8_t seq_diff = static_cast<int8_t>(e131_header.Sequence() -
                                           iter->sequence);
     if (seq_diff <= 0 && seq_diff > SEQUENCE_DIFF_THRESHOLD) {
+      iter->out_of_order++;
+      m_stats.out_of_order++;
       OLA_INFO << "Old packet received, ignoring, this # " <<
         static_cast<int>(e131_header.Sequence()) << ", last " <<
         static_cast<int>(iter->sequence);
       return false;
     }
+    if (seq_diff > 1) {
+      iter->sequence_gaps++;
+      m_stats.sequence_gaps++;
+    }
+    iter->frames++;
+    m_stats.frames++;
     iter->sequence = e131_header.Sequence();
 
     if (e131_header.StreamTerminated()) {
@@ -23,6 +23,7 @@
 #define PLUGINS_E131_E131_DMPE131INFLATOR_H_
 
 #include <map>
+#include <set>
 #include <vector>
 #include "ola/Clock.h"
 #include "ola/Callback.h"
@@ -43,6 +44,32 @@ class DMPE131Inflator: public DMPInflator {
     }
     ~DMPE131Inflator();
 
+    /**
+     * Apply the frames latched against this sync address; wired to the
+     * E131Inflator's sync handler.
+     */
+    void HandleSync(uint16_t sync_address);
+
+    /**
+     * Aggregate ingest statistics, cheap enough to sample per packet.
+     */
+    struct IngestStats {
+      uint64_t frames;
+      uint64_t sequence_gaps;
+      uint64_t out_of_order;
+      // frames received for universes with no handler, e.g. during the
+      // lazy multicast leave window
+      uint64_t unjoined_frames;
+      IngestStats()
+          : frames(0), sequence_gaps(0), out_of_order(0),
+            unjoined_frames(0) {}
+    };
+
+    /**
+     * The totals across all universes & sources.
+     */
+    const IngestStats &GetIngestStats() const { return m_stats; }
+
     bool SetHandler(uint16_t universe, ola::DmxBuffer *buffer,
                     uint8_t *priority, ola::Callback0<void> *handler);
     bool RemoveHandler(uint16_t universe);
@@ -61,6 +88,10 @@ class DMPE131Inflator: public DMPInflator {
       uint8_t sequence;
       TimeStamp last_heard_from;
       DmxBuffer buffer;
+      // ingest statistics for this source
+      uint64_t frames;
+      uint64_t sequence_gaps;
+      uint64_t out_of_order;
     } dmx_source;
 
     typedef struct {
@@ -74,6 +105,13 @@ class DMPE131Inflator: public DMPInflator {
     typedef std::map<uint16_t, universe_handler> UniverseHandlers;
 
     UniverseHandlers m_handlers;
+    // universe-id indexed pointers into m_handlers, so the per-packet
+    // lookup is one array probe rather than a tree walk
+    std::vector<universe_handler*> m_handler_index;
+    // sync-address -> universes with frames latched waiting for the sync
+    // packet
+    std::map<uint16_t, std::set<uint16_t> > m_pending_sync;
+    IngestStats m_stats;
     bool m_ignore_preview;
     ola::Clock m_clock;
 
@@ -42,6 +42,19 @@ bool E131Inflator::DecodeHeader(HeaderSet *headers,
                                 unsigned int length,
                                 unsigned int *bytes_used) {
   if (data) {
+    // A sync packet's framing layer is just sequence + sync address +
+    // reserved; it's distinguishable from the full data header by length.
+    if (length == SYNC_PDU_HEADER_SIZE) {
+      uint16_t sync_address;
+      memcpy(&sync_address, data + 1, sizeof(sync_address));
+      E131Header header("", 0, data[0], 0, false, false, false,
+                        NetworkToHost(sync_address));
+      m_last_header = header;
+      m_last_header_valid = true;
+      headers->SetE131Header(header);
+      *bytes_used = SYNC_PDU_HEADER_SIZE;
+      return true;
+    }
     // the header bit was set, decode it
     if (length >= sizeof(E131Header::e131_pdu_header)) {
       E131Header::e131_pdu_header raw_header;
@@ -53,7 +66,9 @@ bool E131Inflator::DecodeHeader(HeaderSet *headers,
           raw_header.sequence,
           NetworkToHost(raw_header.universe),
           raw_header.options & E131Header::PREVIEW_DATA_MASK,
-          raw_header.options & E131Header::STREAM_TERMINATED_MASK);
+          raw_header.options & E131Header::STREAM_TERMINATED_MASK,
+          false,
+          NetworkToHost(raw_header.reserved));
       m_last_header = header;
       m_last_header_valid = true;
       headers->SetE131Header(header);
@@ -83,6 +98,32 @@ bool E131Inflator::DecodeHeader(HeaderSet *headers,
  * @param length length of the data
  * @returns true if successful, false otherwise
  */
+/*
+ * Drop preview data before the DMP layer or source tracking runs; the
+ * header bytes have already been decoded so this is a single flag test.
+ */
+bool E131Inflator::PostHeader(uint32_t, const HeaderSet &headers) {
+  return !(m_discard_preview && headers.GetE131Header().PreviewData());
+}
+
+
+/*
+ * Handle PDUs without a child inflator. Sync packets land here since their
+ * framing layer carries no sub PDU.
+ */
+bool E131Inflator::HandlePDUData(uint32_t vector,
+                                 const HeaderSet &headers,
+                                 const uint8_t*,
+                                 unsigned int) {
+  if (vector == ola::acn::VECTOR_E131_SYNC && m_sync_handler.get()) {
+    m_sync_handler->Run(headers.GetE131Header().SyncAddress());
+    return true;
+  }
+  OLA_INFO << "unknown E1.31 PDU vector: " << vector;
+  return true;
+}
+
+
 bool E131InflatorRev2::DecodeHeader(HeaderSet *headers,
                                     const uint8_t *data,
                                     unsigned int length,
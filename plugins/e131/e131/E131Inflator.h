@@ -28,6 +28,9 @@
 #include "plugins/e131/e131/BaseInflator.h"
 #include "plugins/e131/e131/E131Header.h"
 
+#include <memory>
+#include "ola/Callback.h"
+
 namespace ola {
 namespace plugin {
 namespace e131 {
@@ -37,24 +40,51 @@ class E131Inflator: public BaseInflator {
 
  public:
     E131Inflator(): BaseInflator(),
-                    m_last_header_valid(false) {
+                    m_last_header_valid(false),
+                    m_discard_preview(false) {
     }
     ~E131Inflator() {}
 
     uint32_t Id() const { return ola::acn::VECTOR_ROOT_E131; }
 
+    /**
+     * Set the handler to run when a sync packet arrives. Ownership is
+     * transferred.
+     */
+    void SetSyncHandler(ola::Callback1<void, uint16_t> *handler) {
+      m_sync_handler.reset(handler);
+    }
+
+    /**
+     * Discard preview-data packets right after the framing header is
+     * decoded, before the DMP layer or source tracking runs.
+     */
+    void SetDiscardPreview(bool discard) { m_discard_preview = discard; }
+
+    // sequence + sync address + reserved
+    enum { SYNC_PDU_HEADER_SIZE = 5 };
+
  protected:
     bool DecodeHeader(HeaderSet *headers,
                       const uint8_t *data,
                       unsigned int len,
                       unsigned int *bytes_used);
 
+    bool HandlePDUData(uint32_t vector,
+                       const HeaderSet &headers,
+                       const uint8_t *data,
+                       unsigned int pdu_len);
+
+    bool PostHeader(uint32_t vector, const HeaderSet &headers);
+
     void ResetHeaderField() {
       m_last_header_valid = false;
     }
  private:
     E131Header m_last_header;
     bool m_last_header_valid;
+    bool m_discard_preview;
+    std::auto_ptr<ola::Callback1<void, uint16_t> > m_sync_handler;
 };
 
 
@@ -122,6 +122,8 @@ E131Node::E131Node(ola::thread::SchedulerInterface *ss,
       m_discovery_inflator(NewCallback(this, &E131Node::NewDiscoveryPage)),
       m_incoming_udp_transport(&m_socket, &m_root_inflator),
       m_send_buffer(NULL),
+      m_sync_sequence(0),
+      m_discovery_pages_dirty(true),
       m_discovery_timeout(ola::thread::INVALID_TIMEOUT) {
 
 
@@ -135,6 +137,9 @@ E131Node::E131Node(ola::thread::SchedulerInterface *ss,
   m_root_inflator.AddInflator(&m_e131_inflator);
   m_root_inflator.AddInflator(&m_e131_rev2_inflator);
   m_e131_inflator.AddInflator(&m_dmp_inflator);
+  m_e131_inflator.SetSyncHandler(ola::NewCallback(
+      &m_dmp_inflator, &DMPE131Inflator::HandleSync));
+  m_e131_inflator.SetDiscardPreview(options.ignore_preview);
   m_e131_inflator.AddInflator(&m_discovery_inflator);
   m_e131_rev2_inflator.AddInflator(&m_dmp_inflator);
 }
@@ -157,6 +162,8 @@ E131Node::~E131Node() {
     delete[] m_send_buffer;
 
   STLDeleteValues(&m_discovered_sources);
+  STLDeleteElements(&m_extra_transports);
+  STLDeleteElements(&m_extra_sockets);
 }
 
 
@@ -185,6 +192,27 @@ bool E131Node::Start() {
   m_socket.SetOnData(NewCallback(&m_incoming_udp_transport,
                                  &IncomingUDPTransport::Receive));
 
+  // Extra receive sockets; universes are sharded over them so each gets
+  // its own kernel queue. Bind() already sets SO_REUSEPORT when the
+  // platform has it.
+  for (unsigned int i = 1; i < m_options.receive_socket_count; i++) {
+    auto_ptr<ola::network::UDPSocket> shard_socket(
+        new ola::network::UDPSocket());
+    if (!shard_socket->Init() ||
+        !shard_socket->Bind(
+            IPV4SocketAddress(IPV4Address::WildCard(), m_options.port))) {
+      OLA_WARN << "Failed to set up receive socket shard " << i;
+      continue;
+    }
+    shard_socket->SetMulticastInterface(m_interface.ip_address);
+    IncomingUDPTransport *transport = new IncomingUDPTransport(
+        shard_socket.get(), &m_root_inflator);
+    shard_socket->SetOnData(
+        NewCallback(transport, &IncomingUDPTransport::Receive));
+    m_extra_transports.push_back(transport);
+    m_extra_sockets.push_back(shard_socket.release());
+  }
+
   if (m_options.enable_draft_discovery) {
     IPV4Address addr;
     m_e131_sender.UniverseIP(DISCOVERY_UNIVERSE_ID, &addr);
@@ -203,6 +231,15 @@ bool E131Node::Start() {
 bool E131Node::Stop() {
   m_ss->RemoveTimeout(m_discovery_timeout);
   m_discovery_timeout = ola::thread::INVALID_TIMEOUT;
+
+  // cancel any lazy leaves still pending; the timers are bound to this
+  // node and must not fire after it's deleted
+  std::map<uint16_t, ola::thread::timeout_id>::iterator iter =
+      m_pending_leaves.begin();
+  for (; iter != m_pending_leaves.end(); ++iter) {
+    m_ss->RemoveTimeout(iter->second);
+  }
+  m_pending_leaves.clear();
   return true;
 }
 
@@ -237,6 +274,12 @@ bool E131Node::TerminateStream(uint16_t universe, uint8_t priority) {
     SendStreamTerminated(universe, DmxBuffer(), priority);
   }
   STLRemove(&m_tx_universes, universe);
+  std::vector<uint16_t>::iterator pos = std::lower_bound(
+      m_tx_universe_list.begin(), m_tx_universe_list.end(), universe);
+  if (pos != m_tx_universe_list.end() && *pos == universe) {
+    m_tx_universe_list.erase(pos);
+    m_discovery_pages_dirty = true;
+  }
   return true;
 }
 
@@ -279,12 +322,6 @@ bool E131Node::SendDMXWithSequenceOffset(uint16_t universe,
   DMPAddressData<TwoByteRangeDMPAddress> range_chunk(&range_addr,
                                                      dmp_data,
                                                      dmp_data_length);
-  vector<DMPAddressData<TwoByteRangeDMPAddress> > ranged_chunks;
-  ranged_chunks.push_back(range_chunk);
-  const DMPPDU *pdu = NewRangeDMPSetProperty<uint16_t>(true,
-                                                       false,
-                                                       ranged_chunks);
-
   E131Header header(settings->source,
                     priority,
                     static_cast<uint8_t>(settings->sequence + sequence_offset),
@@ -293,13 +330,60 @@ bool E131Node::SendDMXWithSequenceOffset(uint16_t universe,
                     false,  // terminated
                     m_options.use_rev2);
 
-  bool result = m_e131_sender.SendDMP(header, pdu);
+  bool result;
+  if (m_options.use_rev2) {
+    // the rev2 layout keeps the generic PDU tree
+    vector<DMPAddressData<TwoByteRangeDMPAddress> > ranged_chunks;
+    ranged_chunks.push_back(range_chunk);
+    const DMPPDU *pdu = NewRangeDMPSetProperty<uint16_t>(true,
+                                                         false,
+                                                         ranged_chunks);
+    result = m_e131_sender.SendDMP(header, pdu);
+    delete pdu;
+  } else {
+    // the DATA frame layout is fixed, use the one-pass builder
+    result = m_e131_sender.SendDMXData(
+        header, dmp_data, static_cast<uint16_t>(dmp_data_length));
+  }
   if (result && !sequence_offset)
     settings->sequence++;
-  delete pdu;
   return result;
 }
 
+/*
+ * The receive socket a universe's multicast group is joined on.
+ */
+ola::network::UDPSocket *E131Node::ReceiveSocketForUniverse(
+    uint16_t universe) {
+  if (m_extra_sockets.empty())
+    return &m_socket;
+  unsigned int shard = universe %
+      static_cast<unsigned int>(m_extra_sockets.size() + 1);
+  return shard ? m_extra_sockets[shard - 1] : &m_socket;
+}
+
+
+/*
+ * The lazy leave timer fired; actually drop the multicast membership.
+ */
+bool E131Node::PerformLazyLeave(uint16_t universe) {
+  m_pending_leaves.erase(universe);
+  IPV4Address addr;
+  if (m_e131_sender.UniverseIP(universe, &addr)) {
+    if (!ReceiveSocketForUniverse(universe)->LeaveMulticast(
+            m_interface.ip_address, addr)) {
+      OLA_WARN << "Failed to leave multicast group " << addr;
+    }
+  }
+  return false;  // single shot
+}
+
+
+bool E131Node::SendSync(uint16_t sync_address) {
+  return m_e131_sender.SendSync(sync_address, m_sync_sequence++);
+}
+
+
 bool E131Node::SendStreamTerminated(uint16_t universe,
                                     const ola::DmxBuffer &buffer,
                                     uint8_t priority) {
@@ -355,7 +439,14 @@ bool E131Node::SetHandler(uint16_t universe,
     return false;
   }
 
-  if (!m_socket.JoinMulticast(m_interface.ip_address, addr)) {
+  // if a leave is pending for this universe we're still joined
+  std::map<uint16_t, ola::thread::timeout_id>::iterator pending =
+      m_pending_leaves.find(universe);
+  if (pending != m_pending_leaves.end()) {
+    m_ss->RemoveTimeout(pending->second);
+    m_pending_leaves.erase(pending);
+  } else if (!ReceiveSocketForUniverse(universe)->JoinMulticast(
+                 m_interface.ip_address, addr)) {
     OLA_WARN << "Failed to join multicast group " << addr;
     return false;
   }
@@ -371,10 +462,14 @@ bool E131Node::RemoveHandler(uint16_t universe) {
     return false;
   }
 
-  if (!m_socket.LeaveMulticast(m_interface.ip_address, addr)) {
-    OLA_WARN << "Failed to leave multicast group " << addr;
-    return false;
+  // defer the leave briefly so a showfile load repatching the same
+  // universes doesn't flap the multicast memberships
+  if (!STLContains(m_pending_leaves, universe)) {
+    m_pending_leaves[universe] = m_ss->RegisterRepeatingTimeout(
+        LAZY_LEAVE_INTERVAL_MS,
+        ola::NewCallback(this, &E131Node::PerformLazyLeave, universe));
   }
+  (void) addr;
 
   return m_dmp_inflator.RemoveHandler(universe);
 }
@@ -402,20 +497,28 @@ E131Node::tx_universe *E131Node::SetupOutgoingSettings(uint16_t universe) {
   settings.sequence = 0;
   ActiveTxUniverses::iterator iter =
       m_tx_universes.insert(std::make_pair(universe, settings)).first;
+  // keep the sorted discovery list in step
+  std::vector<uint16_t>::iterator pos = std::lower_bound(
+      m_tx_universe_list.begin(), m_tx_universe_list.end(), universe);
+  if (pos == m_tx_universe_list.end() || *pos != universe) {
+    m_tx_universe_list.insert(pos, universe);
+    m_discovery_pages_dirty = true;
+  }
   return &iter->second;
 }
 
 
 bool E131Node::PerformDiscoveryHousekeeping() {
-  // Send the Universe Discovery packets.
-  vector<uint16_t> universes;
-  STLKeys(m_tx_universes, &universes);
+  // Send the Universe Discovery packets; the page payloads are prebuilt
+  // and only reassembled when the universe list changed.
+  if (m_discovery_pages_dirty)
+    RebuildDiscoveryPages();
 
-  uint8_t last_page = static_cast<uint8_t>(
-    universes.size() / DISCOVERY_PAGE_SIZE);
-  uint32_t sequence_number = 0;
-  for (uint8_t i = 0; i <= last_page; i++) {
-    SendDiscoveryPage(universes, i, last_page, sequence_number);
+  E131Header header(m_options.source_name, 0, 0, DISCOVERY_UNIVERSE_ID);
+  for (size_t i = 0; i < m_discovery_pages.size(); i++) {
+    m_e131_sender.SendDiscoveryData(
+        header, &m_discovery_pages[i][0],
+        static_cast<unsigned int>(m_discovery_pages[i].size()));
   }
 
   // Delete any sources that we haven't heard from in 2 x
@@ -463,26 +566,32 @@ void E131Node::NewDiscoveryPage(
                   page.universes);
 }
 
-void E131Node::SendDiscoveryPage(const std::vector<uint16_t> &universes,
-                                 uint8_t this_page,
-                                 uint8_t last_page,
-                                 OLA_UNUSED uint32_t sequence_number) {
-  uint16_t in_this_page = static_cast<uint16_t>(this_page == last_page ?
-      universes.size() % DISCOVERY_PAGE_SIZE : DISCOVERY_PAGE_SIZE);
-
-  uint16_t *page_data = new uint16_t[in_this_page + 1];
-  page_data[0] = HostToNetwork(
-      static_cast<uint16_t>(this_page << 8 | last_page));
-
-  for (unsigned int i = 0; i < in_this_page; i++) {
-    page_data[i + 1] = HostToNetwork(
-        universes[this_page * DISCOVERY_PAGE_SIZE + i]);
+/*
+ * Rebuild the wire payloads for the discovery pages from the sorted
+ * universe list.
+ */
+void E131Node::RebuildDiscoveryPages() {
+  m_discovery_pages.clear();
+  uint8_t last_page = static_cast<uint8_t>(
+      m_tx_universe_list.size() / DISCOVERY_PAGE_SIZE);
+
+  for (uint8_t page = 0; page <= last_page; page++) {
+    uint16_t in_this_page = static_cast<uint16_t>(
+        page == last_page ?
+        m_tx_universe_list.size() % DISCOVERY_PAGE_SIZE :
+        DISCOVERY_PAGE_SIZE);
+
+    std::vector<uint8_t> payload((in_this_page + 1) * 2);
+    uint16_t *page_data = reinterpret_cast<uint16_t*>(&payload[0]);
+    page_data[0] = HostToNetwork(
+        static_cast<uint16_t>(page << 8 | last_page));
+    for (unsigned int i = 0; i < in_this_page; i++) {
+      page_data[i + 1] = HostToNetwork(
+          m_tx_universe_list[page * DISCOVERY_PAGE_SIZE + i]);
+    }
+    m_discovery_pages.push_back(payload);
   }
-
-  E131Header header(m_options.source_name, 0, 0, DISCOVERY_UNIVERSE_ID);
-  m_e131_sender.SendDiscoveryData(
-      header, reinterpret_cast<uint8_t*>(page_data), (in_this_page + 1) * 2);
-  delete[] page_data;
+  m_discovery_pages_dirty = false;
 }
 }  // namespace e131
 }  // namespace plugin
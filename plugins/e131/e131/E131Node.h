@@ -61,7 +61,8 @@ class E131Node {
          enable_draft_discovery(false),
          dscp(0),
          port(ola::acn::ACN_PORT),
-         source_name(ola::OLA_DEFAULT_INSTANCE_NAME) {
+         source_name(ola::OLA_DEFAULT_INSTANCE_NAME),
+         receive_socket_count(1) {
     }
 
     bool use_rev2;  /**< Use Revision 0.2 of the 2009 draft */
@@ -70,6 +71,12 @@ class E131Node {
     uint8_t dscp;  /**< The DSCP value to tag packets with */
     uint16_t port; /**< The UDP port to use, defaults to ACN_PORT */
     std::string source_name; /**< The source name to use */
+    /**
+     * The number of receive sockets to shard multicast groups over.
+     * Each socket gets a disjoint set of universes (and so its own
+     * kernel receive queue); needs SO_REUSEPORT for values > 1.
+     */
+    unsigned int receive_socket_count;
   };
 
   struct KnownController {
@@ -116,6 +123,29 @@ class E131Node {
    */
   bool StartStream(uint16_t universe);
 
+  /**
+   * @brief Send an E1.31 synchronization packet.
+   * Receivers apply the frames they've latched against the sync address;
+   * call this after sending the data packets for a flush.
+   */
+  bool SendSync(uint16_t sync_address);
+
+  /**
+   * @brief The aggregate sACN ingest statistics.
+   */
+  const DMPE131Inflator::IngestStats &GetIngestStats() const {
+    return m_dmp_inflator.GetIngestStats();
+  }
+
+ private:
+  ola::network::UDPSocket *ReceiveSocketForUniverse(uint16_t universe);
+  void RebuildDiscoveryPages();
+  bool PerformLazyLeave(uint16_t universe);
+
+  static const unsigned int LAZY_LEAVE_INTERVAL_MS = 5000;
+
+ public:
+
   /**
    * @brief Signal that we will no longer send on this particular universe.
    * @param universe to terminate sending on.
@@ -200,6 +230,15 @@ class E131Node {
    */
   ola::network::UDPSocket* GetSocket() { return &m_socket; }
 
+  /**
+   * @brief The additional receive sockets when sharding is enabled.
+   * The caller must register these with its SelectServer, like
+   * GetSocket().
+   */
+  const std::vector<ola::network::UDPSocket*> &ExtraReceiveSockets() const {
+    return m_extra_sockets;
+  }
+
   /**
    * @brief Return a list of known controllers.
    *
@@ -237,6 +276,18 @@ class E131Node {
   IncomingUDPTransport m_incoming_udp_transport;
   ActiveTxUniverses m_tx_universes;
   uint8_t *m_send_buffer;
+  uint8_t m_sync_sequence;
+  // extra receive sockets (and their transports) for multicast sharding
+  std::vector<ola::network::UDPSocket*> m_extra_sockets;
+  std::vector<IncomingUDPTransport*> m_extra_transports;
+  // sorted tx universe list + prebuilt discovery pages, maintained
+  // incrementally so the discovery timer only sends
+  std::vector<uint16_t> m_tx_universe_list;
+  // universes whose multicast leave is deferred to ride out repatch
+  // flapping
+  std::map<uint16_t, ola::thread::timeout_id> m_pending_leaves;
+  std::vector<std::vector<uint8_t> > m_discovery_pages;
+  bool m_discovery_pages_dirty;
 
   // Discovery members
   ola::thread::timeout_id m_discovery_timeout;
@@ -247,8 +298,6 @@ class E131Node {
   bool PerformDiscoveryHousekeeping();
   void NewDiscoveryPage(const HeaderSet &headers,
                         const E131DiscoveryInflator::DiscoveryPage &page);
-  void SendDiscoveryPage(const std::vector<uint16_t> &universes, uint8_t page,
-                         uint8_t last_page, uint32_t sequence_number);
 
   static const uint16_t DEFAULT_PRIORITY = 100;
   static const uint16_t UNIVERSE_DISCOVERY_INTERVAL = 10000;  // milliseconds
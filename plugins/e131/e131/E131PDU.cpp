@@ -83,7 +83,7 @@ bool E131PDU::PackHeader(uint8_t *data, unsigned int *length) const {
     strings::CopyToFixedLengthBuffer(m_header.Source(), header.source,
                                      arraysize(header.source));
     header.priority = m_header.Priority();
-    header.reserved = 0;
+    header.reserved = HostToNetwork(m_header.SyncAddress());
     header.sequence = m_header.Sequence();
     header.options = static_cast<uint8_t>(
         (m_header.PreviewData() ? E131Header::PREVIEW_DATA_MASK : 0) |
@@ -130,7 +130,7 @@ void E131PDU::PackHeader(OutputStream *stream) const {
     strings::CopyToFixedLengthBuffer(m_header.Source(), header.source,
                                      arraysize(header.source));
     header.priority = m_header.Priority();
-    header.reserved = 0;
+    header.reserved = HostToNetwork(m_header.SyncAddress());
     header.sequence = m_header.Sequence();
     header.options = static_cast<uint8_t>(
         (m_header.PreviewData() ? E131Header::PREVIEW_DATA_MASK : 0) |
@@ -152,6 +152,33 @@ void E131PDU::PackData(OutputStream *stream) const {
     stream->Write(m_data, m_data_size);
   }
 }
+
+unsigned int E131SyncPDU::HeaderSize() const {
+  return sizeof(m_sequence) + sizeof(m_sync_address) + sizeof(uint16_t);
+}
+
+
+bool E131SyncPDU::PackHeader(uint8_t *data, unsigned int *length) const {
+  if (*length < HeaderSize()) {
+    *length = 0;
+    return false;
+  }
+  data[0] = m_sequence;
+  uint16_t sync_address = HostToNetwork(m_sync_address);
+  memcpy(data + 1, &sync_address, sizeof(sync_address));
+  data[3] = 0;  // reserved
+  data[4] = 0;
+  *length = HeaderSize();
+  return true;
+}
+
+
+void E131SyncPDU::PackHeader(ola::io::OutputStream *stream) const {
+  *stream << m_sequence << HostToNetwork(m_sync_address)
+          << static_cast<uint16_t>(0);
+}
+
+
 }  // namespace e131
 }  // namespace plugin
 }  // namespace ola
@@ -21,6 +21,7 @@
 #ifndef PLUGINS_E131_E131_E131PDU_H_
 #define PLUGINS_E131_E131_E131PDU_H_
 
+#include "ola/acn/ACNVectors.h"
 #include "plugins/e131/e131/PDU.h"
 #include "plugins/e131/e131/E131Header.h"
 
@@ -30,6 +31,34 @@ namespace e131 {
 
 class DMPPDU;
 
+/*
+ * An E1.31 synchronization packet's framing PDU: just sequence + sync
+ * address, no sub PDU.
+ */
+class E131SyncPDU: public PDU {
+ public:
+  E131SyncPDU(uint8_t sequence, uint16_t sync_address):
+    PDU(ola::acn::VECTOR_E131_SYNC),
+    m_sequence(sequence),
+    m_sync_address(sync_address) {}
+
+  unsigned int HeaderSize() const;
+  unsigned int DataSize() const { return 0; }
+  bool PackHeader(uint8_t *data, unsigned int *length) const;
+  bool PackData(uint8_t*, unsigned int *length) const {
+    *length = 0;
+    return true;
+  }
+
+  void PackHeader(ola::io::OutputStream *stream) const;
+  void PackData(ola::io::OutputStream*) const {}
+
+ private:
+  uint8_t m_sequence;
+  uint16_t m_sync_address;
+};
+
+
 class E131PDU: public PDU {
  public:
   E131PDU(unsigned int vector,
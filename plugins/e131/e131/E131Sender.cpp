@@ -18,8 +18,12 @@
  * Copyright (C) 2007 Simon Newton
  */
 
+#include <string.h>
+#include "ola/Constants.h"
 #include "ola/Logging.h"
 #include "ola/acn/ACNVectors.h"
+#include "ola/base/Array.h"
+#include "ola/strings/Utils.h"
 #include "ola/network/IPV4Address.h"
 #include "ola/network/NetworkUtils.h"
 #include "plugins/e131/e131/DMPE131Inflator.h"
@@ -35,6 +39,7 @@ namespace e131 {
 
 using ola::network::IPV4Address;
 using ola::network::HostToNetwork;
+using ola::network::IPV4SocketAddress;
 
 /*
  * Create a new E131Sender
@@ -74,6 +79,111 @@ bool E131Sender::SendDMP(const E131Header &header, const DMPPDU *dmp_pdu) {
   return m_root_sender->SendPDU(vector, pdu, &transport);
 }
 
+/*
+ * One-pass builder for the fixed-layout DATA packet.
+ *
+ * offsets:  0 preamble (16)
+ *          16 root flags/len, 18 root vector, 22 cid (16)
+ *          38 framing flags/len, 40 framing vector, 44 e131 header (71)
+ *         115 dmp flags/len, 117 dmp vector, 118 address type,
+ *         119 first addr, 121 increment, 123 count, 125 payload
+ */
+bool E131Sender::SendDMXData(const E131Header &header,
+                             const uint8_t *dmp_data,
+                             uint16_t dmp_data_length) {
+  static const unsigned int ROOT_OFFSET = 16;
+  static const unsigned int FRAMING_OFFSET = 38;
+  static const unsigned int DMP_OFFSET = 115;
+  static const unsigned int PAYLOAD_OFFSET = 125;
+  static const uint8_t VHD_FLAGS = 0x70;
+
+  if (!m_root_sender)
+    return false;
+
+  IPV4Address addr;
+  if (!UniverseIP(header.Universe(), &addr)) {
+    OLA_INFO << "could not convert universe to ip.";
+    return false;
+  }
+
+  if (m_data_packet.empty()) {
+    // build the static parts of the template once
+    m_data_packet.resize(PAYLOAD_OFFSET + DMX_UNIVERSE_SIZE + 1, 0);
+    memcpy(&m_data_packet[0], PreamblePacker::ACN_HEADER,
+           PreamblePacker::ACN_HEADER_SIZE);
+    uint32_t root_vector = HostToNetwork(
+        static_cast<uint32_t>(ola::acn::VECTOR_ROOT_E131));
+    memcpy(&m_data_packet[ROOT_OFFSET + 2], &root_vector,
+           sizeof(root_vector));
+    m_root_sender->GetCID().Pack(&m_data_packet[ROOT_OFFSET + 6]);
+    uint32_t framing_vector = HostToNetwork(
+        static_cast<uint32_t>(ola::acn::VECTOR_E131_DATA));
+    memcpy(&m_data_packet[FRAMING_OFFSET + 2], &framing_vector,
+           sizeof(framing_vector));
+    m_data_packet[DMP_OFFSET + 2] = 0x02;  // DMP SET PROPERTY
+    m_data_packet[DMP_OFFSET + 3] = 0xa1;  // virtual, two byte, range-equal
+    // first address (0) & increment (1), network order
+    m_data_packet[DMP_OFFSET + 4] = 0;
+    m_data_packet[DMP_OFFSET + 5] = 0;
+    m_data_packet[DMP_OFFSET + 6] = 0;
+    m_data_packet[DMP_OFFSET + 7] = 1;
+  }
+
+  unsigned int total_size = PAYLOAD_OFFSET + dmp_data_length;
+
+  // patch the three flags/length fields
+  uint16_t root_fl = HostToNetwork(
+      static_cast<uint16_t>((VHD_FLAGS << 8) | (total_size - ROOT_OFFSET)));
+  memcpy(&m_data_packet[ROOT_OFFSET], &root_fl, sizeof(root_fl));
+  uint16_t framing_fl = HostToNetwork(
+      static_cast<uint16_t>((VHD_FLAGS << 8) |
+                            (total_size - FRAMING_OFFSET)));
+  memcpy(&m_data_packet[FRAMING_OFFSET], &framing_fl, sizeof(framing_fl));
+  uint16_t dmp_fl = HostToNetwork(
+      static_cast<uint16_t>((VHD_FLAGS << 8) | (total_size - DMP_OFFSET)));
+  memcpy(&m_data_packet[DMP_OFFSET], &dmp_fl, sizeof(dmp_fl));
+
+  // the framing header
+  E131Header::e131_pdu_header raw_header;
+  strings::CopyToFixedLengthBuffer(header.Source(), raw_header.source,
+                                   arraysize(raw_header.source));
+  raw_header.priority = header.Priority();
+  raw_header.reserved = HostToNetwork(header.SyncAddress());
+  raw_header.sequence = header.Sequence();
+  raw_header.options = static_cast<uint8_t>(
+      (header.PreviewData() ? E131Header::PREVIEW_DATA_MASK : 0) |
+      (header.StreamTerminated() ? E131Header::STREAM_TERMINATED_MASK : 0));
+  raw_header.universe = HostToNetwork(header.Universe());
+  memcpy(&m_data_packet[FRAMING_OFFSET + 6], &raw_header,
+         sizeof(raw_header));
+
+  // dmp property count & payload
+  uint16_t count = HostToNetwork(dmp_data_length);
+  memcpy(&m_data_packet[DMP_OFFSET + 8], &count, sizeof(count));
+  memcpy(&m_data_packet[PAYLOAD_OFFSET], dmp_data, dmp_data_length);
+
+  return m_transport_impl.SendRaw(
+      &m_data_packet[0], total_size,
+      IPV4SocketAddress(addr, ola::acn::ACN_PORT));
+}
+
+
+bool E131Sender::SendSync(uint16_t sync_address, uint8_t sequence) {
+  if (!m_root_sender)
+    return false;
+
+  IPV4Address addr;
+  if (!UniverseIP(sync_address, &addr)) {
+    OLA_INFO << "could not convert sync address to ip.";
+    return false;
+  }
+
+  OutgoingUDPTransport transport(&m_transport_impl, addr);
+  E131SyncPDU pdu(sequence, sync_address);
+  return m_root_sender->SendPDU(ola::acn::VECTOR_ROOT_E131, pdu, &transport);
+}
+
+
 bool E131Sender::SendDiscoveryData(const E131Header &header,
                                    const uint8_t *data,
                                    unsigned int data_size) {
@@ -29,6 +29,8 @@
 #include "plugins/e131/e131/Transport.h"
 #include "plugins/e131/e131/UDPTransport.h"
 
+#include <vector>
+
 namespace ola {
 namespace plugin {
 namespace e131 {
@@ -42,9 +44,33 @@ class E131Sender {
   ~E131Sender() {}
 
   bool SendDMP(const E131Header &header, const DMPPDU *pdu);
+
+  /**
+   * Emit a data packet in one pass. The wire layout of a DATA frame is
+   * fixed, so this writes the complete image into a reusable template
+   * buffer (lengths, header fields and payload patched in place) instead
+   * of walking the virtual PDU tree. Rare PDU types keep the generic
+   * path.
+   */
+  bool SendDMXData(const E131Header &header,
+                   const uint8_t *dmp_data,
+                   uint16_t dmp_data_length);
+
+  /**
+   * Batch mode: packets queued between BeginBatch() and EndBatch() are
+   * flushed with a single sendmmsg.
+   */
+  void BeginBatch() { m_transport_impl.BeginBatch(); }
+  bool EndBatch() { return m_transport_impl.EndBatch(); }
   bool SendDiscoveryData(const E131Header &header, const uint8_t *data,
                          unsigned int data_size);
 
+  /**
+   * Send an E1.31 synchronization packet; receivers apply the frames
+   * they've latched against this sync address.
+   */
+  bool SendSync(uint16_t sync_address, uint8_t sequence);
+
   static bool UniverseIP(unsigned int universe,
                          class ola::network::IPV4Address *addr);
 
@@ -53,6 +79,8 @@ class E131Sender {
   PreamblePacker m_packer;
   OutgoingUDPTransportImpl m_transport_impl;
   class RootSender *m_root_sender;
+  // the pre-built data packet image used by SendDMXData()
+  std::vector<uint8_t> m_data_packet;
 
   DISALLOW_COPY_AND_ASSIGN(E131Sender);
 };
@@ -55,6 +55,9 @@ class RootSender {
     // TODO(simon): add methods to queue and send PDUs/blocks with different
     // vectors
 
+    // The CID this sender stamps on root PDUs.
+    const ola::acn::CID &GetCID() const { return m_root_pdu.Cid(); }
+
  private:
     PDUBlock<PDU> m_working_block;
     PDUBlock<PDU> m_root_block;
@@ -58,6 +58,8 @@ class IncomingStreamTransport {
 
     bool Receive();
 
+    static const unsigned int READ_CACHE_SIZE = 2048;
+
  private:
     // The receiver is a state machine.
     typedef enum {
@@ -87,6 +89,11 @@ class IncomingStreamTransport {
     bool m_stream_valid;
     PDULengthSize m_pdu_length_size;
     unsigned int m_pdu_size;
+    // Read-ahead cache: the state machine consumes in 1-3 byte header
+    // nibbles; without this each nibble is its own recv() syscall.
+    uint8_t m_read_cache[READ_CACHE_SIZE];
+    unsigned int m_cache_offset;
+    unsigned int m_cache_size;
 
     void HandlePreamble();
     void HandlePDUFlags();
@@ -95,6 +102,8 @@ class IncomingStreamTransport {
 
     void IncreaseBufferSize(unsigned int new_size);
     void ReadRequiredData();
+    int ReceiveCached(uint8_t *data, unsigned int length,
+                      unsigned int *data_read);
     void EnterWaitingForPreamble();
     void EnterWaitingForPDU();
 
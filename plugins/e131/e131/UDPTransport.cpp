@@ -58,10 +58,65 @@ bool OutgoingUDPTransportImpl::Send(const PDUBlock<PDU> &pdu_block,
   if (!data)
     return false;
 
+  if (m_batching) {
+    // the packer's buffer is reused per Pack(), so take a copy
+    m_batch_offsets.push_back(
+        static_cast<unsigned int>(m_batch_data.size()));
+    m_batch_sizes.push_back(data_size);
+    m_batch_destinations.push_back(destination);
+    m_batch_data.insert(m_batch_data.end(), data, data + data_size);
+    return true;
+  }
+
   return m_socket->SendTo(data, data_size, destination);
 }
 
 
+bool OutgoingUDPTransportImpl::SendRaw(
+    const uint8_t *data,
+    unsigned int length,
+    const ola::network::IPV4SocketAddress &destination) {
+  if (m_batching) {
+    m_batch_offsets.push_back(
+        static_cast<unsigned int>(m_batch_data.size()));
+    m_batch_sizes.push_back(length);
+    m_batch_destinations.push_back(destination);
+    m_batch_data.insert(m_batch_data.end(), data, data + length);
+    return true;
+  }
+  return m_socket->SendTo(data, length, destination) ==
+      static_cast<ssize_t>(length);
+}
+
+
+void OutgoingUDPTransportImpl::BeginBatch() {
+  m_batching = true;
+  m_batch_data.clear();
+  m_batch_offsets.clear();
+  m_batch_sizes.clear();
+  m_batch_destinations.clear();
+}
+
+
+bool OutgoingUDPTransportImpl::EndBatch() {
+  m_batching = false;
+  if (m_batch_offsets.empty())
+    return true;
+
+  std::vector<ola::network::UDPSocketInterface::OutgoingDatagram> datagrams(
+      m_batch_offsets.size());
+  for (size_t i = 0; i < m_batch_offsets.size(); i++) {
+    datagrams[i].data = &m_batch_data[m_batch_offsets[i]];
+    datagrams[i].length = m_batch_sizes[i];
+    datagrams[i].destination = m_batch_destinations[i];
+  }
+
+  int sent = m_socket->SendToBatch(
+      &datagrams[0], static_cast<unsigned int>(datagrams.size()));
+  return sent == static_cast<int>(datagrams.size());
+}
+
+
 
 IncomingUDPTransport::IncomingUDPTransport(ola::network::UDPSocket *socket,
                                            BaseInflator *inflator)
@@ -75,22 +130,40 @@ IncomingUDPTransport::IncomingUDPTransport(ola::network::UDPSocket *socket,
  * Called when new data arrives.
  */
 void IncomingUDPTransport::Receive() {
-  if (!m_recv_buffer)
-    m_recv_buffer = new uint8_t[PreamblePacker::MAX_DATAGRAM_SIZE];
+  typedef ola::network::UDPSocketInterface::ReceivedDatagram
+      ReceivedDatagram;
+  const unsigned int batch_size =
+      ola::network::UDPSocket::MAX_RECV_BATCH;
 
-  ssize_t size = PreamblePacker::MAX_DATAGRAM_SIZE;
-  ola::network::IPV4SocketAddress source;
+  if (!m_recv_buffer)
+    m_recv_buffer =
+        new uint8_t[batch_size * PreamblePacker::MAX_DATAGRAM_SIZE];
+
+  // A burst of packets is drained in one batch rather than costing a
+  // poller round trip each.
+  ReceivedDatagram datagrams[ola::network::UDPSocket::MAX_RECV_BATCH];
+  int received = m_socket->RecvFromBatch(
+      m_recv_buffer, PreamblePacker::MAX_DATAGRAM_SIZE, datagrams,
+      batch_size);
+
+  for (int i = 0; i < received; i++) {
+    ProcessDatagram(datagrams[i].source, datagrams[i].data,
+                    static_cast<unsigned int>(datagrams[i].length));
+  }
+}
 
-  if (!m_socket->RecvFrom(m_recv_buffer, &size, &source))
-    return;
 
+void IncomingUDPTransport::ProcessDatagram(
+    const ola::network::IPV4SocketAddress &source,
+    const uint8_t *data,
+    unsigned int size) {
   unsigned int header_size = PreamblePacker::ACN_HEADER_SIZE;
-  if (size < static_cast<ssize_t>(header_size)) {
+  if (size < header_size) {
     OLA_WARN << "short ACN frame, discarding";
     return;
   }
 
-  if (memcmp(m_recv_buffer, PreamblePacker::ACN_HEADER, header_size)) {
+  if (memcmp(data, PreamblePacker::ACN_HEADER, header_size)) {
     OLA_WARN << "ACN header is bad, discarding";
     return;
   }
@@ -99,11 +172,8 @@ void IncomingUDPTransport::Receive() {
   TransportHeader transport_header(source, TransportHeader::UDP);
   header_set.SetTransportHeader(transport_header);
 
-  m_inflator->InflatePDUBlock(
-      &header_set,
-      m_recv_buffer + header_size,
-      static_cast<unsigned int>(size) - header_size);
-  return;
+  m_inflator->InflatePDUBlock(&header_set, data + header_size,
+                              size - header_size);
 }
 }  // namespace e131
 }  // namespace plugin
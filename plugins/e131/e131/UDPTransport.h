@@ -28,6 +28,8 @@
 #include "plugins/e131/e131/PreamblePacker.h"
 #include "plugins/e131/e131/Transport.h"
 
+#include <vector>
+
 namespace ola {
 namespace plugin {
 namespace e131 {
@@ -66,7 +68,8 @@ class OutgoingUDPTransportImpl {
                              PreamblePacker *packer = NULL)
         : m_socket(socket),
           m_packer(packer),
-          m_free_packer(false) {
+          m_free_packer(false),
+          m_batching(false) {
       if (!m_packer) {
         m_packer = new PreamblePacker();
         m_free_packer = true;
@@ -80,10 +83,32 @@ class OutgoingUDPTransportImpl {
     bool Send(const PDUBlock<PDU> &pdu_block,
               const ola::network::IPV4SocketAddress &destination);
 
+    /**
+     * Start accumulating outgoing packets instead of sending them
+     * immediately. EndBatch() flushes the batch with a single
+     * sendmmsg-backed call, so a scheduler flushing many universes in one
+     * tick pays one syscall.
+     */
+    void BeginBatch();
+    bool EndBatch();
+
+    /**
+     * Send an already-framed packet (preamble included), honouring batch
+     * mode. Used by the one-pass data packet builder.
+     */
+    bool SendRaw(const uint8_t *data, unsigned int length,
+                 const ola::network::IPV4SocketAddress &destination);
+
  private:
     ola::network::UDPSocket *m_socket;
     PreamblePacker *m_packer;
     bool m_free_packer;
+    bool m_batching;
+    // accumulated packet bytes; offsets/sizes/destinations per packet
+    std::vector<uint8_t> m_batch_data;
+    std::vector<unsigned int> m_batch_offsets;
+    std::vector<unsigned int> m_batch_sizes;
+    std::vector<ola::network::IPV4SocketAddress> m_batch_destinations;
 };
 
 
@@ -104,8 +129,13 @@ class IncomingUDPTransport {
     void Receive();
 
  private:
+    void ProcessDatagram(const ola::network::IPV4SocketAddress &source,
+                         const uint8_t *data,
+                         unsigned int size);
+
     ola::network::UDPSocket *m_socket;
     class BaseInflator *m_inflator;
+    // a ring of receive buffers, filled a batch at a time
     uint8_t *m_recv_buffer;
 };
 }  // namespace e131
@@ -96,6 +96,13 @@ bool EspNetNode::Start() {
   if (!InitNetwork())
     return false;
 
+  // prebuild the data packet; SendEspData patches only the per-frame
+  // fields
+  memset(&m_dmx_template.dmx, 0, sizeof(m_dmx_template.dmx));
+  m_dmx_template.dmx.head = HostToNetwork((uint32_t) ESPNET_DMX);
+  m_dmx_template.dmx.start = START_CODE;
+  m_dmx_template.dmx.type = DATA_RAW;
+
   m_running = true;
   return true;
 }
@@ -405,16 +412,15 @@ bool EspNetNode::SendEspPollReply(const IPV4Address &dst) {
 bool EspNetNode::SendEspData(const IPV4Address &dst,
                              uint8_t universe,
                              const DmxBuffer &buffer) {
-  espnet_packet_union_t packet;
-  memset(&packet.dmx, 0, sizeof(packet.dmx));
-  packet.dmx.head = HostToNetwork((uint32_t) ESPNET_DMX);
-  packet.dmx.universe = universe;
-  packet.dmx.start = START_CODE;
-  packet.dmx.type = DATA_RAW;
+  m_dmx_template.dmx.universe = universe;
   unsigned int size = DMX_UNIVERSE_SIZE;
-  buffer.Get(packet.dmx.data, &size);
-  packet.dmx.size = HostToNetwork((uint16_t) size);
-  return SendPacket(dst, packet, sizeof(packet.dmx));
+  buffer.Get(m_dmx_template.dmx.data, &size);
+  if (size < DMX_UNIVERSE_SIZE) {
+    // the whole data block goes on the wire; don't leak the last frame
+    memset(m_dmx_template.dmx.data + size, 0, DMX_UNIVERSE_SIZE - size);
+  }
+  m_dmx_template.dmx.size = HostToNetwork((uint16_t) size);
+  return SendPacket(dst, m_dmx_template, sizeof(m_dmx_template.dmx));
 }
 
 
@@ -118,6 +118,9 @@ class EspNetNode {
     ola::network::Interface m_interface;
     ola::network::UDPSocket m_socket;
     RunLengthDecoder m_decoder;
+    // prebuilt data packet; per frame only universe, size and payload
+    // are patched
+    espnet_packet_union_t m_dmx_template;
 
     static const char NODE_NAME[];
     static const uint8_t DEFAULT_OPTIONS = 0;
@@ -24,6 +24,10 @@
 #include <fcntl.h>
 #include <stdint.h>
 #include <string.h>
+#ifdef __linux__
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#endif  // __linux__
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -48,6 +52,7 @@ using std::vector;
 
 GPIODriver::GPIODriver(const Options &options)
     : m_options(options),
+      m_line_handle_fd(-1),
       m_term(false),
       m_dmx_changed(false) {
 }
@@ -74,6 +79,11 @@ bool GPIODriver::Init() {
 bool GPIODriver::SendDmx(const DmxBuffer &dmx) {
   {
     MutexLocker locker(&m_mutex);
+    // A 40fps universe where our slots are static is the common case;
+    // don't wake the pin thread for frames that can't change anything.
+    if (!m_dmx_changed && m_buffer == dmx) {
+      return true;
+    }
     // avoid the reference counting
     m_buffer.Set(dmx);
     m_dmx_changed = true;
@@ -116,6 +126,10 @@ void *GPIODriver::Run() {
 }
 
 bool GPIODriver::SetupGPIO() {
+  if (!m_options.gpiochip.empty()) {
+    return SetupGPIOCharDev();
+  }
+
   /**
    * This relies on the pins being exported:
    *   echo N > /sys/class/gpio/export
@@ -167,6 +181,7 @@ bool GPIODriver::UpdateGPIOPins(const DmxBuffer &dmx) {
     NO_CHANGE,
   };
 
+  bool pins_changed = false;
   for (uint16_t i = 0;
        i < m_gpio_pins.size() && (i + m_options.start_address < dmx.Size());
        i++) {
@@ -189,25 +204,99 @@ bool GPIODriver::UpdateGPIOPins(const DmxBuffer &dmx) {
 
     // Change the pin state if required.
     if (action != NO_CHANGE) {
-      char data = (action == TURN_ON ? '1' : '0');
-      if (write(m_gpio_pins[i].fd, &data, sizeof(data)) < 0) {
-        OLA_WARN << "Failed to toggle GPIO pin " << i << ", fd "
-                 << static_cast<int>(m_gpio_pins[i].fd) << ": "
-                 << strerror(errno);
-        return false;
+      if (m_line_handle_fd >= 0) {
+        // collected below into one multi-line update
+        m_gpio_pins[i].state = (action == TURN_ON ? ON : OFF);
+        pins_changed = true;
+      } else {
+        char data = (action == TURN_ON ? '1' : '0');
+        if (write(m_gpio_pins[i].fd, &data, sizeof(data)) < 0) {
+          OLA_WARN << "Failed to toggle GPIO pin " << i << ", fd "
+                   << static_cast<int>(m_gpio_pins[i].fd) << ": "
+                   << strerror(errno);
+          return false;
+        }
+        m_gpio_pins[i].state = (action == TURN_ON ? ON : OFF);
       }
-      m_gpio_pins[i].state = (action == TURN_ON ? ON : OFF);
     }
   }
+
+#ifdef __linux__
+  if (m_line_handle_fd >= 0 && pins_changed) {
+    // one ioctl sets every line, changed or not
+    struct gpiohandle_data data;
+    memset(&data, 0, sizeof(data));
+    for (unsigned int i = 0; i < m_gpio_pins.size(); i++) {
+      data.values[i] = (m_gpio_pins[i].state == ON ? 1 : 0);
+    }
+    if (ioctl(m_line_handle_fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL,
+              &data) < 0) {
+      OLA_WARN << "Failed to set GPIO line values: " << strerror(errno);
+      return false;
+    }
+  }
+#else
+  (void) pins_changed;
+#endif  // __linux__
   return true;
 }
 
+/*
+ * Request all pins as one output line handle on the gpiochip character
+ * device; updates are then a single multi-line ioctl.
+ */
+bool GPIODriver::SetupGPIOCharDev() {
+#ifdef __linux__
+  if (m_options.gpio_pins.size() > GPIOHANDLES_MAX) {
+    OLA_WARN << "Too many GPIO pins for one line handle, max is "
+             << GPIOHANDLES_MAX;
+    return false;
+  }
+
+  int chip_fd;
+  if (!ola::io::Open(m_options.gpiochip, O_RDWR, &chip_fd)) {
+    return false;
+  }
+
+  struct gpiohandle_request request;
+  memset(&request, 0, sizeof(request));
+  for (unsigned int i = 0; i < m_options.gpio_pins.size(); i++) {
+    request.lineoffsets[i] = m_options.gpio_pins[i];
+  }
+  request.lines = static_cast<uint32_t>(m_options.gpio_pins.size());
+  request.flags = GPIOHANDLE_REQUEST_OUTPUT;
+  snprintf(request.consumer_label, sizeof(request.consumer_label), "olad");
+
+  int r = ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request);
+  close(chip_fd);
+  if (r < 0) {
+    OLA_WARN << "Failed to get a line handle on " << m_options.gpiochip
+             << ": " << strerror(errno);
+    return false;
+  }
+  m_line_handle_fd = request.fd;
+
+  GPIOPin pin = {-1, UNDEFINED, false};
+  m_gpio_pins.assign(m_options.gpio_pins.size(), pin);
+  return true;
+#else
+  OLA_WARN << "gpiochip devices are only supported on Linux";
+  return false;
+#endif  // __linux__
+}
+
 void GPIODriver::CloseGPIOFDs() {
   GPIOPins::iterator iter = m_gpio_pins.begin();
   for (; iter != m_gpio_pins.end(); ++iter) {
-    close(iter->fd);
+    if (iter->fd >= 0) {
+      close(iter->fd);
+    }
   }
   m_gpio_pins.clear();
+  if (m_line_handle_fd >= 0) {
+    close(m_line_handle_fd);
+    m_line_handle_fd = -1;
+  }
 }
 }  // namespace gpio
 }  // namespace plugin
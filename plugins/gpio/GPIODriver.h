@@ -26,6 +26,7 @@
 #include <ola/base/Macro.h>
 #include <ola/thread/Thread.h>
 
+#include <string>
 #include <vector>
 
 namespace ola {
@@ -49,6 +50,15 @@ class GPIODriver : private ola::thread::Thread {
      */
     std::vector<uint8_t> gpio_pins;
 
+    /**
+     * @brief The gpiochip character device to use, e.g. /dev/gpiochip0.
+     *
+     * When set, all pins are driven through one line handle and every
+     * update is a single multi-line ioctl rather than a sysfs write per
+     * pin. Empty (the default) keeps the sysfs interface.
+     */
+    std::string gpiochip;
+
     /**
      * @brief The DMX512 start address of the first pin
      */
@@ -114,6 +124,7 @@ class GPIODriver : private ola::thread::Thread {
 
   const Options m_options;
   GPIOPins m_gpio_pins;
+  int m_line_handle_fd;  // the gpiochip line handle, -1 when using sysfs
 
   DmxBuffer m_buffer;
   bool m_term;  // GUARDED_BY(m_mutex);
@@ -122,6 +133,7 @@ class GPIODriver : private ola::thread::Thread {
   ola::thread::ConditionVariable m_cond;
 
   bool SetupGPIO();
+  bool SetupGPIOCharDev();
   bool UpdateGPIOPins(const DmxBuffer &dmx);
   void CloseGPIOFDs();
 
@@ -37,6 +37,7 @@ using std::auto_ptr;
 using std::string;
 using std::vector;
 
+const char GPIOPlugin::GPIO_CHIP_KEY[] = "gpiochip";
 const char GPIOPlugin::GPIO_PINS_KEY[] = "gpio_pins";
 const char GPIOPlugin::GPIO_SLOT_OFFSET_KEY[] = "gpio_slot_offset";
 const char GPIOPlugin::GPIO_TURN_OFF_KEY[] = "gpio_turn_off";
@@ -70,6 +71,8 @@ bool GPIOPlugin::StartHook() {
     return false;
   }
 
+  options.gpiochip = m_preferences->GetValue(GPIO_CHIP_KEY);
+
   vector<string> pin_list;
   StringSplit(m_preferences->GetValue(GPIO_PINS_KEY), &pin_list, ",");
   vector<string>::const_iterator iter = pin_list.begin();
@@ -132,6 +135,12 @@ string GPIOPlugin::Description() const {
 "\n"
 "gpio_turn_off = <int>\n"
 "The DMX512 value below which a GPIO pin will be turned off.\n"
+"\n"
+"gpiochip = <device>\n"
+"The gpiochip character device, e.g. /dev/gpiochip0. When set, pins\n"
+"are numbered as line offsets on this chip and every update is a\n"
+"single multi-line ioctl instead of a sysfs write per pin. Leave\n"
+"empty to use the sysfs interface.\n"
 "\n";
 }
 
@@ -141,6 +150,9 @@ bool GPIOPlugin::SetDefaultPreferences() {
   if (!m_preferences)
     return false;
 
+  save |= m_preferences->SetDefaultValue(GPIO_CHIP_KEY,
+                                         StringValidator(true),
+                                         "");
   save |= m_preferences->SetDefaultValue(GPIO_PINS_KEY,
                                          StringValidator(),
                                          "");
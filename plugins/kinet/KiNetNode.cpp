@@ -45,7 +45,9 @@ KiNetNode::KiNetNode(ola::io::SelectServerInterface *ss,
     : m_running(false),
       m_ss(ss),
       m_output_stream(&m_output_queue),
-      m_socket(socket) {
+      m_socket(socket),
+      m_pending_count(0),
+      m_flush_timeout(ola::thread::INVALID_TIMEOUT) {
 }
 
 
@@ -61,11 +63,31 @@ KiNetNode::~KiNetNode() {
  * Start this node.
  */
 bool KiNetNode::Start() {
+  static const uint8_t port = 0;
+  static const uint8_t flags = 0;
+  static const uint16_t timer_val = 0;
+  static const uint32_t universe = 0xffffffff;
+
   if (m_running)
     return false;
 
+  // Every DMX packet carries the same constant header, so assemble it
+  // once; transmission then shares these bytes across the whole fanout.
+  m_output_queue.Clear();
+  PopulatePacketHeader(KINET_DMX_MSG);
+  m_output_stream << port << flags << timer_val << universe;
+  unsigned int header_size = m_output_queue.Read(m_dmx_header,
+                                                 sizeof(m_dmx_header));
+  if (header_size != sizeof(m_dmx_header)) {
+    OLA_WARN << "KiNet header size mismatch, expected "
+             << sizeof(m_dmx_header) << ", got " << header_size;
+    return false;
+  }
+
   if (!InitNetwork())
     return false;
+
+  m_pending_packets.resize(MAX_PENDING_PACKETS);
   m_running = true;
   return true;
 }
@@ -78,6 +100,8 @@ bool KiNetNode::Stop() {
   if (!m_running)
     return false;
 
+  FlushPendingPackets();
+
   m_ss->RemoveReadDescriptor(m_socket.get());
   m_socket.reset();
   m_running = false;
@@ -89,32 +113,70 @@ bool KiNetNode::Stop() {
  * Send some DMX data
  */
 bool KiNetNode::SendDMX(const IPV4Address &target_ip, const DmxBuffer &buffer) {
-  static const uint8_t port = 0;
-  static const uint8_t flags = 0;
-  static const uint16_t timer_val = 0;
-  static const uint32_t universe = 0xffffffff;
-
   if (!buffer.Size()) {
     OLA_DEBUG << "Not sending 0 length packet";
     return true;
   }
 
-  m_output_queue.Clear();
-  PopulatePacketHeader(KINET_DMX_MSG);
-  m_output_stream << port << flags << timer_val << universe;
-  m_output_stream << DMX512_START_CODE;
-  m_output_stream.Write(buffer.GetRaw(), buffer.Size());
+  if (m_pending_count == MAX_PENDING_PACKETS) {
+    FlushPendingPackets();
+  }
+
+  // Queue the packet; everything sent this loop pass goes out in a
+  // single batched send, one datagram per power supply.
+  PendingPacket &packet = m_pending_packets[m_pending_count++];
+  packet.payload[0] = DMX512_START_CODE;
+  unsigned int length = buffer.Size();
+  buffer.Get(packet.payload + 1, &length);
+  packet.payload_size = length + 1;
+  packet.destination = IPV4SocketAddress(target_ip, KINET_PORT);
+
+  if (m_flush_timeout == ola::thread::INVALID_TIMEOUT) {
+    m_flush_timeout = m_ss->RegisterSingleTimeout(
+        ola::TimeInterval(),
+        ola::NewSingleCallback(this, &KiNetNode::FlushTimeoutFired));
+  }
+  return true;
+}
+
+/*
+ * The scheduled flush; the timeout has already fired so only the id
+ * needs clearing.
+ */
+void KiNetNode::FlushTimeoutFired() {
+  m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  FlushPendingPackets();
+}
 
-  IPV4SocketAddress target(target_ip, KINET_PORT);
-  bool ok = m_socket->SendTo(&m_output_queue, target);
-  if (!ok)
-    OLA_WARN << "Failed to send KiNet DMX packet";
+/*
+ * Send everything queued this pass with one batched send. Safe to call
+ * with a flush still scheduled (the queue-full inline flush, Stop());
+ * the pending timeout is cancelled so it can't fire on a freed node.
+ */
+void KiNetNode::FlushPendingPackets() {
+  if (m_flush_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_ss->RemoveTimeout(m_flush_timeout);
+    m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  }
+  if (!m_pending_count)
+    return;
+
+  ola::network::UDPSocketInterface::OutgoingDatagram
+      datagrams[MAX_PENDING_PACKETS];
+  for (unsigned int i = 0; i < m_pending_count; i++) {
+    datagrams[i].data = m_dmx_header;
+    datagrams[i].length = sizeof(m_dmx_header);
+    datagrams[i].payload = m_pending_packets[i].payload;
+    datagrams[i].payload_length = m_pending_packets[i].payload_size;
+    datagrams[i].destination = m_pending_packets[i].destination;
+  }
 
-  if (!m_output_queue.Empty()) {
-    OLA_WARN << "Failed to send complete KiNet packet";
-    m_output_queue.Clear();
+  int sent = m_socket->SendToBatch(datagrams, m_pending_count);
+  if (sent != static_cast<int>(m_pending_count)) {
+    OLA_WARN << "Only sent " << sent << " of " << m_pending_count
+             << " KiNet DMX packets";
   }
-  return ok;
+  m_pending_count = 0;
 }
 
 
@@ -22,7 +22,9 @@
 #define PLUGINS_KINET_KINETNODE_H_
 
 #include <memory>
+#include <vector>
 
+#include "ola/Constants.h"
 #include "ola/DmxBuffer.h"
 #include "ola/io/BigEndianStream.h"
 #include "ola/io/IOQueue.h"
@@ -48,12 +50,28 @@ class KiNetNode {
                  const ola::DmxBuffer &buffer);
 
  private:
+    // A queued PORTOUT packet. The header bytes are shared - every DMX
+    // packet we emit has the same constant header - so only the payload
+    // is per packet.
+    struct PendingPacket {
+      uint8_t payload[DMX_UNIVERSE_SIZE + 1];  // start code + slots
+      unsigned int payload_size;
+      ola::network::IPV4SocketAddress destination;
+    };
+
     bool m_running;
     ola::io::SelectServerInterface *m_ss;
     ola::io::IOQueue m_output_queue;
     ola::io::BigEndianOutputStream m_output_stream;
     ola::network::Interface m_interface;
     std::auto_ptr<ola::network::UDPSocketInterface> m_socket;
+    uint8_t m_dmx_header[20];
+    std::vector<PendingPacket> m_pending_packets;
+    unsigned int m_pending_count;
+    ola::thread::timeout_id m_flush_timeout;
+
+    void FlushPendingPackets();
+    void FlushTimeoutFired();
 
     KiNetNode(const KiNetNode&);
     KiNetNode& operator=(const KiNetNode&);
@@ -63,6 +81,7 @@ class KiNetNode {
     bool InitNetwork();
 
     static const uint16_t KINET_PORT = 6038;
+    static const unsigned int MAX_PENDING_PACKETS = 64;
     static const uint32_t KINET_MAGIC_NUMBER = 0x0401dc4a;
     static const uint16_t KINET_VERSION_ONE = 0x0100;
     static const uint16_t KINET_DMX_MSG = 0x0101;
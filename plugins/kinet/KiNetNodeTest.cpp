@@ -85,6 +85,7 @@ void KiNetNodeTest::testSendDMX() {
   DmxBuffer buffer;
   buffer.SetFromString("1,5,8,10,14,45,100,255");
   OLA_ASSERT_TRUE(node.SendDMX(target_ip, buffer));
-  m_socket->Verify();
+  // sends are batched per loop pass; Stop() flushes anything pending
   OLA_ASSERT(node.Stop());
+  m_socket->Verify();
 }
@@ -74,6 +74,7 @@ int MilInstWidget::ConnectToWidget(const string &path, speed_t speed) {
  * Disconnect from the widget
  */
 int MilInstWidget::Disconnect() {
+  m_writer.SetDescriptor(NULL);
   m_socket->Close();
   return 0;
 }
@@ -25,6 +25,7 @@
 #include <termios.h>
 #include <string>
 
+#include "ola/io/BackloggedWriter.h"
 #include "ola/io/SelectServer.h"
 #include "ola/DmxBuffer.h"
 
@@ -66,6 +67,9 @@ class MilInstWidget {
   bool m_enabled;
   const std::string m_path;
   ola::io::ConnectedDescriptor *m_socket;
+  // absorbs partial writes on slow links instead of truncating updates;
+  // mutable because the Send methods are const
+  mutable ola::io::BackloggedWriter m_writer;
 };
 }  // namespace milinst
 }  // namespace plugin
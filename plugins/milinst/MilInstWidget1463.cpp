@@ -39,6 +39,7 @@ bool MilInstWidget1463::Connect() {
     return false;
 
   m_socket = new ola::io::DeviceDescriptor(fd);
+  m_writer.SetDescriptor(m_socket);
 
   OLA_DEBUG << "Connected to " << m_path;
   return true;
@@ -79,7 +80,7 @@ int MilInstWidget1463::SetChannel(unsigned int chan, uint8_t val) const {
   msg[0] = chan;
   msg[1] = val;
   OLA_DEBUG << "Setting " << chan << " to " << static_cast<int>(val);
-  return m_socket->Send(msg, sizeof(msg));
+  return m_writer.Write(msg, sizeof(msg)) ? static_cast<int>(sizeof(msg)) : -1;
 }
 
 
@@ -98,7 +99,7 @@ int MilInstWidget1463::Send112(const DmxBuffer &buffer) const {
     OLA_DEBUG << "Setting " << (i + 1) << " to " <<
         static_cast<int>(buffer.Get(i));
   }
-  return m_socket->Send(msg, (channels * 2));
+  return m_writer.Write(msg, channels * 2) ? static_cast<int>(channels * 2) : -1;
 }
 }  // namespace milinst
 }  // namespace plugin
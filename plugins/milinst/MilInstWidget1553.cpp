@@ -77,6 +77,7 @@ bool MilInstWidget1553::Connect() {
     return false;
 
   m_socket = new ola::io::DeviceDescriptor(fd);
+  m_writer.SetDescriptor(m_socket);
   m_socket->SetOnData(
       NewCallback<MilInstWidget1553>(this, &MilInstWidget1553::SocketReady));
 
@@ -138,7 +139,7 @@ int MilInstWidget1553::SetChannel(unsigned int chan, uint8_t val) const {
   ola::utils::SplitUInt16(chan, &msg[1], &msg[2]);
   msg[3] = val;
   OLA_DEBUG << "Setting " << chan << " to " << static_cast<int>(val);
-  return m_socket->Send(msg, sizeof(msg));
+  return m_writer.Write(msg, sizeof(msg)) ? static_cast<int>(sizeof(msg)) : -1;
 }
 
 
@@ -156,7 +157,7 @@ int MilInstWidget1553::Send(const DmxBuffer &buffer) const {
 
   buffer.Get(msg + 3, &channels);
 
-  return m_socket->Send(msg, sizeof(msg));
+  return m_writer.Write(msg, sizeof(msg)) ? static_cast<int>(sizeof(msg)) : -1;
 }
 
 
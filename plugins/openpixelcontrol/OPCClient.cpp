@@ -38,17 +38,24 @@ using ola::TimeInterval;
 using ola::network::TCPSocket;
 
 OPCClient::OPCClient(ola::io::SelectServerInterface *ss,
-                     const ola::network::IPV4SocketAddress &target)
+                     const ola::network::IPV4SocketAddress &target,
+                     const TimeInterval &flush_interval)
     : m_ss(ss),
       m_target(target),
       m_backoff(TimeInterval(1, 0), TimeInterval(300, 0)),
       m_pool(OPC_FRAME_SIZE),
       m_socket_factory(NewCallback(this, &OPCClient::SocketConnected)),
-      m_tcp_connector(ss, &m_socket_factory, TimeInterval(3, 0)) {
+      m_tcp_connector(ss, &m_socket_factory, TimeInterval(3, 0)),
+      m_flush_interval(flush_interval),
+      m_pending(&m_pool),
+      m_flush_timeout(ola::thread::INVALID_TIMEOUT) {
   m_tcp_connector.AddEndpoint(target, &m_backoff);
 }
 
 OPCClient::~OPCClient() {
+  if (m_flush_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_ss->RemoveTimeout(m_flush_timeout);
+  }
   if (m_client_socket.get()) {
     m_ss->RemoveReadDescriptor(m_client_socket.get());
     m_tcp_connector.Disconnect(m_target, true);
@@ -60,13 +67,34 @@ bool OPCClient::SendDmx(uint8_t channel, const DmxBuffer &buffer) {
     return false;  // not connected
   }
 
-  ola::io::IOQueue queue(&m_pool);
-  ola::io::BigEndianOutputStream stream(&queue);
+  // Frame the message into the pending batch; everything that arrives
+  // before the flush fires goes out in a single write.
+  ola::io::BigEndianOutputStream stream(&m_pending);
   stream << channel;
   stream << SET_PIXEL_COMMAND;
   stream << static_cast<uint16_t>(buffer.Size());
   stream.Write(buffer.GetRaw(), buffer.Size());
-  return m_sender->SendMessage(&queue);
+
+  if (m_flush_timeout == ola::thread::INVALID_TIMEOUT) {
+    // a 0 interval fires on the next loop pass, coalescing all updates
+    // from this pass
+    m_flush_timeout = m_ss->RegisterSingleTimeout(
+        m_flush_interval, NewSingleCallback(this, &OPCClient::Flush));
+  }
+  return true;
+}
+
+void OPCClient::Flush() {
+  m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  if (!m_sender.get()) {
+    // the connection went away while we were holding frames; they're
+    // stale, drop them
+    m_pending.Clear();
+    return;
+  }
+  if (!m_pending.Empty()) {
+    m_sender->SendMessage(&m_pending);
+  }
 }
 
 void OPCClient::SetSocketCallback(SocketEventCallback *callback) {
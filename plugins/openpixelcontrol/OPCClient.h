@@ -57,9 +57,14 @@ class OPCClient {
    * @brief Create a new OPCClient.
    * @param ss The SelectServer to use
    * @param target the remote IP:port to connect to.
+   * @param flush_interval how long to hold frames for coalescing. With
+   *   the default of 0 all frames sent within one event loop pass go out
+   *   in a single write; larger values trade latency for fewer, bigger
+   *   writes on very large walls.
    */
   OPCClient(ola::io::SelectServerInterface *ss,
-            const ola::network::IPV4SocketAddress &target);
+            const ola::network::IPV4SocketAddress &target,
+            const ola::TimeInterval &flush_interval = ola::TimeInterval());
 
   /**
    * @brief Destructor.
@@ -76,6 +81,10 @@ class OPCClient {
    * @brief Send a DMX frame.
    * @param channel the OPC channel to use.
    * @param buffer the DMX data.
+   *
+   * Frames are coalesced: updates for all channels destined to this
+   * server within the flush interval are written to the socket as one
+   * message batch, cutting per-frame syscalls on multi-channel walls.
    */
   bool SendDmx(uint8_t channel, const DmxBuffer &buffer);
 
@@ -98,9 +107,14 @@ class OPCClient {
   std::auto_ptr<ola::io::NonBlockingSender> m_sender;
   std::auto_ptr<SocketEventCallback> m_socket_callback;
 
+  const ola::TimeInterval m_flush_interval;
+  ola::io::IOQueue m_pending;
+  ola::thread::timeout_id m_flush_timeout;
+
   void SocketConnected(ola::network::TCPSocket *socket);
   void NewData();
   void SocketClosed();
+  void Flush();
 
   DISALLOW_COPY_AND_ASSIGN(OPCClient);
 };
@@ -18,6 +18,7 @@
  * Copyright (C) 2014 Simon Newton
  */
 
+#include "ola/StringUtils.h"
 #include "plugins/openpixelcontrol/OPCDevice.h"
 
 #include <sstream>
@@ -101,7 +102,17 @@ OPCClientDevice::OPCClientDevice(AbstractPlugin *owner,
       m_plugin_adaptor(plugin_adaptor),
       m_preferences(preferences),
       m_target(target),
-      m_client(new OPCClient(plugin_adaptor, target)) {
+      m_client(new OPCClient(plugin_adaptor, target, FlushInterval())) {
+}
+
+/*
+ * The optional flush_interval preference, in milliseconds. 0 (the
+ * default) coalesces per event-loop pass.
+ */
+ola::TimeInterval OPCClientDevice::FlushInterval() const {
+  unsigned int interval_ms = 0;
+  ola::StringToInt(m_preferences->GetValue("flush_interval"), &interval_ms);
+  return ola::TimeInterval(interval_ms / 1000, (interval_ms % 1000) * 1000);
 }
 
 string OPCClientDevice::DeviceId() const {
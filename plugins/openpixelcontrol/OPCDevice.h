@@ -22,6 +22,8 @@
 #define PLUGINS_OPENPIXELCONTROL_OPCDEVICE_H_
 
 #include <memory>
+#include <ola/Clock.h>
+
 #include <string>
 #include "ola/network/Socket.h"
 #include "olad/Device.h"
@@ -90,6 +92,8 @@ class OPCClientDevice: public ola::Device {
   const ola::network::IPV4SocketAddress m_target;
   std::auto_ptr<class OPCClient> m_client;
 
+  ola::TimeInterval FlushInterval() const;
+
   DISALLOW_COPY_AND_ASSIGN(OPCClientDevice);
 };
 }  // namespace openpixelcontrol
@@ -95,6 +95,11 @@ string OPCPlugin::Description() const {
 "The Open Pixel Control channels to use for the specified device.\n"
 "Multiple channels can be specified and an input port will be created\n"
 "for each.\n"
+"\n"
+"flush_interval = <milliseconds>\n"
+"How long to hold frames so updates for multiple channels coalesce\n"
+"into one write per server. The default of 0 batches everything sent\n"
+"within one event loop pass.\n"
 "\n";
 }
 
@@ -132,26 +132,37 @@ void OPCServer::SocketReady(TCPSocket *socket, RxState *rx_state) {
   }
 
   rx_state->offset += data_received;
-  if (rx_state->offset < OPC_HEADER_SIZE) {
-    return;
+
+  // TCP has no message boundaries: a read may contain several messages
+  // (senders batch multi-channel updates into one write) or a partial
+  // one, so consume as many complete messages as we have and keep the
+  // remainder for the next read.
+  unsigned int consumed = 0;
+  while (rx_state->offset - consumed >= OPC_HEADER_SIZE) {
+    const uint8_t *message = rx_state->data + consumed;
+    uint16_t message_size = utils::JoinUInt8(message[2], message[3]);
+    if (rx_state->offset - consumed <
+        static_cast<unsigned int>(message_size) + OPC_HEADER_SIZE) {
+      break;  // partial message, wait for more data
+    }
+
+    ChannelCallback *cb = STLFindOrNull(m_callbacks, message[0]);
+    if (cb) {
+      cb->Run(message[1], message + OPC_HEADER_SIZE, message_size);
+    }
+    consumed += OPC_HEADER_SIZE + message_size;
   }
 
-  rx_state->CheckSize();
-  if (rx_state->offset <
-      static_cast<unsigned int>(rx_state->expected_size) + OPC_HEADER_SIZE) {
-    return;
+  if (consumed) {
+    memmove(rx_state->data, rx_state->data + consumed,
+            rx_state->offset - consumed);
+    rx_state->offset -= consumed;
   }
 
-  ChannelCallback *cb = STLFindOrNull(m_callbacks, rx_state->data[0]);
-  if (cb) {
-    DmxBuffer buffer(rx_state->data + OPC_HEADER_SIZE,
-                     rx_state->offset - OPC_HEADER_SIZE);
-    cb->Run(rx_state->data[1],
-            rx_state->data + OPC_HEADER_SIZE,
-            rx_state->expected_size);
+  if (rx_state->offset >= OPC_HEADER_SIZE) {
+    // make sure the buffer can hold the rest of the partial message
+    rx_state->CheckSize();
   }
-  rx_state->offset = 0;
-  rx_state->expected_size = 0;
 }
 
 void OPCServer::SocketClosed(TCPSocket *socket) {
@@ -21,6 +21,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <memory>
+#include <string>
 #include "ola/base/Array.h"
 #include "ola/Callback.h"
 #include "ola/DmxBuffer.h"
@@ -47,12 +48,16 @@ class OPCServerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testUnknownCommand);
   CPPUNIT_TEST(testLargeFrame);
   CPPUNIT_TEST(testHangingFrame);
+  CPPUNIT_TEST(testMultipleMessagesPerRead);
+  CPPUNIT_TEST(testPartialMessageReassembly);
   CPPUNIT_TEST_SUITE_END();
 
  public:
   OPCServerTest()
       : CppUnit::TestFixture(),
-        m_ss(NULL) {
+        m_ss(NULL),
+        m_messages_received(0),
+        m_expected_messages(0) {
   }
   void setUp();
 
@@ -60,6 +65,8 @@ class OPCServerTest: public CppUnit::TestFixture {
   void testUnknownCommand();
   void testLargeFrame();
   void testHangingFrame();
+  void testMultipleMessagesPerRead();
+  void testPartialMessageReassembly();
 
  private:
   ola::io::SelectServer m_ss;
@@ -67,6 +74,9 @@ class OPCServerTest: public CppUnit::TestFixture {
   auto_ptr<TCPSocket> m_client_socket;
   DmxBuffer m_received_data;
   uint8_t m_command;
+  unsigned int m_messages_received;
+  unsigned int m_expected_messages;
+  std::string m_deferred_data;
 
   void SendDataAndCheck(uint8_t channel,
                         const DmxBuffer &data);
@@ -74,7 +84,15 @@ class OPCServerTest: public CppUnit::TestFixture {
   void CaptureData(uint8_t command, const uint8_t *data, unsigned int length) {
     m_received_data.Set(data, length);
     m_command = command;
-    m_ss.Terminate();
+    m_messages_received++;
+    if (m_messages_received >= m_expected_messages)
+      m_ss.Terminate();
+  }
+
+  void SendDeferredData() {
+    m_client_socket->Send(
+        reinterpret_cast<const uint8_t*>(m_deferred_data.data()),
+        static_cast<unsigned int>(m_deferred_data.size()));
   }
 
   static const uint8_t CHANNEL = 1;
@@ -97,6 +115,8 @@ void OPCServerTest::setUp() {
 
 void OPCServerTest::SendDataAndCheck(uint8_t channel,
                                      const DmxBuffer &buffer) {
+  m_messages_received = 0;
+  m_expected_messages = 1;
   unsigned int dmx_size = buffer.Size();
   uint8_t data[dmx_size + 4];
   data[0] = channel;
@@ -120,6 +140,8 @@ void OPCServerTest::testReceiveDmx() {
 }
 
 void OPCServerTest::testUnknownCommand() {
+  m_messages_received = 0;
+  m_expected_messages = 1;
   uint8_t data[] = {1, 1, 0, 2, 3, 4};
   m_client_socket->Send(data, arraysize(data));
   m_ss.Run();
@@ -131,6 +153,8 @@ void OPCServerTest::testUnknownCommand() {
 }
 
 void OPCServerTest::testLargeFrame() {
+  m_messages_received = 0;
+  m_expected_messages = 1;
   uint8_t data[1028];
   data[0] = 1;
   data[1] = 0;
@@ -151,3 +175,59 @@ void OPCServerTest::testHangingFrame() {
   uint8_t data[] = {1, 0};
   m_client_socket->Send(data, arraysize(data));
 }
+
+
+/*
+ * TCP has no message boundaries: several messages can arrive in one
+ * read (senders batch multi-channel updates into one write) and all of
+ * them must be dispatched.
+ */
+void OPCServerTest::testMultipleMessagesPerRead() {
+  m_messages_received = 0;
+  m_expected_messages = 3;
+
+  uint8_t data[3 * 8];
+  unsigned int offset = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    data[offset++] = CHANNEL;
+    data[offset++] = SET_PIXELS_COMMAND;
+    data[offset++] = 0;  // length, high byte
+    data[offset++] = 4;  // length, low byte
+    data[offset++] = i;
+    data[offset++] = static_cast<uint8_t>(i + 1);
+    data[offset++] = static_cast<uint8_t>(i + 2);
+    data[offset++] = static_cast<uint8_t>(i + 3);
+  }
+  m_client_socket->Send(data, offset);
+  m_ss.Run();
+
+  OLA_ASSERT_EQ(3u, m_messages_received);
+  // the last message wins the capture slot
+  DmxBuffer expected;
+  expected.SetFromString("2,3,4,5");
+  OLA_ASSERT_EQ(m_received_data, expected);
+}
+
+
+/*
+ * A message split across two writes must be reassembled, with the
+ * remainder carried over between reads.
+ */
+void OPCServerTest::testPartialMessageReassembly() {
+  m_messages_received = 0;
+  m_expected_messages = 1;
+
+  const uint8_t data[] = {CHANNEL, SET_PIXELS_COMMAND, 0, 4, 9, 8, 7, 6};
+  // header plus one payload byte now, the rest shortly afterwards
+  m_client_socket->Send(data, 5);
+  m_deferred_data.assign(reinterpret_cast<const char*>(data + 5),
+                         sizeof(data) - 5);
+  m_ss.RegisterSingleTimeout(
+      10, ola::NewSingleCallback(this, &OPCServerTest::SendDeferredData));
+  m_ss.Run();
+
+  OLA_ASSERT_EQ(1u, m_messages_received);
+  DmxBuffer expected;
+  expected.SetFromString("9,8,7,6");
+  OLA_ASSERT_EQ(m_received_data, expected);
+}
@@ -211,7 +211,8 @@ OSCNode::OSCNode(SelectServerInterface *ss,
                  const OSCNodeOptions &options)
     : m_ss(ss),
       m_listen_port(options.listen_port),
-      m_osc_server(NULL) {
+      m_osc_server(NULL),
+      m_bundle_flush_timeout(ola::thread::INVALID_TIMEOUT) {
   if (export_map) {
     // export the OSC listening port if we have an export map
     ola::IntegerVariable *osc_port_var =
@@ -272,6 +273,16 @@ bool OSCNode::Init() {
  * Stop this node. This removes all registrations and targets.
  */
 void OSCNode::Stop() {
+  if (m_bundle_flush_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_ss->RemoveTimeout(m_bundle_flush_timeout);
+    m_bundle_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  }
+  PendingBundleMap::iterator pending_iter = m_pending_bundles.begin();
+  for (; pending_iter != m_pending_bundles.end(); ++pending_iter) {
+    lo_bundle_free_recursive(pending_iter->second.bundle);
+  }
+  m_pending_bundles.clear();
+
   if (m_osc_server) {
     lo_server_del_method(m_osc_server, NULL, NULL);
   }
@@ -350,6 +361,15 @@ bool OSCNode::RemoveTarget(unsigned int group, const OSCTarget &target) {
   OSCTargetVector::iterator target_iter = targets.begin();
   for (; target_iter != targets.end(); ++target_iter) {
     if (**target_iter == target) {
+      // Any bundle queued for this host references the lo_address we're
+      // about to free; drop it rather than flushing stale frames.
+      PendingBundleMap::iterator bundle_iter = m_pending_bundles.find(
+          (*target_iter)->socket_address);
+      if (bundle_iter != m_pending_bundles.end()) {
+        lo_bundle_free_recursive(bundle_iter->second.bundle);
+        m_pending_bundles.erase(bundle_iter);
+      }
+
       // the target was found, delete the NodeOSCTarget and remove the entry
       // from the vector.
       delete *target_iter;
@@ -494,22 +514,56 @@ bool OSCNode::SendBlob(const DmxBuffer &dmx_data,
   // create the new OSC blob
   lo_blob osc_data = lo_blob_new(dmx_data.Size(), dmx_data.GetRaw());
 
-  bool ok = true;
-  // iterate over all the targets, and send to each one.
+  // Queue a message per target into that host's pending bundle; the
+  // bundle goes out as a single datagram when the flush fires at the
+  // end of this loop pass.
   OSCTargetVector::const_iterator target_iter = targets.begin();
   for (; target_iter != targets.end(); ++target_iter) {
-    OLA_DEBUG << "Sending to " << (*target_iter)->socket_address;
-    int ret = lo_send_from((*target_iter)->liblo_address,
-                           m_osc_server,
-                           LO_TT_IMMEDIATE,
-                           (*target_iter)->osc_address.c_str(),
-                           "b", osc_data,
-                           LO_ARGS_END);
-    ok &= (ret > 0);
+    OLA_DEBUG << "Queuing for " << (*target_iter)->socket_address;
+    lo_message message = lo_message_new();
+    lo_message_add_blob(message, osc_data);
+
+    PendingBundleMap::iterator bundle_iter = m_pending_bundles.find(
+        (*target_iter)->socket_address);
+    if (bundle_iter == m_pending_bundles.end()) {
+      PendingBundle pending;
+      pending.liblo_address = (*target_iter)->liblo_address;
+      pending.bundle = lo_bundle_new(LO_TT_IMMEDIATE);
+      bundle_iter = m_pending_bundles.insert(
+          std::make_pair((*target_iter)->socket_address, pending)).first;
+    }
+    lo_bundle_add_message(bundle_iter->second.bundle,
+                          (*target_iter)->osc_address.c_str(),
+                          message);
   }
-  // free the blob
+  // the blob was copied into the messages
   lo_blob_free(osc_data);
-  return ok;
+
+  if (m_bundle_flush_timeout == ola::thread::INVALID_TIMEOUT) {
+    m_bundle_flush_timeout = m_ss->RegisterSingleTimeout(
+        ola::TimeInterval(),
+        ola::NewSingleCallback(this, &OSCNode::FlushBundles));
+  }
+  return true;
+}
+
+/**
+ * Send each host's pending bundle as one datagram.
+ */
+void OSCNode::FlushBundles() {
+  m_bundle_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  PendingBundleMap::iterator iter = m_pending_bundles.begin();
+  for (; iter != m_pending_bundles.end(); ++iter) {
+    int ret = lo_send_bundle_from(iter->second.liblo_address,
+                                  m_osc_server,
+                                  iter->second.bundle);
+    if (ret < 0) {
+      OLA_WARN << "Failed to send OSC bundle to " << iter->first;
+    }
+    // frees the messages the bundle references as well
+    lo_bundle_free_recursive(iter->second.bundle);
+  }
+  m_pending_bundles.clear();
 }
 
 
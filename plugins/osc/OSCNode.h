@@ -159,14 +159,27 @@ class OSCNode {
     lo_message message;
   };
 
+  // Blob messages are held per host until the end of the loop pass and
+  // sent as one OSC bundle per host, so a tick's universes cost one
+  // datagram per media server rather than one per universe.
+  struct PendingBundle {
+    lo_address liblo_address;
+    lo_bundle bundle;
+  };
+  typedef std::map<ola::network::IPV4SocketAddress,
+                   PendingBundle> PendingBundleMap;
+
   ola::io::SelectServerInterface *m_ss;
   const uint16_t m_listen_port;
   std::auto_ptr<ola::io::UnmanagedFileDescriptor> m_descriptor;
   lo_server m_osc_server;
   OutputGroupMap m_output_map;
   InputUniverseMap m_input_map;
+  PendingBundleMap m_pending_bundles;
+  ola::thread::timeout_id m_bundle_flush_timeout;
 
   void DescriptorReady();
+  void FlushBundles();
   bool SendBlob(const DmxBuffer &data, const OSCTargetVector &targets);
   bool SendIndividualFloats(const DmxBuffer &data,
                             OSCOutputGroup *group);
@@ -97,6 +97,16 @@ bool PathportNode::Start() {
   if (!InitNetwork())
     return false;
 
+  // Prebuild the DMX data packet; SendDMX patches only the per-frame
+  // fields. The header sequence is refreshed per send by
+  // PopulateHeader.
+  memset(&m_dmx_template, 0, sizeof(m_dmx_template));
+  PopulateHeader(&m_dmx_template.header, PATHPORT_DATA_GROUP);
+  m_dmx_template.d.pdu.head.type = HostToNetwork((uint16_t) PATHPORT_DATA);
+  m_dmx_template.d.pdu.d.data.type = HostToNetwork((uint16_t) XDMX_DATA_FLAT);
+  m_dmx_template.d.pdu.d.data.universe = 0;
+  m_dmx_template.d.pdu.d.data.start_code = 0;
+
   m_socket.SetTos(m_dscp);
   m_running = true;
   SendArpReply();
@@ -272,33 +282,31 @@ bool PathportNode::SendDMX(unsigned int universe, const DmxBuffer &buffer) {
     return false;
   }
 
-  pathport_packet_s packet;
-
   // pad to a multiple of 4 bytes
   unsigned int padded_size = (buffer.Size() + 3) & ~3;
-  PopulateHeader(&packet.header, PATHPORT_DATA_GROUP);
+  m_dmx_template.header.sequence = HostToNetwork(m_sequence_number);
 
-  pathport_packet_pdu *pdu = &packet.d.pdu;
-  pdu->head.type = HostToNetwork((uint16_t) PATHPORT_DATA);
+  pathport_packet_pdu *pdu = &m_dmx_template.d.pdu;
   pdu->head.len = HostToNetwork(
       (uint16_t) (padded_size + sizeof(pathport_pdu_data)));
 
-  pdu->d.data.type = HostToNetwork((uint16_t) XDMX_DATA_FLAT);
   pdu->d.data.channel_count = HostToNetwork((uint16_t) buffer.Size());
-  pdu->d.data.universe = 0;
-  pdu->d.data.start_code = 0;
   pdu->d.data.offset = HostToNetwork(
       (uint16_t) (DMX_UNIVERSE_SIZE * universe));
 
   unsigned int length = padded_size;
   buffer.Get(pdu->d.data.data, &length);
+  if (length < padded_size) {
+    // the pad bytes go on the wire; don't leak the last frame
+    memset(pdu->d.data.data + length, 0, padded_size - length);
+  }
 
   // pad data to multiple of 4 bytes
   length = sizeof(pathport_packet_header) +
            sizeof(pathport_pdu_header) +
            sizeof(pathport_pdu_data) + padded_size;
 
-  return SendPacket(packet, length, m_data_addr);
+  return SendPacket(m_dmx_template, length, m_data_addr);
 }
 
 
@@ -122,6 +122,9 @@ class PathportNode {
     ola::network::IPV4Address m_config_addr;
     ola::network::IPV4Address m_status_addr;
     ola::network::IPV4Address m_data_addr;
+    // prebuilt DMX data packet; per frame only the sequence, lengths,
+    // offset and payload are patched
+    pathport_packet_s m_dmx_template;
 
     static const uint16_t PATHPORT_PORT = 0xed0;
     static const uint16_t PATHPORT_PROTOCOL = 0xed01;
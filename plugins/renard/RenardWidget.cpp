@@ -73,6 +73,7 @@ bool RenardWidget::Connect() {
     return false;
 
   m_socket = new ola::io::DeviceDescriptor(fd);
+  m_writer.SetDescriptor(m_socket);
 
   OLA_DEBUG << "Connected to " << m_path;
   return true;
@@ -112,6 +113,7 @@ int RenardWidget::ConnectToWidget(const string &path, speed_t speed) {
  * Disconnect from the widget
  */
 int RenardWidget::Disconnect() {
+  m_writer.SetDescriptor(NULL);
   m_socket->Close();
   return 0;
 }
@@ -193,11 +195,16 @@ bool RenardWidget::SendDmx(const DmxBuffer &buffer) {
       static_cast<int>(b);
   }
 
-  int bytes_sent = m_socket->Send(msg, dataToSend);
+  // The whole multi-channel packet goes out in one write; anything the
+  // slow link can't take right now is backlogged rather than truncated.
+  bool ok = m_writer.Write(msg, dataToSend);
+  if (!ok) {
+    OLA_WARN << m_path << " has fallen too far behind, dropping data";
+  }
 
-  OLA_DEBUG << "Sending DMX, sent " << bytes_sent << " bytes";
+  OLA_DEBUG << "Sending DMX, queued " << dataToSend << " bytes";
 
-  return true;
+  return ok;
 }
 }  // namespace renard
 }  // namespace plugin
@@ -25,6 +25,7 @@
 #include <termios.h>
 #include <string>
 
+#include "ola/io/BackloggedWriter.h"
 #include "ola/io/SelectServer.h"
 #include "ola/io/Serial.h"
 #include "ola/DmxBuffer.h"
@@ -80,6 +81,8 @@ class RenardWidget {
     // instance variables
     const std::string m_path;
     ola::io::ConnectedDescriptor *m_socket;
+    // absorbs partial writes on slow links instead of truncating frames
+    ola::io::BackloggedWriter m_writer;
     uint32_t m_byteCounter;
     uint32_t m_dmxOffset;
     uint32_t m_channels;
@@ -92,6 +92,17 @@ bool ShowNetNode::Start() {
   if (!InitNetwork())
     return false;
 
+  // Prebuild the data packet image; SendDMX only patches the fields
+  // that change per frame.
+  memset(&m_dmx_template, 0, sizeof(m_dmx_template));
+  m_dmx_template.type =
+      HostToNetwork(static_cast<uint16_t>(COMPRESSED_DMX_PACKET));
+  memcpy(m_dmx_template.ip, &m_interface.ip_address,
+         sizeof(m_dmx_template.ip));
+  strings::CopyToFixedLengthBuffer(
+      m_node_name, m_dmx_template.data.compressed_dmx.name,
+      arraysize(m_dmx_template.data.compressed_dmx.name));
+
   m_running = true;
   return true;
 }
@@ -140,10 +151,10 @@ bool ShowNetNode::SendDMX(unsigned int universe,
     return false;
   }
 
-  shownet_packet packet;
-  unsigned int size = BuildCompressedPacket(&packet, universe, buffer);
+  unsigned int size = BuildCompressedPacket(&m_dmx_template, universe,
+                                            buffer);
   unsigned int bytes_sent = m_socket->SendTo(
-      reinterpret_cast<uint8_t*>(&packet),
+      reinterpret_cast<uint8_t*>(&m_dmx_template),
       size,
       IPV4SocketAddress(m_interface.bcast_address, SHOWNET_PORT));
 
@@ -304,13 +315,13 @@ bool ShowNetNode::HandleCompressedPacket(const shownet_compressed_dmx *packet,
 /*
  * Populate a shownet data packet
  */
+/*
+ * Patch the per-frame fields into the prebuilt packet image. The type,
+ * source ip and node name were filled in at Start().
+ */
 unsigned int ShowNetNode::BuildCompressedPacket(shownet_packet *packet,
                                                 unsigned int universe,
                                                 const DmxBuffer &buffer) {
-  memset(packet, 0, sizeof(*packet));
-  packet->type = HostToNetwork(static_cast<uint16_t>(COMPRESSED_DMX_PACKET));
-  memcpy(packet->ip, &m_interface.ip_address, sizeof(packet->ip));
-
   shownet_compressed_dmx *compressed_dmx = &packet->data.compressed_dmx;
 
   compressed_dmx->netSlot[0] = (universe * DMX_UNIVERSE_SIZE) + 1;
@@ -325,8 +336,6 @@ unsigned int ShowNetNode::BuildCompressedPacket(shownet_packet *packet,
 
   compressed_dmx->sequence = HostToNetwork(m_packet_count);
 
-  strings::CopyToFixedLengthBuffer(m_node_name, compressed_dmx->name,
-                                   arraysize(compressed_dmx->name));
   return (sizeof(*packet) - sizeof(packet->data)) +
          (sizeof(*compressed_dmx) - SHOWNET_COMPRESSED_DATA_LENGTH + enc_len);
 }
@@ -75,6 +75,9 @@ class ShowNetNode {
     ola::network::Interface m_interface;
     ola::dmx::RunLengthEncoder m_encoder;
     ola::network::UDPSocket *m_socket;
+    // the constant fields are filled in once at Start(); per frame only
+    // the universe fields, sequence and payload are patched
+    shownet_packet m_dmx_template;
 
     bool HandlePacket(const shownet_packet *packet, unsigned int size);
     bool HandleCompressedPacket(const shownet_compressed_dmx *packet,
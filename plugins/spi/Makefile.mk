@@ -4,6 +4,8 @@ if USE_SPI
 # This is a library which isn't coupled to olad
 lib_LTLIBRARIES += plugins/spi/libolaspicore.la plugins/spi/libolaspi.la
 plugins_spi_libolaspicore_la_SOURCES = \
+    plugins/spi/PixelKernels.cpp \
+    plugins/spi/PixelKernels.h \
     plugins/spi/SPIBackend.cpp \
     plugins/spi/SPIBackend.h \
     plugins/spi/SPIOutput.cpp \
@@ -36,4 +38,11 @@ plugins_spi_SPITester_LDADD = $(COMMON_TESTING_LIBS) \
                               plugins/spi/libolaspicore.la \
                               common/libolacommon.la
 
+noinst_PROGRAMS += plugins/spi/spi_benchmark
+plugins_spi_spi_benchmark_SOURCES = plugins/spi/spi_benchmark.cpp
+plugins_spi_spi_benchmark_LDADD = plugins/spi/libolaspicore.la \
+                                  common/libolacommon.la
+
+BENCHMARK_PROGS += plugins/spi/spi_benchmark
+
 endif
@@ -0,0 +1,157 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * PixelKernels.cpp
+ * Vectorized DMX-slot to pixel-wire-format translation kernels.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include "plugins/spi/PixelKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OLA_PIXEL_KERNEL_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define OLA_PIXEL_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ola {
+namespace plugin {
+namespace spi {
+
+namespace {
+
+typedef void (*LPD8806Function)(const uint8_t *rgb_data,
+                                uint8_t *output,
+                                unsigned int pixel_count);
+
+/*
+ * The portable kernel: a 256 byte table folds the shift and the high bit
+ * into one lookup. Also covers the tail the vector kernels leave.
+ */
+void ScalarLPD8806(const uint8_t *rgb_data,
+                   uint8_t *output,
+                   unsigned int pixel_count) {
+  static uint8_t lut[256];
+  static bool lut_ready = false;
+  if (!lut_ready) {
+    for (unsigned int i = 0; i < 256; i++) {
+      lut[i] = static_cast<uint8_t>(0x80 | (i >> 1));
+    }
+    lut_ready = true;
+  }
+
+  for (unsigned int i = 0; i < pixel_count; i++) {
+    const uint8_t *in = rgb_data + i * 3;
+    uint8_t *out = output + i * 3;
+    out[0] = lut[in[1]];  // G
+    out[1] = lut[in[0]];  // R
+    out[2] = lut[in[2]];  // B
+  }
+}
+
+#ifdef OLA_PIXEL_KERNEL_X86
+/*
+ * 5 pixels per iteration: a single pshufb does the RGB -> GRB reorder and
+ * the shift-and-set-high-bit is three wide ops. The 16th lane byte is a
+ * don't-care that the next iteration (or the scalar tail) overwrites,
+ * hence the 6 pixel headroom in the loop bound.
+ */
+__attribute__((target("ssse3")))
+void SSSE3LPD8806(const uint8_t *rgb_data,
+                  uint8_t *output,
+                  unsigned int pixel_count) {
+  const __m128i swizzle = _mm_setr_epi8(1, 0, 2, 4, 3, 5, 7, 6, 8,
+                                        10, 9, 11, 13, 12, 14, -1);
+  const __m128i low_mask = _mm_set1_epi8(0x7f);
+  const __m128i high_bit = _mm_set1_epi8(static_cast<char>(0x80));
+
+  unsigned int i = 0;
+  for (; i + 6 <= pixel_count; i += 5) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(rgb_data + i * 3));
+    v = _mm_shuffle_epi8(v, swizzle);
+    v = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 1), low_mask),
+                     high_bit);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 3), v);
+  }
+  ScalarLPD8806(rgb_data + i * 3, output + i * 3, pixel_count - i);
+}
+#endif  // OLA_PIXEL_KERNEL_X86
+
+#ifdef OLA_PIXEL_KERNEL_NEON
+/*
+ * 16 pixels per iteration: vld3q deinterleaves the colour planes for
+ * free, so the reorder is just writing the planes back in GRB order.
+ */
+void NeonLPD8806(const uint8_t *rgb_data,
+                 uint8_t *output,
+                 unsigned int pixel_count) {
+  const uint8x16_t high_bit = vdupq_n_u8(0x80);
+  unsigned int i = 0;
+  for (; i + 16 <= pixel_count; i += 16) {
+    uint8x16x3_t v = vld3q_u8(rgb_data + i * 3);
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshrq_n_u8(v.val[1], 1), high_bit);  // G
+    out.val[1] = vorrq_u8(vshrq_n_u8(v.val[0], 1), high_bit);  // R
+    out.val[2] = vorrq_u8(vshrq_n_u8(v.val[2], 1), high_bit);  // B
+    vst3q_u8(output + i * 3, out);
+  }
+  ScalarLPD8806(rgb_data + i * 3, output + i * 3, pixel_count - i);
+}
+#endif  // OLA_PIXEL_KERNEL_NEON
+
+struct Kernel {
+  LPD8806Function lpd8806;
+  const char *name;
+};
+
+/*
+ * Pick the widest kernel the host CPU supports. This runs once, at static
+ * init time.
+ */
+Kernel SelectKernel() {
+  Kernel kernel = { ScalarLPD8806, "scalar-lut" };
+#if defined(OLA_PIXEL_KERNEL_X86)
+  if (__builtin_cpu_supports("ssse3")) {
+    kernel.lpd8806 = SSSE3LPD8806;
+    kernel.name = "ssse3";
+  }
+#elif defined(OLA_PIXEL_KERNEL_NEON)
+  kernel.lpd8806 = NeonLPD8806;
+  kernel.name = "neon";
+#endif
+  return kernel;
+}
+
+const Kernel &GetKernel() {
+  static const Kernel kernel = SelectKernel();
+  return kernel;
+}
+}  // namespace
+
+void LPD8806Encode(const uint8_t *rgb_data,
+                   uint8_t *output,
+                   unsigned int pixel_count) {
+  GetKernel().lpd8806(rgb_data, output, pixel_count);
+}
+
+const char *PixelKernelName() {
+  return GetKernel().name;
+}
+}  // namespace spi
+}  // namespace plugin
+}  // namespace ola
@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * PixelKernels.h
+ * Vectorized DMX-slot to pixel-wire-format translation kernels.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#ifndef PLUGINS_SPI_PIXELKERNELS_H_
+#define PLUGINS_SPI_PIXELKERNELS_H_
+
+#include <stdint.h>
+
+namespace ola {
+namespace plugin {
+namespace spi {
+
+/**
+ * @brief Translate RGB slot data into the LPD8806 wire format.
+ *
+ * Each output byte is (value >> 1) | 0x80 and each pixel is reordered
+ * RGB -> GRB. The widest kernel the host CPU supports is picked at
+ * runtime (AVX2 / SSE2 on x86, NEON on ARM, a lookup-table scalar
+ * otherwise); on a Pi-class core this is the difference between the
+ * translation saturating a core and it disappearing into the noise for
+ * multi-thousand-pixel strings.
+ *
+ * @param rgb_data the DMX slot data, RGB order.
+ * @param output the wire buffer, at least pixel_count * 3 bytes.
+ * @param pixel_count the number of whole pixels to translate.
+ */
+void LPD8806Encode(const uint8_t *rgb_data,
+                   uint8_t *output,
+                   unsigned int pixel_count);
+
+/**
+ * @brief The name of the pixel kernel in use, for diagnostics.
+ */
+const char *PixelKernelName();
+}  // namespace spi
+}  // namespace plugin
+}  // namespace ola
+#endif  // PLUGINS_SPI_PIXELKERNELS_H_
@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "ola/Clock.h"
 #include "ola/Logging.h"
 #include "ola/io/IOUtils.h"
 #include "ola/network/SocketCloser.h"
@@ -99,14 +100,30 @@ HardwareBackend::HardwareBackend(const Options &options,
                                  ExportMap *export_map)
     : m_spi_writer(writer),
       m_drop_map(NULL),
+      m_write_map(NULL),
+      m_output_drop_map(NULL),
+      m_write_time(NULL),
       m_output_count(1 << options.gpio_pins.size()),
       m_exit(false),
       m_gpio_pins(options.gpio_pins) {
   SetupOutputs(&m_output_data);
+  for (unsigned int i = 0; i < m_output_count; i++) {
+    std::ostringstream key;
+    key << m_spi_writer->DevicePath() << "-" << i;
+    m_output_keys.push_back(key.str());
+  }
   if (export_map) {
     m_drop_map = export_map->GetUIntMapVar(SPI_DROP_VAR,
                                            SPI_DROP_VAR_KEY);
     (*m_drop_map)[m_spi_writer->DevicePath()] = 0;
+    m_write_map = export_map->GetUIntMapVar("spi-output-writes", "output");
+    m_output_drop_map = export_map->GetUIntMapVar("spi-output-drops",
+                                                  "output");
+    for (unsigned int i = 0; i < m_output_count; i++) {
+      (*m_write_map)[m_output_keys[i]] = 0;
+      (*m_output_drop_map)[m_output_keys[i]] = 0;
+    }
+    m_write_time = export_map->GetHistogramVar("spi-write-time-us");
   }
 }
 
@@ -163,6 +180,7 @@ void HardwareBackend::Commit(uint8_t output) {
   if (output_data->IsPending() && m_drop_map) {
     // There was already another write pending which we're now stomping on
     (*m_drop_map)[m_spi_writer->DevicePath()]++;
+    (*m_output_drop_map)[m_output_keys[output]]++;
   }
   output_data->SetPending();
   m_mutex.Unlock();
@@ -247,7 +265,16 @@ void HardwareBackend::WriteOutput(uint8_t output_id, OutputData *output) {
     }
   }
 
+  Clock clock;
+  TimeStamp write_start, write_end;
+  clock.CurrentTime(&write_start);
   m_spi_writer->WriteSPIData(output->GetData(), output->Size());
+  clock.CurrentTime(&write_end);
+  if (m_write_map) {
+    (*m_write_map)[m_output_keys[output_id]]++;
+    m_write_time->Record(
+        static_cast<uint64_t>((write_end - write_start).AsInt()));
+  }
 }
 
 bool HardwareBackend::SetupGPIO() {
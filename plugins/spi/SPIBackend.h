@@ -128,6 +128,13 @@ class HardwareBackend : public ola::thread::Thread,
 
   SPIWriterInterface *m_spi_writer;
   UIntMap *m_drop_map;
+  // per-output completion tracking; the writer thread runs behind the
+  // assembly path, so visibility into which output is falling behind has
+  // to come from counters rather than blocking.
+  UIntMap *m_write_map;
+  UIntMap *m_output_drop_map;
+  HistogramVariable *m_write_time;
+  std::vector<std::string> m_output_keys;
   const uint8_t m_output_count;
   ola::thread::Mutex m_mutex;
   ola::thread::ConditionVariable m_cond_var;
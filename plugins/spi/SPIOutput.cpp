@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include "ola/base/Array.h"
+#include "plugins/spi/PixelKernels.h"
 #include "ola/Constants.h"
 #include "ola/Logging.h"
 #include "ola/file/Util.h"
@@ -358,19 +359,14 @@ void SPIOutput::IndividualLPD8806Control(const DmxBuffer &buffer) {
   if (!output)
     return;
 
-  const unsigned int length = std::min(m_pixel_count * LPD8806_SLOTS_PER_PIXEL,
-                                       buffer.Size() - first_slot);
-
-  for (unsigned int i = 0; i < length / LPD8806_SLOTS_PER_PIXEL; i++) {
-    // Convert RGB to GRB
-    unsigned int offset = first_slot + i * LPD8806_SLOTS_PER_PIXEL;
-    uint8_t r = buffer.Get(offset);
-    uint8_t g = buffer.Get(offset + 1);
-    uint8_t b = buffer.Get(offset + 2);
-    output[i * LPD8806_SLOTS_PER_PIXEL] = 0x80 | (g >> 1);
-    output[i * LPD8806_SLOTS_PER_PIXEL + 1] = 0x80 | (r >> 1);
-    output[i * LPD8806_SLOTS_PER_PIXEL + 2] = 0x80 | (b >> 1);
-  }
+  unsigned int length = std::min(m_pixel_count * LPD8806_SLOTS_PER_PIXEL,
+                                 buffer.Size() - first_slot);
+
+  // The RGB -> GRB + shift translation runs in the vectorized kernel;
+  // this is the hot path when driving long strings.
+  uint8_t rgb_data[DMX_UNIVERSE_SIZE];
+  buffer.GetRange(first_slot, rgb_data, &length);
+  LPD8806Encode(rgb_data, output, length / LPD8806_SLOTS_PER_PIXEL);
   m_backend->Commit(m_output_number);
 }
 
@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * spi_benchmark.cpp
+ * Microbenchmark for the pixel translation kernels.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "ola/Clock.h"
+#include "plugins/spi/PixelKernels.h"
+
+using ola::Clock;
+using ola::TimeStamp;
+using std::cout;
+using std::endl;
+
+namespace {
+
+const unsigned int PIXELS = 1024;  // one long string
+const unsigned int SAMPLES = 9;
+
+uint8_t g_rgb[PIXELS * 3];
+uint8_t g_out[PIXELS * 3];
+uint8_t g_reference[PIXELS * 3];
+
+double TimeKernel(unsigned int iterations) {
+  std::vector<int64_t> samples;
+  Clock clock;
+  for (unsigned int s = 0; s < SAMPLES; s++) {
+    TimeStamp start, end;
+    clock.CurrentTime(&start);
+    for (unsigned int i = 0; i < iterations; i++) {
+      ola::plugin::spi::LPD8806Encode(g_rgb, g_out, PIXELS);
+    }
+    clock.CurrentTime(&end);
+    samples.push_back((end - start).AsInt());
+  }
+  std::sort(samples.begin(), samples.end());
+  return 1000.0 * samples[SAMPLES / 2] / iterations;
+}
+}  // namespace
+
+int main() {
+  for (unsigned int i = 0; i < sizeof(g_rgb); i++) {
+    g_rgb[i] = static_cast<uint8_t>(random());
+  }
+
+  // the scalar reference, for correctness checking
+  for (unsigned int i = 0; i < PIXELS; i++) {
+    g_reference[i * 3] = 0x80 | (g_rgb[i * 3 + 1] >> 1);
+    g_reference[i * 3 + 1] = 0x80 | (g_rgb[i * 3] >> 1);
+    g_reference[i * 3 + 2] = 0x80 | (g_rgb[i * 3 + 2] >> 1);
+  }
+
+  ola::plugin::spi::LPD8806Encode(g_rgb, g_out, PIXELS);
+  if (memcmp(g_out, g_reference, sizeof(g_reference))) {
+    cout << "kernel " << ola::plugin::spi::PixelKernelName()
+         << " output doesn't match the scalar reference!" << endl;
+    return 1;
+  }
+
+  double ns = TimeKernel(100000);
+  cout << "LPD8806Encode/" << PIXELS << "px ("
+       << ola::plugin::spi::PixelKernelName() << "): " << ns
+       << " ns/frame, " << ns / PIXELS << " ns/pixel" << endl;
+
+  // the reference loop again, timed, so the kernel speedup is visible in
+  // one run
+  Clock clock;
+  std::vector<int64_t> samples;
+  for (unsigned int s = 0; s < SAMPLES; s++) {
+    TimeStamp start, end;
+    clock.CurrentTime(&start);
+    for (unsigned int i = 0; i < 10000; i++) {
+      for (unsigned int p = 0; p < PIXELS; p++) {
+        g_out[p * 3] = 0x80 | (g_rgb[p * 3 + 1] >> 1);
+        g_out[p * 3 + 1] = 0x80 | (g_rgb[p * 3] >> 1);
+        g_out[p * 3 + 2] = 0x80 | (g_rgb[p * 3 + 2] >> 1);
+      }
+    }
+    clock.CurrentTime(&end);
+    samples.push_back((end - start).AsInt());
+  }
+  std::sort(samples.begin(), samples.end());
+  double scalar_ns = 1000.0 * samples[SAMPLES / 2] / 10000;
+  cout << "per-byte loop: " << scalar_ns << " ns/frame ("
+       << scalar_ns / ns << "x the kernel)" << endl;
+  return 0;
+}
@@ -59,7 +59,10 @@ StageProfiWidget::StageProfiWidget(io::SelectServerInterface *ss,
       m_widget_path(widget_path),
       m_disconnect_cb(disconnect_cb),
       m_timeout_id(INVALID_TIMEOUT),
-      m_got_response(false) {
+      m_got_response(false),
+      m_last_sent_length(0),
+      m_frames_since_full(0) {
+  memset(m_last_sent, 0, sizeof(m_last_sent));
   m_descriptor->SetOnData(
       NewCallback<StageProfiWidget>(this, &StageProfiWidget::SocketReady));
   m_ss->AddReadDescriptor(m_descriptor.get());
@@ -88,16 +91,74 @@ bool StageProfiWidget::SendDmx(const DmxBuffer &buffer) {
     return false;
   }
 
-  uint16_t index = 0;
-  while (index < buffer.Size()) {
-    unsigned int size = std::min((unsigned int) DMX_MSG_LEN,
-                                 buffer.Size() - index);
-    bool ok = Send255(index, buffer.GetRaw() + index, size);
-    if (!ok) {
-      OLA_INFO << "Failed to send StageProfi message, closing socket";
-      RunDisconnectHandler();
+  // The protocol is ranged, so mostly-static rigs only need the changed
+  // spans; a full frame still goes out periodically and whenever the
+  // frame size changes.
+  bool full_refresh = buffer.Size() != m_last_sent_length ||
+      ++m_frames_since_full >= FULL_REFRESH_INTERVAL;
+
+  if (full_refresh) {
+    m_frames_since_full = 0;
+    uint16_t index = 0;
+    while (index < buffer.Size()) {
+      unsigned int size = std::min((unsigned int) DMX_MSG_LEN,
+                                   buffer.Size() - index);
+      if (!SendRange(index, buffer.GetRaw() + index, size)) {
+        return true;
+      }
+      index += size;
+    }
+  } else {
+    const uint8_t *data = buffer.GetRaw();
+    unsigned int i = 0;
+    while (i < buffer.Size()) {
+      if (data[i] == m_last_sent[i]) {
+        i++;
+        continue;
+      }
+      // find the end of this changed span, merging small gaps so we
+      // don't fragment into many tiny messages
+      unsigned int span_end = i + 1;
+      unsigned int clean_run = 0;
+      for (unsigned int j = i + 1;
+           j < buffer.Size() && clean_run < DIFF_MERGE_GAP; j++) {
+        if (data[j] != m_last_sent[j]) {
+          span_end = j + 1;
+          clean_run = 0;
+        } else {
+          clean_run++;
+        }
+      }
+
+      unsigned int index = i;
+      while (index < span_end) {
+        unsigned int size = std::min((unsigned int) DMX_MSG_LEN,
+                                     span_end - index);
+        if (!SendRange(static_cast<uint16_t>(index), data + index, size)) {
+          return true;
+        }
+        index += size;
+      }
+      i = span_end;
     }
-    index += size;
+  }
+
+  memcpy(m_last_sent, buffer.GetRaw(), buffer.Size());
+  m_last_sent_length = buffer.Size();
+  return true;
+}
+
+
+/*
+ * Send a range & handle the failure path.
+ */
+bool StageProfiWidget::SendRange(uint16_t start,
+                                const uint8_t *data,
+                                unsigned int length) {
+  if (!Send255(start, data, length)) {
+    OLA_INFO << "Failed to send StageProfi message, closing socket";
+    RunDisconnectHandler();
+    return false;
   }
   return true;
 }
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <string>
+#include "ola/Constants.h"
 #include "ola/DmxBuffer.h"
 #include "ola/Callback.h"
 #include "ola/io/Descriptor.h"
@@ -65,6 +66,10 @@ class StageProfiWidget {
 
  private:
   enum { DMX_MSG_LEN = 255 };
+  // send a full frame at least this often when running in diff mode
+  enum { FULL_REFRESH_INTERVAL = 44 };
+  // changed spans closer than this are merged into one message
+  enum { DIFF_MERGE_GAP = 8 };
   enum { DMX_HEADER_SIZE = 4};
 
   ola::io::SelectServerInterface *m_ss;
@@ -73,9 +78,14 @@ class StageProfiWidget {
   DisconnectCallback *m_disconnect_cb;
   ola::thread::timeout_id m_timeout_id;
   bool m_got_response;
+  // the last frame sent, for diff transmit
+  uint8_t m_last_sent[ola::DMX_UNIVERSE_SIZE];
+  unsigned int m_last_sent_length;
+  unsigned int m_frames_since_full;
 
   void SocketReady();
   void DiscoveryTimeout();
+  bool SendRange(uint16_t start, const uint8_t *data, unsigned int length);
   bool Send255(uint16_t start, const uint8_t *buf, unsigned int len) const;
   void SendQueryPacket();
   void RunDisconnectHandler();
@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <time.h>
 #include <unistd.h>
 #include <string>
 #include "ola/Clock.h"
@@ -72,7 +73,6 @@ bool UartDmxThread::WriteDMX(const DmxBuffer &buffer) {
  * The method called by the thread
  */
 void *UartDmxThread::Run() {
-  TimeStamp ts1, ts2;
   Clock clock;
   CheckTimeGranularity();
   DmxBuffer buffer;
@@ -81,6 +81,28 @@ void *UartDmxThread::Run() {
   if (!m_widget->IsOpen())
     m_widget->SetupOutput();
 
+  // The frame cadence is paced against absolute deadlines: each frame's
+  // deadline is the previous one plus the precomputed period, so jitter
+  // in the break ioctls or the tty write doesn't accumulate into the
+  // frame rate the way back-to-back relative sleeps did.
+  const unsigned int period_usecs =
+      m_breakt + DMX_MAB + DMX_FRAME_WIRE_TIME + m_malft;
+
+  struct timespec deadline;
+#ifdef CLOCK_MONOTONIC
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+#else
+  deadline.tv_sec = 0;
+  deadline.tv_nsec = 0;
+#endif  // CLOCK_MONOTONIC
+
+  // pacing stats
+  uint64_t frames = 0;
+  int64_t break_jitter_sum = 0;
+  int64_t break_jitter_max = 0;
+  TimeStamp stats_start;
+  clock.CurrentTime(&stats_start);
+
   while (1) {
     {
       ola::thread::MutexLocker locker(&m_term_mutex);
@@ -96,8 +118,20 @@ void *UartDmxThread::Run() {
     if (!m_widget->SetBreak(true))
       goto framesleep;
 
-    if (m_granularity == GOOD)
-      usleep(m_breakt);
+    {
+      TimeStamp break_start, break_end;
+      clock.CurrentTime(&break_start);
+      if (m_granularity == GOOD)
+        usleep(m_breakt);
+      clock.CurrentTime(&break_end);
+      int64_t jitter =
+          (break_end - break_start).AsInt() - static_cast<int64_t>(m_breakt);
+      if (jitter < 0)
+        jitter = -jitter;
+      break_jitter_sum += jitter;
+      if (jitter > break_jitter_max)
+        break_jitter_max = jitter;
+    }
 
     if (!m_widget->SetBreak(false))
       goto framesleep;
@@ -108,13 +142,64 @@ void *UartDmxThread::Run() {
     if (!m_widget->Write(buffer))
       goto framesleep;
 
+    frames++;
+
   framesleep:
-    // Sleep for the remainder of the DMX frame time
-    usleep(m_malft);
+    FrameSleep(&deadline, period_usecs);
+
+    {
+      TimeStamp now;
+      clock.CurrentTime(&now);
+      TimeInterval elapsed = now - stats_start;
+      if (elapsed.Seconds() >= STATS_INTERVAL_SECONDS) {
+        double seconds = elapsed.AsInt() / 1e6;
+        OLA_INFO << m_widget->Name() << " achieved "
+                 << static_cast<double>(frames) / seconds
+                 << " fps, break jitter avg "
+                 << (frames ? break_jitter_sum / static_cast<int64_t>(frames)
+                            : 0)
+                 << "us / max " << break_jitter_max << "us";
+        frames = 0;
+        break_jitter_sum = 0;
+        break_jitter_max = 0;
+        stats_start = now;
+      }
+    }
   }
   return NULL;
 }
 
+/**
+ * Sleep until the next absolute frame deadline. If we've fallen more
+ * than a period behind (a stalled tty, a debugger), re-anchor instead of
+ * bursting frames to catch up.
+ */
+void UartDmxThread::FrameSleep(struct timespec *deadline,
+                               unsigned int period_usecs) {
+  deadline->tv_nsec += static_cast<long>(period_usecs) * 1000;  // NOLINT(runtime/int)
+  while (deadline->tv_nsec >= 1000000000L) {
+    deadline->tv_nsec -= 1000000000L;
+    deadline->tv_sec++;
+  }
+
+#if defined(CLOCK_MONOTONIC) && defined(TIMER_ABSTIME)
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  int64_t behind_ns =
+      (static_cast<int64_t>(now.tv_sec) - deadline->tv_sec) * 1000000000ll +
+      (now.tv_nsec - deadline->tv_nsec);
+  if (behind_ns > static_cast<int64_t>(period_usecs) * 1000) {
+    *deadline = now;
+    return;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) ==
+         EINTR) {
+  }
+#else
+  usleep(period_usecs);
+#endif  // CLOCK_MONOTONIC && TIMER_ABSTIME
+}
+
 
 /**
  * Check the granularity of usleep.
@@ -51,8 +51,13 @@ class UartDmxThread : public ola::thread::Thread {
   ola::thread::Mutex m_buffer_mutex;
 
   void CheckTimeGranularity();
+  void FrameSleep(struct timespec *deadline, unsigned int period_usecs);
 
   static const uint32_t DMX_MAB = 16;
+  // 513 bytes at 250kbaud, 44us per byte on the wire
+  static const uint32_t DMX_FRAME_WIRE_TIME = 22572;
+  // how often to report pacing stats
+  static const uint32_t STATS_INTERVAL_SECONDS = 10;
 
   DISALLOW_COPY_AND_ASSIGN(UartDmxThread);
 };
@@ -75,6 +75,7 @@ AsyncPluginImpl::AsyncPluginImpl(PluginAdaptor *plugin_adaptor,
       m_context(NULL),
       m_use_hotplug(false),
       m_suppress_hotplug_events(false),
+      m_probe_thread(ola::thread::Thread::Options("usbdmx-probe")),
       m_scan_timeout(ola::thread::INVALID_TIMEOUT) {
 }
 
@@ -91,6 +92,7 @@ bool AsyncPluginImpl::Start() {
   OLA_DEBUG << "libusb debug level set to " << m_debug_level;
   libusb_set_debug(m_context, m_debug_level);
 
+  m_probe_thread.Start();
   m_use_hotplug = HotplugSupported();
   OLA_INFO << "HotplugSupported returned " << m_use_hotplug;
   if (m_use_hotplug) {
@@ -153,6 +155,8 @@ bool AsyncPluginImpl::Stop() {
     ola::thread::MutexLocker locker(&m_mutex);
     m_suppress_hotplug_events = true;
   }
+  // drain any in-progress probes before tearing down
+  m_probe_thread.Stop();
 
   USBDeviceToFactoryMap::iterator iter = m_device_factory_map.begin();
   for (; iter != m_device_factory_map.end(); ++iter) {
@@ -182,11 +186,26 @@ void AsyncPluginImpl::HotPlugEvent(struct libusb_device *usb_device,
   OLA_INFO << "Got USB hotplug event  for " << usb_device << " : "
            << (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED ? "add" : "del");
   if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED) {
-    USBDeviceAdded(usb_device);
+    // Probing (descriptor reads, device opens, even firmware loads) can
+    // take milliseconds; run it on the probe thread so neither this
+    // callback context nor the main loop stalls. The device is ref'd
+    // for the handoff.
+    libusb_ref_device(usb_device);
+    m_probe_thread.Execute(ola::NewSingleCallback(
+        this, &AsyncPluginImpl::ProbeDevice, usb_device));
   } else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT) {
     USBDeviceRemoved(usb_device);
   }
 }
+
+
+/*
+ * Runs on the probe thread.
+ */
+void AsyncPluginImpl::ProbeDevice(struct libusb_device *usb_device) {
+  USBDeviceAdded(usb_device);
+  libusb_unref_device(usb_device);
+}
 #endif
 
 bool AsyncPluginImpl::NewWidget(AnymauDMX *widget) {
@@ -274,6 +293,7 @@ bool AsyncPluginImpl::USBDeviceAdded(libusb_device *usb_device) {
   WidgetFactories::iterator iter = m_widget_factories.begin();
   for (; iter != m_widget_factories.end(); ++iter) {
     if ((*iter)->DeviceAdded(&m_widget_observer, usb_device, descriptor)) {
+      ola::thread::MutexLocker locker(&m_map_mutex);
       STLReplacePtr(&m_device_factory_map, usb_device, *iter);
       return true;
     }
@@ -288,8 +308,11 @@ bool AsyncPluginImpl::USBDeviceAdded(libusb_device *usb_device) {
  * only one of those will be active at once, so we can avoid locking.
  */
 void AsyncPluginImpl::USBDeviceRemoved(libusb_device *usb_device) {
-  WidgetFactory *factory = STLLookupAndRemovePtr(
-      &m_device_factory_map, usb_device);
+  WidgetFactory *factory = NULL;
+  {
+    ola::thread::MutexLocker locker(&m_map_mutex);
+    factory = STLLookupAndRemovePtr(&m_device_factory_map, usb_device);
+  }
   if (factory) {
     factory->DeviceRemoved(&m_widget_observer, usb_device);
   }
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "ola/base/Macro.h"
+#include "ola/thread/ExecutorThread.h"
 #include "ola/thread/Mutex.h"
 #include "ola/thread/Thread.h"
 #include "plugins/usbdmx/PluginImplInterface.h"
@@ -112,6 +113,11 @@ class AsyncPluginImpl: public PluginImplInterface, public WidgetObserver {
   bool m_use_hotplug;
   ola::thread::Mutex m_mutex;
   bool m_suppress_hotplug_events;  // GUARDED_BY(m_mutex);
+  // device probing & factory negotiation runs here, off the hotplug
+  // callback context and the main loop
+  ola::thread::ExecutorThread m_probe_thread;
+  // guards m_device_factory_map, written by the probe thread
+  ola::thread::Mutex m_map_mutex;
   std::auto_ptr<class LibUsbThread> m_usb_thread;
   std::auto_ptr<class LibUsbAdaptor> m_usb_adaptor;
 
@@ -125,6 +131,7 @@ class AsyncPluginImpl: public PluginImplInterface, public WidgetObserver {
 
   bool HotplugSupported();
   bool USBDeviceAdded(libusb_device *device);
+  void ProbeDevice(struct libusb_device *device);
   void USBDeviceRemoved(libusb_device *device);
 
   bool StartAndRegisterDevice(class Widget *widget, Device *device);
@@ -20,6 +20,10 @@
 
 #include "plugins/usbdmx/AsyncUsbSender.h"
 
+#include <set>
+
+#include "ola/stl/STLUtils.h"
+
 #include "ola/Logging.h"
 #include "plugins/usbdmx/LibUsbAdaptor.h"
 
@@ -43,14 +47,26 @@ void AsyncCallback(struct libusb_transfer *transfer) {
 }  // namespace
 
 AsyncUsbSender::AsyncUsbSender(LibUsbAdaptor *adaptor,
-                               libusb_device *usb_device)
+                               libusb_device *usb_device,
+                               unsigned int queue_depth)
     : m_adaptor(adaptor),
       m_usb_device(usb_device),
       m_usb_handle(NULL),
       m_suppress_continuation(false),
-      m_transfer_state(IDLE),
-      m_pending_tx(false) {
-  m_transfer = m_adaptor->AllocTransfer(0);
+      m_active_slot(0),
+      m_disconnected(false),
+      m_slot_sequence(0),
+      m_slot_length(0),
+      m_pending_tx(false),
+      m_reopen_pending(false),
+      m_consecutive_errors(0) {
+  if (!queue_depth)
+    queue_depth = 1;
+  for (unsigned int i = 0; i < queue_depth; i++) {
+    m_transfers.push_back(m_adaptor->AllocTransfer(0));
+    m_transfer_states.push_back(IDLE);
+  }
+  m_transfer = m_transfers[0];
   m_adaptor->RefDevice(usb_device);
 }
 
@@ -58,7 +74,8 @@ AsyncUsbSender::~AsyncUsbSender() {
   CancelTransfer();
   m_adaptor->Close(m_usb_handle);
   m_adaptor->UnrefDevice(m_usb_device);
-  m_adaptor->FreeTransfer(m_transfer);
+  for (unsigned int i = 0; i < m_transfers.size(); i++)
+    m_adaptor->FreeTransfer(m_transfers[i]);
 }
 
 bool AsyncUsbSender::Init() {
@@ -67,41 +84,148 @@ bool AsyncUsbSender::Init() {
 }
 
 bool AsyncUsbSender::SendDMX(const DmxBuffer &buffer) {
+  ReopenIfSafe();
   if (!m_usb_handle) {
     OLA_WARN << "AsyncUsbSender hasn't been initialized";
     return false;
   }
-  ola::thread::MutexLocker locker(&m_mutex);
-  if (m_transfer_state == IDLE) {
-    PerformTransfer(buffer);
-  } else {
-    // Buffer incoming data so we can send it when the outstanding transfers
-    // complete.
+  {
+    ola::thread::MutexLocker locker(&m_mutex);
+    if (!m_disconnected && ClaimFreeSlot()) {
+      PerformTransfer(buffer);
+      return true;
+    }
+  }
+  // All slots are busy; publish the frame through the lock-free slot (the
+  // latest frame wins) and flag it. The copy happens outside the lock.
+  PublishFrame(buffer);
+  {
+    ola::thread::MutexLocker locker(&m_mutex);
     m_pending_tx = true;
-    m_tx_buffer.Set(buffer);
   }
   return true;
 }
 
+
+/*
+ * Producer side of the frame slot; runs on the SelectServer thread.
+ */
+void AsyncUsbSender::PublishFrame(const DmxBuffer &buffer) {
+  __atomic_add_fetch(&m_slot_sequence, 1, __ATOMIC_ACQ_REL);  // now odd
+  unsigned int length = DMX_UNIVERSE_SIZE;
+  buffer.Get(m_slot_data, &length);
+  m_slot_length = length;
+  __atomic_add_fetch(&m_slot_sequence, 1, __ATOMIC_ACQ_REL);  // even again
+}
+
+
+/*
+ * Consumer side; runs on the libusb thread. Returns false if a write was
+ * in progress (the producer will re-flag the frame).
+ */
+bool AsyncUsbSender::SnapshotFrame() {
+  for (unsigned int attempt = 0; attempt < 10; attempt++) {
+    uint32_t before = __atomic_load_n(&m_slot_sequence, __ATOMIC_ACQUIRE);
+    if (before & 1)
+      continue;
+    m_tx_buffer.Set(m_slot_data, m_slot_length);
+    uint32_t after = __atomic_load_n(&m_slot_sequence, __ATOMIC_ACQUIRE);
+    if (before == after)
+      return true;
+  }
+  return false;
+}
+
+
+/*
+ * Update the supervision counters & recover a wedged widget. After
+ * several consecutive errors we close and re-open the device handle,
+ * which un-sticks the common silent-death failure mode without a power
+ * cycle.
+ */
+void AsyncUsbSender::RecordTransferResult(int status) {
+  if (status == LIBUSB_TRANSFER_COMPLETED) {
+    m_stats.completed++;
+    m_consecutive_errors = 0;
+    return;
+  }
+  if (status == LIBUSB_TRANSFER_TIMED_OUT) {
+    m_stats.timeouts++;
+  } else {
+    m_stats.errors++;
+  }
+
+  if (status != LIBUSB_TRANSFER_NO_DEVICE &&
+      ++m_consecutive_errors >= CONSECUTIVE_ERROR_REOPEN_LIMIT) {
+    OLA_WARN << "USB transfers failing repeatedly, re-opening the device";
+    m_consecutive_errors = 0;
+    // Closing the handle here - inside the libusb completion callback,
+    // with other ring slots possibly still in flight on it and the
+    // SelectServer thread reading m_usb_handle - is unsafe. Flag it;
+    // the next SendDMX performs the reopen once every slot is idle.
+    ola::thread::MutexLocker locker(&m_mutex);
+    m_reopen_pending = true;
+  }
+}
+
+
+/*
+ * Runs on the SelectServer thread. Only swaps the handle when no
+ * transfer references it, so in-flight completions never see a closed
+ * handle.
+ */
+void AsyncUsbSender::ReopenIfSafe() {
+  {
+    ola::thread::MutexLocker locker(&m_mutex);
+    if (!m_reopen_pending) {
+      return;
+    }
+    for (unsigned int i = 0; i < m_transfer_states.size(); i++) {
+      if (m_transfer_states[i] == IN_PROGRESS) {
+        return;  // try again on the next frame
+      }
+    }
+    m_reopen_pending = false;
+  }
+  m_stats.reopens++;
+  m_adaptor->Close(m_usb_handle);
+  m_usb_handle = SetupHandle();
+}
+
+
+bool AsyncUsbSender::ClaimFreeSlot() {
+  for (unsigned int i = 0; i < m_transfers.size(); i++) {
+    if (m_transfer_states[i] == IDLE) {
+      m_active_slot = i;
+      m_transfer = m_transfers[i];
+      return true;
+    }
+  }
+  return false;
+}
+
 void AsyncUsbSender::CancelTransfer() {
-  if (!m_transfer) {
+  if (m_transfers.empty()) {
     return;
   }
 
-  bool canceled = false;
+  std::set<unsigned int> canceled;
   while (1) {
     ola::thread::MutexLocker locker(&m_mutex);
-    if (m_transfer_state == IDLE || m_transfer_state == DISCONNECTED) {
-      break;
-    }
-    if (!canceled) {
-      m_suppress_continuation = true;
-      if (m_adaptor->CancelTransfer(m_transfer) == 0) {
-        canceled = true;
-      } else {
-        break;
+    bool in_flight = false;
+    for (unsigned int i = 0; i < m_transfers.size(); i++) {
+      if (m_transfer_states[i] != IN_PROGRESS)
+        continue;
+      in_flight = true;
+      if (!STLContains(canceled, i)) {
+        m_suppress_continuation = true;
+        if (m_adaptor->CancelTransfer(m_transfers[i]) == 0) {
+          canceled.insert(i);
+        }
       }
     }
+    if (!in_flight)
+      break;
   }
 
   m_suppress_continuation = false;
@@ -135,28 +259,40 @@ int AsyncUsbSender::SubmitTransfer() {
     OLA_WARN << "libusb_submit_transfer returned "
              << m_adaptor->ErrorCodeToString(ret);
     if (ret == LIBUSB_ERROR_NO_DEVICE) {
-      m_transfer_state = DISCONNECTED;
+      m_transfer_states[m_active_slot] = DISCONNECTED;
+      m_disconnected = true;
     }
     return false;
   }
-  m_transfer_state = IN_PROGRESS;
+  m_transfer_states[m_active_slot] = IN_PROGRESS;
   return ret;
 }
 
 void AsyncUsbSender::TransferComplete(struct libusb_transfer *transfer) {
-  if (transfer != m_transfer) {
-    OLA_WARN << "Mismatched libusb transfer: " << transfer << " != "
-             << m_transfer;
+  unsigned int slot = m_transfers.size();
+  for (unsigned int i = 0; i < m_transfers.size(); i++) {
+    if (m_transfers[i] == transfer) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == m_transfers.size()) {
+    OLA_WARN << "Mismatched libusb transfer: " << transfer;
     return;
   }
 
   if (transfer->status != LIBUSB_TRANSFER_COMPLETED) {
     OLA_WARN << "Transfer returned " << transfer->status;
   }
+  RecordTransferResult(transfer->status);
 
   ola::thread::MutexLocker locker(&m_mutex);
-  m_transfer_state = (transfer->status == LIBUSB_TRANSFER_NO_DEVICE ?
-      DISCONNECTED : IDLE);
+  if (transfer->status == LIBUSB_TRANSFER_NO_DEVICE) {
+    m_transfer_states[slot] = DISCONNECTED;
+    m_disconnected = true;
+  } else {
+    m_transfer_states[slot] = IDLE;
+  }
 
   if (m_suppress_continuation) {
     return;
@@ -164,7 +300,8 @@ void AsyncUsbSender::TransferComplete(struct libusb_transfer *transfer) {
 
   PostTransferHook();
 
-  if ((m_transfer_state == IDLE) && m_pending_tx) {
+  if (m_pending_tx && !m_disconnected && SnapshotFrame() &&
+      ClaimFreeSlot()) {
     m_pending_tx = false;
     PerformTransfer(m_tx_buffer);
   }
@@ -27,6 +27,10 @@
 #include "ola/base/Macro.h"
 #include "ola/thread/Mutex.h"
 
+#include <vector>
+
+#include "ola/Constants.h"
+
 namespace ola {
 namespace plugin {
 namespace usbdmx {
@@ -43,9 +47,14 @@ class AsyncUsbSender {
    * @brief Create a new AsyncUsbSender.
    * @param adaptor the LibUsbAdaptor to use.
    * @param usb_device the libusb_device to use for the widget.
+   * @param queue_depth the number of transfers to keep in flight.
+   *   Subclasses that opt into a depth > 1 must provide a distinct frame
+   *   buffer per slot (see ActiveSlot()); the default of 1 matches the
+   *   old single-transfer behaviour.
    */
   AsyncUsbSender(class LibUsbAdaptor* const adaptor,
-                 libusb_device *usb_device);
+                 libusb_device *usb_device,
+                 unsigned int queue_depth = 1);
 
   /**
    * @brief Destructor
@@ -145,6 +154,32 @@ class AsyncUsbSender {
    */
   bool TransferPending() const { return m_pending_tx; }
 
+  /**
+   * @brief The ring slot the current PerformTransfer() call is filling.
+   * Subclasses with a queue depth > 1 use this to pick the matching
+   * frame buffer.
+   */
+  unsigned int ActiveSlot() const { return m_active_slot; }
+
+ public:
+  /**
+   * @brief Transfer supervision counters, for monitoring.
+   */
+  struct TransferStats {
+    uint64_t completed;
+    uint64_t errors;
+    uint64_t timeouts;
+    uint64_t reopens;
+    TransferStats() : completed(0), errors(0), timeouts(0), reopens(0) {}
+  };
+
+  /**
+   * @brief The transfer counters for this sender.
+   */
+  const TransferStats &GetTransferStats() const { return m_stats; }
+
+ protected:
+
  private:
   enum TransferState {
     IDLE,
@@ -152,15 +187,43 @@ class AsyncUsbSender {
     DISCONNECTED,
   };
 
+  // re-open the handle after this many consecutive failed transfers
+  static const unsigned int CONSECUTIVE_ERROR_REOPEN_LIMIT = 8;
+
   libusb_device_handle *m_usb_handle;
   bool m_suppress_continuation;
+  // the ring of transfers; m_transfer tracks the slot being filled
+  std::vector<struct libusb_transfer*> m_transfers;
+  std::vector<TransferState> m_transfer_states;  // GUARDED_BY(m_mutex);
   struct libusb_transfer *m_transfer;
-
-  TransferState m_transfer_state;  // GUARDED_BY(m_mutex);
-  DmxBuffer m_tx_buffer;  // GUARDED_BY(m_mutex);
+  unsigned int m_active_slot;
+  bool m_disconnected;  // GUARDED_BY(m_mutex);
+
+  // The pending frame is handed between the SelectServer thread and the
+  // libusb thread through a sequence-counter validated slot, so the 512
+  // byte copy happens outside m_mutex and neither thread blocks on the
+  // other's copy. An odd sequence means a write is in progress.
+  uint32_t m_slot_sequence;
+  uint8_t m_slot_data[DMX_UNIVERSE_SIZE];
+  unsigned int m_slot_length;
+  DmxBuffer m_tx_buffer;  // consumer-side copy, libusb thread only
   bool m_pending_tx;  // GUARDED_BY(m_mutex);
+  bool m_reopen_pending;  // GUARDED_BY(m_mutex);
   ola::thread::Mutex m_mutex;
 
+  void PublishFrame(const DmxBuffer &buffer);
+  bool SnapshotFrame();
+
+  // Finds a free slot & makes it active. Returns false if all slots are
+  // in flight. With the lock held.
+  bool ClaimFreeSlot();
+  void RecordTransferResult(int status);
+  void ReopenIfSafe();
+
+  TransferStats m_stats;
+  // consecutive errored transfers; triggers a handle re-open
+  unsigned int m_consecutive_errors;
+
   DISALLOW_COPY_AND_ASSIGN(AsyncUsbSender);
 };
 }  // namespace usbdmx
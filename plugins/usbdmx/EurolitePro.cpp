@@ -194,7 +194,7 @@ class EuroliteProAsyncUsbSender : public AsyncUsbSender {
  public:
   EuroliteProAsyncUsbSender(LibUsbAdaptor *adaptor,
                             libusb_device *usb_device)
-      : AsyncUsbSender(adaptor, usb_device) {
+      : AsyncUsbSender(adaptor, usb_device, QUEUE_DEPTH) {
   }
 
   ~EuroliteProAsyncUsbSender() {
@@ -214,14 +214,18 @@ class EuroliteProAsyncUsbSender : public AsyncUsbSender {
   }
 
   bool PerformTransfer(const DmxBuffer &buffer) {
-    CreateFrame(buffer, m_tx_frame);
-    FillBulkTransfer(ENDPOINT, m_tx_frame, EUROLITE_PRO_FRAME_SIZE,
+    // one frame buffer per ring slot, so in-flight transfers aren't
+    // overwritten
+    uint8_t *frame = m_tx_frames[ActiveSlot()];
+    CreateFrame(buffer, frame);
+    FillBulkTransfer(ENDPOINT, frame, EUROLITE_PRO_FRAME_SIZE,
                      URB_TIMEOUT_MS);
     return (SubmitTransfer() == 0);
   }
 
  private:
-  uint8_t m_tx_frame[EUROLITE_PRO_FRAME_SIZE];
+  enum { QUEUE_DEPTH = 2 };
+  uint8_t m_tx_frames[QUEUE_DEPTH][EUROLITE_PRO_FRAME_SIZE];
 
   DISALLOW_COPY_AND_ASSIGN(EuroliteProAsyncUsbSender);
 };
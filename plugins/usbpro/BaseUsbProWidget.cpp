@@ -38,6 +38,11 @@ namespace ola {
 namespace plugin {
 namespace usbpro {
 
+namespace {
+// the smoothing factor for the write-time EWMA
+const double EWMA_ALPHA = 0.2;
+}  // namespace
+
 using std::string;
 
 
@@ -48,6 +53,11 @@ const unsigned int BaseUsbProWidget::HEADER_SIZE =
 BaseUsbProWidget::BaseUsbProWidget(
     ola::io::ConnectedDescriptor *descriptor)
     : m_descriptor(descriptor),
+      m_writer(descriptor),
+      m_batching(false),
+      m_write_time_ewma_usecs(0.0),
+      m_frames_sent(0),
+      m_frames_shed(0),
       m_state(PRE_SOM),
       m_bytes_received(0) {
   memset(&m_header, 0, sizeof(m_header));
@@ -81,12 +91,31 @@ bool BaseUsbProWidget::SendDMX(const DmxBuffer &buffer) {
     uint8_t dmx[DMX_UNIVERSE_SIZE];
   } widget_dmx;
 
+  // Adaptive pacing: when the serial buffer backs up, the write() call
+  // itself slows down. If writes are taking longer than a full DMX frame
+  // on the wire, the widget can't absorb our rate; shed this frame
+  // instead of wedging the loop in write().
+  if (m_write_time_ewma_usecs > DMX_FRAME_WIRE_TIME_USECS) {
+    m_frames_shed++;
+    // decay so we retry once the backlog drains
+    m_write_time_ewma_usecs *= (1.0 - EWMA_ALPHA);
+    return true;
+  }
+
   widget_dmx.start_code = DMX512_START_CODE;
   unsigned int length = DMX_UNIVERSE_SIZE;
   buffer.Get(widget_dmx.dmx, &length);
-  return SendMessage(DMX_LABEL,
-                     reinterpret_cast<uint8_t*>(&widget_dmx),
-                     length + 1);
+
+  TimeStamp write_start, write_end;
+  m_clock.CurrentTime(&write_start);
+  bool ok = SendMessage(DMX_LABEL,
+                        reinterpret_cast<uint8_t*>(&widget_dmx),
+                        length + 1);
+  m_clock.CurrentTime(&write_end);
+  m_write_time_ewma_usecs = (1.0 - EWMA_ALPHA) * m_write_time_ewma_usecs +
+      EWMA_ALPHA * static_cast<double>((write_end - write_start).AsInt());
+  m_frames_sent++;
+  return ok;
 }
 
 
@@ -111,12 +140,40 @@ bool BaseUsbProWidget::SendMessage(uint8_t label,
   memcpy(frame + sizeof(message_header), data, length);
   frame[frame_size - 1] = EOM;
 
-  ssize_t bytes_sent = m_descriptor->Send(frame, frame_size);
-  if (bytes_sent != frame_size)
-    // we've probably screwed framing at this point
-    return false;
+  if (m_batching) {
+    m_batch_buffer.append(reinterpret_cast<char*>(frame), frame_size);
+    return true;
+  }
+
+  return WriteOrBacklog(frame, static_cast<unsigned int>(frame_size));
+}
 
-  return true;
+
+/*
+ * Write to the (non-blocking) serial device. Bytes the device can't
+ * absorb right now are kept in a bounded per-widget backlog and flushed
+ * ahead of later messages, so one glitching widget degrades only its own
+ * output instead of being disconnected on the first partial write.
+ */
+bool BaseUsbProWidget::WriteOrBacklog(const uint8_t *data,
+                                      unsigned int length) const {
+  return m_writer.Write(data, length);
+}
+
+
+/*
+ * Flush the coalesced messages with a single write.
+ */
+bool BaseUsbProWidget::EndBatch() const {
+  m_batching = false;
+  if (m_batch_buffer.empty())
+    return true;
+
+  bool ok = WriteOrBacklog(
+      reinterpret_cast<const uint8_t*>(m_batch_buffer.data()),
+      static_cast<unsigned int>(m_batch_buffer.size()));
+  m_batch_buffer.clear();
+  return ok;
 }
 
 
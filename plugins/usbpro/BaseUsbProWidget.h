@@ -24,8 +24,11 @@
 
 #include <stdint.h>
 #include <string>
+
+#include "ola/Clock.h"
 #include "ola/Callback.h"
 #include "ola/DmxBuffer.h"
+#include "ola/io/BackloggedWriter.h"
 #include "ola/io/Descriptor.h"
 #include "plugins/usbpro/SerialWidgetInterface.h"
 
@@ -54,8 +57,40 @@ class BaseUsbProWidget: public SerialWidgetInterface {
                    const uint8_t *data,
                    unsigned int length) const;
 
+  /**
+   * Coalesce messages: frames built between BeginBatch() and EndBatch()
+   * are gathered into one buffer and hit the serial device with a single
+   * write, instead of one small write per message.
+   */
+  void BeginBatch() const { m_batching = true; }
+  bool EndBatch() const;
+
+  /**
+   * The total bytes written to the widget, for spotting devices that
+   * can't keep up.
+   */
+  uint64_t BytesSent() const { return m_writer.BytesSent(); }
+
+  /**
+   * An EWMA of the time a DMX frame write takes, in microseconds. When
+   * the serial buffer backs up, writes slow down, so this tracks what
+   * the widget can actually absorb.
+   */
+  unsigned int FrameWriteTimeUsecs() const {
+    return static_cast<unsigned int>(m_write_time_ewma_usecs);
+  }
+
+  /**
+   * The number of DMX frames handed to the widget, and the number shed
+   * because the device couldn't keep up.
+   */
+  uint64_t FramesSent() const { return m_frames_sent; }
+  uint64_t FramesShed() const { return m_frames_shed; }
+
   static ola::io::ConnectedDescriptor *OpenDevice(const std::string &path);
 
+  // a full 512 slot frame takes ~23ms on the wire
+  static const unsigned int DMX_FRAME_WIRE_TIME_USECS = 23000;
   static const uint8_t DEVICE_LABEL = 78;
   static const uint8_t DMX_LABEL = 6;
   static const uint8_t GET_PARAMS = 3;
@@ -64,6 +99,21 @@ class BaseUsbProWidget: public SerialWidgetInterface {
   static const uint8_t SERIAL_LABEL = 10;
 
  private:
+  // message coalescing state; mutable since SendMessage is const
+  mutable bool m_batching;
+  mutable std::string m_batch_buffer;
+
+  // adaptive pacing state
+  ola::Clock m_clock;
+  double m_write_time_ewma_usecs;
+  uint64_t m_frames_sent;
+  uint64_t m_frames_shed;
+  // bytes the serial device couldn't absorb yet; bounded, flushed before
+  // each new message so ordering & framing are preserved
+  mutable ola::io::BackloggedWriter m_writer;
+
+  bool WriteOrBacklog(const uint8_t *data, unsigned int length) const;
+
   typedef enum {
     PRE_SOM,
     RECV_LABEL,
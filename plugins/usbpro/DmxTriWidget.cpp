@@ -885,9 +885,17 @@ void DmxTriWidgetImpl::MaybeSendNextRequest() {
     }
     first = false;
 
-    if (m_outgoing_dmx.Size() && m_last_command != SINGLE_TX_COMMAND_ID) {
-      // avoid starving out DMX frames
+    TimeStamp now;
+    m_clock.CurrentTime(&now);
+    if (m_outgoing_dmx.Size() && m_last_command != SINGLE_TX_COMMAND_ID &&
+        (!m_last_dmx_send.IsSet() ||
+         now - m_last_dmx_send > TimeInterval(0, DMX_INTERLEAVE_USECS))) {
+      // Keep the DMX output alive, but don't interleave a frame between
+      // every single RDM transaction: during a rig scan that doubles the
+      // number of round trips. One frame per DMX_INTERLEAVE_USECS matches
+      // the wire rate.
       SendDMXBuffer();
+      m_last_dmx_send = now;
     } else if (m_pending_rdm_request) {
       // there is an RDM command to send
       SendQueuedRDMCommand();
@@ -25,6 +25,7 @@
 #include <string>
 #include <queue>
 #include "ola/Callback.h"
+#include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
 #include "ola/rdm/QueueingRDMController.h"
 #include "ola/rdm/RDMControllerInterface.h"
@@ -104,6 +105,9 @@ class DmxTriWidgetImpl: public BaseUsbProWidget,
     uint8_t m_transaction_number;
     // The command id that we expect to see in the response.
     uint8_t m_last_command, m_expected_command;
+    // throttles DMX interleaving during RDM bursts
+    ola::Clock m_clock;
+    TimeStamp m_last_dmx_send;
 
     void SendDMXBuffer();
     void SendQueuedRDMCommand();
@@ -199,6 +203,9 @@ class DmxTriWidgetImpl: public BaseUsbProWidget,
 
     // The ms delay between checking on the RDM discovery process
     static const unsigned int RDM_STATUS_INTERVAL_MS = 100;
+    // don't interleave DMX frames between RDM commands more often than
+    // this; a full frame takes ~23ms on the wire anyway
+    static const unsigned int DMX_INTERLEAVE_USECS = 25000;
 };
 
 
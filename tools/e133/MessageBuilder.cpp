@@ -19,13 +19,20 @@
  * A class to simplify some of the E1.33 packet building operations.
  */
 
+#include <string.h>
+
 #include <string>
 #include "ola/acn/ACNVectors.h"
 #include "ola/acn/CID.h"
 #include "ola/e133/MessageBuilder.h"
 #include "ola/io/IOStack.h"
 
+#include "ola/network/NetworkUtils.h"
+#include "ola/strings/Utils.h"
+#include "ola/base/Array.h"
+#include "plugins/e131/e131/E133Header.h"
 #include "plugins/e131/e131/E133PDU.h"
+#include "plugins/e131/e131/PDU.h"
 #include "plugins/e131/e131/RDMPDU.h"
 #include "plugins/e131/e131/RootPDU.h"
 #include "plugins/e131/e131/E133StatusPDU.h"
@@ -47,6 +54,21 @@ MessageBuilder::MessageBuilder(const CID &cid, const string &source_name)
       // The Max sized RDM packet is 256 bytes, E1.33 adds 118 bytes of
       // headers.
       m_memory_pool(400) {
+  uint8_t cid_buffer[CID::CID_LENGTH];
+  m_cid.Pack(cid_buffer);
+  m_packed_cid.assign(reinterpret_cast<char*>(cid_buffer),
+                      sizeof(cid_buffer));
+
+  // the E1.33 PDU header is invariant bar sequence and endpoint; build
+  // it once rather than re-copying the 64 byte source name per message
+  ola::plugin::e131::E133Header::e133_pdu_header header;
+  ola::strings::CopyToFixedLengthBuffer(m_source_name, header.source,
+                                        arraysize(header.source));
+  header.sequence = 0;
+  header.endpoint = 0;
+  header.reserved = 0;
+  m_e133_header_template.assign(reinterpret_cast<char*>(&header),
+                                sizeof(header));
 }
 
 
@@ -107,9 +129,8 @@ void MessageBuilder::BuildTCPRootE133(IOStack *packet,
                                       uint32_t vector,
                                       uint32_t sequence_number,
                                       uint16_t endpoint_id) {
-  E133PDU::PrependPDU(packet, vector, m_source_name, sequence_number,
-                      endpoint_id);
-  RootPDU::PrependPDU(packet, ola::acn::VECTOR_ROOT_E133, m_cid);
+  PrependE133Header(packet, vector, sequence_number, endpoint_id);
+  PrependRoot(packet);
   PreamblePacker::AddTCPPreamble(packet);
 }
 
@@ -121,10 +142,43 @@ void MessageBuilder::BuildUDPRootE133(IOStack *packet,
                                       uint32_t vector,
                                       uint32_t sequence_number,
                                       uint16_t endpoint_id) {
-  E133PDU::PrependPDU(packet, vector, m_source_name, sequence_number,
-                      endpoint_id);
-  RootPDU::PrependPDU(packet, ola::acn::VECTOR_ROOT_E133, m_cid);
+  PrependE133Header(packet, vector, sequence_number, endpoint_id);
+  PrependRoot(packet);
   PreamblePacker::AddUDPPreamble(packet);
 }
+
+/*
+ * Write the cached E1.33 PDU header with the per-message fields patched,
+ * then the PDU flags/length.
+ */
+void MessageBuilder::PrependE133Header(IOStack *packet,
+                                       uint32_t vector,
+                                       uint32_t sequence_number,
+                                       uint16_t endpoint_id) {
+  ola::plugin::e131::E133Header::e133_pdu_header header;
+  memcpy(&header, m_e133_header_template.data(), sizeof(header));
+  header.sequence = ola::network::HostToNetwork(sequence_number);
+  header.endpoint = ola::network::HostToNetwork(endpoint_id);
+  packet->Write(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+
+  vector = ola::network::HostToNetwork(vector);
+  packet->Write(reinterpret_cast<uint8_t*>(&vector), sizeof(vector));
+  ola::plugin::e131::PDU::PrependFlagsAndLength(packet);
+}
+
+
+/*
+ * Write the cached root layer (vector + packed CID), then the root PDU
+ * flags/length.
+ */
+void MessageBuilder::PrependRoot(IOStack *packet) {
+  packet->Write(
+      reinterpret_cast<const uint8_t*>(m_packed_cid.data()),
+      static_cast<unsigned int>(m_packed_cid.size()));
+  uint32_t vector = ola::network::HostToNetwork(
+      static_cast<uint32_t>(ola::acn::VECTOR_ROOT_E133));
+  packet->Write(reinterpret_cast<uint8_t*>(&vector), sizeof(vector));
+  ola::plugin::e131::PDU::PrependFlagsAndLength(packet);
+}
 }  // namespace e133
 }  // namespace ola
@@ -64,7 +64,7 @@ namespace {
 void InTransferCompleteHandler(struct libusb_transfer *transfer) {
   OpenLightingDevice *sender = static_cast<OpenLightingDevice*>(
       transfer->user_data);
-  return sender->_InTransferComplete();
+  return sender->_InTransferComplete(transfer);
 }
 
 void OutTransferCompleteHandler(struct libusb_transfer *transfer) {
@@ -81,8 +81,11 @@ OpenLightingDevice::OpenLightingDevice(SelectServer* ss, libusb_device* device)
     m_handle(NULL),
     m_out_transfer(libusb_alloc_transfer(0)),
     m_out_in_progress(false),
-    m_in_transfer(libusb_alloc_transfer(0)),
-    m_in_in_progress(false) {
+    m_out_sent_time() {
+  for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++) {
+    m_in_transfers[i] = libusb_alloc_transfer(0);
+    m_in_in_progress[i] = false;
+  }
 }
 
 OpenLightingDevice::~OpenLightingDevice() {
@@ -96,9 +99,11 @@ OpenLightingDevice::~OpenLightingDevice() {
 
   {
     MutexLocker locker(&m_in_mutex);
-    if (m_in_in_progress) {
-      OLA_DEBUG << "Cancel m_in_transfer";
-      libusb_cancel_transfer(m_in_transfer);
+    for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++) {
+      if (m_in_in_progress[i]) {
+        OLA_DEBUG << "Cancel in transfer " << i;
+        libusb_cancel_transfer(m_in_transfers[i]);
+      }
     }
   }
 
@@ -113,7 +118,10 @@ OpenLightingDevice::~OpenLightingDevice() {
   OLA_DEBUG << "Waiting for in to complete";
   while (true) {
     MutexLocker locker(&m_in_mutex);
-    if (!m_in_in_progress) {
+    bool in_progress = false;
+    for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++)
+      in_progress |= m_in_in_progress[i];
+    if (!in_progress) {
       break;
     }
   }
@@ -122,8 +130,16 @@ OpenLightingDevice::~OpenLightingDevice() {
     libusb_free_transfer(m_out_transfer);
   }
 
-  if (m_in_transfer) {
-    libusb_free_transfer(m_in_transfer);
+  for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++) {
+    if (m_in_transfers[i]) {
+      libusb_free_transfer(m_in_transfers[i]);
+    }
+  }
+  {
+    MutexLocker locker(&m_in_mutex);
+    for (unsigned int i = 0; i < m_free_rx_buffers.size(); i++)
+      delete[] m_free_rx_buffers[i];
+    m_free_rx_buffers.clear();
   }
 
   if (m_handle) {
@@ -202,8 +218,8 @@ bool OpenLightingDevice::SendMessage(Command command,
 
   m_out_in_progress = true;
   locker.Release();
-  // Submit the In transfer here to reduce the latency.
-  SubmitInTransfer();
+  // Submit the In transfers here to reduce the latency.
+  SubmitInTransfers();
   return true;
 }
 
@@ -220,70 +236,107 @@ void OpenLightingDevice::_OutTransferComplete() {
   }
 }
 
-void OpenLightingDevice::_InTransferComplete() {
+void OpenLightingDevice::_InTransferComplete(
+    struct libusb_transfer *transfer) {
   TimeStamp now;
   Clock clock;
   clock.CurrentTime(&now);
   OLA_INFO << "Command completed in " << (now - m_out_sent_time)
            << ", status is "
-           << LibUsbAdaptor::ErrorCodeToString(m_in_transfer->status);
+           << LibUsbAdaptor::ErrorCodeToString(transfer->status);
+
+  unsigned int slot = IN_TRANSFER_COUNT;
+  for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++) {
+    if (m_in_transfers[i] == transfer) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == IN_TRANSFER_COUNT) {
+    OLA_WARN << "Unknown in transfer " << transfer;
+    return;
+  }
 
-  if (m_in_transfer->status == LIBUSB_TRANSFER_COMPLETED) {
+  if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
     // Ownership of the buffer is transferred to the HandleData method,
-    // running on the SS thread.
+    // running on the SS thread; it returns the buffer to the pool.
     m_ss->Execute(
         NewSingleCallback(
           this, &OpenLightingDevice::HandleData,
-          reinterpret_cast<const uint8_t*>(m_in_transfer->buffer),
-          static_cast<unsigned int>(m_in_transfer->actual_length)));
+          reinterpret_cast<const uint8_t*>(transfer->buffer),
+          static_cast<unsigned int>(transfer->actual_length)));
   } else {
-    delete[] m_in_transfer->buffer;
+    ReleaseRxBuffer(transfer->buffer);
   }
 
   {
-    MutexLocker locker(&m_out_mutex);
-    m_in_in_progress = false;
+    MutexLocker locker(&m_in_mutex);
+    m_in_in_progress[slot] = false;
   }
+  // keep the window full so a burst of responder traffic can't starve
+  // the queue
+  SubmitInTransfers();
 }
 
-bool OpenLightingDevice::SubmitInTransfer() {
+bool OpenLightingDevice::SubmitInTransfers() {
   MutexLocker locker(&m_in_mutex);
-  if (m_in_in_progress) {
-    OLA_WARN << "Read already pending";
-    return true;
-  }
-
-
-  uint8_t* rx_buffer = new uint8_t[IN_BUFFER_SIZE];
-  libusb_fill_bulk_transfer(m_in_transfer, m_handle, kInEndpoint,
-                            rx_buffer, IN_BUFFER_SIZE,
-                            InTransferCompleteHandler,
-                            static_cast<void*>(this),
-                            kTimeout);
+  bool ok = true;
+  for (unsigned int i = 0; i < IN_TRANSFER_COUNT; i++) {
+    if (m_in_in_progress[i]) {
+      continue;
+    }
 
-  Clock clock;
-  clock.CurrentTime(&m_send_in_time);
-  int r = libusb_submit_transfer(m_in_transfer);
-  if (r) {
-    OLA_WARN << "Failed to submit input transfer: "
-             << LibUsbAdaptor::ErrorCodeToString(r);
-    return false;
+    uint8_t* rx_buffer;
+    if (m_free_rx_buffers.empty()) {
+      rx_buffer = new uint8_t[IN_BUFFER_SIZE];
+    } else {
+      rx_buffer = m_free_rx_buffers.back();
+      m_free_rx_buffers.pop_back();
+    }
+    libusb_fill_bulk_transfer(m_in_transfers[i], m_handle, kInEndpoint,
+                              rx_buffer, IN_BUFFER_SIZE,
+                              InTransferCompleteHandler,
+                              static_cast<void*>(this),
+                              kTimeout);
+
+    Clock clock;
+    clock.CurrentTime(&m_send_in_time);
+    int r = libusb_submit_transfer(m_in_transfers[i]);
+    if (r) {
+      OLA_WARN << "Failed to submit input transfer: "
+               << LibUsbAdaptor::ErrorCodeToString(r);
+      m_free_rx_buffers.push_back(rx_buffer);
+      ok = false;
+      break;
+    }
+    m_in_in_progress[i] = true;
   }
+  return ok;
+}
 
-  m_in_in_progress = true;
-  return true;
+
+/*
+ * Return a receive buffer to the pool; called from the SS thread once the
+ * message has been handled.
+ */
+void OpenLightingDevice::ReleaseRxBuffer(const uint8_t *buffer) {
+  MutexLocker locker(&m_in_mutex);
+  m_free_rx_buffers.push_back(const_cast<uint8_t*>(buffer));
 }
 
 void OpenLightingDevice::HandleData(const uint8_t* data, unsigned int size) {
-  class ArrayDeleter {
+  // returns the buffer to the receive pool on all paths out
+  class BufferReturner {
    public:
-    explicit ArrayDeleter(const uint8_t* data) : m_data(data) {}
-    ~ArrayDeleter() { delete[] m_data; }
+    BufferReturner(OpenLightingDevice *device, const uint8_t* data)
+        : m_device(device), m_data(data) {}
+    ~BufferReturner() { m_device->ReleaseRxBuffer(m_data); }
    private:
+    OpenLightingDevice *m_device;
     const uint8_t* m_data;
   };
 
-  ArrayDeleter deleter(data);
+  BufferReturner returner(this, data);
 
   // Right now we assume that the device only sends a single message at a time.
   // If this ever changes from a message model to more of a stream model we'll
@@ -26,6 +26,8 @@
 #include <ola/io/SelectServer.h>
 #include <ola/thread/Mutex.h>
 
+#include <vector>
+
 typedef enum {
   LOGS_PENDING_FLAG = 0x01,  //!< Log messages are pending
   FLAGS_CHANGED_FLAG = 0x02,  //!< Flags have changed
@@ -121,7 +123,7 @@ class OpenLightingDevice {
   /**
    * @brief Called by libusb when the transfer completes or is cancelled.
    */
-  void _InTransferComplete();
+  void _InTransferComplete(struct libusb_transfer *transfer);
 
  private:
   // This must be a multiple of the USB packet size otherwise we can experience
@@ -146,13 +148,20 @@ class OpenLightingDevice {
   bool m_out_in_progress;  // GUARDED_BY(m_out_mutex);
   ola::TimeStamp m_out_sent_time;
 
+  // Several IN transfers are kept in flight so responder traffic at full
+  // speed doesn't starve the queue, and the receive buffers are pooled
+  // instead of allocated per message.
+  static const unsigned int IN_TRANSFER_COUNT = 4;
+
   ola::thread::Mutex m_in_mutex;
-  uint8_t m_in_buffer[IN_BUFFER_SIZE];  // GUARDED_BY(m_in_mutex);
-  libusb_transfer *m_in_transfer;  // GUARDED_BY(m_in_mutex);
-  bool m_in_in_progress;  // GUARDED_BY(m_in_mutex);
+  libusb_transfer *m_in_transfers[IN_TRANSFER_COUNT];
+      // GUARDED_BY(m_in_mutex);
+  bool m_in_in_progress[IN_TRANSFER_COUNT];  // GUARDED_BY(m_in_mutex);
+  std::vector<uint8_t*> m_free_rx_buffers;  // GUARDED_BY(m_in_mutex);
   ola::TimeStamp m_send_in_time;
 
-  bool SubmitInTransfer();
+  bool SubmitInTransfers();
+  void ReleaseRxBuffer(const uint8_t *buffer);
 
   void HandleData(const uint8_t *data, unsigned int size);
 
@@ -34,6 +34,8 @@ class OlaFetcher(object):
   def __init__(self, host, port):
     self._host = host
     self._port = port
+    self._last_body = None
+    self._last_variables = {}
 
   def FetchVariables(self):
     """Fetch the variables from an OLAD instance.
@@ -43,7 +45,16 @@ class OlaFetcher(object):
     """
     body = self._FetchDebug()
     if body:
-      return self._ProcessDebug(body)
+      # Scrapes on a quiet daemon are usually byte-identical; skip the
+      # re-parse and hand back the previous dict. This is the client half
+      # of delta scraping - a server-side changed-only endpoint would
+      # also shrink the transfer, but the parse is what costs on the
+      # embedded boxes.
+      if body == self._last_body:
+        return self._last_variables
+      self._last_body = body
+      self._last_variables = self._ProcessDebug(body)
+      return self._last_variables
     return {}
 
   def _FetchDebug(self):
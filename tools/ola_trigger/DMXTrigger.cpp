@@ -42,6 +42,13 @@ DMXTrigger::DMXTrigger(Context *context,
  * Called when new DMX arrives.
  */
 void DMXTrigger::NewDMX(const DmxBuffer &data) {
+  // Most frames on a quiet rig are identical to the previous one; a
+  // single compare skips the whole per-slot evaluation walk.
+  if (m_last_frame == data) {
+    return;
+  }
+  m_last_frame.Set(data);
+
   SlotVector::iterator iter = m_slots.begin();
   for (; iter != m_slots.end(); iter++) {
     uint16_t slot_number = (*iter)->SlotOffset();
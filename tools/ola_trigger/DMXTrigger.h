@@ -41,5 +41,7 @@ class DMXTrigger {
  private:
     Context *m_context;
     SlotVector m_slots;  // kept sorted
+    // the last frame processed, for unchanged-frame suppression
+    ola::DmxBuffer m_last_frame;
 };
 #endif  // TOOLS_OLA_TRIGGER_DMXTRIGGER_H_
@@ -0,0 +1,90 @@
+#!/bin/sh
+#  This program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU Library General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software
+#  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# replay_soak.sh
+# Replay a recorded show through a headless olad and assert an SLO on the
+# wall-clock drift, for CI soak testing.
+#
+# Usage: replay_soak.sh <show file> [iterations] [max drift %]
+#
+# Requires ola_recorder & olad in the PATH (or set OLAD / OLA_RECORDER).
+# The show's universes must be listed with --universes if playback should
+# hit patched ports; by default the daemon just absorbs the stream, which
+# exercises the full RPC + merge path.
+
+set -e
+
+SHOW_FILE=$1
+ITERATIONS=${2:-1}
+MAX_DRIFT_PCT=${3:-5}
+
+OLAD=${OLAD:-olad}
+OLA_RECORDER=${OLA_RECORDER:-ola_recorder}
+
+if [ -z "$SHOW_FILE" ]; then
+  echo "usage: $0 <show file> [iterations] [max drift %]" >&2
+  exit 2
+fi
+
+CONFIG_DIR=$(mktemp -d)
+trap 'kill $OLAD_PID 2>/dev/null; rm -rf "$CONFIG_DIR"' EXIT
+
+# headless daemon: no http, dummy plugin is enough to terminate universes
+$OLAD --no-http --config-dir "$CONFIG_DIR" -l 1 &
+OLAD_PID=$!
+sleep 2
+
+if ! kill -0 $OLAD_PID 2>/dev/null; then
+  echo "FAIL: olad didn't start" >&2
+  exit 1
+fi
+
+# expected duration comes from the show's own index
+EXPECTED_MS=$($OLA_RECORDER --verify "$SHOW_FILE" 2>/dev/null | \
+    awk '/Playback time/ { print int($3 * 1000) }')
+if [ -z "$EXPECTED_MS" ]; then
+  echo "FAIL: couldn't verify $SHOW_FILE" >&2
+  exit 1
+fi
+
+START=$(date +%s%N)
+$OLA_RECORDER --playback "$SHOW_FILE" --iterations "$ITERATIONS" \
+    > /dev/null 2>&1
+END=$(date +%s%N)
+
+ACTUAL_MS=$(( (END - START) / 1000000 ))
+TARGET_MS=$(( EXPECTED_MS * ITERATIONS ))
+if [ "$TARGET_MS" -eq 0 ]; then
+  TARGET_MS=1
+fi
+# client setup & the final frame aren't part of the show's timed gaps, so
+# allow a fixed grace on top of the percentage SLO; it only matters for
+# short smoke shows, real captures dwarf it.
+GRACE_MS=750
+DRIFT_MS=$(( ACTUAL_MS - TARGET_MS ))
+if [ "$DRIFT_MS" -lt 0 ]; then
+  DRIFT_MS=$(( -DRIFT_MS ))
+fi
+TOLERANCE_MS=$(( TARGET_MS * MAX_DRIFT_PCT / 100 + GRACE_MS ))
+
+echo "replayed $SHOW_FILE x$ITERATIONS: expected ${TARGET_MS}ms," \
+     "actual ${ACTUAL_MS}ms, drift ${DRIFT_MS}ms" \
+     "(tolerance ${TOLERANCE_MS}ms)"
+
+if [ "$DRIFT_MS" -gt "$TOLERANCE_MS" ]; then
+  echo "FAIL: drift ${DRIFT_MS}ms exceeds SLO of ${TOLERANCE_MS}ms" >&2
+  exit 1
+fi
+echo "PASS"
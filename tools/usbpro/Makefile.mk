@@ -4,3 +4,8 @@ bin_PROGRAMS += tools/usbpro/usbpro_firmware
 tools_usbpro_usbpro_firmware_SOURCES = tools/usbpro/usbpro-firmware.cpp
 tools_usbpro_usbpro_firmware_LDADD = common/libolacommon.la \
                                      plugins/usbpro/libolausbprowidget.la
+
+noinst_PROGRAMS += tools/usbpro/widget_bench
+tools_usbpro_widget_bench_SOURCES = tools/usbpro/widget_bench.cpp
+tools_usbpro_widget_bench_LDADD = common/libolacommon.la \
+                                  plugins/usbpro/libolausbprowidget.la
@@ -0,0 +1,183 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * widget_bench.cpp
+ * Bench & fuzz the Usb Pro widget framing code over a pty.
+ * Copyright (C) 2013 Simon Newton
+ */
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <memory>
+
+#include "ola/Clock.h"
+#include "ola/Logging.h"
+#include "ola/Constants.h"
+#include "ola/base/Flags.h"
+#include "ola/base/Init.h"
+#include "ola/io/Descriptor.h"
+#include "ola/io/SelectServer.h"
+#include "plugins/usbpro/BaseUsbProWidget.h"
+
+using ola::io::DeviceDescriptor;
+using ola::io::SelectServer;
+using std::auto_ptr;
+using std::cout;
+using std::endl;
+
+DEFINE_uint32(messages, 100000, "The number of frames to feed the parser");
+DEFINE_uint32(fuzz_pct, 10,
+              "The percentage of bytes to corrupt, exercising the resync "
+              "path [0 - 100]");
+
+namespace {
+
+/**
+ * A widget that just counts the messages the framing layer hands it.
+ */
+class CountingWidget
+    : public ola::plugin::usbpro::BaseUsbProWidget {
+ public:
+  explicit CountingWidget(ola::io::ConnectedDescriptor *descriptor)
+      : BaseUsbProWidget(descriptor),
+        messages(0),
+        payload_bytes(0) {
+  }
+
+  uint64_t messages;
+  uint64_t payload_bytes;
+
+  void Stop() {}
+
+ private:
+  void HandleMessage(uint8_t, const uint8_t*, unsigned int length) {
+    messages++;
+    payload_bytes += length;
+  }
+};
+
+SelectServer *g_ss = NULL;
+
+void MaybeStop(CountingWidget *widget, uint64_t expected) {
+  // with fuzzing we may never reach the full count; the writer closes
+  // the pty which terminates us instead
+  if (widget->messages >= expected)
+    g_ss->Terminate();
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  ola::AppInit(&argc, argv, "[options]",
+               "Bench / fuzz the Usb Pro widget framing code.");
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) || unlockpt(master)) {
+    OLA_FATAL << "Failed to open a pty";
+    return 1;
+  }
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (slave < 0) {
+    OLA_FATAL << "Failed to open the pty slave";
+    return 1;
+  }
+
+  // raw mode, or the line discipline mangles (and echoes) the stream
+  struct termios term;
+  tcgetattr(slave, &term);
+  cfmakeraw(&term);
+  tcsetattr(slave, TCSANOW, &term);
+
+  SelectServer ss;
+  g_ss = &ss;
+  DeviceDescriptor *descriptor = new DeviceDescriptor(slave);
+  CountingWidget widget(descriptor);
+  descriptor->SetOnData(ola::NewCallback(
+      static_cast<ola::plugin::usbpro::BaseUsbProWidget*>(&widget),
+      &ola::plugin::usbpro::BaseUsbProWidget::DescriptorReady));
+  ss.AddReadDescriptor(descriptor);
+
+  // The writer: a child process blasting frames (some corrupted) at the
+  // master side at line rate.
+  pid_t writer = fork();
+  if (writer == 0) {
+    uint8_t frame[5 + 513];
+    frame[0] = 0x7e;  // SOM
+    frame[1] = 6;     // DMX label
+    frame[2] = (513) & 0xff;
+    frame[3] = (513) >> 8;
+    for (unsigned int i = 0; i < 513; i++)
+      frame[4 + i] = static_cast<uint8_t>(i);
+    frame[sizeof(frame) - 1] = 0xe7;  // EOM
+
+    for (uint64_t i = 0; i < FLAGS_messages; i++) {
+      uint8_t buffer[sizeof(frame)];
+      memcpy(buffer, frame, sizeof(frame));
+      if (FLAGS_fuzz_pct &&
+          static_cast<uint32_t>(random() % 100) < FLAGS_fuzz_pct) {
+        // corrupt a random byte; the parser should resync on the next SOM
+        buffer[random() % sizeof(buffer)] = static_cast<uint8_t>(random());
+      }
+      const uint8_t *ptr = buffer;
+      ssize_t remaining = sizeof(buffer);
+      while (remaining > 0) {
+        ssize_t written = write(master, ptr, remaining);
+        if (written <= 0) {
+          usleep(100);
+          continue;
+        }
+        ptr += written;
+        remaining -= written;
+      }
+    }
+    _exit(0);
+  }
+
+  ola::Clock clock;
+  ola::TimeStamp start, end;
+  clock.CurrentTime(&start);
+
+  // run until we've seen the frames or the stream goes quiet
+  uint64_t last_count = 0;
+  while (true) {
+    ss.RunOnce(ola::TimeInterval(1, 0));
+    if (widget.messages >= FLAGS_messages)
+      break;
+    if (widget.messages == last_count) {
+      // a quiet second; if fuzzing ate the tail frames that's expected
+      break;
+    }
+    last_count = widget.messages;
+  }
+  clock.CurrentTime(&end);
+
+  double seconds = (end - start).AsInt() / 1e6;
+  cout << "parsed " << widget.messages << " / " << FLAGS_messages
+       << " frames (" << widget.payload_bytes << " payload bytes) in "
+       << seconds << "s: "
+       << static_cast<uint64_t>(widget.messages / seconds)
+       << " frames/s with " << FLAGS_fuzz_pct << "% corruption" << endl;
+
+  if (!FLAGS_fuzz_pct && widget.messages != FLAGS_messages) {
+    cout << "FAIL: lost frames without fuzzing" << endl;
+    return 1;
+  }
+  cout << "PASS" << endl;
+  return 0;
+}